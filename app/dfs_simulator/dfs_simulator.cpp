@@ -0,0 +1,571 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+/**
+ * Discrete-event simulator for the DFS load balancing policies.
+ *
+ * A stream of timeslices is distributed among compute nodes of given
+ * relative speeds according to the load distribution of the current interval
+ * (smooth weighted round robin). Compute nodes process their timeslices in
+ * order from a bounded buffer; a full buffer blocks the input stream. Every
+ * balancer-interval-count intervals, the per compute node medians observed
+ * since the last decision are passed to the configured LoadBalancingPolicy
+ * instances and the average of their distributions becomes the new load.
+ * Failed compute nodes are removed from the distribution and their buffered
+ * timeslices are sent again.
+ *
+ * Usage: dfs_simulator --speeds 1,1,1,0.5 --policies proportional-throughput
+ */
+
+#include "LoadBalancingPolicy.hpp"
+#include "dfs/StatisticsCalculator.hpp"
+#include "log.hpp"
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace po = boost::program_options;
+using namespace tl_libfabric;
+
+namespace {
+
+struct SimulationParameters {
+  std::vector<double> speeds;
+  std::vector<double> weights; // configured capacities, empty: equal
+  uint32_t interval_count = 40;
+  uint32_t interval_length = 1000;
+  uint32_t balancer_interval_count = 4;
+  std::string policies = LoadBalancingPolicy::DEFAULT_POLICIES;
+  uint32_t variance_percentage = 10;
+  double ts_duration = 1000;   // microseconds at speed 1
+  double jitter = 0.1;         // relative standard deviation
+  double input_rate = 0;       // timeslices per second, 0: unlimited
+  uint32_t buffer_size = 16;   // timeslices per compute node
+  double network_latency = 50; // microseconds
+  // <node, interval>
+  std::vector<std::pair<uint32_t, uint32_t>> failures;
+  uint64_t seed = 1;
+  bool verbose = false;
+};
+
+class Simulator {
+public:
+  explicit Simulator(const SimulationParameters& par)
+      : par_(par), nodes_(par.speeds.size()),
+        policies_(LoadBalancingPolicy::create(par.policies,
+                                              par.variance_percentage)),
+        load_(LoadBalancingPolicy::initial_load(par.weights,
+                                                par.speeds.size())),
+        credit_(par.speeds.size(), 0.0),
+        rng_(par.seed) {
+    for (uint32_t i = 0; i < nodes_.size(); ++i)
+      nodes_[i].speed = par.speeds[i];
+  }
+
+  void run() {
+    schedule_send(0);
+    while (!events_.empty()) {
+      Event event = events_.top();
+      events_.pop();
+      now_ = event.time;
+      switch (event.type) {
+      case EventType::SEND:
+        on_send();
+        break;
+      case EventType::ARRIVE:
+        on_arrive(event.node, event.ts);
+        break;
+      case EventType::COMPLETE:
+        on_complete(event.node, event.ts);
+        break;
+      }
+    }
+    finish_interval();
+  }
+
+  void report(std::ostream& out) const {
+    double seconds = now_ / 1e6;
+    double throughput = seconds > 0 ? completed_ / seconds : 0;
+    double capacity = 0;
+    for (const ComputeNode& node : nodes_) {
+      if (!node.failed)
+        capacity += node.speed * 1e6 / par_.ts_duration;
+    }
+
+    out << "policies:            " << par_.policies << "\n"
+        << "timeslices:          " << completed_ << " (" << resent_
+        << " sent again)\n"
+        << "simulated time:      " << seconds << " s\n"
+        << "throughput:          " << throughput << " ts/s\n"
+        << "capacity (at end):   " << capacity << " ts/s\n"
+        << "efficiency:          " << 100.0 * throughput / capacity << " %\n"
+        << "input blocked:       " << 100.0 * blocked_time_ / now_ << " %\n"
+        << "load decisions:      " << decision_count_ << "\n";
+
+    double sum = 0, sq_sum = 0;
+    uint32_t live = 0;
+    out << "\n"
+        << std::setw(6) << "node" << std::setw(8) << "speed" << std::setw(12)
+        << "timeslices" << std::setw(14) << "utilization" << std::setw(10)
+        << "load"
+        << "\n";
+    for (uint32_t i = 0; i < nodes_.size(); ++i) {
+      const ComputeNode& node = nodes_[i];
+      double utilization = now_ > 0 ? node.busy_time / now_ : 0;
+      out << std::setw(6) << i << std::setw(8) << node.speed << std::setw(12)
+          << node.completed << std::setw(13) << 100.0 * utilization << "%"
+          << std::setw(10) << (node.failed ? "failed" : to_string(load_[i]))
+          << "\n";
+      if (!node.failed) {
+        sum += utilization;
+        sq_sum += utilization * utilization;
+        ++live;
+      }
+    }
+    if (live > 0) {
+      double mean = sum / live;
+      double stddev = std::sqrt(std::max(0.0, sq_sum / live - mean * mean));
+      out << "\nbalance (utilization cv): "
+          << (mean > 0 ? stddev / mean : 0) << "\n";
+    }
+  }
+
+private:
+  enum class EventType { SEND, ARRIVE, COMPLETE };
+
+  struct Event {
+    double time;
+    uint64_t sequence;
+    EventType type;
+    uint32_t node;
+    uint64_t ts;
+    bool operator>(const Event& other) const {
+      return time != other.time ? time > other.time
+                                : sequence > other.sequence;
+    }
+  };
+
+  struct ComputeNode {
+    double speed = 1;
+    bool failed = false;
+    bool busy = false;
+    uint64_t serving_ts = 0;
+    double service_start = 0;
+    uint32_t occupancy = 0;
+    // <timeslice, arrival time>
+    std::deque<std::pair<uint64_t, double>> queue;
+    double busy_time = 0;
+    uint64_t completed = 0;
+    // observations since the last load balancing decision
+    StatisticsCalculator::Histogram processing_duration;
+    StatisticsCalculator::Histogram completion_duration;
+    StatisticsCalculator::Histogram send_latency;
+    StatisticsCalculator::Histogram buffer_fill_level;
+  };
+
+  static std::string to_string(double value) {
+    std::ostringstream str;
+    str << std::setprecision(3) << value;
+    return str.str();
+  }
+
+  void schedule(double time, EventType type, uint32_t node, uint64_t ts) {
+    events_.push(Event{time, sequence_++, type, node, ts});
+  }
+
+  uint64_t total_timeslices() const {
+    return static_cast<uint64_t>(par_.interval_count) * par_.interval_length;
+  }
+
+  // Smooth weighted round robin over the live compute nodes
+  uint32_t next_owner() {
+    double sum = 0;
+    uint32_t best = 0;
+    bool found = false;
+    for (uint32_t i = 0; i < nodes_.size(); ++i) {
+      if (nodes_[i].failed)
+        continue;
+      credit_[i] += load_[i];
+      sum += load_[i];
+      if (!found || credit_[i] > credit_[best]) {
+        best = i;
+        found = true;
+      }
+    }
+    if (!found)
+      throw std::runtime_error("all compute nodes failed");
+    credit_[best] -= sum;
+    return best;
+  }
+
+  void schedule_send(double time) {
+    if (!send_scheduled_) {
+      schedule(time, EventType::SEND, 0, 0);
+      send_scheduled_ = true;
+    }
+  }
+
+  void on_send() {
+    send_scheduled_ = false;
+    if (blocked_)
+      return;
+    if (!has_pending_) {
+      if (!resend_.empty()) {
+        pending_ts_ = resend_.front();
+        resend_.pop_front();
+      } else if (next_ts_ < total_timeslices()) {
+        if (next_ts_ % par_.interval_length == 0 && next_ts_ > 0)
+          start_interval(next_ts_ / par_.interval_length);
+        pending_ts_ = next_ts_++;
+      } else {
+        return;
+      }
+      pending_owner_ = next_owner();
+      has_pending_ = true;
+      ready_since_ = now_;
+    }
+
+    ComputeNode& node = nodes_[pending_owner_];
+    if (node.occupancy >= par_.buffer_size) {
+      blocked_ = true;
+      blocked_since_ = now_;
+      return;
+    }
+    ++node.occupancy;
+    node.send_latency.record(
+        static_cast<uint64_t>(now_ - ready_since_ + par_.network_latency));
+    schedule(now_ + par_.network_latency, EventType::ARRIVE, pending_owner_,
+             pending_ts_);
+    has_pending_ = false;
+
+    double gap = par_.input_rate > 0 ? 1e6 / par_.input_rate : 0;
+    schedule_send(now_ + gap);
+  }
+
+  void on_arrive(uint32_t index, uint64_t ts) {
+    ComputeNode& node = nodes_[index];
+    if (node.failed) {
+      resend(ts);
+      return;
+    }
+    node.queue.emplace_back(ts, now_);
+    if (!node.busy)
+      start_service(index);
+  }
+
+  void start_service(uint32_t index) {
+    ComputeNode& node = nodes_[index];
+    if (node.queue.empty())
+      return;
+    std::pair<uint64_t, double> entry = node.queue.front();
+    node.queue.pop_front();
+    double factor = std::max(0.1, 1.0 + par_.jitter * normal_(rng_));
+    double duration = par_.ts_duration / node.speed * factor;
+    node.busy = true;
+    node.serving_ts = entry.first;
+    node.service_start = now_;
+    node.processing_duration.record(static_cast<uint64_t>(duration));
+    node.buffer_fill_level.record(node.occupancy * 100 / par_.buffer_size);
+    schedule(now_ + duration, EventType::COMPLETE, index, entry.first);
+    node.completion_duration.record(
+        static_cast<uint64_t>(now_ + duration - entry.second));
+  }
+
+  void on_complete(uint32_t index, uint64_t ts) {
+    ComputeNode& node = nodes_[index];
+    if (node.failed || !node.busy || node.serving_ts != ts)
+      return;
+    node.busy = false;
+    node.busy_time += now_ - node.service_start;
+    --node.occupancy;
+    ++node.completed;
+    ++completed_;
+    start_service(index);
+    if (blocked_ && pending_owner_ == index)
+      unblock();
+  }
+
+  void unblock() {
+    blocked_ = false;
+    blocked_time_ += now_ - blocked_since_;
+    schedule_send(now_);
+  }
+
+  void resend(uint64_t ts) {
+    resend_.push_back(ts);
+    ++resent_;
+    if (!blocked_)
+      schedule_send(now_);
+  }
+
+  void fail(uint32_t index) {
+    ComputeNode& node = nodes_[index];
+    if (node.failed)
+      return;
+    node.failed = true;
+    if (node.busy) {
+      node.busy_time += now_ - node.service_start;
+      resend(node.serving_ts);
+      node.busy = false;
+    }
+    for (const auto& entry : node.queue)
+      resend(entry.first);
+    node.queue.clear();
+    node.occupancy = 0;
+    load_[index] = 0;
+    if (par_.verbose)
+      std::cout << "compute node " << index << " failed" << std::endl;
+    if (has_pending_ && pending_owner_ == index) {
+      pending_owner_ = next_owner();
+      if (blocked_)
+        unblock();
+    }
+  }
+
+  void start_interval(uint64_t interval) {
+    finish_interval();
+    interval_start_ = now_;
+
+    for (const auto& failure : par_.failures) {
+      if (failure.second == interval && failure.first < nodes_.size())
+        fail(failure.first);
+    }
+    if (interval % par_.balancer_interval_count == 0)
+      balance_load();
+  }
+
+  void finish_interval() {
+    if (par_.verbose) {
+      std::cout << "interval " << std::setw(5) << interval_ << " duration "
+                << std::setw(10) << (now_ - interval_start_) / 1e3
+                << " ms, load";
+      for (uint32_t i = 0; i < load_.size(); ++i)
+        std::cout << " " << to_string(load_[i]);
+      std::cout << std::endl;
+    }
+    ++interval_;
+  }
+
+  // Pass the observations of the live compute nodes to the policies
+  void balance_load() {
+    std::vector<uint32_t> live;
+    std::vector<ComputeNodeLoadStatistics> statistics;
+    std::vector<double> last_load;
+    for (uint32_t i = 0; i < nodes_.size(); ++i) {
+      ComputeNode& node = nodes_[i];
+      if (node.failed)
+        continue;
+      ComputeNodeLoadStatistics stats;
+      stats.ts_processing_duration = node.processing_duration.median();
+      stats.ts_completion_duration = node.completion_duration.median();
+      stats.rdma_latency = node.send_latency.median();
+      stats.message_latency = stats.rdma_latency;
+      stats.buffer_fill_level =
+          static_cast<uint32_t>(node.buffer_fill_level.median());
+      statistics.push_back(stats);
+      last_load.push_back(load_[i]);
+      live.push_back(i);
+      node.processing_duration.reset();
+      node.completion_duration.reset();
+      node.send_latency.reset();
+      node.buffer_fill_level.reset();
+    }
+    // the loads of the live nodes sum up to their number
+    double sum = 0;
+    for (double l : last_load)
+      sum += l;
+    for (double& l : last_load)
+      l = sum > 0 ? l * last_load.size() / sum : 1.0;
+
+    std::vector<double> new_load(live.size(), 0);
+    for (auto& policy : policies_) {
+      LoadBalancingDecision decision =
+          policy->decide(statistics, last_load, true);
+      for (uint32_t i = 0; i < live.size(); ++i)
+        new_load[i] += decision.load[i] / policies_.size();
+    }
+    for (uint32_t i = 0; i < live.size(); ++i)
+      load_[live[i]] = new_load[i];
+    ++decision_count_;
+  }
+
+  const SimulationParameters& par_;
+  std::vector<ComputeNode> nodes_;
+  std::vector<std::unique_ptr<LoadBalancingPolicy>> policies_;
+
+  // relative load and round robin credit of each compute node
+  std::vector<double> load_;
+  std::vector<double> credit_;
+
+  std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events_;
+  uint64_t sequence_ = 0;
+  double now_ = 0;
+
+  // input stream state
+  bool send_scheduled_ = false;
+  uint64_t next_ts_ = 0;
+  std::deque<uint64_t> resend_;
+  bool has_pending_ = false;
+  uint64_t pending_ts_ = 0;
+  uint32_t pending_owner_ = 0;
+  double ready_since_ = 0;
+  bool blocked_ = false;
+  double blocked_since_ = 0;
+  double blocked_time_ = 0;
+
+  uint64_t interval_ = 0;
+  double interval_start_ = 0;
+  uint64_t completed_ = 0;
+  uint64_t resent_ = 0;
+  uint64_t decision_count_ = 0;
+
+  std::mt19937_64 rng_;
+  std::normal_distribution<double> normal_;
+};
+
+template <typename T> std::vector<T> parse_list(const std::string& text) {
+  std::vector<T> values;
+  std::istringstream stream(text);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    if (item.empty())
+      continue;
+    size_t pos = 0;
+    double value = 0;
+    try {
+      value = std::stod(item, &pos);
+    } catch (const std::logic_error&) {
+    }
+    if (pos != item.size() || !std::isfinite(value))
+      throw po::invalid_option_value(item);
+    values.push_back(static_cast<T>(value));
+  }
+  return values;
+}
+
+bool parse_options(int argc, char* argv[], SimulationParameters& par) {
+  unsigned log_level = 3;
+  uint32_t compute_nodes = 4;
+  std::string speeds;
+  std::string weights;
+  std::vector<std::string> failures;
+
+  po::options_description desc("Allowed options");
+  auto desc_add = desc.add_options();
+  desc_add("help,h", "produce help message");
+  desc_add("log-level,l",
+           po::value<unsigned>(&log_level)->default_value(log_level),
+           "set the log level (all:0)");
+  desc_add("verbose,v", po::bool_switch(&par.verbose),
+           "print the duration and load of each interval");
+  desc_add("compute-nodes,n",
+           po::value<uint32_t>(&compute_nodes)->default_value(compute_nodes),
+           "number of compute nodes of speed 1 (if no speeds are given)");
+  desc_add("speeds,s", po::value<std::string>(&speeds),
+           "comma-separated relative speeds of the compute nodes");
+  desc_add("weights,w", po::value<std::string>(&weights),
+           "comma-separated configured capacities of the compute nodes");
+  desc_add("intervals,i",
+           po::value<uint32_t>(&par.interval_count)
+               ->default_value(par.interval_count),
+           "number of intervals to simulate");
+  desc_add("interval-length",
+           po::value<uint32_t>(&par.interval_length)
+               ->default_value(par.interval_length),
+           "timeslices per interval");
+  desc_add("balancer-interval-count",
+           po::value<uint32_t>(&par.balancer_interval_count)
+               ->default_value(par.balancer_interval_count),
+           "intervals between load balancing decisions");
+  desc_add("policies,p",
+           po::value<std::string>(&par.policies)->default_value(par.policies),
+           "comma-separated load balancing policies");
+  desc_add("variance-percentage",
+           po::value<uint32_t>(&par.variance_percentage)
+               ->default_value(par.variance_percentage),
+           "allowed difference before the load is redistributed");
+  desc_add("ts-duration",
+           po::value<double>(&par.ts_duration)->default_value(par.ts_duration),
+           "timeslice processing duration at speed 1 (microseconds)");
+  desc_add("jitter", po::value<double>(&par.jitter)->default_value(par.jitter),
+           "relative standard deviation of the processing duration");
+  desc_add("input-rate",
+           po::value<double>(&par.input_rate)->default_value(par.input_rate),
+           "timeslices per second entering the system (0: unlimited)");
+  desc_add("buffer-size",
+           po::value<uint32_t>(&par.buffer_size)
+               ->default_value(par.buffer_size),
+           "buffered timeslices per compute node");
+  desc_add("network-latency",
+           po::value<double>(&par.network_latency)
+               ->default_value(par.network_latency),
+           "timeslice transfer latency (microseconds)");
+  desc_add("fail,f", po::value<std::vector<std::string>>(&failures),
+           "fail a compute node at the start of an interval "
+           "(<node>@<interval>, repeatable)");
+  desc_add("seed", po::value<uint64_t>(&par.seed)->default_value(par.seed),
+           "random seed");
+
+  po::variables_map vm;
+  po::store(po::parse_command_line(argc, argv, desc), vm);
+  po::notify(vm);
+
+  if (vm.count("help") != 0u) {
+    std::cout << "dfs_simulator, DFS load balancing policy simulator\n"
+              << desc << std::endl;
+    return false;
+  }
+
+  logging::add_console(static_cast<severity_level>(log_level));
+
+  par.speeds = speeds.empty() ? std::vector<double>(compute_nodes, 1.0)
+                              : parse_list<double>(speeds);
+  if (!weights.empty())
+    par.weights = parse_list<double>(weights);
+  for (const std::string& failure : failures) {
+    size_t at = failure.find('@');
+    if (at == std::string::npos)
+      throw po::invalid_option_value(failure);
+    par.failures.emplace_back(std::stoul(failure.substr(0, at)),
+                              std::stoul(failure.substr(at + 1)));
+  }
+  if (par.speeds.empty() || par.interval_length == 0 ||
+      par.balancer_interval_count == 0 || par.buffer_size == 0 ||
+      par.ts_duration <= 0 ||
+      std::any_of(par.speeds.begin(), par.speeds.end(),
+                  [](double s) { return s <= 0; }) ||
+      std::any_of(par.weights.begin(), par.weights.end(),
+                  [](double w) { return w < 0; }) ||
+      (!par.weights.empty() &&
+       std::none_of(par.weights.begin(), par.weights.end(),
+                    [](double w) { return w > 0; })))
+    throw po::error("invalid simulation parameters");
+  return true;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+  try {
+    SimulationParameters par;
+    if (!parse_options(argc, argv, par))
+      return EXIT_SUCCESS;
+    Simulator simulator(par);
+    simulator.run();
+    simulator.report(std::cout);
+  } catch (std::exception const& e) {
+    std::cerr << "dfs_simulator: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+/**
+ * Convert binary DFS trace files (see TraceFormat.hpp) to CSV.
+ *
+ * Usage: dfs_trace [-o output.csv] trace_file...
+ */
+
+#include "TraceFormat.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace tl_libfabric;
+
+namespace {
+
+bool convert(const std::string& file_name, std::ostream& out) {
+  std::ifstream in(file_name, std::ios::binary);
+  if (!in) {
+    std::cerr << "cannot open " << file_name << std::endl;
+    return false;
+  }
+
+  TraceFileHeader header;
+  in.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!in || header.magic != TraceFileHeader::MAGIC) {
+    std::cerr << file_name << ": not a DFS trace file" << std::endl;
+    return false;
+  }
+  if (header.version != TraceFileHeader::VERSION ||
+      header.record_size != sizeof(TraceRecord)) {
+    std::cerr << file_name << ": unsupported trace version " << header.version
+              << std::endl;
+    return false;
+  }
+
+  const char* role = header.node_role == 0 ? "input" : "compute";
+  std::vector<TraceRecord> records(4096);
+  while (in) {
+    in.read(reinterpret_cast<char*>(records.data()),
+            static_cast<std::streamsize>(records.size() * sizeof(TraceRecord)));
+    size_t count = static_cast<size_t>(in.gcount()) / sizeof(TraceRecord);
+    for (size_t i = 0; i < count; ++i) {
+      const TraceRecord& rec = records[i];
+      out << role << ',' << header.node_index << ',' << rec.thread << ','
+          << static_cast<int64_t>(rec.time_ns) + header.clock_offset_ns << ','
+          << trace_event_name(rec.event) << ',' << rec.destination << ','
+          << rec.id << ',' << rec.value << '\n';
+    }
+  }
+  return true;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+  std::string output;
+  std::vector<std::string> inputs;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      output = argv[++i];
+    } else if (std::strcmp(argv[i], "-h") == 0 ||
+               std::strcmp(argv[i], "--help") == 0) {
+      inputs.clear();
+      break;
+    } else {
+      inputs.emplace_back(argv[i]);
+    }
+  }
+  if (inputs.empty()) {
+    std::cerr << "Usage: " << argv[0] << " [-o output.csv] trace_file..."
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ofstream file;
+  if (!output.empty()) {
+    file.open(output);
+    if (!file) {
+      std::cerr << "cannot open " << output << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::ostream& out = output.empty() ? std::cout : file;
+
+  out << "role,node,thread,time_ns,event,destination,id,value\n";
+  bool ok = true;
+  for (const auto& input : inputs) {
+    ok = convert(input, out) && ok;
+  }
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
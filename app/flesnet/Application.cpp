@@ -3,6 +3,7 @@
 #include "Application.hpp"
 #include "ChildProcessManager.hpp"
 #include "FlesnetPatternGenerator.hpp"
+#include "InputBufferCrcStage.hpp"
 #include "Utility.hpp"
 #include "log.hpp"
 #include "shm_channel_client.hpp"
@@ -15,8 +16,28 @@
 Application::Application(Parameters const& par,
                          volatile sig_atomic_t* signal_status)
     : par_(par), signal_status_(signal_status) {
+  if (par_.metrics_port() != 0) {
+    metrics_server_ = std::make_unique<MetricsServer>(par_.metrics_port());
+  }
+  if (!par_.metrics_push_uri().empty()) {
+    metrics_pusher_ = std::make_unique<MetricsPusher>(
+        par_.metrics_push_uri(), std::chrono::seconds(10));
+  }
   zmq_context_ = std::unique_ptr<void, std::function<int(void*)>>(
       zmq_ctx_new(), zmq_ctx_destroy);
+#ifdef HAVE_LIBFABRIC
+  if (par_.transport() == Transport::LibFabric) {
+    // has to be configured before the provider is initialized
+    tl_libfabric::LibfabricMRCache::getInst()->set_max_region_size(
+        par_.mr_max_size());
+    tl_libfabric::Provider::on_demand_paging = par_.mr_on_demand_paging();
+  }
+#endif
+  if (par_.transport() == Transport::Loopback) {
+    loopback_network_ = std::make_unique<tl_loopback::LoopbackNetwork>(
+        static_cast<uint32_t>(par_.inputs().size()),
+        static_cast<uint32_t>(par_.outputs().size()));
+  }
   create_input_channel_senders();
   create_timeslice_buffers();
   set_node();
@@ -84,10 +105,28 @@ void Application::create_timeslice_buffers() {
               par_.scheduler_speedup_interval_count(),
               par_.scheduler_balancer_difference_percentage(),
               par_.scheduler_balancer_interval_count(),
+              par_.scheduler_balancer_policies(),
+              par_.output_weights(), par_.active_outputs(),
               par_.scheduler_log_directory(), par_.scheduler_enable_logging()));
       timeslice_builders_.push_back(std::move(builder));
 #else
       L_(fatal) << "flesnet built without LIBFABRIC support";
+#endif
+    } else if (par_.transport() == Transport::Loopback) {
+      std::unique_ptr<tl_loopback::TimesliceBuilder> builder(
+          new tl_loopback::TimesliceBuilder(
+              i, *tsb, *loopback_network_, par_.timeslice_size(),
+              signal_status_, par_.drop_process_ts()));
+      timeslice_builders_.push_back(std::move(builder));
+    } else if (par_.transport() == Transport::IoUring) {
+#ifdef HAVE_IOURING
+      std::unique_ptr<tl_uring::TimesliceBuilder> builder(
+          new tl_uring::TimesliceBuilder(
+              i, *tsb, par_.base_port() + i, input_size, par_.timeslice_size(),
+              signal_status_, par_.drop_process_ts()));
+      timeslice_builders_.push_back(std::move(builder));
+#else
+      L_(fatal) << "flesnet built without io_uring support";
 #endif
     } else {
 #ifdef HAVE_RDMA
@@ -182,6 +221,12 @@ void Application::create_input_channel_senders() {
       L_(fatal) << "unknown input scheme: " << scheme;
     }
 
+    if (param.count("crc") != 0u) {
+      double crc_budget = std::stod(param.at("crc"));
+      data_sources_.back() = std::make_unique<InputBufferCrcStage>(
+          std::move(data_sources_.back()), index, crc_budget);
+    }
+
     uint32_t overlap_size = 1;
     if (param.count("overlap") != 0u) {
       overlap_size = stou(param.at("overlap"));
@@ -206,10 +251,29 @@ void Application::create_input_channel_senders() {
               output_services, par_.timeslice_size(), overlap_size,
               par_.max_timeslice_number(), par_.inputs().at(index).host,
               par_.scheduler_interval_length(), par_.scheduler_log_directory(),
-              par_.scheduler_enable_logging()));
+              par_.scheduler_enable_logging(), par_.sender_threads(),
+              par_.output_weights(), par_.active_outputs()));
       input_channel_senders_.push_back(std::move(sender));
 #else
       L_(fatal) << "flesnet built without LIBFABRIC support";
+#endif
+    } else if (par_.transport() == Transport::Loopback) {
+      std::unique_ptr<tl_loopback::InputChannelSender> sender(
+          new tl_loopback::InputChannelSender(
+              index, *(data_sources_.at(c).get()), *loopback_network_,
+              par_.timeslice_size(), overlap_size,
+              par_.max_timeslice_number()));
+      input_channel_senders_.push_back(std::move(sender));
+    } else if (par_.transport() == Transport::IoUring) {
+#ifdef HAVE_IOURING
+      std::unique_ptr<tl_uring::InputChannelSender> sender(
+          new tl_uring::InputChannelSender(
+              index, *(data_sources_.at(c).get()), output_hosts,
+              output_services, par_.timeslice_size(), overlap_size,
+              par_.max_timeslice_number()));
+      input_channel_senders_.push_back(std::move(sender));
+#else
+      L_(fatal) << "flesnet built without io_uring support";
 #endif
     } else {
 #ifdef HAVE_RDMA
@@ -228,7 +292,6 @@ void Application::create_input_channel_senders() {
 void Application::run() {
 // Do not spawn additional thread if only one is needed, simplifies
 // debugging
-#if defined(HAVE_RDMA) || defined(HAVE_LIBFABRIC)
   if (timeslice_builders_.size() == 1 && input_channel_senders_.empty()) {
     L_(debug) << "using existing thread for single timeslice builder";
     (*timeslice_builders_[0])();
@@ -239,14 +302,12 @@ void Application::run() {
     (*input_channel_senders_[0])();
     return;
   };
-#endif
 
   // FIXME: temporary code, need to implement interrupt
   boost::thread_group threads;
   std::vector<boost::unique_future<void>> futures;
   bool stop = false;
 
-#if defined(HAVE_RDMA) || defined(HAVE_LIBFABRIC)
   for (auto& buffer : timeslice_builders_) {
     boost::packaged_task<void> task(std::ref(*buffer));
     futures.push_back(task.get_future());
@@ -258,7 +319,6 @@ void Application::run() {
     futures.push_back(task.get_future());
     threads.add_thread(new boost::thread(std::move(task)));
   }
-#endif
 
   for (auto& buffer : timeslice_builders_zeromq_) {
     boost::packaged_task<void> task(std::ref(*buffer));
@@ -3,10 +3,14 @@
 
 #include "ComponentSenderZeromq.hpp"
 #include "ConnectionGroupWorker.hpp"
+#include "MetricsServer.hpp"
 #include "Parameters.hpp"
 #include "ThreadContainer.hpp"
 #include "TimesliceBuffer.hpp"
 #include "TimesliceBuilderZeromq.hpp"
+#include "fles_loopback/InputChannelSender.hpp"
+#include "fles_loopback/LoopbackNetwork.hpp"
+#include "fles_loopback/TimesliceBuilder.hpp"
 #include "shm_device_client.hpp"
 #if defined(HAVE_RDMA)
 #include "fles_rdma/InputChannelSender.hpp"
@@ -16,6 +20,10 @@
 #include "fles_libfabric/InputChannelSender.hpp"
 #include "fles_libfabric/TimesliceBuilder.hpp"
 #endif
+#if defined(HAVE_IOURING)
+#include "fles_uring/InputChannelSender.hpp"
+#include "fles_uring/TimesliceBuilder.hpp"
+#endif
 #include <csignal>
 #include <map>
 #include <memory>
@@ -46,6 +54,10 @@ private:
   Parameters const& par_;
   volatile sig_atomic_t* signal_status_;
 
+  /// The application's metrics scrape endpoint and push client
+  std::unique_ptr<MetricsServer> metrics_server_;
+  std::unique_ptr<MetricsPusher> metrics_pusher_;
+
   // Input node application
   std::map<std::string, std::shared_ptr<flib_shm_device_client>> shm_devices_;
 
@@ -53,11 +65,13 @@ private:
   std::vector<std::unique_ptr<InputBufferReadInterface>> data_sources_;
   std::vector<std::unique_ptr<TimesliceBuffer>> timeslice_buffers_;
 
-#if defined(HAVE_RDMA) || defined(HAVE_LIBFABRIC)
-  /// The application's RDMA or libfabric transport objects
+  /// The application's RDMA, libfabric, io_uring or loopback transport
+  /// objects
   std::vector<std::unique_ptr<ConnectionGroupWorker>> timeslice_builders_;
   std::vector<std::unique_ptr<ConnectionGroupWorker>> input_channel_senders_;
-#endif
+
+  /// The channels between the loopback transport objects
+  std::unique_ptr<tl_loopback::LoopbackNetwork> loopback_network_;
 
   /// The application's ZeroMQ context
   std::unique_ptr<void, std::function<int(void*)>> zmq_context_;
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <boost/algorithm/string/join.hpp>
 #include <boost/program_options.hpp>
+#include <cmath>
 #define _TURN_OFF_PLATFORM_STRING
 #include <cpprest/base_uri.h>
 #include <fstream>
@@ -28,6 +29,10 @@ std::istream& operator>>(std::istream& in, Transport& transport) {
     transport = Transport::LibFabric;
   } else if (token == "zeromq" || token == "z") {
     transport = Transport::ZeroMQ;
+  } else if (token == "iouring" || token == "u") {
+    transport = Transport::IoUring;
+  } else if (token == "loopback" || token == "l") {
+    transport = Transport::Loopback;
   } else {
     throw po::invalid_option_value(token);
   }
@@ -45,6 +50,12 @@ std::ostream& operator<<(std::ostream& out, const Transport& transport) {
   case Transport::ZeroMQ:
     out << "ZeroMQ";
     break;
+  case Transport::IoUring:
+    out << "IoUring";
+    break;
+  case Transport::Loopback:
+    out << "Loopback";
+    break;
   }
   return out;
 }
@@ -97,6 +108,13 @@ void Parameters::parse_options(int argc, char* argv[]) {
               po::value<std::string>(&monitor_uri_)
                   ->implicit_value("http://login:8086/"),
               "publish flesnet status to InfluxDB");
+  generic_add("metrics-port",
+              po::value<uint16_t>(&metrics_port_)->value_name("<port>"),
+              "serve metrics for Prometheus at http://<host>:<port>/metrics");
+  generic_add("metrics-push",
+              po::value<std::string>(&metrics_push_uri_)->value_name("<uri>"),
+              "push metrics periodically to a Prometheus Pushgateway, e.g. "
+              "http://host:9091/metrics/job/flesnet");
   generic_add("help,h", "display this help and exit");
   generic_add("version,V", "output version information and exit");
 
@@ -119,7 +137,10 @@ void Parameters::parse_options(int argc, char* argv[]) {
              po::value<std::vector<InterfaceSpecification>>()
                  ->multitoken()
                  ->value_name("scheme://host/path?param=value ..."),
-             "add an output to the list of compute node outputs");
+             "add an output to the list of compute node outputs (the "
+             "\"weight\" parameter gives its relative capacity, outputs "
+             "with \"standby=1\" join the running system later; only "
+             "outputs listed at startup can join)");
   config_add("timeslice-size",
              po::value<uint32_t>(&timeslice_size_)
                  ->default_value(timeslice_size_)
@@ -147,7 +168,8 @@ void Parameters::parse_options(int argc, char* argv[]) {
                  ->default_value(transport_)
                  ->value_name("<id>"),
              "select transport implementation; possible values "
-             "(case-insensitive) are: RDMA, LibFabric, ZeroMQ");
+             "(case-insensitive) are: RDMA, LibFabric, ZeroMQ, IoUring, "
+             "Loopback (single process only)");
   config_add("discard-all-ts",
              po::value<bool>(&drop_process_ts_)->default_value(false),
              "Discard all timeslices at receiver (debug only)");
@@ -170,6 +192,14 @@ void Parameters::parse_options(int argc, char* argv[]) {
       "scheduler-speedup-interval-count",
       po::value<uint32_t>(&scheduler_speedup_interval_count_)->default_value(0),
       "The scheduler speeding up interval count (LibFabric only)");
+  config_add("scheduler-balancer-policies",
+             po::value<std::string>(&scheduler_balancer_policies_)
+                 ->default_value(scheduler_balancer_policies_)
+                 ->value_name("<list>"),
+             "comma-separated load balancing policies: rdma-latency, "
+             "msg-latency, processing-duration, completion-duration, "
+             "proportional-throughput, pid, buffer-fill-level (LibFabric "
+             "only)");
   config_add(
       "scheduler-log-directory",
       po::value<std::string>(&scheduler_log_directory_)->default_value("."),
@@ -177,6 +207,23 @@ void Parameters::parse_options(int argc, char* argv[]) {
   config_add("scheduler-enable-logging",
              po::value<bool>(&scheduler_enable_logging_)->default_value(false),
              "Enable generating logging files (LibFabric only)");
+  config_add("sender-threads",
+             po::value<uint32_t>(&sender_threads_)
+                 ->default_value(sender_threads_)
+                 ->value_name("<n>"),
+             "number of threads sharing the compute connections of an input "
+             "(LibFabric only)");
+  config_add("mr-max-size",
+             po::value<uint64_t>(&mr_max_size_)
+                 ->default_value(mr_max_size_)
+                 ->value_name("<bytes>"),
+             "maximum size of a registered memory region, larger buffers are "
+             "registered in chunks; 0 = limited by provider (LibFabric only)");
+  config_add("mr-odp",
+             po::value<bool>(&mr_on_demand_paging_)
+                 ->default_value(mr_on_demand_paging_),
+             "register buffers with on-demand paging instead of pinning, "
+             "requires FI_VERBS_USE_ODP=1 (LibFabric verbs only)");
 
   po::options_description cmdline_options("Allowed options");
   cmdline_options.add(generic).add(config);
@@ -223,6 +270,10 @@ void Parameters::parse_options(int argc, char* argv[]) {
     throw ParametersException("timeslice size cannot be zero");
   }
 
+  if (sender_threads_ < 1) {
+    throw ParametersException("number of sender threads cannot be zero");
+  }
+
 #ifndef HAVE_RDMA
   if (transport_ == Transport::RDMA) {
     throw ParametersException("flesnet built without RDMA support");
@@ -233,6 +284,11 @@ void Parameters::parse_options(int argc, char* argv[]) {
     throw ParametersException("flesnet built without LIBFABRIC support");
   }
 #endif
+#ifndef HAVE_IOURING
+  if (transport_ == Transport::IoUring) {
+    throw ParametersException("flesnet built without io_uring support");
+  }
+#endif
 
   if (vm.count("input") == 0u) {
     throw ParametersException("list of inputs is empty");
@@ -259,6 +315,49 @@ void Parameters::parse_options(int argc, char* argv[]) {
     }
   }
 
+  for (size_t i = 0; i < outputs_.size(); ++i) {
+    if (outputs_[i].param.count("weight") == 0u) {
+      continue;
+    }
+    output_weights_.resize(outputs_.size(), 1.0);
+    const std::string& text = outputs_[i].param.at("weight");
+    double weight = -1;
+    try {
+      size_t pos = 0;
+      weight = std::stod(text, &pos);
+      if (pos != text.size()) {
+        weight = -1;
+      }
+    } catch (const std::logic_error&) {
+    }
+    if (!std::isfinite(weight) || weight < 0) {
+      throw ParametersException("invalid output weight: " +
+                                outputs_[i].full_uri);
+    }
+    output_weights_[i] = weight;
+  }
+  if (!output_weights_.empty() &&
+      std::none_of(output_weights_.begin(), output_weights_.end(),
+                   [](double w) { return w > 0; })) {
+    throw ParametersException("all output weights are zero");
+  }
+
+  // standby outputs follow the outputs that start the run
+  active_outputs_ = static_cast<uint32_t>(outputs_.size());
+  for (size_t i = 0; i < outputs_.size(); ++i) {
+    bool standby = outputs_[i].param.count("standby") != 0u &&
+                   outputs_[i].param.at("standby") != "0";
+    if (standby && active_outputs_ == outputs_.size()) {
+      active_outputs_ = static_cast<uint32_t>(i);
+    } else if (!standby && active_outputs_ != outputs_.size()) {
+      throw ParametersException("standby outputs have to be the last ones: " +
+                                outputs_[i].full_uri);
+    }
+  }
+  if (active_outputs_ == 0 && !outputs_.empty()) {
+    throw ParametersException("at least one output must not be standby");
+  }
+
   if (vm.count("input-index") != 0u) {
     input_indexes_ = vm["input-index"].as<std::vector<unsigned>>();
   }
@@ -288,6 +387,11 @@ void Parameters::parse_options(int argc, char* argv[]) {
     }
   }
 
+  if (transport_ == Transport::Loopback && !local_only()) {
+    throw ParametersException(
+        "loopback transport requires all inputs and outputs in one process");
+  }
+
   if (!outputs_.empty() && processor_executable_.empty()) {
     throw ParametersException("processor executable not specified");
   }
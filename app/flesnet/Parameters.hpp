@@ -26,7 +26,7 @@ struct InterfaceSpecification {
 };
 
 /// Transport implementation enum.
-enum class Transport { RDMA, LibFabric, ZeroMQ };
+enum class Transport { RDMA, LibFabric, ZeroMQ, IoUring, Loopback };
 
 std::istream& operator>>(std::istream& in, Transport& transport);
 std::ostream& operator<<(std::ostream& out, const Transport& transport);
@@ -45,6 +45,12 @@ public:
 
   std::string monitor_uri() const { return monitor_uri_; }
 
+  /// Retrieve the port of the metrics endpoint (0: disabled).
+  uint16_t metrics_port() const { return metrics_port_; }
+
+  /// Retrieve the Pushgateway URI metrics are pushed to (empty: disabled).
+  std::string metrics_push_uri() const { return metrics_push_uri_; }
+
   /// Retrieve the global timeslice size in number of microslices.
   uint32_t timeslice_size() const { return timeslice_size_; }
 
@@ -69,6 +75,14 @@ public:
   /// Retrieve the list of compute node outputs.
   std::vector<InterfaceSpecification> outputs() const { return outputs_; }
 
+  /// Retrieve the relative capacity of each compute node output, given by
+  /// the "weight" parameter of the output URI (empty: all equal).
+  std::vector<double> output_weights() const { return output_weights_; }
+
+  /// Retrieve the number of outputs that start the run. The remaining
+  /// ("standby") outputs join the running system later.
+  uint32_t active_outputs() const { return active_outputs_; }
+
   /// Retrieve this applications's indexes in the list of inputs.
   std::vector<unsigned> input_indexes() const { return input_indexes_; }
 
@@ -120,6 +134,11 @@ public:
     return scheduler_balancer_interval_count_;
   }
 
+  /// Retrieve the comma-separated list of load balancing policies
+  std::string scheduler_balancer_policies() const {
+    return scheduler_balancer_policies_;
+  }
+
   /// Retrieve the directory to store DFS log files
   std::string scheduler_log_directory() const {
     return scheduler_log_directory_;
@@ -128,12 +147,28 @@ public:
   /// Check whether to generate  DFS log files
   bool scheduler_enable_logging() const { return scheduler_enable_logging_; }
 
+  /// Retrieve the number of threads sharing the compute connections of an
+  /// input channel
+  uint32_t sender_threads() const { return sender_threads_; }
+
+  /// Retrieve the maximum size of a single registered memory region
+  uint64_t mr_max_size() const { return mr_max_size_; }
+
+  /// Check whether registered buffers use on-demand paging
+  bool mr_on_demand_paging() const { return mr_on_demand_paging_; }
+
 private:
   /// Parse command line options.
   void parse_options(int argc, char* argv[]);
 
   std::string monitor_uri_;
 
+  /// The port of the metrics endpoint (0: disabled).
+  uint16_t metrics_port_ = 0;
+
+  /// The Pushgateway URI metrics are pushed to.
+  std::string metrics_push_uri_;
+
   /// The global timeslice size in number of microslices.
   uint32_t timeslice_size_ = 100;
 
@@ -158,6 +193,12 @@ private:
   /// The list of compute node outputs.
   std::vector<InterfaceSpecification> outputs_;
 
+  /// The relative capacity of each compute node output.
+  std::vector<double> output_weights_;
+
+  /// The number of outputs that start the run.
+  uint32_t active_outputs_ = 0;
+
   /// This applications's indexes in the list of inputs.
   std::vector<unsigned> input_indexes_;
 
@@ -190,8 +231,21 @@ private:
   /// The stabalizing/load balancing interval count of the scheduler
   uint32_t scheduler_balancer_interval_count_;
 
+  /// The load balancing policies whose load distributions are averaged
+  std::string scheduler_balancer_policies_ =
+      "rdma-latency,processing-duration,completion-duration";
+
   /// The directory to store the log files
   std::string scheduler_log_directory_;
 
   bool scheduler_enable_logging_ = false;
+
+  /// The number of threads sharing the compute connections of an input
+  uint32_t sender_threads_ = 1;
+
+  /// The maximum size of a single registered memory region (0: unlimited)
+  uint64_t mr_max_size_ = 0;
+
+  /// Use on-demand paging for registered buffers
+  bool mr_on_demand_paging_ = false;
 };
@@ -2,6 +2,7 @@
 
 #include "Application.hpp"
 #include "FlesnetPatternGenerator.hpp"
+#include "InputBufferCrcStage.hpp"
 #include "MicrosliceAnalyzer.hpp"
 #include "MicrosliceInputArchive.hpp"
 #include "MicrosliceOutputArchive.hpp"
@@ -41,6 +42,11 @@ Application::Application(Parameters const& par) : par_(par) {
         typical_content_size, true, true));
   }
 
+  if (data_source_ && par_.crc_budget > 0) {
+    data_source_ = std::make_unique<InputBufferCrcStage>(
+        std::move(data_source_), par_.channel_idx, par_.crc_budget);
+  }
+
   if (data_source_) {
     source_.reset(new fles::MicrosliceReceiver(*data_source_));
   } else if (!par_.input_archive.empty()) {
@@ -45,6 +45,10 @@ void Parameters::parse_options(int argc, char* argv[]) {
              "name of a shared memory to use as data source");
   source_add("input-archive,i", po::value<std::string>(&input_archive),
              "name of an input file archive to read");
+  source_add("crc-budget", po::value<double>(&crc_budget)->value_name("<r>"),
+             "compute the CRC-32C of the microslices from a pattern generator "
+             "or shared memory source, with a throughput budget of the given "
+             "number of GB/s per core");
 
   po::options_description sink("Sink options");
   auto sink_add = sink.add_options();
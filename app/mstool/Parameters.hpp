@@ -27,6 +27,7 @@ struct Parameters {
   size_t channel_idx = 0;
   std::string input_shm;
   std::string input_archive;
+  double crc_budget = 0;
 
   // sink selection
   bool analyze = false;
@@ -0,0 +1,21 @@
+# Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+# The io_uring transport talks to the kernel directly, it only needs kernel
+# headers recent enough to define zero-copy sends and multishot receives.
+find_path(IOURING_INCLUDE_DIR linux/io_uring.h)
+
+if(IOURING_INCLUDE_DIR)
+  include(CheckCXXSourceCompiles)
+  set(CMAKE_REQUIRED_INCLUDES ${IOURING_INCLUDE_DIR})
+  check_cxx_source_compiles("
+    #include <linux/io_uring.h>
+    int main() {
+      return IORING_OP_SEND_ZC + IORING_RECV_MULTISHOT +
+             IORING_RECVSEND_FIXED_BUF + IORING_CQE_F_NOTIF;
+    }" IOURING_HEADERS_USABLE)
+  unset(CMAKE_REQUIRED_INCLUDES)
+endif()
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(IOURING
+  REQUIRED_VARS IOURING_INCLUDE_DIR IOURING_HEADERS_USABLE)
@@ -0,0 +1,58 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "RingBuffer.hpp"
+#include <cassert>
+#include <cstdint>
+
+/// Reordering acknowledgment ring class.
+/** An AckRing object tracks the acknowledgment of a sequence of positions
+    (e.g., timeslices) whose acknowledgments may arrive out of order. All
+    positions below acked() are acknowledged. Acknowledgments of later
+    positions are stored in a ring buffer until the gap is closed, so the
+    ring must be able to hold the maximum number of pending positions. */
+
+class AckRing {
+public:
+  /// The AckRing default constructor.
+  AckRing() = default;
+
+  /// The AckRing initializing constructor.
+  explicit AckRing(size_t size_exponent) : ack_(size_exponent) {}
+
+  AckRing(const AckRing&) = delete;
+  void operator=(const AckRing&) = delete;
+
+  /// Create and initialize ring with given minimum size.
+  void alloc_with_size(size_t minimum_size) {
+    ack_.alloc_with_size(minimum_size);
+  }
+
+  /// Acknowledge a position. Returns true if acked() has advanced.
+  bool acknowledge(uint64_t pos) {
+    assert(pos >= acked_ && pos < acked_ + ack_.size());
+    if (pos != acked_) {
+      // acknowledgment has been reordered, store it for later
+      ack_.at(pos) = pos;
+      return false;
+    }
+    // entries left from earlier rounds hold smaller positions
+    do {
+      ++acked_;
+    } while (ack_.at(acked_) > pos);
+    return true;
+  }
+
+  /// Retrieve the first position that has not been acknowledged.
+  uint64_t acked() const { return acked_; }
+
+  /// Retrieve the maximum number of pending positions.
+  size_t size() const { return ack_.size(); }
+
+private:
+  /// Buffer to store acknowledged status of pending positions.
+  RingBuffer<uint64_t, true> ack_;
+
+  /// First position that has not been acknowledged.
+  uint64_t acked_ = 0;
+};
@@ -1,15 +1,126 @@
 // Copyright 2015 Jan de Cuveland <cmail@cuveland.de>
 
 #include "Benchmark.hpp"
+#include "Crc32cEngine.hpp"
+#include "FlesnetPatternChecker.hpp"
+#include "FlibLegacyPatternChecker.hpp"
+#include "FlibPatternChecker.hpp"
+#include "RampChecker.hpp"
+#include "StorableMicroslice.hpp"
 #include "interface.h" // crcutil_interface
 #include <algorithm>   // std::generate_n
 #include <boost/crc.hpp>
 #include <chrono>
 #include <functional> // std::bind
+#include <cstring>
 #include <iostream>
 #include <random>
 #include <smmintrin.h>
 
+namespace {
+Crc32cEngine::Implementation engine_implementation(
+    Benchmark::Algorithm algorithm) {
+  switch (algorithm) {
+  case Benchmark::Algorithm::Engine_Serial:
+    return Crc32cEngine::Implementation::Serial;
+  case Benchmark::Algorithm::Engine_Interleaved:
+    return Crc32cEngine::Implementation::Interleaved;
+  case Benchmark::Algorithm::Engine_Avx512:
+    return Crc32cEngine::Implementation::Avx512;
+  default:
+    return Crc32cEngine::Implementation::Table;
+  }
+}
+
+/// Size of the microslices in the pattern checker benchmarks.
+constexpr size_t pattern_microslice_size = 8192;
+
+fles::MicrosliceDescriptor pattern_descriptor(fles::SubsystemFormatFLES format,
+                                              uint64_t index,
+                                              uint32_t size) {
+  return fles::MicrosliceDescriptor{
+      static_cast<uint8_t>(fles::HeaderFormatIdentifier::Standard),
+      static_cast<uint8_t>(fles::HeaderFormatVersion::Standard),
+      0xE001,
+      0,
+      static_cast<uint8_t>(fles::SubsystemIdentifier::FLES),
+      static_cast<uint8_t>(format),
+      index,
+      0,
+      size,
+      0};
+}
+
+/// Create a microslice in the format of the embedded pattern generator.
+fles::StorableMicroslice make_flesnet_microslice(uint64_t index) {
+  std::vector<uint8_t> content(pattern_microslice_size);
+  uint32_t crc = 0;
+  for (size_t pos = 0; pos < content.size() / sizeof(uint64_t); ++pos) {
+    uint64_t data_word = pos * sizeof(uint64_t);
+    std::memcpy(&content[pos * sizeof(uint64_t)], &data_word,
+                sizeof(data_word));
+    crc ^= static_cast<uint32_t>(data_word & 0xffffffff) ^
+           static_cast<uint32_t>(data_word >> 32);
+  }
+  auto desc = pattern_descriptor(fles::SubsystemFormatFLES::BasicRampPattern,
+                                 index,
+                                 static_cast<uint32_t>(content.size()));
+  desc.crc = crc;
+  return fles::StorableMicroslice(desc, std::move(content));
+}
+
+/// Create a microslice in the format of the FLIB pattern generator.
+fles::StorableMicroslice make_flib_microslice(uint64_t index) {
+  constexpr uint8_t last_word_size = 5;
+  constexpr size_t size = pattern_microslice_size + last_word_size;
+  std::vector<uint8_t> content(size, 0xFA);
+  content[0] = last_word_size;
+  content[1] = 0;
+  const uint16_t hdr_word = 0xBBFF;
+  std::memcpy(&content[2], &hdr_word, sizeof(hdr_word));
+  const auto packet_number = static_cast<uint32_t>(index + 1);
+  std::memcpy(&content[4], &packet_number, sizeof(packet_number));
+  const size_t ramp_words = (size - 9) / sizeof(uint64_t);
+  for (size_t pos = 1; pos <= ramp_words; ++pos) {
+    uint64_t ramp = 0xABCD000000000000 + pos - 1;
+    std::memcpy(&content[pos * sizeof(uint64_t)], &ramp, sizeof(ramp));
+  }
+  auto desc = pattern_descriptor(fles::SubsystemFormatFLES::FlibPattern,
+                                 index, static_cast<uint32_t>(size));
+  return fles::StorableMicroslice(desc, std::move(content));
+}
+
+/// Create a microslice of CBMnet pattern generator frames.
+fles::StorableMicroslice make_flib_legacy_microslice(uint64_t index) {
+  constexpr size_t word_count = 64;
+  constexpr size_t padding_count = 3;
+  constexpr size_t frame_words = 1 + word_count + padding_count;
+  constexpr size_t frames =
+      (pattern_microslice_size - 16) / (frame_words * sizeof(uint16_t));
+  std::vector<uint16_t> words(8, 0); // room for the descriptor copy
+  for (size_t f = 0; f < frames; ++f) {
+    uint64_t frame = index * frames + f;
+    uint64_t frame_number = (frame + 1) & 0xff;
+    words.push_back(
+        static_cast<uint16_t>((frame_number << 8) | (word_count - 1)));
+    words.push_back(0); // source address
+    for (size_t i = 1; i < word_count - 1; ++i) {
+      words.push_back(static_cast<uint16_t>(0xbc00 | (i - 1)));
+    }
+    words.push_back(static_cast<uint16_t>(frame + 1));
+    words.insert(words.end(), padding_count, 0);
+  }
+  auto desc = pattern_descriptor(fles::SubsystemFormatFLES::CbmNetPattern,
+                                 index,
+                                 static_cast<uint32_t>(words.size() *
+                                                       sizeof(uint16_t)));
+  std::memcpy(words.data(), &desc, 16);
+  std::vector<uint8_t> content(words.size() * sizeof(uint16_t));
+  std::memcpy(content.data(), words.data(), content.size());
+  return fles::StorableMicroslice(desc, std::move(content));
+}
+} // namespace
+
 Benchmark::Benchmark() {
   random_data_.reserve(size_);
 
@@ -118,6 +229,18 @@ uint32_t Benchmark::compute_crc32(Algorithm algorithm) {
     crc_32->Delete();
     break;
   }
+
+  case Algorithm::Engine_Table:
+  case Algorithm::Engine_Serial:
+  case Algorithm::Engine_Interleaved:
+  case Algorithm::Engine_Avx512: {
+    // Castagnoli
+    Crc32cEngine engine(engine_implementation(algorithm));
+    for (size_t i = 0; i < cycles_; ++i) {
+      crc = engine.extend(crc, random_data_.data(), random_data_.size());
+    }
+    break;
+  }
   }
 
   return crc;
@@ -136,6 +259,30 @@ void Benchmark::run() {
   run_single(Algorithm::CrcUtil_C);
   std::cout << "CRC32 Benchmark: CrcUtil (IEEE)" << std::endl;
   run_single(Algorithm::CrcUtil_I);
+  for (auto algorithm :
+       {Algorithm::Engine_Table, Algorithm::Engine_Serial,
+        Algorithm::Engine_Interleaved, Algorithm::Engine_Avx512}) {
+    auto implementation = engine_implementation(algorithm);
+    std::cout << "CRC32 Benchmark: Engine "
+              << Crc32cEngine::to_string(implementation) << " (Castagnoli)"
+              << std::endl;
+    if (!Crc32cEngine::is_available(implementation)) {
+      std::cout << "not available on this CPU" << std::endl;
+      continue;
+    }
+    run_single(algorithm);
+  }
+  for (auto mix :
+       {SizeMix::Small, SizeMix::Medium, SizeMix::Large, SizeMix::Mixed}) {
+    std::cout << "CRC32 Microslice Benchmark: " << to_string(mix)
+              << " sizes (Castagnoli)" << std::endl;
+    run_microslices(mix);
+  }
+  for (auto pattern : {Pattern::Flesnet, Pattern::Flib, Pattern::FlibLegacy}) {
+    std::cout << "Pattern Checker Benchmark: " << to_string(pattern)
+              << std::endl;
+    run_pattern_checker(pattern);
+  }
 }
 
 void Benchmark::run_single(Algorithm algorithm) {
@@ -150,3 +297,178 @@ void Benchmark::run_single(Algorithm algorithm) {
   std::cout << "crc32=" << std::hex << crc32 << "  " << rate << " MiB/s"
             << std::endl;
 }
+
+void Benchmark::run_microslices(SizeMix mix) {
+  // cut the random data into microslices of the given size distribution
+  std::mt19937 engine;
+  std::uniform_int_distribution<size_t> small(32, 512);
+  std::uniform_int_distribution<size_t> medium(1024, 16384);
+  std::uniform_int_distribution<size_t> large(65536, 262144);
+  std::uniform_int_distribution<int> percent(0, 99);
+
+  std::vector<const void*> data;
+  std::vector<size_t> sizes;
+  size_t bytes = 0;
+  for (;;) {
+    size_t size = 0;
+    switch (mix) {
+    case SizeMix::Small:
+      size = small(engine);
+      break;
+    case SizeMix::Medium:
+      size = medium(engine);
+      break;
+    case SizeMix::Large:
+      size = large(engine);
+      break;
+    case SizeMix::Mixed: {
+      int p = percent(engine);
+      size = (p < 70) ? small(engine) : (p < 95) ? medium(engine)
+                                                 : large(engine);
+      break;
+    }
+    }
+    if (bytes + size > random_data_.size()) {
+      break;
+    }
+    data.push_back(random_data_.data() + bytes);
+    sizes.push_back(size);
+    bytes += size;
+  }
+
+  auto measure = [&](const std::string& name, auto&& compute_all) {
+    uint32_t crc32 = 0;
+    auto start = std::chrono::system_clock::now();
+    for (size_t i = 0; i < cycles_; ++i) {
+      crc32 = compute_all();
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now() - start);
+    const float rate = static_cast<float>(bytes * cycles_) /
+                       static_cast<float>(duration.count());
+    const float ms_rate = static_cast<float>(sizes.size() * cycles_) /
+                          static_cast<float>(duration.count());
+    std::cout << name << ": crc32=" << std::hex << crc32 << std::dec << "  "
+              << rate << " MiB/s, " << ms_rate << " M microslices/s"
+              << std::endl;
+  };
+
+  crcutil_interface::CRC* crcutil = crcutil_interface::CRC::Create(
+      0x82f63b78, 0, 32, true, 0, 0, 0,
+      crcutil_interface::CRC::IsSSE42Available(), NULL);
+  measure("CrcUtil", [&]() {
+    uint32_t x = 0;
+    for (size_t m = 0; m < data.size(); ++m) {
+      crcutil_interface::UINT64 crc64 = 0;
+      crcutil->Compute(data[m], sizes[m], &crc64);
+      x ^= static_cast<uint32_t>(crc64);
+    }
+    return x;
+  });
+  crcutil->Delete();
+
+  Crc32cEngine crc_engine;
+  measure("Engine " + Crc32cEngine::to_string(crc_engine.implementation()),
+          [&]() {
+            uint32_t x = 0;
+            for (size_t m = 0; m < data.size(); ++m) {
+              x ^= crc_engine.compute(data[m], sizes[m]);
+            }
+            return x;
+          });
+
+  std::vector<uint32_t> crcs(data.size());
+  measure("Engine batch", [&]() {
+    crc_engine.compute_batch(data.size(), data.data(), sizes.data(),
+                             crcs.data());
+    uint32_t x = 0;
+    for (uint32_t crc : crcs) {
+      x ^= crc;
+    }
+    return x;
+  });
+}
+
+std::string Benchmark::to_string(SizeMix mix) {
+  switch (mix) {
+  case SizeMix::Small:
+    return "small";
+  case SizeMix::Medium:
+    return "medium";
+  case SizeMix::Large:
+    return "large";
+  case SizeMix::Mixed:
+    return "mixed";
+  }
+  return "unknown";
+}
+
+void Benchmark::run_pattern_checker(Pattern pattern) {
+  // a consecutive stream of microslices of about the size of the random data
+  std::vector<fles::StorableMicroslice> microslices;
+  size_t bytes = 0;
+  for (uint64_t index = 0; bytes < size_; ++index) {
+    switch (pattern) {
+    case Pattern::Flesnet:
+      microslices.push_back(make_flesnet_microslice(index));
+      break;
+    case Pattern::Flib:
+      microslices.push_back(make_flib_microslice(index));
+      break;
+    case Pattern::FlibLegacy:
+      microslices.push_back(make_flib_legacy_microslice(index));
+      break;
+    }
+    bytes += microslices.back().desc().size;
+  }
+
+  for (auto implementation :
+       {RampChecker::Implementation::Scalar, RampChecker::Implementation::Sse41,
+        RampChecker::Implementation::Avx2,
+        RampChecker::Implementation::Avx512}) {
+    std::cout << RampChecker::to_string(implementation) << ": ";
+    if (!RampChecker::is_available(implementation)) {
+      std::cout << "not available on this CPU" << std::endl;
+      continue;
+    }
+    std::unique_ptr<PatternChecker> checker;
+    switch (pattern) {
+    case Pattern::Flesnet:
+      checker = std::make_unique<FlesnetPatternChecker>(0, implementation);
+      break;
+    case Pattern::Flib:
+      checker = std::make_unique<FlibPatternChecker>(implementation);
+      break;
+    case Pattern::FlibLegacy:
+      checker = std::make_unique<FlibLegacyPatternChecker>(implementation);
+      break;
+    }
+
+    bool success = true;
+    auto start = std::chrono::system_clock::now();
+    for (size_t i = 0; i < cycles_; ++i) {
+      checker->reset();
+      for (const auto& ms : microslices) {
+        success = checker->check(ms) && success;
+      }
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now() - start);
+    const double rate = static_cast<double>(bytes * cycles_) /
+                        static_cast<double>(duration.count());
+    std::cout << rate << " GB/s per core"
+              << (success ? "" : " (pattern check failed)") << std::endl;
+  }
+}
+
+std::string Benchmark::to_string(Pattern pattern) {
+  switch (pattern) {
+  case Pattern::Flesnet:
+    return "flesnet";
+  case Pattern::Flib:
+    return "flib";
+  case Pattern::FlibLegacy:
+    return "flib legacy";
+  }
+  return "unknown";
+}
@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
 #include <vector>
 
 /// %Benchmark class.
@@ -17,14 +18,34 @@ public:
     Intrinsic32,
     Intrinsic64,
     CrcUtil_C,
-    CrcUtil_I
+    CrcUtil_I,
+    Engine_Table,
+    Engine_Serial,
+    Engine_Interleaved,
+    Engine_Avx512
   };
   uint32_t compute_crc32(Algorithm algorithm);
   void run_single(Algorithm algorithm);
 
+  /// Microslice size distributions for the per-microslice benchmarks.
+  enum class SizeMix {
+    Small,  ///< 32 B .. 512 B
+    Medium, ///< 1 kB .. 16 kB
+    Large,  ///< 64 kB .. 256 kB
+    Mixed   ///< 70 % small, 25 % medium, 5 % large
+  };
+  void run_microslices(SizeMix mix);
+
+  /// Test patterns for the pattern checker benchmarks.
+  enum class Pattern { Flesnet, Flib, FlibLegacy };
+  void run_pattern_checker(Pattern pattern);
+
   const size_t size_ = 1048576;
   const size_t cycles_ = 500;
 
 private:
+  static std::string to_string(SizeMix mix);
+  static std::string to_string(Pattern pattern);
+
   std::vector<uint8_t> random_data_;
 };
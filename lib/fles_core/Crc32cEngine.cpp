@@ -0,0 +1,397 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "Crc32cEngine.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/// CRC-32C polynomial (Castagnoli), reflected.
+constexpr uint32_t polynomial = 0x82f63b78;
+
+/// Length of each of the three streams of an interleaved block (long and
+/// short variant, in bytes).
+constexpr size_t long_block = 4096;
+constexpr size_t short_block = 256;
+
+/// Buffers in a batch from this size on are computed one by one.
+constexpr size_t batch_limit = 3 * short_block;
+
+/// Multiply two polynomials modulo the CRC polynomial (reflected, with
+/// the coefficient of x^0 in the most significant bit).
+uint32_t multiply_modp(uint32_t a, uint32_t b) {
+  uint32_t m = UINT32_C(1) << 31;
+  uint32_t p = 0;
+  for (;;) {
+    if ((a & m) != 0) {
+      p ^= b;
+      if ((a & (m - 1)) == 0) {
+        break;
+      }
+    }
+    m >>= 1;
+    b = ((b & 1) != 0) ? (b >> 1) ^ polynomial : b >> 1;
+  }
+  return p;
+}
+
+/// Compute x^n modulo the CRC polynomial.
+uint32_t x_pow_modp(uint64_t n) {
+  uint32_t result = UINT32_C(1) << 31; // x^0
+  uint32_t square = UINT32_C(1) << 30; // x^1
+  while (n != 0) {
+    if ((n & 1) != 0) {
+      result = multiply_modp(result, square);
+    }
+    square = multiply_modp(square, square);
+    n >>= 1;
+  }
+  return result;
+}
+
+/// Precomputed tables and multiplication constants.
+struct Constants {
+  Constants() {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = ((crc & 1) != 0) ? (crc >> 1) ^ polynomial : crc >> 1;
+      }
+      table[i] = crc;
+    }
+    // a carry-less product in the reflected domain carries an extra factor
+    // of x, the crc32 reduction one of x^32
+    long_shift = x_pow_modp(8 * long_block - 33);
+    short_shift = x_pow_modp(8 * short_block - 33);
+    // folding of 128-bit lanes by 2048 bits (four 512-bit registers)
+    fold_lo = x_pow_modp(2048 + 64 - 33);
+    fold_hi = x_pow_modp(2048 - 33);
+  }
+
+  std::array<uint32_t, 256> table{};
+  uint32_t long_shift;
+  uint32_t short_shift;
+  uint32_t fold_lo;
+  uint32_t fold_hi;
+};
+
+const Constants& constants() {
+  static const Constants c;
+  return c;
+}
+
+uint64_t load64(const uint8_t* p) {
+  uint64_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+// The following functions work on the raw (not inverted) CRC state.
+
+uint32_t crc32_table_raw(uint32_t state, const uint8_t* p, size_t n) {
+  const auto& table = constants().table;
+  while (n-- != 0) {
+    state = table[(state ^ *p++) & 0xff] ^ (state >> 8);
+  }
+  return state;
+}
+
+uint32_t extend_table(uint32_t crc, const uint8_t* p, size_t n) {
+  return ~crc32_table_raw(~crc, p, n);
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("sse4.2"))) uint32_t
+crc32_serial_raw(uint32_t state, const uint8_t* p, size_t n) {
+  uint64_t state64 = state;
+  while (n >= 8) {
+    state64 = _mm_crc32_u64(state64, load64(p));
+    p += 8;
+    n -= 8;
+  }
+  auto state32 = static_cast<uint32_t>(state64);
+  if ((n & 4) != 0) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    state32 = _mm_crc32_u32(state32, value);
+    p += 4;
+  }
+  if ((n & 2) != 0) {
+    uint16_t value;
+    std::memcpy(&value, p, sizeof(value));
+    state32 = _mm_crc32_u16(state32, value);
+    p += 2;
+  }
+  if ((n & 1) != 0) {
+    state32 = _mm_crc32_u8(state32, *p);
+  }
+  return state32;
+}
+
+uint32_t extend_serial(uint32_t crc, const uint8_t* p, size_t n) {
+  return ~crc32_serial_raw(~crc, p, n);
+}
+
+/// Multiply a CRC state by a constant x^(8 * length - 33), i.e., advance
+/// it over length zero bytes.
+__attribute__((target("sse4.2,pclmul"))) uint32_t shift(uint32_t state,
+                                                        uint32_t constant) {
+  __m128i product =
+      _mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<int>(state)),
+                           _mm_cvtsi32_si128(static_cast<int>(constant)), 0);
+  return static_cast<uint32_t>(
+      _mm_crc32_u64(0, static_cast<uint64_t>(_mm_cvtsi128_si64(product))));
+}
+
+/// Process blocks of three times the given length as three interleaved
+/// streams.
+__attribute__((target("sse4.2,pclmul"))) uint32_t
+crc32_blocks_raw(uint32_t state,
+                 const uint8_t*& p,
+                 size_t& n,
+                 size_t block,
+                 uint32_t constant) {
+  while (n >= 3 * block) {
+    uint64_t s0 = state;
+    uint64_t s1 = 0;
+    uint64_t s2 = 0;
+    const uint8_t* const end = p + block;
+    do {
+      s0 = _mm_crc32_u64(s0, load64(p));
+      s1 = _mm_crc32_u64(s1, load64(p + block));
+      s2 = _mm_crc32_u64(s2, load64(p + 2 * block));
+      p += 8;
+    } while (p < end);
+    state = shift(shift(static_cast<uint32_t>(s0), constant) ^
+                      static_cast<uint32_t>(s1),
+                  constant) ^
+            static_cast<uint32_t>(s2);
+    p += 2 * block;
+    n -= 3 * block;
+  }
+  return state;
+}
+
+uint32_t crc32_interleaved_raw(uint32_t state, const uint8_t* p, size_t n) {
+  if (n < 3 * short_block) {
+    return crc32_serial_raw(state, p, n);
+  }
+  const Constants& c = constants();
+  state = crc32_blocks_raw(state, p, n, long_block, c.long_shift);
+  state = crc32_blocks_raw(state, p, n, short_block, c.short_shift);
+  return crc32_serial_raw(state, p, n);
+}
+
+uint32_t extend_interleaved(uint32_t crc, const uint8_t* p, size_t n) {
+  return ~crc32_interleaved_raw(~crc, p, n);
+}
+
+__attribute__((target("avx512f,vpclmulqdq"))) __m512i
+fold(__m512i x, __m512i constant, __m512i data) {
+  __m512i lo = _mm512_clmulepi64_epi128(x, constant, 0x00);
+  __m512i hi = _mm512_clmulepi64_epi128(x, constant, 0x11);
+  return _mm512_ternarylogic_epi64(lo, hi, data, 0x96); // lo ^ hi ^ data
+}
+
+/// Fold 256-byte blocks in four 512-bit registers. The registers hold a
+/// 256-byte message with the same CRC (from zero state) as the data
+/// processed so far.
+__attribute__((target("avx512f,vpclmulqdq,sse4.2,pclmul"))) uint32_t
+crc32_avx512_raw(uint32_t state, const uint8_t* p, size_t n) {
+  if (n >= 512) {
+    const Constants& c = constants();
+    const auto hi = static_cast<int64_t>(c.fold_hi);
+    const auto lo = static_cast<int64_t>(c.fold_lo);
+    const __m512i constant = _mm512_set_epi64(hi, lo, hi, lo, hi, lo, hi, lo);
+    __m512i x0 = _mm512_xor_si512(_mm512_loadu_si512(p),
+                                  _mm512_set_epi64(0, 0, 0, 0, 0, 0, 0, state));
+    __m512i x1 = _mm512_loadu_si512(p + 64);
+    __m512i x2 = _mm512_loadu_si512(p + 128);
+    __m512i x3 = _mm512_loadu_si512(p + 192);
+    p += 256;
+    n -= 256;
+    while (n >= 256) {
+      x0 = fold(x0, constant, _mm512_loadu_si512(p));
+      x1 = fold(x1, constant, _mm512_loadu_si512(p + 64));
+      x2 = fold(x2, constant, _mm512_loadu_si512(p + 128));
+      x3 = fold(x3, constant, _mm512_loadu_si512(p + 192));
+      p += 256;
+      n -= 256;
+    }
+    alignas(64) uint8_t folded[256];
+    _mm512_store_si512(folded, x0);
+    _mm512_store_si512(folded + 64, x1);
+    _mm512_store_si512(folded + 128, x2);
+    _mm512_store_si512(folded + 192, x3);
+    state = crc32_serial_raw(0, folded, sizeof(folded));
+  }
+  return crc32_interleaved_raw(state, p, n);
+}
+
+uint32_t extend_avx512(uint32_t crc, const uint8_t* p, size_t n) {
+  return ~crc32_avx512_raw(~crc, p, n);
+}
+
+/// Compute the CRCs of three independent buffers in interleaved streams.
+/// All three streams advance up to the length of the shortest buffer, the
+/// remaining two up to the length of the second shortest one.
+__attribute__((target("sse4.2"))) void crc32_triple(const uint8_t* const* p,
+                                                    const size_t* n,
+                                                    uint32_t* crcs) {
+  std::array<size_t, 3> order{0, 1, 2};
+  if (n[order[0]] > n[order[1]]) {
+    std::swap(order[0], order[1]);
+  }
+  if (n[order[1]] > n[order[2]]) {
+    std::swap(order[1], order[2]);
+  }
+  if (n[order[0]] > n[order[1]]) {
+    std::swap(order[0], order[1]);
+  }
+  const uint8_t* p0 = p[order[0]];
+  const uint8_t* p1 = p[order[1]];
+  const uint8_t* p2 = p[order[2]];
+  const size_t common3 = n[order[0]] & ~size_t{7};
+  const size_t common2 = n[order[1]] & ~size_t{7};
+  uint64_t s0 = UINT32_MAX;
+  uint64_t s1 = UINT32_MAX;
+  uint64_t s2 = UINT32_MAX;
+  size_t i = 0;
+  for (; i < common3; i += 8) {
+    s0 = _mm_crc32_u64(s0, load64(p0 + i));
+    s1 = _mm_crc32_u64(s1, load64(p1 + i));
+    s2 = _mm_crc32_u64(s2, load64(p2 + i));
+  }
+  crcs[order[0]] = ~crc32_serial_raw(static_cast<uint32_t>(s0), p0 + i,
+                                     n[order[0]] - i);
+  for (; i < common2; i += 8) {
+    s1 = _mm_crc32_u64(s1, load64(p1 + i));
+    s2 = _mm_crc32_u64(s2, load64(p2 + i));
+  }
+  crcs[order[1]] = ~crc32_serial_raw(static_cast<uint32_t>(s1), p1 + i,
+                                     n[order[1]] - i);
+  crcs[order[2]] = ~crc32_serial_raw(static_cast<uint32_t>(s2), p2 + i,
+                                     n[order[2]] - i);
+}
+
+#endif
+
+} // namespace
+
+Crc32cEngine::Crc32cEngine(Implementation implementation)
+    : implementation_(implementation) {
+  assert(is_available(implementation));
+  switch (implementation) {
+#if defined(__x86_64__)
+  case Implementation::Serial:
+    extend_ = extend_serial;
+    break;
+  case Implementation::Interleaved:
+    extend_ = extend_interleaved;
+    break;
+  case Implementation::Avx512:
+    extend_ = extend_avx512;
+    break;
+#endif
+  default:
+    implementation_ = Implementation::Table;
+    extend_ = extend_table;
+    break;
+  }
+}
+
+uint32_t
+Crc32cEngine::extend(uint32_t crc, const void* data, size_t size) const {
+  return extend_(crc, static_cast<const uint8_t*>(data), size);
+}
+
+void Crc32cEngine::compute_batch(size_t count,
+                                 const void* const* data,
+                                 const size_t* sizes,
+                                 uint32_t* crcs) const {
+#if defined(__x86_64__)
+  if (implementation_ == Implementation::Interleaved ||
+      implementation_ == Implementation::Avx512) {
+    // queue of small buffers to be processed together
+    const uint8_t* p[3];
+    size_t n[3];
+    size_t index[3];
+    uint32_t result[3];
+    size_t queued = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (sizes[i] >= batch_limit) {
+        crcs[i] = compute(data[i], sizes[i]);
+        continue;
+      }
+      p[queued] = static_cast<const uint8_t*>(data[i]);
+      n[queued] = sizes[i];
+      index[queued] = i;
+      if (++queued == 3) {
+        crc32_triple(p, n, result);
+        for (size_t j = 0; j < 3; ++j) {
+          crcs[index[j]] = result[j];
+        }
+        queued = 0;
+      }
+    }
+    for (size_t j = 0; j < queued; ++j) {
+      crcs[index[j]] = compute(p[j], n[j]);
+    }
+    return;
+  }
+#endif
+  for (size_t i = 0; i < count; ++i) {
+    crcs[i] = compute(data[i], sizes[i]);
+  }
+}
+
+bool Crc32cEngine::is_available(Implementation implementation) {
+  switch (implementation) {
+  case Implementation::Table:
+    return true;
+#if defined(__x86_64__)
+  case Implementation::Serial:
+    return __builtin_cpu_supports("sse4.2") != 0;
+  case Implementation::Interleaved:
+    return __builtin_cpu_supports("sse4.2") != 0 &&
+           __builtin_cpu_supports("pclmul") != 0;
+  case Implementation::Avx512:
+    return is_available(Implementation::Interleaved) &&
+           __builtin_cpu_supports("avx512f") != 0 &&
+           __builtin_cpu_supports("vpclmulqdq") != 0;
+#endif
+  default:
+    return false;
+  }
+}
+
+Crc32cEngine::Implementation Crc32cEngine::best_implementation() {
+  for (auto implementation : {Implementation::Avx512,
+                              Implementation::Interleaved,
+                              Implementation::Serial}) {
+    if (is_available(implementation)) {
+      return implementation;
+    }
+  }
+  return Implementation::Table;
+}
+
+std::string Crc32cEngine::to_string(Implementation implementation) {
+  switch (implementation) {
+  case Implementation::Table:
+    return "Table";
+  case Implementation::Serial:
+    return "Serial";
+  case Implementation::Interleaved:
+    return "Interleaved";
+  case Implementation::Avx512:
+    return "Avx512";
+  }
+  return "Unknown";
+}
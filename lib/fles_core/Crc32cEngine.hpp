@@ -0,0 +1,65 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// CRC-32C (Castagnoli polynomial) engine class.
+/** A Crc32cEngine object computes the CRC-32C of microslice contents with
+    the fastest implementation the CPU supports, selected at run time:
+
+    - Table: portable byte-wise table lookup.
+    - Serial: a single stream of SSE 4.2 crc32 instructions, limited by
+      the latency of the instruction.
+    - Interleaved: three independent crc32 streams per buffer, combined
+      with carry-less multiplication (PCLMULQDQ).
+    - Avx512: folding of 256-byte blocks with 512-bit carry-less
+      multiplication (VPCLMULQDQ), followed by crc32 for the rest.
+
+    All implementations yield the same (standard CRC-32C) values. */
+
+class Crc32cEngine {
+public:
+  enum class Implementation { Table, Serial, Interleaved, Avx512 };
+
+  /// The Crc32cEngine constructor, using the best available
+  /// implementation.
+  Crc32cEngine() : Crc32cEngine(best_implementation()) {}
+
+  /// The Crc32cEngine constructor, using a given implementation (which
+  /// has to be available).
+  explicit Crc32cEngine(Implementation implementation);
+
+  /// Compute the CRC-32C of a buffer.
+  uint32_t compute(const void* data, size_t size) const {
+    return extend(0, data, size);
+  }
+
+  /// Extend a CRC-32C value by the contents of a buffer.
+  uint32_t extend(uint32_t crc, const void* data, size_t size) const;
+
+  /// Compute the CRC-32C of a number of independent buffers. Small buffers
+  /// are processed three at a time in interleaved streams.
+  void compute_batch(size_t count,
+                     const void* const* data,
+                     const size_t* sizes,
+                     uint32_t* crcs) const;
+
+  /// Retrieve the selected implementation.
+  Implementation implementation() const { return implementation_; }
+
+  /// Check whether an implementation is supported by the CPU.
+  static bool is_available(Implementation implementation);
+
+  /// Retrieve the fastest implementation supported by the CPU.
+  static Implementation best_implementation();
+
+  static std::string to_string(Implementation implementation);
+
+private:
+  using ExtendFunction = uint32_t (*)(uint32_t, const uint8_t*, size_t);
+
+  Implementation implementation_;
+  ExtendFunction extend_;
+};
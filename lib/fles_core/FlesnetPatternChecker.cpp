@@ -4,15 +4,20 @@
 
 bool FlesnetPatternChecker::check(const fles::Microslice& m) {
   const uint64_t* content = reinterpret_cast<const uint64_t*>(m.content());
-  uint32_t crc = 0x00000000;
-  for (size_t pos = 0; pos < m.desc().size / sizeof(uint64_t); ++pos) {
-    uint64_t data_word = content[pos];
-    crc ^= (data_word & 0xffffffff) ^ (data_word >> 32);
-    uint64_t expected =
-        (static_cast<uint64_t>(component) << 48) | (pos * sizeof(uint64_t));
-    if (data_word != expected) {
-      return false;
-    }
+  const size_t count = m.desc().size / sizeof(uint64_t);
+  uint64_t xor_sum = 0;
+  if (ramp_checker_.find_mismatch(content, count,
+                                  static_cast<uint64_t>(component) << 48,
+                                  sizeof(uint64_t), &xor_sum) != count) {
+    return false;
+  }
+  uint32_t crc = static_cast<uint32_t>(xor_sum & 0xffffffff) ^
+                 static_cast<uint32_t>(xor_sum >> 32);
+  // with CrcValid set, the descriptor holds a CRC-32C (checked separately)
+  // instead of the checksum of the pattern generator
+  if ((m.desc().flags &
+       static_cast<uint16_t>(fles::MicrosliceFlags::CrcValid)) != 0) {
+    return true;
   }
   return crc == m.desc().crc;
 }
@@ -2,14 +2,18 @@
 #pragma once
 
 #include "PatternChecker.hpp"
+#include "RampChecker.hpp"
 
 class FlesnetPatternChecker : public PatternChecker {
 public:
-  explicit FlesnetPatternChecker(std::size_t arg_component)
-      : component(arg_component){};
+  explicit FlesnetPatternChecker(std::size_t arg_component,
+                                 RampChecker::Implementation implementation =
+                                     RampChecker::best_implementation())
+      : component(arg_component), ramp_checker_(implementation){};
 
   bool check(const fles::Microslice& m) override;
 
 private:
   std::size_t component = 0;
+  RampChecker ramp_checker_;
 };
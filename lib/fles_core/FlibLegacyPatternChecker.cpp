@@ -22,14 +22,13 @@ bool FlibLegacyPatternChecker::check_content_pgen(const uint16_t* content,
     return false;
   }
 
-  for (size_t i = 1; i < size - 1; ++i) {
-    uint8_t low = content[i] & 0xff;
-    uint8_t high = (content[i] >> 8) & 0xff;
-    if (high != 0xbc || low != i - 1) {
-      std::cerr << "unexpected cbmnet content word: " << content[i]
-                << std::endl;
-      return false;
-    }
+  // content words 0xbc00, 0xbc01, ... (at most 64 words, so the low byte
+  // does not overflow)
+  size_t mismatch = ramp_checker_.find_mismatch(content + 1, size - 2, 0xbc00);
+  if (mismatch != size - 2) {
+    std::cerr << "unexpected cbmnet content word: " << content[1 + mismatch]
+              << std::endl;
+    return false;
   }
 
   uint16_t pgen_sequence_number = content[size - 1];
@@ -2,9 +2,15 @@
 #pragma once
 
 #include "PatternChecker.hpp"
+#include "RampChecker.hpp"
 
 class FlibLegacyPatternChecker : public PatternChecker {
 public:
+  explicit FlibLegacyPatternChecker(
+      RampChecker::Implementation implementation =
+          RampChecker::best_implementation())
+      : ramp_checker_(implementation){};
+
   bool check(const fles::Microslice& m) override;
   void reset() override {
     frame_number_ = 0;
@@ -20,4 +26,5 @@ private:
 
   uint8_t frame_number_ = 0;
   uint16_t pgen_sequence_number_ = 0;
+  RampChecker ramp_checker_;
 };
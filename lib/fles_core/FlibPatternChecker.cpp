@@ -83,21 +83,20 @@ bool FlibPatternChecker::check(const fles::Microslice& m) {
     } else {
       ramp_limit = 9;
     }
-    size_t pos = 1;
-    uint64_t ramp = 0xABCD000000000000;
+    const uint64_t ramp = 0xABCD000000000000;
     const uint64_t* content =
         reinterpret_cast<const uint64_t*>(m.content()) + 0;
 
-    while (pos <= ((m.desc().size - ramp_limit) / sizeof(uint64_t))) {
-      if (content[pos] != ramp) {
-        std::cerr << "Flib pgen: error in ramp word "
-                  << " exp " << std::hex << ramp << " seen " << content[pos]
-                  << std::endl;
-        return false;
-      }
-      ++ramp;
-      ++pos;
+    const size_t ramp_words = (m.desc().size - ramp_limit) / sizeof(uint64_t);
+    size_t mismatch =
+        ramp_checker_.find_mismatch(content + 1, ramp_words, ramp, 1);
+    if (mismatch != ramp_words) {
+      std::cerr << "Flib pgen: error in ramp word "
+                << " exp " << std::hex << ramp + mismatch << " seen "
+                << content[1 + mismatch] << std::endl;
+      return false;
     }
+    size_t pos = 1 + ramp_words;
 
     // check last word if any
     size_t last_word_start = pos * sizeof(uint64_t);
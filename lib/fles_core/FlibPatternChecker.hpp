@@ -2,12 +2,18 @@
 #pragma once
 
 #include "PatternChecker.hpp"
+#include "RampChecker.hpp"
 
 class FlibPatternChecker : public PatternChecker {
 public:
+  explicit FlibPatternChecker(RampChecker::Implementation implementation =
+                                  RampChecker::best_implementation())
+      : ramp_checker_(implementation){};
+
   bool check(const fles::Microslice& m) override;
   void reset() override { flib_pgen_packet_number_ = 0; };
 
 private:
   uint32_t flib_pgen_packet_number_ = 0;
+  RampChecker ramp_checker_;
 };
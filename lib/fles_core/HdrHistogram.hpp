@@ -0,0 +1,140 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/// Fixed-memory histogram of non-negative integer values with logarithmic
+/// buckets of bounded relative error (HdrHistogram layout). Values below
+/// 2^SUB_BUCKET_BITS are counted exactly; above, each power-of-two range is
+/// split into SUB_BUCKET_COUNT linear buckets (~3% relative error). Recording
+/// is O(1) and quantile queries scan a constant number of buckets.
+///
+/// Count is either uint64_t (single-threaded use) or std::atomic<uint64_t>
+/// (concurrent recording, e.g. for metrics).
+template <typename Count = uint64_t> class HdrHistogram {
+public:
+  static constexpr unsigned SUB_BUCKET_BITS = 5;
+  static constexpr uint64_t SUB_BUCKET_COUNT = UINT64_C(1) << SUB_BUCKET_BITS;
+  static constexpr size_t BUCKET_COUNT =
+      (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+  HdrHistogram() { reset(); }
+
+  HdrHistogram(const HdrHistogram&) = delete;
+  HdrHistogram& operator=(const HdrHistogram&) = delete;
+
+  /// Record a value (count times).
+  void record(uint64_t value, uint64_t count = 1) {
+    counts_[bucket_index(value)] += count;
+    total_count_ += count;
+    total_sum_ += value * count;
+  }
+
+  /// Remove a previously recorded value (count times).
+  void remove(uint64_t value, uint64_t count = 1) {
+    counts_[bucket_index(value)] -= count;
+    total_count_ -= count;
+    total_sum_ -= value * count;
+  }
+
+  void reset() {
+    for (auto& c : counts_) {
+      c = 0;
+    }
+    total_count_ = 0;
+    total_sum_ = 0;
+  }
+
+  uint64_t count() const { return total_count_; }
+
+  uint64_t sum() const { return total_sum_; }
+
+  double mean() const {
+    uint64_t n = count();
+    return n == 0 ? 0.0 : static_cast<double>(sum()) / static_cast<double>(n);
+  }
+
+  /// Value at quantile q in [0, 1] (representative value of its bucket), 0
+  /// if empty.
+  uint64_t value_at_quantile(double q) const {
+    uint64_t n = count();
+    if (n == 0) {
+      return 0;
+    }
+    auto rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(n)));
+    if (rank < 1) {
+      rank = 1;
+    }
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+      cumulative += counts_[i];
+      if (cumulative >= rank) {
+        return bucket_midpoint(i);
+      }
+    }
+    return bucket_midpoint(BUCKET_COUNT - 1);
+  }
+
+  uint64_t median() const { return value_at_quantile(0.5); }
+
+  /// Standard deviation estimated from the bucket midpoints.
+  double stddev() const {
+    uint64_t n = count();
+    if (n == 0) {
+      return 0.0;
+    }
+    double avg = mean();
+    double sq_sum = 0.0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+      uint64_t c = counts_[i];
+      if (c != 0) {
+        double d = static_cast<double>(bucket_midpoint(i)) - avg;
+        sq_sum += d * d * static_cast<double>(c);
+      }
+    }
+    return std::sqrt(sq_sum / static_cast<double>(n));
+  }
+
+  uint64_t bucket_count(size_t index) const { return counts_[index]; }
+
+  static size_t bucket_index(uint64_t value) {
+    if (value < SUB_BUCKET_COUNT) {
+      return static_cast<size_t>(value);
+    }
+    unsigned exponent = 63u - static_cast<unsigned>(__builtin_clzll(value));
+    unsigned shift = exponent - SUB_BUCKET_BITS;
+    return static_cast<size_t>((shift + 1) * SUB_BUCKET_COUNT +
+                               ((value >> shift) - SUB_BUCKET_COUNT));
+  }
+
+  static uint64_t bucket_lower_bound(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+      return index;
+    }
+    uint64_t shift = index / SUB_BUCKET_COUNT - 1;
+    uint64_t sub = index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+    return sub << shift;
+  }
+
+  static uint64_t bucket_upper_bound(size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+      return index;
+    }
+    uint64_t shift = index / SUB_BUCKET_COUNT - 1;
+    return bucket_lower_bound(index) + ((UINT64_C(1) << shift) - 1);
+  }
+
+  static uint64_t bucket_midpoint(size_t index) {
+    uint64_t lower = bucket_lower_bound(index);
+    return lower + (bucket_upper_bound(index) - lower) / 2;
+  }
+
+private:
+  std::array<Count, BUCKET_COUNT> counts_;
+  Count total_count_;
+  Count total_sum_;
+};
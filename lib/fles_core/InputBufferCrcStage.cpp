@@ -0,0 +1,206 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "InputBufferCrcStage.hpp"
+#include "Utility.hpp"
+#include "log.hpp"
+#include <algorithm>
+
+namespace {
+/// Maximum number of microslices processed in a single batch.
+constexpr uint64_t max_batch = 1024;
+
+/// Interval of throughput reports.
+constexpr std::chrono::seconds report_interval{1};
+
+std::string crc_labels(uint64_t input_index) {
+  return "input=\"" + std::to_string(input_index) + "\"";
+}
+} // namespace
+
+InputBufferCrcStage::InputBufferCrcStage(
+    std::unique_ptr<InputBufferReadInterface> source,
+    uint64_t input_index,
+    double budget_gb_per_s)
+    : source_(std::move(source)), input_index_(input_index),
+      budget_gb_per_s_(budget_gb_per_s),
+      available_(source_->get_read_index()), done_(available_),
+      report_begin_(std::chrono::steady_clock::now()),
+      bytes_metric_(MetricsRegistry::instance().counter(
+          "flesnet_crc_bytes_total",
+          "Total amount of microslice content checksummed on input",
+          crc_labels(input_index))),
+      rate_metric_(MetricsRegistry::instance().gauge(
+          "flesnet_crc_rate",
+          "Checksumming throughput of the input CRC stage while busy",
+          crc_labels(input_index))),
+      load_metric_(MetricsRegistry::instance().gauge(
+          "flesnet_crc_load",
+          "Fraction of time the input CRC stage is busy",
+          crc_labels(input_index))) {
+  L_(info) << "[i" << input_index_ << "] computing CRC-32C on input ("
+           << Crc32cEngine::to_string(crc32_engine_.implementation())
+           << "), budget " << budget_gb_per_s_ << " GB/s per core";
+  thread_ = std::thread(&InputBufferCrcStage::run, this);
+}
+
+InputBufferCrcStage::~InputBufferCrcStage() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  total_busy_time_ += busy_time_;
+  total_bytes_ += busy_bytes_;
+  double busy_s = std::chrono::duration<double>(total_busy_time_).count();
+  if (busy_s > 0) {
+    L_(info) << "[i" << input_index_ << "] CRC stage: "
+             << human_readable_count(total_bytes_) << " at "
+             << static_cast<double>(total_bytes_) / busy_s / 1e9
+             << " GB/s per core";
+  }
+}
+
+void InputBufferCrcStage::proceed() {
+  source_->proceed();
+  DualIndex write_index = source_->get_write_index();
+  bool notify = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (write_index.desc > available_.desc) {
+      available_ = write_index;
+      notify = true;
+    }
+  }
+  if (notify) {
+    cv_.notify_one();
+  }
+}
+
+DualIndex InputBufferCrcStage::get_write_index() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return done_;
+}
+
+bool InputBufferCrcStage::get_eof() {
+  if (!source_->get_eof()) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  return done_.desc == source_->get_write_index().desc;
+}
+
+void InputBufferCrcStage::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopping_) {
+    if (done_.desc == available_.desc) {
+      cv_.wait_for(lock, report_interval);
+      auto now = std::chrono::steady_clock::now();
+      if (now - report_begin_ >= report_interval) {
+        lock.unlock();
+        report(now);
+        lock.lock();
+      }
+      continue;
+    }
+    const DualIndex available = available_;
+    const uint64_t desc_begin = done_.desc;
+    const uint64_t desc_end = std::min(available.desc, desc_begin + max_batch);
+    lock.unlock();
+
+    auto begin = std::chrono::steady_clock::now();
+    uint64_t bytes = process(desc_begin, desc_end);
+    auto end = std::chrono::steady_clock::now();
+    busy_time_ += end - begin;
+    busy_bytes_ += bytes;
+    bytes_metric_.add(bytes);
+
+    DualIndex done{desc_end, available.data};
+    if (desc_end != available.desc) {
+      const auto& last = source_->desc_buffer().at(desc_end - 1);
+      done.data = last.offset + last.size;
+    }
+    if (end - report_begin_ >= report_interval) {
+      report(end);
+    }
+
+    lock.lock();
+    done_ = done;
+  }
+}
+
+uint64_t InputBufferCrcStage::process(uint64_t desc_begin, uint64_t desc_end) {
+  auto& desc_buffer = source_->desc_buffer();
+  auto& data_buffer = source_->data_buffer();
+  const uint8_t* buffer_begin = data_buffer.ptr();
+  const uint8_t* buffer_end = buffer_begin + data_buffer.bytes();
+
+  const size_t count = desc_end - desc_begin;
+  crc_data_.resize(count);
+  crc_sizes_.resize(count);
+  crcs_.resize(count);
+
+  uint64_t bytes = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const auto& desc = desc_buffer.at(desc_begin + i);
+    const uint8_t* data_begin = &data_buffer.at(desc.offset);
+    const uint8_t* data_end = &data_buffer.at(desc.offset + desc.size);
+    bool crc_valid =
+        (desc.flags &
+         static_cast<uint16_t>(fles::MicrosliceFlags::CrcValid)) != 0;
+    crc_data_[i] = data_begin;
+    crc_sizes_[i] = (crc_valid || data_begin > data_end) ? 0 : desc.size;
+  }
+
+  crc32_engine_.compute_batch(count, crc_data_.data(), crc_sizes_.data(),
+                              crcs_.data());
+
+  for (size_t i = 0; i < count; ++i) {
+    auto& desc = desc_buffer.at(desc_begin + i);
+    if ((desc.flags &
+         static_cast<uint16_t>(fles::MicrosliceFlags::CrcValid)) != 0) {
+      continue;
+    }
+    const uint8_t* data_begin = &data_buffer.at(desc.offset);
+    const uint8_t* data_end = &data_buffer.at(desc.offset + desc.size);
+    if (data_begin <= data_end) {
+      desc.crc = crcs_[i];
+    } else {
+      // microslice wraps around the end of the data buffer
+      uint32_t crc = crc32_engine_.compute(
+          data_begin, static_cast<size_t>(buffer_end - data_begin));
+      desc.crc = crc32_engine_.extend(
+          crc, buffer_begin, static_cast<size_t>(data_end - buffer_begin));
+    }
+    desc.flags |= static_cast<uint16_t>(fles::MicrosliceFlags::CrcValid);
+    bytes += desc.size;
+  }
+  return bytes;
+}
+
+void InputBufferCrcStage::report(std::chrono::steady_clock::time_point now) {
+  double interval_s =
+      std::chrono::duration<double>(now - report_begin_).count();
+  double busy_s = std::chrono::duration<double>(busy_time_).count();
+  if (interval_s <= 0) {
+    return;
+  }
+  load_metric_.set(busy_s / interval_s);
+  if (busy_s > 0) {
+    double rate = static_cast<double>(busy_bytes_) / busy_s / 1e9;
+    rate_metric_.set(rate * 1e9);
+    if (rate < budget_gb_per_s_) {
+      L_(warning) << "[i" << input_index_ << "] CRC stage below budget: "
+                  << rate << " GB/s per core (budget " << budget_gb_per_s_
+                  << " GB/s), " << static_cast<int>(100 * busy_s / interval_s)
+                  << "% busy";
+    }
+  }
+  total_busy_time_ += busy_time_;
+  total_bytes_ += busy_bytes_;
+  busy_time_ = std::chrono::steady_clock::duration::zero();
+  busy_bytes_ = 0;
+  report_begin_ = now;
+}
@@ -0,0 +1,103 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "Crc32cEngine.hpp"
+#include "DualRingBuffer.hpp"
+#include "Metrics.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// CRC-computing input buffer decorator class.
+/** An InputBufferCrcStage object wraps a data source and computes the
+    CRC-32C of each microslice on a helper thread as soon as it arrives. The
+    value is stored in the microslice descriptor and the CrcValid flag is
+    set; microslices become visible to the reader only afterwards.
+    Microslices already flagged CrcValid by the source are passed on
+    unchanged.
+
+    The stage is given a throughput budget in GB/s per core. It measures
+    the throughput of its helper thread while busy and warns if it falls
+    below the budget. */
+
+class InputBufferCrcStage : public InputBufferReadInterface {
+public:
+  /// The InputBufferCrcStage constructor.
+  InputBufferCrcStage(std::unique_ptr<InputBufferReadInterface> source,
+                      uint64_t input_index,
+                      double budget_gb_per_s);
+
+  InputBufferCrcStage(const InputBufferCrcStage&) = delete;
+  void operator=(const InputBufferCrcStage&) = delete;
+
+  /// The InputBufferCrcStage destructor.
+  ~InputBufferCrcStage() override;
+
+  void proceed() override;
+
+  DualIndex get_write_index() override;
+
+  bool get_eof() override;
+
+  void set_read_index(DualIndex new_read_index) override {
+    source_->set_read_index(new_read_index);
+  }
+
+  DualIndex get_read_index() override { return source_->get_read_index(); }
+
+  RingBufferView<uint8_t>& data_buffer() override {
+    return source_->data_buffer();
+  }
+
+  RingBufferView<fles::MicrosliceDescriptor>& desc_buffer() override {
+    return source_->desc_buffer();
+  }
+
+private:
+  /// The helper thread main function.
+  void run();
+
+  /// Compute the CRCs of the microslices in a given descriptor range.
+  /// Returns the number of content bytes processed.
+  uint64_t process(uint64_t desc_begin, uint64_t desc_end);
+
+  /// Update the metrics and check the throughput against the budget.
+  void report(std::chrono::steady_clock::time_point now);
+
+  std::unique_ptr<InputBufferReadInterface> source_;
+  uint64_t input_index_;
+  double budget_gb_per_s_;
+
+  Crc32cEngine crc32_engine_;
+
+  /// Buffers of the batched CRC computation.
+  std::vector<const void*> crc_data_;
+  std::vector<size_t> crc_sizes_;
+  std::vector<uint32_t> crcs_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopping_ = false;
+
+  /// Write index of the source, as published by the reader thread.
+  DualIndex available_;
+
+  /// Index up to which the CRCs have been computed.
+  DualIndex done_;
+
+  /// Throughput accounting of the helper thread.
+  std::chrono::steady_clock::time_point report_begin_;
+  std::chrono::steady_clock::duration busy_time_{0};
+  uint64_t busy_bytes_ = 0;
+  std::chrono::steady_clock::duration total_busy_time_{0};
+  uint64_t total_bytes_ = 0;
+
+  MetricsCounter& bytes_metric_;
+  MetricsGauge& rate_metric_;
+  MetricsGauge& load_metric_;
+
+  std::thread thread_;
+};
@@ -0,0 +1,88 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "LatencyTracer.hpp"
+#include <cassert>
+
+namespace {
+const std::array<const char*, LatencyTracer::STAGE_COUNT - 1>
+    input_stage_names = {"available_to_posted", "posted_to_written",
+                         "written_to_released"};
+
+const std::array<const char*, LatencyTracer::STAGE_COUNT - 1>
+    compute_stage_names = {"first_to_last_contribution",
+                           "last_contribution_to_dispatched",
+                           "dispatched_to_completed"};
+} // namespace
+
+LatencyTracer::LatencyTracer(Role role,
+                             const std::string& transport,
+                             uint64_t index,
+                             uint32_t sample_interval)
+    : sample_interval_(sample_interval) {
+  assert(sample_interval_ > 0);
+  std::string labels = metrics_labels(
+      transport, role == Role::input ? "input" : "compute", index);
+  const auto& names =
+      role == Role::input ? input_stage_names : compute_stage_names;
+  for (size_t i = 0; i < stage_latency_.size(); ++i) {
+    stage_latency_[i] = &MetricsRegistry::instance().histogram(
+        "flesnet_timeslice_stage_microseconds",
+        "Latency between two processing stages of sampled timeslices",
+        labels + ",stage=\"" + names[i] + "\"");
+  }
+  total_latency_ = &MetricsRegistry::instance().histogram(
+      "flesnet_timeslice_latency_microseconds",
+      "Latency from the first to the last processing stage of sampled "
+      "timeslices",
+      labels);
+}
+
+void LatencyTracer::record(uint64_t ts, size_t stage, bool latest) {
+  assert(stage < STAGE_COUNT);
+  auto now = std::chrono::steady_clock::now();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Sample& sample = samples_[(ts / sample_interval_) % SLOT_COUNT];
+  if (sample.ts != ts) {
+    if (sample.ts != UINT64_MAX && sample.ts > ts) {
+      // late event of a timeslice whose slot has been reused
+      return;
+    }
+    sample = Sample();
+    sample.ts = ts;
+  }
+  if (sample.finished) {
+    return;
+  }
+
+  auto& time = sample.time[stage];
+  if (latest || time.time_since_epoch().count() == 0) {
+    time = now;
+  }
+  if (stage == STAGE_COUNT - 1) {
+    finish(sample);
+    sample.finished = true;
+  }
+}
+
+void LatencyTracer::finish(const Sample& sample) {
+  auto micros = [](std::chrono::steady_clock::duration d) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+  };
+  auto is_set = [](std::chrono::steady_clock::time_point t) {
+    return t.time_since_epoch().count() != 0;
+  };
+
+  for (size_t i = 0; i + 1 < STAGE_COUNT; ++i) {
+    if (is_set(sample.time[i]) && is_set(sample.time[i + 1]) &&
+        sample.time[i + 1] >= sample.time[i]) {
+      stage_latency_[i]->record(micros(sample.time[i + 1] - sample.time[i]));
+    }
+  }
+  const auto& first = sample.time.front();
+  const auto& last = sample.time.back();
+  if (is_set(first) && last >= first) {
+    total_latency_->record(micros(last - first));
+  }
+}
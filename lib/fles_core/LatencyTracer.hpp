@@ -0,0 +1,109 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "Metrics.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+/// Sampled per-timeslice latency tracing. For every sample_interval-th
+/// timeslice, the time each processing stage is reached is kept alongside
+/// the timeslice; when it reaches the final stage, the stage-to-stage and
+/// total latencies are added to histograms of the MetricsRegistry.
+///
+/// Input nodes trace from the availability of the last microslice of a
+/// timeslice to its release from the input buffer after the compute node
+/// acknowledged it, which in the DFS transport includes timeslice processing
+/// and thus spans the full path on a single clock. Compute nodes trace from
+/// the first contribution of a timeslice to its completion by the timeslice
+/// processors.
+class LatencyTracer {
+public:
+  enum class Role { input, compute };
+
+  /// Stages on input nodes.
+  enum InputStage : size_t {
+    available, ///< last microslice seen in the input buffer
+    posted,    ///< transfer started
+    written,   ///< transfer completed
+    released   ///< removed from the input buffer
+  };
+
+  /// Stages on compute nodes.
+  enum ComputeStage : size_t {
+    first_contribution, ///< first input contribution received
+    last_contribution,  ///< all input contributions received
+    dispatched,         ///< work item handed to the timeslice processors
+    completed           ///< completion received from the processors
+  };
+
+  static constexpr size_t STAGE_COUNT = 4;
+  static constexpr uint32_t DEFAULT_SAMPLE_INTERVAL = 64;
+
+  LatencyTracer(Role role,
+                const std::string& transport,
+                uint64_t index,
+                uint32_t sample_interval = DEFAULT_SAMPLE_INTERVAL);
+
+  LatencyTracer(const LatencyTracer&) = delete;
+  LatencyTracer& operator=(const LatencyTracer&) = delete;
+
+  bool sampled(uint64_t ts) const { return ts % sample_interval_ == 0; }
+
+  /// Record the first time a sampled timeslice reaches a stage.
+  void mark(uint64_t ts, size_t stage) {
+    if (sampled(ts)) {
+      record(ts, stage, false);
+    }
+  }
+
+  /// Record the latest time a sampled timeslice reaches a stage.
+  void mark_latest(uint64_t ts, size_t stage) {
+    if (sampled(ts)) {
+      record(ts, stage, true);
+    }
+  }
+
+  /// Mark a stage for all timeslices in [begin, end).
+  void mark_range(uint64_t begin, uint64_t end, size_t stage) {
+    for (uint64_t ts = next_sampled(begin); ts < end; ts += sample_interval_) {
+      record(ts, stage, false);
+    }
+  }
+
+  /// Mark a stage (latest time) for all timeslices in [begin, end).
+  void mark_latest_range(uint64_t begin, uint64_t end, size_t stage) {
+    for (uint64_t ts = next_sampled(begin); ts < end; ts += sample_interval_) {
+      record(ts, stage, true);
+    }
+  }
+
+private:
+  // number of concurrently traced timeslices
+  static constexpr size_t SLOT_COUNT = 1024;
+
+  struct Sample {
+    uint64_t ts = UINT64_MAX;
+    bool finished = false;
+    std::array<std::chrono::steady_clock::time_point, STAGE_COUNT> time{};
+  };
+
+  uint64_t next_sampled(uint64_t ts) const {
+    return (ts + sample_interval_ - 1) / sample_interval_ * sample_interval_;
+  }
+
+  void record(uint64_t ts, size_t stage, bool latest);
+
+  void finish(const Sample& sample);
+
+  const uint32_t sample_interval_;
+
+  std::mutex mutex_;
+  std::array<Sample, SLOT_COUNT> samples_;
+
+  // stage-to-stage latencies (index i: stage i to i + 1) and the total
+  std::array<MetricsHistogram*, STAGE_COUNT - 1> stage_latency_;
+  MetricsHistogram* total_latency_;
+};
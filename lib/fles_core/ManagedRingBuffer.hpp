@@ -57,6 +57,12 @@ public:
     write_index_ += n;
   }
 
+  // claim n entries at the write index that are filled in place
+  void advance_write_index(std::size_t n) {
+    assert(size_available() >= n);
+    write_index_ += n;
+  }
+
   // skip remaining entries in ring buffer so that n entries can be stored
   // without fragmentation
   void skip_buffer_wrap(std::size_t n) {
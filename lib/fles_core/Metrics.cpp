@@ -0,0 +1,182 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "Metrics.hpp"
+#include <sstream>
+#include <stdexcept>
+
+MetricsRegistry& MetricsRegistry::instance() {
+  static MetricsRegistry registry;
+  return registry;
+}
+
+MetricsRegistry::Family& MetricsRegistry::family(const std::string& name,
+                                                 Type type,
+                                                 const std::string& help) {
+  auto it = families_.find(name);
+  if (it == families_.end()) {
+    it = families_.emplace(name, Family()).first;
+    it->second.type = type;
+    it->second.help = help;
+  } else if (it->second.type != type) {
+    throw std::logic_error("metric " + name +
+                           " registered with different types");
+  }
+  return it->second;
+}
+
+MetricsCounter& MetricsRegistry::counter(const std::string& name,
+                                         const std::string& help,
+                                         const std::string& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& metric = family(name, Type::counter, help).counters[labels];
+  if (!metric) {
+    metric = std::make_unique<MetricsCounter>();
+  }
+  return *metric;
+}
+
+MetricsGauge& MetricsRegistry::gauge(const std::string& name,
+                                     const std::string& help,
+                                     const std::string& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& metric = family(name, Type::gauge, help).gauges[labels];
+  if (!metric) {
+    metric = std::make_unique<MetricsGauge>();
+  }
+  return *metric;
+}
+
+MetricsHistogram& MetricsRegistry::histogram(const std::string& name,
+                                             const std::string& help,
+                                             const std::string& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& metric = family(name, Type::histogram, help).histograms[labels];
+  if (!metric) {
+    metric = std::make_unique<MetricsHistogram>();
+  }
+  return *metric;
+}
+
+namespace {
+std::string with_labels(const std::string& labels, const std::string& extra) {
+  if (labels.empty() && extra.empty()) {
+    return "";
+  }
+  if (labels.empty() || extra.empty()) {
+    return "{" + labels + extra + "}";
+  }
+  return "{" + labels + "," + extra + "}";
+}
+
+void render_histogram(std::ostringstream& out,
+                      const std::string& name,
+                      const std::string& labels,
+                      const MetricsHistogram& histogram) {
+  // Buckets are reported cumulatively at the end of each power-of-two range,
+  // up to the highest non-empty one.
+  size_t last = 0;
+  for (size_t i = 0; i < MetricsHistogram::BUCKET_COUNT; ++i) {
+    if (histogram.bucket_count(i) != 0) {
+      last = i;
+    }
+  }
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i <= last; ++i) {
+    cumulative += histogram.bucket_count(i);
+    if ((i + 1) % MetricsHistogram::SUB_BUCKET_COUNT == 0 || i == last) {
+      uint64_t le = MetricsHistogram::bucket_upper_bound(
+          i | (MetricsHistogram::SUB_BUCKET_COUNT - 1));
+      out << name << "_bucket"
+          << with_labels(labels, "le=\"" + std::to_string(le) + "\"") << " "
+          << cumulative << "\n";
+    }
+  }
+  out << name << "_bucket" << with_labels(labels, "le=\"+Inf\"") << " "
+      << histogram.count() << "\n";
+  out << name << "_sum" << with_labels(labels, "") << " " << histogram.sum()
+      << "\n";
+  out << name << "_count" << with_labels(labels, "") << " "
+      << histogram.count() << "\n";
+}
+} // namespace
+
+std::string MetricsRegistry::render_prometheus() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream out;
+  out.precision(17);
+  for (const auto& entry : families_) {
+    const std::string& name = entry.first;
+    const Family& f = entry.second;
+    out << "# HELP " << name << " " << f.help << "\n";
+    switch (f.type) {
+    case Type::counter:
+      out << "# TYPE " << name << " counter\n";
+      for (const auto& m : f.counters) {
+        out << name << with_labels(m.first, "") << " " << m.second->value()
+            << "\n";
+      }
+      break;
+    case Type::gauge:
+      out << "# TYPE " << name << " gauge\n";
+      for (const auto& m : f.gauges) {
+        out << name << with_labels(m.first, "") << " " << m.second->value()
+            << "\n";
+      }
+      break;
+    case Type::histogram:
+      out << "# TYPE " << name << " histogram\n";
+      for (const auto& m : f.histograms) {
+        render_histogram(out, name, m.first, *m.second);
+      }
+      break;
+    }
+  }
+  return out.str();
+}
+
+std::string metrics_labels(const std::string& transport,
+                           const std::string& role,
+                           uint64_t index) {
+  return "transport=\"" + transport + "\"," + role + "=\"" +
+         std::to_string(index) + "\"";
+}
+
+BufferMetrics::BufferMetrics(const std::string& buffer,
+                             const std::string& labels)
+    : used_(gauge(buffer, "used", "Part of the buffer holding unsent data",
+                  labels)),
+      sending_(gauge(buffer, "sending", "Part of the buffer being transferred",
+                     labels)),
+      freeing_(gauge(buffer, "freeing",
+                     "Part of the buffer transferred but not yet released",
+                     labels)),
+      free_(gauge(buffer, "free", "Free part of the buffer", labels)),
+      size_(gauge(buffer, "size", "Size of the buffer", labels)),
+      acked_(MetricsRegistry::instance().counter(
+          "flesnet_" + buffer + "_acked_total",
+          "Total amount of data released from the buffer", labels)) {}
+
+MetricsGauge& BufferMetrics::gauge(const std::string& buffer,
+                                   const std::string& field,
+                                   const std::string& help,
+                                   const std::string& labels) {
+  return MetricsRegistry::instance().gauge("flesnet_" + buffer + "_" + field,
+                                           help, labels);
+}
+
+void BufferMetrics::update(int64_t used,
+                           int64_t sending,
+                           int64_t freeing,
+                           uint64_t size,
+                           uint64_t acked) {
+  used_.set(static_cast<double>(used));
+  sending_.set(static_cast<double>(sending));
+  freeing_.set(static_cast<double>(freeing));
+  free_.set(static_cast<double>(static_cast<int64_t>(size) - used - sending -
+                                freeing));
+  size_.set(static_cast<double>(size));
+  if (acked > previous_acked_) {
+    acked_.add(acked - previous_acked_);
+  }
+  previous_acked_ = acked;
+}
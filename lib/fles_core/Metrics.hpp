@@ -0,0 +1,138 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "HdrHistogram.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// Monotonically increasing counter metric.
+class MetricsCounter {
+public:
+  void add(uint64_t value = 1) {
+    value_.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<uint64_t> value_{0};
+};
+
+/// Gauge metric holding an arbitrary floating point value.
+class MetricsGauge {
+public:
+  void set(double value) {
+    bits_.store(to_bits(value), std::memory_order_relaxed);
+  }
+
+  void add(double value) {
+    uint64_t old_bits = bits_.load(std::memory_order_relaxed);
+    while (!bits_.compare_exchange_weak(old_bits,
+                                        to_bits(from_bits(old_bits) + value),
+                                        std::memory_order_relaxed)) {
+    }
+  }
+
+  double value() const {
+    return from_bits(bits_.load(std::memory_order_relaxed));
+  }
+
+private:
+  static uint64_t to_bits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+
+  static double from_bits(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  std::atomic<uint64_t> bits_{0};
+};
+
+/// Histogram metric, recorded concurrently without locking.
+using MetricsHistogram = HdrHistogram<std::atomic<uint64_t>>;
+
+/// Process-wide registry of named metrics. Metrics are created once (under a
+/// lock) and returned by reference; updating them afterwards is lock-free.
+/// Labels are given in Prometheus syntax, e.g. "input=\"0\",compute=\"1\"".
+class MetricsRegistry {
+public:
+  static MetricsRegistry& instance();
+
+  MetricsCounter& counter(const std::string& name,
+                          const std::string& help,
+                          const std::string& labels = "");
+
+  MetricsGauge& gauge(const std::string& name,
+                      const std::string& help,
+                      const std::string& labels = "");
+
+  MetricsHistogram& histogram(const std::string& name,
+                              const std::string& help,
+                              const std::string& labels = "");
+
+  /// Render all metrics in the Prometheus text exposition format.
+  std::string render_prometheus() const;
+
+private:
+  enum class Type { counter, gauge, histogram };
+
+  struct Family {
+    Type type;
+    std::string help;
+    std::map<std::string, std::unique_ptr<MetricsCounter>> counters;
+    std::map<std::string, std::unique_ptr<MetricsGauge>> gauges;
+    std::map<std::string, std::unique_ptr<MetricsHistogram>> histograms;
+  };
+
+  Family& family(const std::string& name, Type type, const std::string& help);
+
+  mutable std::mutex mutex_;
+  std::map<std::string, Family> families_;
+};
+
+/// Label string for a metric of a single connection.
+std::string metrics_labels(const std::string& transport,
+                           const std::string& role,
+                           uint64_t index);
+
+/// Set of metrics describing the fill level of a ring buffer and the amount
+/// of data passed through it, as reported periodically by the senders and
+/// timeslice builders. Amounts are given in the unit of the buffer (bytes or
+/// descriptors); rates are left to the monitoring system.
+class BufferMetrics {
+public:
+  BufferMetrics(const std::string& buffer, const std::string& labels);
+
+  /// Update from the current buffer state; acked is the total amount of
+  /// data released so far.
+  void update(int64_t used,
+              int64_t sending,
+              int64_t freeing,
+              uint64_t size,
+              uint64_t acked);
+
+private:
+  static MetricsGauge& gauge(const std::string& buffer,
+                             const std::string& field,
+                             const std::string& help,
+                             const std::string& labels);
+
+  MetricsGauge& used_;
+  MetricsGauge& sending_;
+  MetricsGauge& freeing_;
+  MetricsGauge& free_;
+  MetricsGauge& size_;
+  MetricsCounter& acked_;
+  uint64_t previous_acked_ = 0;
+};
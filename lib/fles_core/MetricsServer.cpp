@@ -0,0 +1,226 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "MetricsServer.hpp"
+#include "Metrics.hpp"
+#include "log.hpp"
+#include <cerrno>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+// time after which the server and pusher threads notice a stop request
+constexpr int poll_timeout_ms = 200;
+
+bool send_all(int fd, const std::string& data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    ssize_t n =
+        ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    sent += static_cast<size_t>(n);
+  }
+  return true;
+}
+
+std::string http_response(const std::string& status,
+                          const std::string& content_type,
+                          const std::string& body) {
+  return "HTTP/1.1 " + status + "\r\nContent-Type: " + content_type +
+         "\r\nContent-Length: " + std::to_string(body.size()) +
+         "\r\nConnection: close\r\n\r\n" + body;
+}
+} // namespace
+
+MetricsServer::MetricsServer(uint16_t port) : port_(port) {
+  listen_fd_ = ::socket(AF_INET6, SOCK_STREAM, 0);
+  if (listen_fd_ < 0) {
+    throw std::runtime_error("metrics server: socket() failed: " +
+                             std::string(std::strerror(errno)));
+  }
+  int on = 1;
+  ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  int off = 0;
+  ::setsockopt(listen_fd_, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+
+  sockaddr_in6 addr{};
+  addr.sin6_family = AF_INET6;
+  addr.sin6_addr = in6addr_any;
+  addr.sin6_port = htons(port);
+  if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) !=
+          0 ||
+      ::listen(listen_fd_, 16) != 0) {
+    std::string error = std::strerror(errno);
+    ::close(listen_fd_);
+    throw std::runtime_error("metrics server: cannot listen on port " +
+                             std::to_string(port) + ": " + error);
+  }
+
+  thread_ = std::thread(&MetricsServer::serve, this);
+  L_(info) << "metrics available at http://<host>:" << port_ << "/metrics";
+}
+
+MetricsServer::~MetricsServer() {
+  stopping_ = true;
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  ::close(listen_fd_);
+}
+
+void MetricsServer::serve() {
+  while (!stopping_) {
+    pollfd pfd{listen_fd_, POLLIN, 0};
+    int ret = ::poll(&pfd, 1, poll_timeout_ms);
+    if (ret <= 0) {
+      continue;
+    }
+    int client_fd = ::accept(listen_fd_, nullptr, nullptr);
+    if (client_fd < 0) {
+      continue;
+    }
+    handle_client(client_fd);
+    ::close(client_fd);
+  }
+}
+
+void MetricsServer::handle_client(int client_fd) {
+  // read the request header, giving up on slow or oversized requests
+  std::string request;
+  char buf[1024];
+  while (request.find("\r\n\r\n") == std::string::npos &&
+         request.size() < 8192) {
+    pollfd pfd{client_fd, POLLIN, 0};
+    if (::poll(&pfd, 1, poll_timeout_ms * 5) <= 0) {
+      return;
+    }
+    ssize_t n = ::recv(client_fd, buf, sizeof(buf), 0);
+    if (n <= 0) {
+      return;
+    }
+    request.append(buf, static_cast<size_t>(n));
+  }
+
+  std::string response;
+  if (request.compare(0, 13, "GET /metrics ") == 0 ||
+      request.compare(0, 14, "GET /metrics/ ") == 0) {
+    response = http_response("200 OK", "text/plain; version=0.0.4",
+                             MetricsRegistry::instance().render_prometheus());
+  } else if (request.compare(0, 4, "GET ") == 0) {
+    response = http_response("404 Not Found", "text/plain", "not found\n");
+  } else {
+    response = http_response("405 Method Not Allowed", "text/plain",
+                             "method not allowed\n");
+  }
+  send_all(client_fd, response);
+}
+
+MetricsPusher::MetricsPusher(const std::string& uri,
+                             std::chrono::milliseconds interval)
+    : interval_(interval) {
+  const std::string scheme = "http://";
+  if (uri.compare(0, scheme.size(), scheme) != 0) {
+    throw std::invalid_argument("metrics push: only http:// is supported");
+  }
+  std::string rest = uri.substr(scheme.size());
+  size_t slash = rest.find('/');
+  std::string authority = rest.substr(0, slash);
+  path_ = slash == std::string::npos ? "/" : rest.substr(slash);
+  size_t colon = authority.rfind(':');
+  if (colon == std::string::npos) {
+    host_ = authority;
+    port_ = "80";
+  } else {
+    host_ = authority.substr(0, colon);
+    port_ = authority.substr(colon + 1);
+  }
+  if (host_.empty()) {
+    throw std::invalid_argument("metrics push: no host in " + uri);
+  }
+
+  thread_ = std::thread(&MetricsPusher::run, this);
+}
+
+MetricsPusher::~MetricsPusher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  // final push so that short runs are recorded as well
+  push();
+}
+
+void MetricsPusher::run() {
+  bool failed = false;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopping_) {
+    cv_.wait_for(lock, interval_);
+    if (stopping_) {
+      break;
+    }
+    lock.unlock();
+    bool ok = push();
+    if (!ok && !failed) {
+      L_(warning) << "metrics push to " << host_ << ":" << port_ << path_
+                  << " failed";
+    }
+    failed = !ok;
+    lock.lock();
+  }
+}
+
+bool MetricsPusher::push() const {
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* result = nullptr;
+  if (::getaddrinfo(host_.c_str(), port_.c_str(), &hints, &result) != 0) {
+    return false;
+  }
+  int fd = -1;
+  for (addrinfo* ai = result; ai != nullptr; ai = ai->ai_next) {
+    fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd < 0) {
+      continue;
+    }
+    if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+      break;
+    }
+    ::close(fd);
+    fd = -1;
+  }
+  ::freeaddrinfo(result);
+  if (fd < 0) {
+    return false;
+  }
+
+  std::string body = MetricsRegistry::instance().render_prometheus();
+  std::string request = "PUT " + path_ + " HTTP/1.1\r\nHost: " + host_ +
+                        "\r\nContent-Type: text/plain; version=0.0.4" +
+                        "\r\nContent-Length: " + std::to_string(body.size()) +
+                        "\r\nConnection: close\r\n\r\n" + body;
+  bool ok = send_all(fd, request);
+  if (ok) {
+    // check for a 2xx status line
+    char status[16] = {};
+    pollfd pfd{fd, POLLIN, 0};
+    ok = ::poll(&pfd, 1, poll_timeout_ms * 5) > 0 &&
+         ::recv(fd, status, sizeof(status) - 1, 0) >= 12 &&
+         std::strncmp(status + 8, " 2", 2) == 0;
+  }
+  ::close(fd);
+  return ok;
+}
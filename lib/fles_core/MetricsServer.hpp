@@ -0,0 +1,60 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/// Minimal embedded HTTP server answering "GET /metrics" with the contents
+/// of the MetricsRegistry in the Prometheus text format. It runs in its own
+/// thread and serves one request at a time.
+class MetricsServer {
+public:
+  explicit MetricsServer(uint16_t port);
+
+  MetricsServer(const MetricsServer&) = delete;
+  MetricsServer& operator=(const MetricsServer&) = delete;
+
+  ~MetricsServer();
+
+  uint16_t port() const { return port_; }
+
+private:
+  void serve();
+  void handle_client(int client_fd);
+
+  int listen_fd_ = -1;
+  uint16_t port_;
+  std::atomic<bool> stopping_{false};
+  std::thread thread_;
+};
+
+/// Periodic push of the MetricsRegistry contents to a Prometheus Pushgateway,
+/// given as "http://host:port/metrics/job/<job>".
+class MetricsPusher {
+public:
+  MetricsPusher(const std::string& uri, std::chrono::milliseconds interval);
+
+  MetricsPusher(const MetricsPusher&) = delete;
+  MetricsPusher& operator=(const MetricsPusher&) = delete;
+
+  ~MetricsPusher();
+
+private:
+  void run();
+  bool push() const;
+
+  std::string host_;
+  std::string port_;
+  std::string path_;
+  std::chrono::milliseconds interval_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopping_ = false;
+  std::thread thread_;
+};
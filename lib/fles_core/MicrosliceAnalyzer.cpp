@@ -14,26 +14,12 @@ MicrosliceAnalyzer::MicrosliceAnalyzer(uint64_t arg_output_interval,
                                        size_t component)
     : output_interval_(arg_output_interval), out_verbosity_(arg_out_verbosity),
       out_(arg_out), output_prefix_(std::move(arg_output_prefix)),
-      component_(component) {
-  // create CRC-32C engine (Castagnoli polynomial)
-  crc32_engine_ = crcutil_interface::CRC::Create(
-      0x82f63b78, 0, 32, true, 0, 0, 0,
-      crcutil_interface::CRC::IsSSE42Available(), NULL);
-}
+      component_(component) {}
 
-MicrosliceAnalyzer::~MicrosliceAnalyzer() {
-  if (crc32_engine_ != nullptr) {
-    crc32_engine_->Delete();
-  }
-}
+MicrosliceAnalyzer::~MicrosliceAnalyzer() = default;
 
 uint32_t MicrosliceAnalyzer::compute_crc(const fles::Microslice& ms) const {
-  assert(crc32_engine_);
-
-  crcutil_interface::UINT64 crc64 = 0;
-  crc32_engine_->Compute(ms.content(), ms.desc().size, &crc64);
-
-  return static_cast<uint32_t>(crc64);
+  return crc32_engine_.compute(ms.content(), ms.desc().size);
 }
 
 bool MicrosliceAnalyzer::check_crc(const fles::Microslice& ms) const {
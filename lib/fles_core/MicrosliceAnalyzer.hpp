@@ -1,10 +1,10 @@
 // Copyright 2015 Jan de Cuveland <cmail@cuveland.de>
 #pragma once
 
+#include "Crc32cEngine.hpp"
 #include "Microslice.hpp"
 #include "MicrosliceDescriptor.hpp"
 #include "Sink.hpp"
-#include "interface.h" // crcutil_interface
 #include <memory>
 #include <ostream>
 #include <string>
@@ -33,7 +33,7 @@ private:
 
   void initialize(const fles::Microslice& ms);
 
-  crcutil_interface::CRC* crc32_engine_ = nullptr;
+  Crc32cEngine crc32_engine_;
 
   fles::MicrosliceDescriptor reference_descriptor_;
   std::unique_ptr<PatternChecker> pattern_checker_;
@@ -0,0 +1,156 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "MicrosliceIndexChecker.hpp"
+#include <algorithm>
+#include <sstream>
+
+bool MicrosliceIndexChecker::check(const fles::Timeslice& ts,
+                                   size_t component) {
+  error_.clear();
+  const uint64_t n = ts.num_microslices(component);
+  if (n == 0) {
+    return true;
+  }
+  const uint64_t core = std::min(ts.num_core_microslices(), n);
+  const fles::MicrosliceDescriptor* desc = &ts.descriptor(component, 0);
+  bool success = true;
+
+  // continuity with the previous timeslice
+  if (has_previous_ && ts.index() == previous_ts_index_ + 1) {
+    if (has_overlap_ && desc[0].idx != overlap_first_index_) {
+      ++overlap_mismatches_;
+      std::ostringstream s;
+      s << "first microslice " << desc[0].idx
+        << " differs from previous overlap " << overlap_first_index_;
+      set_error(s.str());
+      success = false;
+    }
+    if (desc[0].idx - last_core_index_ != period_ || period_ == 0) {
+      success = check_step(last_core_index_, desc[0].idx, true) && success;
+    }
+  }
+
+  // core microslices, and overlap microslices (which are counted as core
+  // microslices of the next timeslice)
+  success = check_range(desc, 1, core, true) && success;
+  success = check_range(desc, std::max(core, UINT64_C(1)), n, false) &&
+            success;
+
+  checked_ += core;
+  has_previous_ = core > 0;
+  previous_ts_index_ = ts.index();
+  if (core > 0) {
+    last_core_index_ = desc[core - 1].idx;
+  }
+  has_overlap_ = n > core;
+  if (has_overlap_) {
+    overlap_first_index_ = desc[core].idx;
+  }
+
+  return success;
+}
+
+bool MicrosliceIndexChecker::check_range(const fles::MicrosliceDescriptor* desc,
+                                         uint64_t begin,
+                                         uint64_t end,
+                                         bool record) {
+  bool success = true;
+  for (uint64_t m = begin; m < end; ++m) {
+    if (desc[m].idx - desc[m - 1].idx != period_ || period_ == 0) {
+      success = check_step(desc[m - 1].idx, desc[m].idx, record) && success;
+    }
+  }
+  return success;
+}
+
+bool MicrosliceIndexChecker::check_step(uint64_t previous,
+                                        uint64_t index,
+                                        bool record) {
+  std::ostringstream s;
+
+  if (index > previous) {
+    uint64_t delta = index - previous;
+    if (period_ == 0) {
+      period_ = delta;
+      return true;
+    }
+    if (delta % period_ == 0) {
+      uint64_t count = delta / period_ - 1;
+      if (record) {
+        missing_ += count;
+        add_gap(previous + period_, count);
+      }
+      s << count << " microslice(s) missing after " << previous;
+      set_error(s.str());
+      return false;
+    }
+    if (period_ % delta == 0) {
+      // the initial period estimate included a gap
+      period_ = delta;
+      return true;
+    }
+  } else if (period_ != 0 && (previous - index) % period_ == 0) {
+    uint64_t count = (previous - index) / period_ + 1;
+    if (record) {
+      duplicates_ += count;
+    }
+    s << count << " microslice(s) repeated from " << index;
+    set_error(s.str());
+    return false;
+  }
+
+  if (record) {
+    ++disorders_;
+  }
+  s << "irregular index step from " << previous << " to " << index;
+  if (period_ != 0) {
+    s << " (period " << period_ << ")";
+  }
+  set_error(s.str());
+  return false;
+}
+
+void MicrosliceIndexChecker::add_gap(uint64_t first, uint64_t count) {
+  if (!recent_gaps_.empty()) {
+    Run& last = recent_gaps_.back();
+    if (last.first + last.count * period_ == first) {
+      last.count += count;
+      return;
+    }
+  }
+  ++gap_runs_;
+  if (recent_gaps_.size() == max_runs) {
+    recent_gaps_.erase(recent_gaps_.begin());
+  }
+  recent_gaps_.push_back({first, count});
+}
+
+void MicrosliceIndexChecker::set_error(const std::string& error) {
+  if (error_.empty()) {
+    error_ = error;
+  }
+}
+
+std::string MicrosliceIndexChecker::report() const {
+  std::ostringstream s;
+  s << checked_ << " microslices (period " << period_ << "), " << missing_
+    << " missing in " << gap_runs_ << " gaps";
+  s.precision(1);
+  s << " (" << std::scientific << missing_rate() << std::defaultfloat << ")";
+  if (duplicates_ != 0) {
+    s << ", " << duplicates_ << " duplicates";
+  }
+  if (disorders_ != 0) {
+    s << ", " << disorders_ << " irregular";
+  }
+  if (overlap_mismatches_ != 0) {
+    s << ", " << overlap_mismatches_ << " overlap mismatches";
+  }
+  if (!recent_gaps_.empty()) {
+    s << ", recent gaps:";
+    for (const auto& run : recent_gaps_) {
+      s << " " << run.first << "+" << run.count;
+    }
+  }
+  return s.str();
+}
@@ -0,0 +1,119 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "MicrosliceDescriptor.hpp"
+#include "Timeslice.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Microslice index continuity checker class.
+/** A MicrosliceIndexChecker object verifies the continuity of the
+    microslice indices (or start times) of one timeslice component over a
+    stream of timeslices. The index period is learned from the data.
+
+    Within a timeslice, the index has to advance by the period from one
+    microslice to the next. Across consecutive timeslices, the first
+    microslice has to follow the last core microslice of the previous
+    timeslice and to match its first overlap microslice. Missing
+    microslices are recorded as run-length gaps, repeated ones as
+    duplicates.
+
+    Only the descriptors are read, in a single pass with one comparison per
+    microslice in the regular case. */
+
+class MicrosliceIndexChecker {
+public:
+  /// A run of consecutive missing microslices.
+  struct Run {
+    uint64_t first; ///< Index of the first missing microslice
+    uint64_t count; ///< Number of missing microslices
+  };
+
+  /// Check the microslices of a timeslice component. Returns false if a
+  /// discontinuity has been found.
+  bool check(const fles::Timeslice& ts, size_t component);
+
+  /// Forget the previous timeslice, e.g., after a restart of the stream.
+  void reset() { has_previous_ = false; }
+
+  /// Description of the first discontinuity in the last checked timeslice.
+  const std::string& error() const { return error_; }
+
+  /// Index period (zero if not known yet).
+  uint64_t period() const { return period_; }
+
+  /// Number of core microslices checked.
+  uint64_t checked() const { return checked_; }
+
+  /// Number of missing microslices.
+  uint64_t missing() const { return missing_; }
+
+  /// Number of repeated microslices.
+  uint64_t duplicates() const { return duplicates_; }
+
+  /// Number of index steps that are neither regular, gaps nor repetitions.
+  uint64_t disorders() const { return disorders_; }
+
+  /// Number of timeslices not starting with the previous overlap.
+  uint64_t overlap_mismatches() const { return overlap_mismatches_; }
+
+  /// Total number of gap runs.
+  uint64_t gap_runs() const { return gap_runs_; }
+
+  /// The most recent gap runs (at most max_runs, adjacent ones merged).
+  const std::vector<Run>& recent_gaps() const { return recent_gaps_; }
+
+  /// Fraction of missing microslices among all expected ones.
+  double missing_rate() const {
+    return (checked_ + missing_) == 0
+               ? 0.
+               : static_cast<double>(missing_) /
+                     static_cast<double>(checked_ + missing_);
+  }
+
+  /// Check whether any discontinuity has been found so far.
+  bool has_errors() const {
+    return missing_ != 0 || duplicates_ != 0 || disorders_ != 0 ||
+           overlap_mismatches_ != 0;
+  }
+
+  /// Compact summary of the results, including the recent gap runs.
+  std::string report() const;
+
+  /// Maximum number of recent gap runs kept.
+  static constexpr size_t max_runs = 8;
+
+private:
+  /// Check the steps between the microslices in the range [begin, end).
+  /// Errors are only counted if record is set.
+  bool check_range(const fles::MicrosliceDescriptor* desc,
+                   uint64_t begin,
+                   uint64_t end,
+                   bool record);
+
+  /// Classify an irregular step from index previous to index.
+  bool check_step(uint64_t previous, uint64_t index, bool record);
+
+  void add_gap(uint64_t first, uint64_t count);
+
+  void set_error(const std::string& error);
+
+  uint64_t period_ = 0;
+
+  bool has_previous_ = false;
+  uint64_t previous_ts_index_ = 0;
+  uint64_t last_core_index_ = 0;
+  bool has_overlap_ = false;
+  uint64_t overlap_first_index_ = 0;
+
+  uint64_t checked_ = 0;
+  uint64_t missing_ = 0;
+  uint64_t duplicates_ = 0;
+  uint64_t disorders_ = 0;
+  uint64_t overlap_mismatches_ = 0;
+  uint64_t gap_runs_ = 0;
+  std::vector<Run> recent_gaps_;
+
+  std::string error_;
+};
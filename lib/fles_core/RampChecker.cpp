@@ -0,0 +1,339 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "RampChecker.hpp"
+#include <cassert>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+size_t find_mismatch64_scalar(const uint64_t* words,
+                              size_t count,
+                              uint64_t first,
+                              uint64_t step,
+                              uint64_t* xor_sum) {
+  uint64_t sum = 0;
+  uint64_t expected = first;
+  for (size_t i = 0; i < count; ++i) {
+    if (words[i] != expected) {
+      return i;
+    }
+    sum ^= words[i];
+    expected += step;
+  }
+  if (xor_sum != nullptr) {
+    *xor_sum = sum;
+  }
+  return count;
+}
+
+size_t find_mismatch16_scalar(const uint16_t* words,
+                              size_t count,
+                              uint16_t first) {
+  uint16_t expected = first;
+  for (size_t i = 0; i < count; ++i) {
+    if (words[i] != expected) {
+      return i;
+    }
+    ++expected;
+  }
+  return count;
+}
+
+/// Handle the rest of a 64-bit word buffer (and a block containing a
+/// mismatch) after a vectorized part of the given length.
+size_t finish_mismatch64(const uint64_t* words,
+                         size_t count,
+                         size_t done,
+                         uint64_t first,
+                         uint64_t step,
+                         uint64_t sum,
+                         uint64_t* xor_sum) {
+  uint64_t rest_sum = 0;
+  size_t pos = done + find_mismatch64_scalar(words + done, count - done,
+                                             first + done * step, step,
+                                             &rest_sum);
+  if (pos == count && xor_sum != nullptr) {
+    *xor_sum = sum ^ rest_sum;
+  }
+  return pos;
+}
+
+#if defined(__x86_64__)
+
+/// Ramp value at a given index, as a vector element.
+int64_t ramp(uint64_t first, uint64_t step, uint64_t index) {
+  return static_cast<int64_t>(first + index * step);
+}
+
+// Each vectorized variant compares blocks of four vectors against the
+// expected ramp and only branches once per block.
+
+__attribute__((target("sse4.1"))) size_t
+find_mismatch64_sse41(const uint64_t* words,
+                      size_t count,
+                      uint64_t first,
+                      uint64_t step,
+                      uint64_t* xor_sum) {
+  constexpr size_t lanes = 2;
+  const auto* p = reinterpret_cast<const __m128i*>(words);
+  const __m128i vector_step = _mm_set1_epi64x(ramp(0, step, lanes));
+  const __m128i block_step = _mm_set1_epi64x(ramp(0, step, 4 * lanes));
+  __m128i e0 = _mm_set_epi64x(ramp(first, step, 1), ramp(first, step, 0));
+  __m128i e1 = _mm_add_epi64(e0, vector_step);
+  __m128i e2 = _mm_add_epi64(e1, vector_step);
+  __m128i e3 = _mm_add_epi64(e2, vector_step);
+  __m128i sum = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 4 * lanes <= count; i += 4 * lanes, p += 4) {
+    __m128i d0 = _mm_loadu_si128(p);
+    __m128i d1 = _mm_loadu_si128(p + 1);
+    __m128i d2 = _mm_loadu_si128(p + 2);
+    __m128i d3 = _mm_loadu_si128(p + 3);
+    __m128i diff = _mm_or_si128(
+        _mm_or_si128(_mm_xor_si128(d0, e0), _mm_xor_si128(d1, e1)),
+        _mm_or_si128(_mm_xor_si128(d2, e2), _mm_xor_si128(d3, e3)));
+    if (_mm_testz_si128(diff, diff) == 0) {
+      break;
+    }
+    sum = _mm_xor_si128(sum, _mm_xor_si128(_mm_xor_si128(d0, d1),
+                                           _mm_xor_si128(d2, d3)));
+    e0 = _mm_add_epi64(e0, block_step);
+    e1 = _mm_add_epi64(e1, block_step);
+    e2 = _mm_add_epi64(e2, block_step);
+    e3 = _mm_add_epi64(e3, block_step);
+  }
+  auto reduced = static_cast<uint64_t>(_mm_extract_epi64(sum, 0) ^
+                                       _mm_extract_epi64(sum, 1));
+  return finish_mismatch64(words, count, i, first, step, reduced, xor_sum);
+}
+
+__attribute__((target("avx2"))) size_t
+find_mismatch64_avx2(const uint64_t* words,
+                     size_t count,
+                     uint64_t first,
+                     uint64_t step,
+                     uint64_t* xor_sum) {
+  constexpr size_t lanes = 4;
+  const auto* p = reinterpret_cast<const __m256i*>(words);
+  const __m256i vector_step = _mm256_set1_epi64x(ramp(0, step, lanes));
+  const __m256i block_step = _mm256_set1_epi64x(ramp(0, step, 4 * lanes));
+  __m256i e0 = _mm256_set_epi64x(ramp(first, step, 3), ramp(first, step, 2),
+                                 ramp(first, step, 1), ramp(first, step, 0));
+  __m256i e1 = _mm256_add_epi64(e0, vector_step);
+  __m256i e2 = _mm256_add_epi64(e1, vector_step);
+  __m256i e3 = _mm256_add_epi64(e2, vector_step);
+  __m256i sum = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 4 * lanes <= count; i += 4 * lanes, p += 4) {
+    __m256i d0 = _mm256_loadu_si256(p);
+    __m256i d1 = _mm256_loadu_si256(p + 1);
+    __m256i d2 = _mm256_loadu_si256(p + 2);
+    __m256i d3 = _mm256_loadu_si256(p + 3);
+    __m256i diff = _mm256_or_si256(
+        _mm256_or_si256(_mm256_xor_si256(d0, e0), _mm256_xor_si256(d1, e1)),
+        _mm256_or_si256(_mm256_xor_si256(d2, e2), _mm256_xor_si256(d3, e3)));
+    if (_mm256_testz_si256(diff, diff) == 0) {
+      break;
+    }
+    sum = _mm256_xor_si256(sum, _mm256_xor_si256(_mm256_xor_si256(d0, d1),
+                                                 _mm256_xor_si256(d2, d3)));
+    e0 = _mm256_add_epi64(e0, block_step);
+    e1 = _mm256_add_epi64(e1, block_step);
+    e2 = _mm256_add_epi64(e2, block_step);
+    e3 = _mm256_add_epi64(e3, block_step);
+  }
+  __m128i half = _mm_xor_si128(_mm256_castsi256_si128(sum),
+                               _mm256_extracti128_si256(sum, 1));
+  auto reduced = static_cast<uint64_t>(_mm_extract_epi64(half, 0) ^
+                                       _mm_extract_epi64(half, 1));
+  return finish_mismatch64(words, count, i, first, step, reduced, xor_sum);
+}
+
+__attribute__((target("avx512f"))) size_t
+find_mismatch64_avx512(const uint64_t* words,
+                       size_t count,
+                       uint64_t first,
+                       uint64_t step,
+                       uint64_t* xor_sum) {
+  constexpr size_t lanes = 8;
+  const __m512i vector_step = _mm512_set1_epi64(ramp(0, step, lanes));
+  const __m512i block_step = _mm512_set1_epi64(ramp(0, step, 4 * lanes));
+  __m512i e0 = _mm512_set_epi64(ramp(first, step, 7), ramp(first, step, 6),
+                                ramp(first, step, 5), ramp(first, step, 4),
+                                ramp(first, step, 3), ramp(first, step, 2),
+                                ramp(first, step, 1), ramp(first, step, 0));
+  __m512i e1 = _mm512_add_epi64(e0, vector_step);
+  __m512i e2 = _mm512_add_epi64(e1, vector_step);
+  __m512i e3 = _mm512_add_epi64(e2, vector_step);
+  __m512i sum = _mm512_setzero_si512();
+  size_t i = 0;
+  for (; i + 4 * lanes <= count; i += 4 * lanes) {
+    __m512i d0 = _mm512_loadu_si512(words + i);
+    __m512i d1 = _mm512_loadu_si512(words + i + lanes);
+    __m512i d2 = _mm512_loadu_si512(words + i + 2 * lanes);
+    __m512i d3 = _mm512_loadu_si512(words + i + 3 * lanes);
+    // ternary logic 0xf6: a | (b ^ c)
+    __m512i diff = _mm512_ternarylogic_epi64(
+        _mm512_xor_si512(d0, e0), d1, e1, 0xf6);
+    diff = _mm512_or_si512(
+        diff, _mm512_ternarylogic_epi64(_mm512_xor_si512(d2, e2), d3, e3,
+                                        0xf6));
+    if (_mm512_test_epi64_mask(diff, diff) != 0) {
+      break;
+    }
+    // ternary logic 0x96: a ^ b ^ c
+    sum = _mm512_ternarylogic_epi64(sum, d0, d1, 0x96);
+    sum = _mm512_ternarylogic_epi64(sum, d2, d3, 0x96);
+    e0 = _mm512_add_epi64(e0, block_step);
+    e1 = _mm512_add_epi64(e1, block_step);
+    e2 = _mm512_add_epi64(e2, block_step);
+    e3 = _mm512_add_epi64(e3, block_step);
+  }
+  alignas(64) uint64_t sum_lanes[lanes];
+  _mm512_store_si512(sum_lanes, sum);
+  uint64_t reduced = 0;
+  for (uint64_t lane : sum_lanes) {
+    reduced ^= lane;
+  }
+  return finish_mismatch64(words, count, i, first, step, reduced, xor_sum);
+}
+
+__attribute__((target("sse4.1"))) size_t
+find_mismatch16_sse41(const uint16_t* words, size_t count, uint16_t first) {
+  constexpr size_t lanes = 8;
+  const __m128i step = _mm_set1_epi16(lanes);
+  __m128i expected = _mm_add_epi16(_mm_set1_epi16(static_cast<short>(first)),
+                                   _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7));
+  size_t i = 0;
+  for (; i + lanes <= count; i += lanes) {
+    __m128i data =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+    __m128i diff = _mm_xor_si128(data, expected);
+    if (_mm_testz_si128(diff, diff) == 0) {
+      break;
+    }
+    expected = _mm_add_epi16(expected, step);
+  }
+  return i + find_mismatch16_scalar(words + i, count - i,
+                                    static_cast<uint16_t>(first + i));
+}
+
+__attribute__((target("avx2"))) size_t
+find_mismatch16_avx2(const uint16_t* words, size_t count, uint16_t first) {
+  constexpr size_t lanes = 16;
+  const __m256i step = _mm256_set1_epi16(lanes);
+  __m256i expected = _mm256_add_epi16(
+      _mm256_set1_epi16(static_cast<short>(first)),
+      _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+  size_t i = 0;
+  for (; i + lanes <= count; i += lanes) {
+    __m256i data =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+    __m256i diff = _mm256_xor_si256(data, expected);
+    if (_mm256_testz_si256(diff, diff) == 0) {
+      break;
+    }
+    expected = _mm256_add_epi16(expected, step);
+  }
+  return i + find_mismatch16_scalar(words + i, count - i,
+                                    static_cast<uint16_t>(first + i));
+}
+
+/// The 16-bit ramps of the test patterns are short, so the AVX-512 variant
+/// covers the whole buffer with masked loads instead of a scalar tail.
+__attribute__((target("avx512f,avx512bw"))) size_t
+find_mismatch16_avx512(const uint16_t* words, size_t count, uint16_t first) {
+  constexpr size_t lanes = 32;
+  const __m512i step = _mm512_set1_epi16(lanes);
+  __m512i expected = _mm512_add_epi16(
+      _mm512_set1_epi16(static_cast<short>(first)),
+      _mm512_set_epi16(31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18,
+                       17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2,
+                       1, 0));
+  for (size_t i = 0; i < count; i += lanes) {
+    const size_t n = count - i < lanes ? count - i : lanes;
+    const __mmask32 valid =
+        n == lanes ? ~__mmask32{0} : (__mmask32{1} << n) - 1;
+    __m512i data = _mm512_maskz_loadu_epi16(valid, words + i);
+    __mmask32 mismatch = _mm512_mask_cmpneq_epi16_mask(valid, data, expected);
+    if (mismatch != 0) {
+      return i + static_cast<size_t>(__builtin_ctz(mismatch));
+    }
+    expected = _mm512_add_epi16(expected, step);
+  }
+  return count;
+}
+
+#endif
+
+} // namespace
+
+RampChecker::RampChecker(Implementation implementation)
+    : implementation_(implementation) {
+  assert(is_available(implementation));
+  switch (implementation) {
+#if defined(__x86_64__)
+  case Implementation::Sse41:
+    find_mismatch64_ = find_mismatch64_sse41;
+    find_mismatch16_ = find_mismatch16_sse41;
+    break;
+  case Implementation::Avx2:
+    find_mismatch64_ = find_mismatch64_avx2;
+    find_mismatch16_ = find_mismatch16_avx2;
+    break;
+  case Implementation::Avx512:
+    find_mismatch64_ = find_mismatch64_avx512;
+    find_mismatch16_ = find_mismatch16_avx512;
+    break;
+#endif
+  default:
+    implementation_ = Implementation::Scalar;
+    find_mismatch64_ = find_mismatch64_scalar;
+    find_mismatch16_ = find_mismatch16_scalar;
+    break;
+  }
+}
+
+bool RampChecker::is_available(Implementation implementation) {
+  switch (implementation) {
+  case Implementation::Scalar:
+    return true;
+#if defined(__x86_64__)
+  case Implementation::Sse41:
+    return __builtin_cpu_supports("sse4.1") != 0;
+  case Implementation::Avx2:
+    return __builtin_cpu_supports("avx2") != 0;
+  case Implementation::Avx512:
+    return __builtin_cpu_supports("avx512f") != 0 &&
+           __builtin_cpu_supports("avx512bw") != 0;
+#endif
+  default:
+    return false;
+  }
+}
+
+RampChecker::Implementation RampChecker::best_implementation() {
+  for (auto implementation :
+       {Implementation::Avx512, Implementation::Avx2, Implementation::Sse41}) {
+    if (is_available(implementation)) {
+      return implementation;
+    }
+  }
+  return Implementation::Scalar;
+}
+
+std::string RampChecker::to_string(Implementation implementation) {
+  switch (implementation) {
+  case Implementation::Scalar:
+    return "Scalar";
+  case Implementation::Sse41:
+    return "Sse41";
+  case Implementation::Avx2:
+    return "Avx2";
+  case Implementation::Avx512:
+    return "Avx512";
+  }
+  return "Unknown";
+}
@@ -0,0 +1,65 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// Test pattern ramp comparison class.
+/** A RampChecker object compares buffers of test pattern data against an
+    expected ramp of words, using the widest vector instructions the CPU
+    supports (selected at run time). Whole vectors are compared at once;
+    only a block containing a mismatch is inspected word by word. */
+
+class RampChecker {
+public:
+  enum class Implementation { Scalar, Sse41, Avx2, Avx512 };
+
+  /// The RampChecker constructor, using the best available implementation.
+  RampChecker() : RampChecker(best_implementation()) {}
+
+  /// The RampChecker constructor, using a given implementation (which has
+  /// to be available).
+  explicit RampChecker(Implementation implementation);
+
+  /// Compare 64-bit words against the ramp first, first + step, ...
+  /// Returns the index of the first mismatching word, or count if all
+  /// words match. If xor_sum is given, it receives the XOR of all words
+  /// (valid only if all words match).
+  size_t find_mismatch(const uint64_t* words,
+                       size_t count,
+                       uint64_t first,
+                       uint64_t step,
+                       uint64_t* xor_sum = nullptr) const {
+    return find_mismatch64_(words, count, first, step, xor_sum);
+  }
+
+  /// Compare 16-bit words against the ramp first, first + 1, ... Returns
+  /// the index of the first mismatching word, or count if all words match.
+  size_t find_mismatch(const uint16_t* words,
+                       size_t count,
+                       uint16_t first) const {
+    return find_mismatch16_(words, count, first);
+  }
+
+  /// Retrieve the selected implementation.
+  Implementation implementation() const { return implementation_; }
+
+  /// Check whether an implementation is supported by the CPU.
+  static bool is_available(Implementation implementation);
+
+  /// Retrieve the fastest implementation supported by the CPU.
+  static Implementation best_implementation();
+
+  static std::string to_string(Implementation implementation);
+
+private:
+  using FindMismatch64Function = size_t (*)(
+      const uint64_t*, size_t, uint64_t, uint64_t, uint64_t*);
+  using FindMismatch16Function = size_t (*)(const uint16_t*, size_t,
+                                            uint16_t);
+
+  Implementation implementation_;
+  FindMismatch64Function find_mismatch64_;
+  FindMismatch16Function find_mismatch16_;
+};
@@ -0,0 +1,50 @@
+// Copyright 2012-2013 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <boost/format.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Timeslice buffer fill level snapshot.
+/** The positions of a ReceiveBufferStatus object partition a compute
+    node's receive buffer into used (received, not yet acknowledged),
+    freeing (acknowledged, not yet reported to the sender) and free
+    space. */
+
+struct ReceiveBufferStatus {
+  std::chrono::system_clock::time_point time;
+  uint64_t size;
+
+  uint64_t cached_acked;
+  uint64_t acked;
+  uint64_t received;
+
+  int64_t used() const { return received - acked; }
+  int64_t freeing() const { return acked - cached_acked; }
+  int64_t unused() const { return cached_acked + size - received; }
+
+  float percentage(int64_t value) const {
+    return static_cast<float>(value) / static_cast<float>(size);
+  }
+
+  static std::string caption() { return std::string("used/freeing/free"); }
+
+  std::string percentage_str(int64_t value) const {
+    boost::format percent_fmt("%4.1f%%");
+    percent_fmt % (percentage(value) * 100);
+    std::string s = percent_fmt.str();
+    s.resize(4);
+    return s;
+  }
+
+  std::string percentages() const {
+    return percentage_str(used()) + " " + percentage_str(freeing()) + " " +
+           percentage_str(unused());
+  }
+
+  std::vector<int64_t> vector() const {
+    return std::vector<int64_t>{used(), freeing(), unused()};
+  }
+};
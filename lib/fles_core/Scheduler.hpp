@@ -54,6 +54,12 @@ public:
     }
   }
 
+  /// Time of the earliest pending event, or max() if there is none.
+  event::time_type next_event_time() const {
+    return event_queue_.empty() ? event::time_type::max()
+                                : event_queue_.top().when_;
+  }
+
 private:
   std::priority_queue<event, std::vector<event>, event_less> event_queue_;
 };
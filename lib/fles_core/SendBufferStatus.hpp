@@ -0,0 +1,67 @@
+// Copyright 2012-2013 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <boost/format.hpp>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Input buffer fill level snapshot.
+/** The positions of a SendBufferStatus object partition the input buffer
+    of a timeslice sender into used (written, not yet sent), sending (sent,
+    not yet acknowledged), freeing (acknowledged, not yet released to the
+    data source) and free space. */
+
+struct SendBufferStatus {
+  std::chrono::system_clock::time_point time;
+  uint64_t size;
+
+  uint64_t cached_acked;
+  uint64_t acked;
+  uint64_t sent;
+  uint64_t written;
+
+  int64_t used() const {
+    assert(sent <= written);
+    return written - sent;
+  }
+  int64_t sending() const {
+    assert(acked <= sent);
+    return sent - acked;
+  }
+  int64_t freeing() const {
+    assert(cached_acked <= acked);
+    return acked - cached_acked;
+  }
+  int64_t unused() const {
+    assert(written <= cached_acked + size);
+    return cached_acked + size - written;
+  }
+
+  float percentage(int64_t value) const {
+    return static_cast<float>(value) / static_cast<float>(size);
+  }
+
+  static std::string caption() {
+    return std::string("used/sending/freeing/free");
+  }
+
+  std::string percentage_str(int64_t value) const {
+    boost::format percent_fmt("%4.1f%%");
+    percent_fmt % (percentage(value) * 100);
+    std::string s = percent_fmt.str();
+    s.resize(4);
+    return s;
+  }
+
+  std::string percentages() const {
+    return percentage_str(used()) + " " + percentage_str(sending()) + " " +
+           percentage_str(freeing()) + " " + percentage_str(unused());
+  }
+
+  std::vector<int64_t> vector() const {
+    return std::vector<int64_t>{used(), sending(), freeing(), unused()};
+  }
+};
@@ -0,0 +1,73 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "SendBufferTracker.hpp"
+#include <algorithm>
+#include <cassert>
+
+SendBufferTracker::SendBufferTracker(InputBufferReadInterface& data_source,
+                                     uint32_t timeslice_size,
+                                     uint32_t parts)
+    : data_source_(data_source), timeslice_size_(timeslice_size),
+      parts_(parts), min_acked_({data_source.desc_buffer().size() / 4,
+                                 data_source.data_buffer().size() / 4}) {
+  assert(parts_ > 0);
+  start_index_ = sent_ = acked_ = cached_acked_ =
+      data_source_.get_read_index();
+
+  // all timeslices in the input buffer may be pending
+  ack_.alloc_with_size(
+      (data_source_.desc_buffer().size() / timeslice_size_ + 1) * parts_);
+}
+
+bool SendBufferTracker::acknowledge(uint64_t timeslice, uint32_t part) {
+  assert(part < parts_);
+  uint64_t acked_ts = ack_.acked() / parts_;
+  if (!ack_.acknowledge(timeslice * parts_ + part) ||
+      ack_.acked() / parts_ == acked_ts) {
+    return false;
+  }
+
+  // completion is for earliest pending timeslice, update indexes
+  acked_.desc = ack_.acked() / parts_ * timeslice_size_ + start_index_.desc;
+  const auto& last = data_source_.desc_buffer().at(acked_.desc - 1);
+  acked_.data = last.offset + last.size;
+  if (acked_.data >= cached_acked_.data + min_acked_.data ||
+      acked_.desc >= cached_acked_.desc + min_acked_.desc) {
+    cached_acked_ = acked_;
+    data_source_.set_read_index(cached_acked_);
+  }
+  return true;
+}
+
+void SendBufferTracker::sync_data_source() {
+  if (acked_.data > cached_acked_.data || acked_.desc > cached_acked_.desc) {
+    cached_acked_ = acked_;
+    data_source_.set_read_index(cached_acked_);
+  }
+}
+
+SendBufferStatus
+SendBufferTracker::status_desc(std::chrono::system_clock::time_point now) {
+  // if the data source's write index is lagging behind due to lazy
+  // updates, use the sent index instead
+  uint64_t written =
+      std::max(data_source_.get_write_index().desc, sent_.desc);
+  return SendBufferStatus{now,
+                          data_source_.desc_buffer().size(),
+                          cached_acked_.desc,
+                          acked_.desc,
+                          sent_.desc,
+                          written};
+}
+
+SendBufferStatus
+SendBufferTracker::status_data(std::chrono::system_clock::time_point now) {
+  uint64_t written =
+      std::max(data_source_.get_write_index().data, sent_.data);
+  return SendBufferStatus{now,
+                          data_source_.data_buffer().size(),
+                          cached_acked_.data,
+                          acked_.data,
+                          sent_.data,
+                          written};
+}
@@ -0,0 +1,89 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "AckRing.hpp"
+#include "DualRingBuffer.hpp"
+#include "SendBufferStatus.hpp"
+#include <chrono>
+#include <cstdint>
+
+/// Input buffer read position tracker class.
+/** A SendBufferTracker object keeps the read side positions of an input
+    buffer for a timeslice sender, independent of the transport. Sent
+    timeslice components may be acknowledged out of order; the read index
+    of the data source follows the last timeslice up to which all
+    components have been acknowledged. It is written to the data source
+    lazily, in steps of a quarter of the buffer, or on sync_data_source().
+
+    A transport that acknowledges each timeslice in several independent
+    parts (e.g., descriptors and data) declares this with parts. */
+
+class SendBufferTracker {
+public:
+  /// The SendBufferTracker constructor.
+  SendBufferTracker(InputBufferReadInterface& data_source,
+                    uint32_t timeslice_size,
+                    uint32_t parts = 1);
+
+  SendBufferTracker(const SendBufferTracker&) = delete;
+  void operator=(const SendBufferTracker&) = delete;
+
+  /// Record that the input buffer has been sent up to given indexes.
+  void mark_sent(DualIndex sent) { sent_ = sent; }
+
+  /// Acknowledge a part of a sent timeslice component. Returns true if the
+  /// number of acknowledged timeslices has advanced.
+  bool acknowledge(uint64_t timeslice, uint32_t part = 0);
+
+  /// Write the acknowledged read indexes to the data source.
+  void sync_data_source();
+
+  /// Retrieve the number of completely acknowledged timeslices.
+  uint64_t acked_timeslices() const { return ack_.acked() / parts_; }
+
+  /// Retrieve the read indexes at start of operation.
+  DualIndex start_index() const { return start_index_; }
+
+  /// Retrieve the indexes up to which the input buffer has been sent.
+  DualIndex sent() const { return sent_; }
+
+  /// Retrieve the indexes up to which sending has been acknowledged.
+  DualIndex acked() const { return acked_; }
+
+  /// Retrieve the read indexes last written to the data source.
+  DualIndex cached_acked() const { return cached_acked_; }
+
+  /// Retrieve a snapshot of the descriptor buffer fill level.
+  SendBufferStatus status_desc(std::chrono::system_clock::time_point now);
+
+  /// Retrieve a snapshot of the data buffer fill level.
+  SendBufferStatus status_data(std::chrono::system_clock::time_point now);
+
+private:
+  /// Data source (e.g., FLIB).
+  InputBufferReadInterface& data_source_;
+
+  /// Constant size (in microslices) of a timeslice component.
+  const uint32_t timeslice_size_;
+
+  /// Number of acknowledgments per timeslice.
+  const uint32_t parts_;
+
+  /// Hysteresis for writing read indexes to data source.
+  const DualIndex min_acked_;
+
+  /// Acknowledgment status of timeslice parts.
+  AckRing ack_;
+
+  /// Read indexes at start of operation.
+  DualIndex start_index_;
+
+  /// Indexes up to which the input buffer has been sent.
+  DualIndex sent_;
+
+  /// Indexes of acknowledged microslices (i.e., read indexes).
+  DualIndex acked_;
+
+  /// Read indexes last written to data source.
+  DualIndex cached_acked_;
+};
@@ -12,44 +12,32 @@ TimesliceAnalyzer::TimesliceAnalyzer(uint64_t arg_output_interval,
                                      std::string arg_output_prefix,
                                      std::ostream* arg_hist)
     : output_interval_(arg_output_interval), out_(arg_out),
-      output_prefix_(std::move(arg_output_prefix)), hist_(arg_hist) {
-  // create CRC-32C engine (Castagnoli polynomial)
-  crc32_engine_ = crcutil_interface::CRC::Create(
-      0x82f63b78, 0, 32, true, 0, 0, 0,
-      crcutil_interface::CRC::IsSSE42Available(), NULL);
-}
-
-TimesliceAnalyzer::~TimesliceAnalyzer() {
-  if (crc32_engine_ != nullptr) {
-    crc32_engine_->Delete();
+      output_prefix_(std::move(arg_output_prefix)), hist_(arg_hist) {}
+
+TimesliceAnalyzer::~TimesliceAnalyzer() = default;
+
+void TimesliceAnalyzer::compute_crcs(const fles::Timeslice& ts,
+                                     size_t component) {
+  const size_t count = ts.num_microslices(component);
+  crc_data_.resize(count);
+  crc_sizes_.resize(count);
+  crcs_.resize(count);
+  for (size_t m = 0; m < count; ++m) {
+    fles::MicrosliceView ms = ts.get_microslice(component, m);
+    bool crc_valid =
+        (ms.desc().flags &
+         static_cast<uint16_t>(fles::MicrosliceFlags::CrcValid)) != 0;
+    crc_data_[m] = ms.content();
+    crc_sizes_[m] = crc_valid ? ms.desc().size : 0;
   }
-}
-
-uint32_t TimesliceAnalyzer::compute_crc(const fles::MicrosliceView& m) const {
-  assert(crc32_engine_);
-
-  crcutil_interface::UINT64 crc64 = 0;
-  crc32_engine_->Compute(m.content(), m.desc().size, &crc64);
-
-  return static_cast<uint32_t>(crc64);
-}
-
-bool TimesliceAnalyzer::check_crc(const fles::MicrosliceView& m) const {
-  return compute_crc(m) == m.desc().crc;
+  crc32_engine_.compute_batch(count, crc_data_.data(), crc_sizes_.data(),
+                              crcs_.data());
 }
 
 bool TimesliceAnalyzer::check_microslice(const fles::MicrosliceView& m,
                                          size_t component,
-                                         size_t microslice) {
-// disabled, not applicable when using start time instead of index
-#if 0
-    if (m.desc().idx != microslice) {
-        out_ << "microslice index " << m.desc().idx << " found in m.desc() "
-             << microslice << std::endl;
-        return false;
-    }
-#endif
-
+                                         size_t microslice,
+                                         uint32_t crc) {
   ++microslice_count_;
   content_bytes_ += m.desc().size;
 
@@ -66,7 +54,7 @@ bool TimesliceAnalyzer::check_microslice(const fles::MicrosliceView& m,
   bool crc_error =
       ((m.desc().flags &
         static_cast<uint16_t>(fles::MicrosliceFlags::CrcValid)) != 0) &&
-      !check_crc(m);
+      crc != m.desc().crc;
   if (crc_error) {
     out_ << "crc failure in microslice " << microslice << std::endl;
   }
@@ -88,6 +76,7 @@ bool TimesliceAnalyzer::check_microslice(const fles::MicrosliceView& m,
 void TimesliceAnalyzer::initialize(const fles::Timeslice& ts) {
   reference_descriptors_.clear();
   pattern_checkers_.clear();
+  index_checkers_.assign(ts.num_components(), MicrosliceIndexChecker());
   for (size_t c = 0; c < ts.num_components(); ++c) {
     assert(ts.num_microslices(c) > 0);
     fles::MicrosliceDescriptor desc = ts.get_microslice(c, 0).desc();
@@ -110,6 +99,7 @@ bool TimesliceAnalyzer::check_timeslice(const fles::Timeslice& ts) {
     return false;
   }
 
+  bool index_error = false;
   uint64_t first_component_start_time = 0;
   if (ts.num_microslices(0) != 0) {
     first_component_start_time = ts.get_microslice(0, 0).desc().idx;
@@ -134,12 +124,21 @@ bool TimesliceAnalyzer::check_timeslice(const fles::Timeslice& ts) {
       assert(false);
       return false;
     }
+    // check index continuity of component
+    if (c < index_checkers_.size() && !index_checkers_[c].check(ts, c)) {
+      out_ << "index discontinuity in timeslice " << ts.index()
+           << ", component " << c << ": " << index_checkers_[c].error()
+           << std::endl;
+      index_error = true;
+    }
     // checke all microslices of component
     pattern_checkers_.at(c)->reset();
+    compute_crcs(ts, c);
     for (size_t m = 0; m < ts.num_microslices(c); ++m) {
       bool success =
           check_microslice(ts.get_microslice(c, m), c,
-                           ts.index() * ts.num_core_microslices() + m);
+                           ts.index() * ts.num_core_microslices() + m,
+                           crcs_[m]);
       if (!success) {
         out_ << "pattern error in timeslice " << ts.index() << ", microslice "
              << m << ", component " << c << std::endl;
@@ -155,6 +154,10 @@ bool TimesliceAnalyzer::check_timeslice(const fles::Timeslice& ts) {
       }
     }
   }
+  if (index_error) {
+    ++timeslice_error_count_;
+    return false;
+  }
   return true;
 }
 
@@ -167,6 +170,13 @@ std::string TimesliceAnalyzer::statistics() const {
   if (timeslice_error_count_ > 0) {
     s << " [" << timeslice_error_count_ << " errors]";
   }
+  for (size_t c = 0; c < index_checkers_.size(); ++c) {
+    if (index_checkers_[c].has_errors()) {
+      s << "\n"
+        << output_prefix_ << "component " << c
+        << " index: " << index_checkers_[c].report();
+    }
+  }
   return s.str();
 }
 
@@ -1,13 +1,15 @@
 // Copyright 2013, 2015 Jan de Cuveland <cmail@cuveland.de>
 #pragma once
 
+#include "Crc32cEngine.hpp"
 #include "MicrosliceDescriptor.hpp"
+#include "MicrosliceIndexChecker.hpp"
 #include "Sink.hpp"
 #include "Timeslice.hpp"
-#include "interface.h" // crcutil_interface
 #include <memory>
 #include <ostream>
 #include <string>
+#include <vector>
 
 class PatternChecker;
 
@@ -30,20 +32,27 @@ private:
     content_bytes_ = 0;
   }
 
-  uint32_t compute_crc(const fles::MicrosliceView& m) const;
-
-  bool check_crc(const fles::MicrosliceView& m) const;
+  /// Compute the CRCs of all microslices of a component that carry a
+  /// valid CRC value (in a single batch).
+  void compute_crcs(const fles::Timeslice& ts, size_t component);
 
   bool check_microslice(const fles::MicrosliceView& m,
                         size_t component,
-                        size_t microslice);
+                        size_t microslice,
+                        uint32_t crc);
 
   void initialize(const fles::Timeslice& ts);
 
-  crcutil_interface::CRC* crc32_engine_ = nullptr;
+  Crc32cEngine crc32_engine_;
+
+  /// Buffers of the batched CRC computation, reused across components.
+  std::vector<const void*> crc_data_;
+  std::vector<size_t> crc_sizes_;
+  std::vector<uint32_t> crcs_;
 
   std::vector<fles::MicrosliceDescriptor> reference_descriptors_;
   std::vector<std::unique_ptr<PatternChecker>> pattern_checkers_;
+  std::vector<MicrosliceIndexChecker> index_checkers_;
 
   uint64_t output_interval_ = UINT64_MAX;
   std::ostream& out_;
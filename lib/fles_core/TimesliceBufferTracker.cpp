@@ -0,0 +1,38 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "TimesliceBufferTracker.hpp"
+#include "TimesliceCompletion.hpp"
+#include "TimesliceWorkItem.hpp"
+
+TimesliceBufferTracker::TimesliceBufferTracker(
+    TimesliceBuffer& timeslice_buffer,
+    uint32_t timeslice_size,
+    LatencyTracer& latency_tracer,
+    bool drop)
+    : timeslice_buffer_(timeslice_buffer), timeslice_size_(timeslice_size),
+      latency_tracer_(latency_tracer), drop_(drop),
+      ack_(timeslice_buffer.get_desc_size_exp()) {}
+
+void TimesliceBufferTracker::dispatch(uint64_t ts_index) {
+  uint64_t tpos = dispatched_++;
+  if (drop_) {
+    timeslice_buffer_.send_completion({tpos});
+    return;
+  }
+  latency_tracer_.mark(tpos, LatencyTracer::dispatched);
+  timeslice_buffer_.send_work_item(
+      {{ts_index, tpos, timeslice_size_,
+        timeslice_buffer_.get_num_input_nodes()},
+       timeslice_buffer_.get_data_size_exp(),
+       timeslice_buffer_.get_desc_size_exp()});
+}
+
+bool TimesliceBufferTracker::poll_completion() {
+  fles::TimesliceCompletion c;
+  if (!timeslice_buffer_.try_receive_completion(c)) {
+    return false;
+  }
+  latency_tracer_.mark(c.ts_pos, LatencyTracer::completed);
+  ack_.acknowledge(c.ts_pos);
+  return true;
+}
@@ -0,0 +1,60 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "AckRing.hpp"
+#include "LatencyTracer.hpp"
+#include "TimesliceBuffer.hpp"
+#include <cstdint>
+
+/// Timeslice buffer position tracker class.
+/** A TimesliceBufferTracker object hands the timeslices that have been
+    completely received to a compute node's timeslice buffer to the
+    timeslice processors, and collects their completions, which may arrive
+    out of order. It is shared by all transports; the transport decides
+    when a timeslice is complete and passes the acknowledged position on
+    to its input nodes. */
+
+class TimesliceBufferTracker {
+public:
+  /// The TimesliceBufferTracker constructor.
+  TimesliceBufferTracker(TimesliceBuffer& timeslice_buffer,
+                         uint32_t timeslice_size,
+                         LatencyTracer& latency_tracer,
+                         bool drop = false);
+
+  TimesliceBufferTracker(const TimesliceBufferTracker&) = delete;
+  void operator=(const TimesliceBufferTracker&) = delete;
+
+  /// Hand the timeslice at buffer position dispatched() to the
+  /// processors (or complete it right away if dropping).
+  void dispatch(uint64_t ts_index);
+
+  /// Handle a pending timeslice completion. Returns false if there was
+  /// none.
+  bool poll_completion();
+
+  /// Retrieve the number of dispatched timeslices.
+  uint64_t dispatched() const { return dispatched_; }
+
+  /// Retrieve the number of completely acknowledged timeslices.
+  uint64_t acked() const { return ack_.acked(); }
+
+private:
+  /// Shared memory buffer to store received timeslices.
+  TimesliceBuffer& timeslice_buffer_;
+
+  /// Constant size (in microslices) of a timeslice component.
+  const uint32_t timeslice_size_;
+
+  /// Sampled latencies of the timeslice building stages.
+  LatencyTracer& latency_tracer_;
+
+  /// Flag whether timeslices are dropped instead of processed.
+  const bool drop_;
+
+  /// Number of dispatched timeslices.
+  uint64_t dispatched_ = 0;
+
+  /// Acknowledgment status of dispatched timeslices.
+  AckRing ack_;
+};
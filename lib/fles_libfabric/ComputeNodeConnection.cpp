@@ -60,7 +60,7 @@ ComputeNodeConnection::ComputeNodeConnection(
     connection_oriented_ = false;
   }
 
-  //  setup anonymous endpoint
+  //  setup anonymous endpoint and its memory regions
   make_endpoint(Provider::getInst()->get_info(), "", "", pd, cq, av);
 }
 
@@ -118,23 +118,26 @@ void ComputeNodeConnection::setup_mr(struct fid_domain* pd) {
   std::size_t data_bytes = UINT64_C(1) << data_buffer_size_exp_;
   std::size_t desc_bytes = (UINT64_C(1) << desc_buffer_size_exp_) *
                            sizeof(fles::TimesliceComponentDescriptor);
-  int res = fi_mr_reg(pd, data_ptr_, data_bytes, FI_WRITE | FI_REMOTE_WRITE, 0,
-                      Provider::requested_key++, 0, &mr_data_, nullptr);
-  if (res != 0) {
-    L_(fatal) << "fi_mr_reg failed for data_ptr: " << res << "="
-              << fi_strerror(-res);
-    throw LibfabricException("fi_mr_reg failed for data_ptr");
-  }
-  res = fi_mr_reg(pd, desc_ptr_, desc_bytes, FI_WRITE | FI_REMOTE_WRITE, 0,
-                  Provider::requested_key++, 0, &mr_desc_, nullptr);
-  if (res != 0) {
-    L_(fatal) << "fi_mr_reg failed for desc_ptr: " << res << "="
-              << fi_strerror(-res);
-    throw LibfabricException("fi_mr_reg failed for desc_ptr");
-  }
-  res = fi_mr_reg(pd, &send_status_message_, sizeof(ComputeNodeStatusMessage),
-                  FI_SEND | FI_TAGGED, 0, Provider::requested_key++, 0,
-                  &mr_send_, nullptr);
+  // the buffers are registered once per domain and reused on reconnect
+  if (data_region_ == nullptr) {
+    data_region_ = LibfabricMRCache::getInst()->register_buffer(
+        pd, data_ptr_, data_bytes, FI_WRITE | FI_REMOTE_WRITE, ep_);
+  }
+  if (desc_region_ == nullptr) {
+    desc_region_ = LibfabricMRCache::getInst()->register_buffer(
+        pd, desc_ptr_, desc_bytes, FI_WRITE | FI_REMOTE_WRITE, ep_);
+  }
+  // the input node writes to each chunk of the data buffer with its own key
+  if (data_region_->chunk_count() > MAX_DATA_CHUNKS) {
+    L_(fatal) << "compute data buffer is registered in "
+              << data_region_->chunk_count() << " memory regions, at most "
+              << MAX_DATA_CHUNKS << " are supported";
+    throw LibfabricException("compute buffer registration has too many chunks");
+  }
+  int res =
+      fi_mr_reg(pd, &send_status_message_, sizeof(ComputeNodeStatusMessage),
+                FI_SEND | FI_TAGGED, 0, Provider::requested_key++, 0,
+                &mr_send_, nullptr);
   if (res != 0) {
     L_(fatal) << "fi_mr_reg failed for send: " << res << "="
               << fi_strerror(-res);
@@ -149,22 +152,39 @@ void ComputeNodeConnection::setup_mr(struct fid_domain* pd) {
     throw LibfabricException("fi_mr_reg failed for recv");
   }
 
-  if ((mr_data_ == nullptr) || (mr_desc_ == nullptr) || (mr_recv_ == nullptr) ||
-      (mr_send_ == nullptr)) {
+  if ((mr_recv_ == nullptr) || (mr_send_ == nullptr)) {
     throw LibfabricException(
         "registration of memory region failed in ComputeNodeConnection");
   }
+  LibfabricMRCache::bind_to_endpoint(mr_send_, ep_);
+  LibfabricMRCache::bind_to_endpoint(mr_recv_, ep_);
 
-  send_status_message_.info.data.addr = reinterpret_cast<uintptr_t>(data_ptr_);
-  send_status_message_.info.data.rkey = fi_mr_key(mr_data_);
-  send_status_message_.info.desc.addr = reinterpret_cast<uintptr_t>(desc_ptr_);
-  send_status_message_.info.desc.rkey = fi_mr_key(mr_desc_);
-  send_status_message_.info.index = remote_index_;
-  send_status_message_.info.data_buffer_size_exp = data_buffer_size_exp_;
-  send_status_message_.info.desc_buffer_size_exp = desc_buffer_size_exp_;
+  fill_buffer_info(send_status_message_.info);
+  fill_data_chunk_info(send_status_message_.data_chunks);
   send_status_message_.connect = false;
 }
 
+void ComputeNodeConnection::fill_buffer_info(ComputeNodeInfo& info) const {
+  info.data.addr = data_region_->remote_addr(data_ptr_);
+  info.data.rkey = data_region_->key(data_ptr_);
+  info.desc.addr = desc_region_->remote_addr(desc_ptr_);
+  info.desc.rkey = desc_region_->key(desc_ptr_);
+  info.index = remote_index_;
+  info.data_buffer_size_exp = data_buffer_size_exp_;
+  info.desc_buffer_size_exp = desc_buffer_size_exp_;
+  info.data_chunk_count = static_cast<uint32_t>(data_region_->chunk_count());
+}
+
+void ComputeNodeConnection::fill_data_chunk_info(DataChunkInfo& chunks) const {
+  chunks = DataChunkInfo();
+  chunks.chunk_size = data_region_->chunk_size();
+  for (size_t i = 0; i < data_region_->chunk_count(); ++i) {
+    const uint8_t* chunk = data_ptr_ + i * chunks.chunk_size;
+    chunks.chunk[i].addr = data_region_->remote_addr(chunk);
+    chunks.chunk[i].rkey = data_region_->key(chunk);
+  }
+}
+
 void ComputeNodeConnection::setup() {
   LibfabricBarrier::get_instance()->add_endpoint(
       index_, Provider::getInst()->get_info(), "", false);
@@ -211,6 +231,11 @@ void ComputeNodeConnection::setup() {
 
 void ComputeNodeConnection::on_established(struct fi_eq_cm_entry* event) {
   Connection::on_established(event);
+  // the input node learns the keys of further data buffer chunks from the
+  // first status message
+  if (data_region_->chunk_count() > 1) {
+    data_changed_ = true;
+  }
 
   L_(debug) << "[c" << remote_index_ << "] "
             << "remote index: " << remote_info_.index;
@@ -232,17 +257,15 @@ void ComputeNodeConnection::on_disconnected(struct fi_eq_cm_entry* event) {
     fi_close((struct fid*)mr_send_);
     mr_send_ = nullptr;
   }
+#pragma GCC diagnostic pop
 
-  if (mr_desc_ != nullptr) {
-    fi_close((struct fid*)mr_desc_);
-    mr_desc_ = nullptr;
-  }
-
-  if (mr_data_ != nullptr) {
-    fi_close((struct fid*)mr_data_);
-    mr_data_ = nullptr;
+  // buffer registrations stay cached for a reconnect unless they are bound
+  // to the endpoint being closed
+  if (LibfabricMRCache::endpoint_bound()) {
+    LibfabricMRCache::getInst()->release(data_region_);
+    LibfabricMRCache::getInst()->release(desc_region_);
+    data_region_ = desc_region_ = nullptr;
   }
-#pragma GCC diagnostic pop
 
   Connection::on_disconnected(event);
 }
@@ -303,7 +326,9 @@ void ComputeNodeConnection::on_complete_recv() {
   sync_after_scheduler_decision_received();
   write_received_descriptors();
 
-  // TODO DDSchedulerOrchestrator::log_heartbeat(index_);
+  // status messages double as heartbeats
+  if (!DDSchedulerOrchestrator::is_connection_timed_out(index_))
+    DDSchedulerOrchestrator::log_heartbeat(index_);
   post_recv_status_message();
 }
 
@@ -366,13 +391,7 @@ ComputeNodeConnection::get_private_data() {
 
   ComputeNodeInfo* cn_info =
       reinterpret_cast<ComputeNodeInfo*>(private_data->data());
-  cn_info->data.addr = reinterpret_cast<uintptr_t>(data_ptr_);
-  cn_info->data.rkey = fi_mr_key(mr_data_);
-  cn_info->desc.addr = reinterpret_cast<uintptr_t>(desc_ptr_);
-  cn_info->desc.rkey = fi_mr_key(mr_desc_);
-  cn_info->index = remote_index_;
-  cn_info->data_buffer_size_exp = data_buffer_size_exp_;
-  cn_info->desc_buffer_size_exp = desc_buffer_size_exp_;
+  fill_buffer_info(*cn_info);
 
   return private_data;
 }
@@ -462,6 +481,8 @@ void ComputeNodeConnection::on_complete_heartbeat_recv() {
 void ComputeNodeConnection::on_complete_dfs_recv() {
   if (final_msg_sent_)
     return;
+  if (!DDSchedulerOrchestrator::is_connection_timed_out(index_))
+    DDSchedulerOrchestrator::log_heartbeat(index_);
   if (false) {
     std::stringstream cn_blockage, in_blockage, msg_latency, rdma_latency;
     for (uint32_t i = 0;
@@ -576,6 +597,16 @@ void ComputeNodeConnection::prepare_DFS_LB_message() {
                         dfs_DDS_message_.load_distribution,
                         dfs_DDS_message_.proposed_interval_metadata
                             .compute_node_count);
+    } else if (DDSchedulerOrchestrator::is_standby()) {
+      // a joined compute node only reports its statistics to be considered
+      // by the load balancing of the other compute nodes
+      const ComputeIntervalMetaDataStatistics* statistics =
+          DDSchedulerOrchestrator::get_actual_meta_data_statistics(
+              dfs_IE_message_.actual_interval_metadata.interval_index);
+      if (statistics == nullptr)
+        return;
+      dfs_DDS_message_.last_completed_statistics = *statistics;
+      dfs_DDS_message_.statistics_only = true;
     }
     post_send_dfs_message();
   }
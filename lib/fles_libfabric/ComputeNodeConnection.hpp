@@ -8,11 +8,12 @@
 #include "Connection.hpp"
 #include "InputChannelStatusMessage.hpp"
 #include "InputNodeInfo.hpp"
+#include "ReceiveBufferStatus.hpp"
 #include "RequestIdentifier.hpp"
 #include "TimesliceComponentDescriptor.hpp"
 #include "dfs/controller/DDSchedulerOrchestrator.hpp"
+#include "providers/LibfabricMRCache.hpp"
 
-#include <boost/format.hpp>
 #include <cmath>
 #include <rdma/fi_cm.h>
 
@@ -105,54 +106,18 @@ public:
 
   std::unique_ptr<std::vector<uint8_t>> get_private_data() override;
 
-  struct BufferStatus {
-    std::chrono::system_clock::time_point time;
-    uint64_t size;
-
-    uint64_t cached_acked;
-    uint64_t acked;
-    uint64_t received;
-
-    int64_t used() const { return received - acked; }
-    int64_t freeing() const { return acked - cached_acked; }
-    int64_t unused() const { return cached_acked + size - received; }
-
-    float percentage(int64_t value) const {
-      return static_cast<float>(value) / static_cast<float>(size);
-    }
-
-    std::string caption() const { return std::string("used/freeing/free"); }
-
-    std::string percentage_str(int64_t value) const {
-      boost::format percent_fmt("%4.1f%%");
-      percent_fmt % (percentage(value) * 100);
-      std::string s = percent_fmt.str();
-      s.resize(4);
-      return s;
-    }
-
-    std::string percentages() const {
-      return percentage_str(used()) + " " + percentage_str(freeing()) + " " +
-             percentage_str(unused());
-    }
-
-    std::vector<int64_t> vector() const {
-      return std::vector<int64_t>{used(), freeing(), unused()};
-    }
-  };
-
-  BufferStatus buffer_status_data() const {
-    return BufferStatus{std::chrono::system_clock::now(),
-                        (UINT64_C(1) << data_buffer_size_exp_),
-                        send_status_message_.ack.data, cn_ack_.data,
-                        cn_wp_.data};
+  ReceiveBufferStatus buffer_status_data() const {
+    return ReceiveBufferStatus{std::chrono::system_clock::now(),
+                               (UINT64_C(1) << data_buffer_size_exp_),
+                               send_status_message_.ack.data, cn_ack_.data,
+                               cn_wp_.data};
   }
 
-  BufferStatus buffer_status_desc() const {
-    return BufferStatus{std::chrono::system_clock::now(),
-                        (UINT64_C(1) << desc_buffer_size_exp_),
-                        send_status_message_.ack.desc, cn_ack_.desc,
-                        cn_wp_.desc};
+  ReceiveBufferStatus buffer_status_desc() const {
+    return ReceiveBufferStatus{std::chrono::system_clock::now(),
+                               (UINT64_C(1) << desc_buffer_size_exp_),
+                               send_status_message_.ack.desc, cn_ack_.desc,
+                               cn_wp_.desc};
   }
 
   void set_partner_addr(fi_addr_t addr);
@@ -173,6 +138,12 @@ private:
 
   void update_scheduler_interval_data();
 
+  /// Describe the registered buffers for the remote input node
+  void fill_buffer_info(ComputeNodeInfo& info) const;
+
+  /// Describe the memory regions of the data buffer for the remote input node
+  void fill_data_chunk_info(DataChunkInfo& chunks) const;
+
   void prepare_DFS_LB_message() override;
 
   ComputeNodeStatusMessage send_status_message_ = ComputeNodeStatusMessage();
@@ -181,8 +152,8 @@ private:
   InputChannelStatusMessage recv_status_message_ = InputChannelStatusMessage();
   ComputeNodeBufferPosition cn_wp_ = ComputeNodeBufferPosition();
 
-  struct fid_mr* mr_data_ = nullptr;
-  struct fid_mr* mr_desc_ = nullptr;
+  const LibfabricMemoryRegion* data_region_ = nullptr;
+  const LibfabricMemoryRegion* desc_region_ = nullptr;
   struct fid_mr* mr_send_ = nullptr;
   struct fid_mr* mr_recv_ = nullptr;
 
@@ -14,12 +14,23 @@ struct BufferInfo {
   uint64_t rkey; ///< Target remote access key
 };
 
+/// Maximum number of memory regions a compute data buffer is registered in.
+constexpr uint32_t MAX_DATA_CHUNKS = 8;
+
 struct ComputeNodeInfo {
-  BufferInfo data;
+  BufferInfo data; ///< First (or only) memory region of the data buffer
   BufferInfo desc;
   uint32_t index;
   uint32_t data_buffer_size_exp;
   uint32_t desc_buffer_size_exp;
+  uint32_t data_chunk_count; ///< Memory regions of the data buffer
+};
+
+/// Memory regions of a data buffer registered in several chunks. Sent with
+/// the status messages, as it exceeds the connection private data.
+struct DataChunkInfo {
+  uint64_t chunk_size;               ///< Bytes per memory region
+  BufferInfo chunk[MAX_DATA_CHUNKS]; ///< Start of each memory region
 };
 } // namespace tl_libfabric
 #pragma pack()
@@ -21,6 +21,7 @@ struct ComputeNodeStatusMessage {
   //
   bool connect;
   ComputeNodeInfo info;
+  DataChunkInfo data_chunks;
   // address must be not null if connect = true
   unsigned char my_address[64];
 };
@@ -89,13 +89,14 @@ void Connection::connect(const std::string& hostname,
     }
   }
 #pragma GCC diagnostic pop
+  // memory regions are bound to the endpoint before it is enabled
+  setup_mr(domain);
   err = fi_enable(ep_);
   if (err != 0) {
     L_(fatal) << "fi_enable failed: " << err << "=" << fi_strerror(-err);
     throw LibfabricException("fi_enable failed");
   }
 
-  setup_mr(domain);
   Provider::getInst()->connect(ep_, max_send_wr_, max_send_sge_, max_recv_wr_,
                                max_recv_sge_, max_inline_data_,
                                private_data->data(), private_data->size(),
@@ -227,6 +228,8 @@ void Connection::make_endpoint(struct fi_info* info,
     }
   }
 #pragma GCC diagnostic pop
+  // memory regions are bound to the endpoint before it is enabled
+  setup_mr(pd);
   err = fi_enable(ep_);
   if (err != 0) {
     L_(fatal) << "fi_enable failed: " << err << "=" << fi_strerror(-err);
@@ -311,6 +314,9 @@ void Connection::setup_heartbeat_mr(struct fid_domain* pd) {
   if (mr_heartbeat_send_ == nullptr)
     throw LibfabricException(
         "registration of memory region failed in Connection2");
+
+  LibfabricMRCache::bind_to_endpoint(mr_heartbeat_recv_, ep_);
+  LibfabricMRCache::bind_to_endpoint(mr_heartbeat_send_, ep_);
 }
 
 void Connection::setup_dfs() {
@@ -410,6 +416,9 @@ void Connection::setup_dfs_mr(struct fid_domain* pd) {
   if (mr_dfs_send_ == nullptr)
     throw LibfabricException(
         "registration of memory region failed in Connection2");
+
+  LibfabricMRCache::bind_to_endpoint(mr_dfs_recv_, ep_);
+  LibfabricMRCache::bind_to_endpoint(mr_dfs_send_, ep_);
 }
 
 void Connection::post_recv_heartbeat_message() {
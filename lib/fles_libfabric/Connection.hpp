@@ -15,6 +15,7 @@
 #include "providers/LibfabricBarrier.hpp"
 #include "providers/LibfabricContextPool.hpp"
 #include "providers/LibfabricException.hpp"
+#include "providers/LibfabricMRCache.hpp"
 #include "providers/Provider.hpp"
 
 #include <rdma/fi_cm.h>
@@ -130,6 +131,9 @@ public:
   /// Retrieve index of this connection in the remote connection group.
   uint_fast16_t remote_index() const { return remote_index_; }
 
+  /// Retrieve the libfabric endpoint of this connection.
+  struct fid_ep* endpoint() const { return ep_; }
+
   bool done() const { return done_; }
 
   void mark_done() { done_ = true; }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "ConnectionGroupWorker.hpp"
+#include "Metrics.hpp"
 #include "RequestIdentifier.hpp"
 #include "dfs/controller/SchedulerOrchestrator.hpp"
 #include "log.hpp"
@@ -18,10 +19,14 @@
 #include <rdma/fi_errno.h>
 #include <set>
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <chrono>
 #include <fstream>
 #include <functional>
 
+#include <poll.h>
 #include <sys/uio.h>
 
 namespace tl_libfabric {
@@ -47,6 +52,7 @@ public:
       throw LibfabricException("fi_eq_open failed");
     }
     cqs_.resize(MAX_CQ_INSTANCE);
+    cq_fds_.resize(MAX_CQ_INSTANCE, -1);
   }
 
   ConnectionGroup(const ConnectionGroup&) = delete;
@@ -129,9 +135,14 @@ public:
   }
 
   /// The Libfabric completion notification handler.
-  int poll_completion() {
-    // TODO detect the number of messages that we are waiting for
-    const int ne_max = conn_.size() * conn_.size() * 1000;
+  int poll_completion() { return poll_completion(0, 1); }
+
+  /// The Libfabric completion notification handler for a subset of the
+  /// completion queues (every cq_stride-th queue starting at first_cq).
+  int poll_completion(uint16_t first_cq, uint16_t cq_stride) {
+    // a fixed batch per queue keeps the entries on the stack of the polling
+    // thread; the remaining completions are read by the next call
+    constexpr int ne_max = 256;
 
     struct fi_cq_tagged_entry wc[ne_max];
     int ne;
@@ -140,7 +151,7 @@ public:
     agg_CQ_count_++;
     std::chrono::high_resolution_clock::time_point start, end;
 
-    for (uint16_t i = 0; i < MAX_CQ_INSTANCE; i++) {
+    for (uint16_t i = first_cq; i < MAX_CQ_INSTANCE; i += cq_stride) {
       start = std::chrono::high_resolution_clock::now();
       ne = fi_cq_read(cqs_[i], wc, ne_max);
       if (ne != 0) {
@@ -151,6 +162,7 @@ public:
             std::chrono::duration_cast<std::chrono::microseconds>(end - start)
                 .count();
         agg_CQ_time_ += diff;
+        cq_read_time_metric_.add(diff);
         /// END OF LOGGING
         if (ne == -FI_EAVAIL) { // error available
           struct fi_cq_err_entry err;
@@ -208,9 +220,57 @@ public:
       }
     }
 
+    cq_polls_metric_.add();
+    if (ne_total > 0) {
+      cq_completions_metric_.add(static_cast<uint64_t>(ne_total));
+      cq_batch_metric_.record(static_cast<uint64_t>(ne_total));
+    }
+
     return ne_total;
   }
 
+  /// Block until a completion arrives on the queues polled by
+  /// poll_completion(first_cq, cq_stride) or event_fd becomes readable, at
+  /// most for the given timeout. Queues without a wait object are only
+  /// waited for up to unsignalled_wait_max_.
+  void wait_completion(uint16_t first_cq,
+                       uint16_t cq_stride,
+                       int event_fd,
+                       std::chrono::microseconds timeout) {
+    std::vector<struct fid*> fids;
+    std::vector<struct pollfd> fds;
+    for (uint16_t i = first_cq; i < MAX_CQ_INSTANCE; i += cq_stride) {
+      fids.push_back(&cqs_[i]->fid);
+      fds.push_back({cq_fds_[i], POLLIN, 0});
+    }
+    bool signalled =
+        !fids.empty() && std::all_of(fds.begin(), fds.end(),
+                                     [](const pollfd& p) { return p.fd >= 0; });
+    if (signalled) {
+      // fi_trywait re-arms the wait objects, or reports pending completions
+      int res = fi_trywait(Provider::getInst()->get_fabric(), fids.data(),
+                           static_cast<int>(fids.size()));
+      if (res == -FI_EAGAIN) {
+        return;
+      }
+      signalled = (res == 0);
+    }
+    if (!signalled) {
+      fds.clear();
+      timeout = std::min(timeout, unsignalled_wait_max_);
+    }
+    if (event_fd >= 0) {
+      fds.push_back({event_fd, POLLIN, 0});
+    }
+
+    struct timespec ts;
+    ts.tv_sec = timeout.count() / 1000000;
+    ts.tv_nsec = (timeout.count() % 1000000) * 1000;
+    if (ppoll(fds.data(), fds.size(), &ts, nullptr) < 0 && errno != EINTR) {
+      throw LibfabricException("ppoll failed");
+    }
+  }
+
   /// Retrieve the InfiniBand completion queue.
   struct fid_cq* completion_queue(uint32_t conn_index) const {
     return cqs_[conn_index % MAX_CQ_INSTANCE];
@@ -238,9 +298,10 @@ public:
              << " sent in " << runtime / 1000000. << " s (" << rate << " MB/s)";
     L_(info) << "summary: Agg. bytes of sync messages "
              << human_readable_count(aggregate_sync_bytes_sent_);
-    L_(info) << "summary: Agg. CQ retrieving time " << agg_CQ_time_ / 1000000.
-             << " s and processing time " << agg_CQ_COMP_time_ / 1000000.
-             << " s in " << agg_CQ_count_ << " calls";
+    L_(info) << "summary: Agg. CQ retrieving time "
+             << agg_CQ_time_.load() / 1000000. << " s and processing time "
+             << agg_CQ_COMP_time_.load() / 1000000. << " s in "
+             << agg_CQ_count_.load() << " calls";
   }
 
   /// The "main" function of an ConnectionGroup decendant.
@@ -305,16 +366,29 @@ protected:
       cq_attr.flags = 0;
       // cq_attr.format = FI_CQ_FORMAT_CONTEXT;
       cq_attr.format = FI_CQ_FORMAT_TAGGED;
-      cq_attr.wait_obj = FI_WAIT_NONE;
+      cq_attr.wait_obj = cq_wait_fd_ ? FI_WAIT_FD : FI_WAIT_NONE;
       cq_attr.signaling_vector = Provider::vector++; // ??
       cq_attr.wait_cond = FI_CQ_COND_NONE;
       cq_attr.wait_set = nullptr;
       res = fi_cq_open(pd_, &cq_attr, &cqs_[i], nullptr);
+      if (!cqs_[i] && cq_wait_fd_) {
+        // not every provider supports file descriptor wait objects
+        L_(warning) << "fi_cq_open[" << i << "] with FI_WAIT_FD failed: "
+                    << -res << "=" << fi_strerror(-res) << ", polling instead";
+        cq_wait_fd_ = false;
+        cq_attr.wait_obj = FI_WAIT_NONE;
+        res = fi_cq_open(pd_, &cq_attr, &cqs_[i], nullptr);
+      }
       if (!cqs_[i]) {
         L_(fatal) << "fi_cq_open[" << i << "] failed: " << -res << "="
                   << fi_strerror(-res);
         throw LibfabricException("fi_cq_open failed");
       }
+      cq_fds_[i] = -1;
+      if (cq_attr.wait_obj == FI_WAIT_FD &&
+          fi_control(&cqs_[i]->fid, FI_GETWAIT, &cq_fds_[i]) != 0) {
+        cq_fds_[i] = -1;
+      }
     }
 
     if (Provider::getInst()->has_av()) {
@@ -372,6 +446,16 @@ protected:
   /// Libfabric completion queues
   std::vector<struct fid_cq*> cqs_;
 
+  /// Request file descriptor wait objects for the completion queues, so
+  /// that wait_completion() can block (set before init_context()).
+  bool cq_wait_fd_ = false;
+
+  /// Wait object file descriptors of the completion queues (-1 if none).
+  std::vector<int> cq_fds_;
+
+  /// Longest wait_completion() on queues without wait objects.
+  std::chrono::microseconds unsignalled_wait_max_{50};
+
   /// Libfabric address vector.
   struct fid_av* av_ = nullptr;
 
@@ -443,11 +527,26 @@ private:
   /// RDMA connection manager ID (for connection-oriented fabrics)
   struct fid_pep* pep_ = nullptr;
 
-  /// LOGGING completion queues statistics
-  uint64_t agg_CQ_time_ = 0;
-
-  uint64_t agg_CQ_count_ = 0;
-
-  uint64_t agg_CQ_COMP_time_ = 0;
+  /// LOGGING completion queues statistics (updated by all polling threads)
+  std::atomic<uint64_t> agg_CQ_time_{0};
+
+  std::atomic<uint64_t> agg_CQ_count_{0};
+
+  std::atomic<uint64_t> agg_CQ_COMP_time_{0};
+
+  /// Exported completion queue statistics
+  MetricsCounter& cq_polls_metric_ = MetricsRegistry::instance().counter(
+      "flesnet_cq_polls_total", "Completion queue polls",
+      "transport=\"libfabric\"");
+  MetricsCounter& cq_completions_metric_ = MetricsRegistry::instance().counter(
+      "flesnet_cq_completions_total", "Completions read from the queues",
+      "transport=\"libfabric\"");
+  MetricsCounter& cq_read_time_metric_ = MetricsRegistry::instance().counter(
+      "flesnet_cq_read_microseconds_total",
+      "Time spent in non-empty completion queue reads",
+      "transport=\"libfabric\"");
+  MetricsHistogram& cq_batch_metric_ = MetricsRegistry::instance().histogram(
+      "flesnet_cq_batch_size", "Completions handled per non-empty poll",
+      "transport=\"libfabric\"");
 };
 } // namespace tl_libfabric
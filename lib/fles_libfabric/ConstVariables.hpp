@@ -20,15 +20,18 @@ struct ConstVariables {
 
   const static uint64_t INIT_HEARTBEAT_TIMEOUT = 1000000; // in microseconds
 
-  const static uint32_t HEARTBEAT_TIMEOUT_HISTORY_SIZE =
-      10000; // high for unstable networks
+  // Suspicion level (phi) before probing a connection with heartbeats
+  constexpr static double HEARTBEAT_INACTIVE_PHI = 3;
 
-  const static uint32_t HEARTBEAT_TIMEOUT_FACTOR =
-      50; // Factor of timeout value before considering a connection timed out
+  // Suspicion level (phi) before considering a connection timed out
+  constexpr static double HEARTBEAT_TIMEOUT_PHI = 8;
 
-  const static uint32_t HEARTBEAT_INACTIVE_FACTOR =
-      30; // Factor of timeout value before considering a connection is in
-          // active
+  const static uint64_t HEARTBEAT_MIN_STD_DEVIATION = 2000; // in microseconds
+
+  const static uint64_t HEARTBEAT_ACCEPTABLE_PAUSE =
+      20000; // in microseconds, tolerated delay on load spikes
+
+  const static uint64_t HEARTBEAT_CHECK_INTERVAL = 10000; // in microseconds
 
   const static uint32_t HEARTBEAT_INACTIVE_RETRY_COUNT = 3;
 
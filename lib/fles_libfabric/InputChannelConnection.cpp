@@ -3,6 +3,8 @@
 
 #include "InputChannelConnection.hpp"
 
+#include <algorithm>
+
 namespace tl_libfabric {
 
 InputChannelConnection::InputChannelConnection(
@@ -53,6 +55,11 @@ bool InputChannelConnection::check_for_buffer_space(uint64_t data_size,
                      cn_wp_.desc - cn_wp_pending_.desc;
   }
 
+  // the keys of a chunked compute buffer arrive with the first status message
+  if (remote_info_.data_chunk_count > 1 && remote_chunks_.chunk_size == 0) {
+    return false;
+  }
+
   if (cn_ack_.data - cn_wp_.data - cn_wp_pending_.data +
               (UINT64_C(1) << remote_info_.data_buffer_size_exp) <
           data_size ||
@@ -70,12 +77,12 @@ bool InputChannelConnection::send_data(struct iovec* sge,
                                        uint64_t timeslice,
                                        uint64_t desc_length,
                                        uint64_t data_length,
-                                       uint64_t skip) {
-  std::pair<uint64_t, uint64_t> last_timeslice_info =
-      InputSchedulerOrchestrator::get_data_and_desc_of_last_timeslice(index_);
+                                       uint64_t skip,
+                                       std::pair<uint64_t, uint64_t>
+                                           last_timeslice_info) {
   int num_sge2 = 0;
-  struct iovec sge2[4];
-  void* desc2[4];
+  struct iovec sge2[MAX_SEND_SGE];
+  void* desc2[MAX_SEND_SGE];
   bool res = true;
 
   uint64_t cn_wp_data = cn_wp_.data + cn_wp_pending_.data;
@@ -124,78 +131,21 @@ bool InputChannelConnection::send_data(struct iovec* sge,
   }
   num_sge -= num_sge_cut;
 
-  struct fi_msg_rma send_wr_ts;
-  struct fi_msg_rma send_wr_tswrap;
-  struct fi_rma_iov rma_iov[1];
-  struct fi_custom_context* context;
-
-  uint64_t remote_addr =
-      remote_info_.data.addr + (cn_wp_data & cn_data_buffer_mask);
-  for (int i = 0; i < num_sge; i++) {
-
-    memset(rma_iov, 0, sizeof(rma_iov));
-    rma_iov[0].addr = remote_addr;
-    rma_iov[0].len = sge[i].iov_len;
-    rma_iov[0].key = remote_info_.data.rkey;
-
-    remote_addr += sge[i].iov_len;
-
-    memset(&send_wr_ts, 0, sizeof(send_wr_ts));
-    send_wr_ts.msg_iov = &sge[i];
-    send_wr_ts.desc = &desc[i];
-    send_wr_ts.iov_count = 1;
-    // addr
-    send_wr_ts.rma_iov = rma_iov;
-    send_wr_ts.rma_iov_count = 1;
-    send_wr_ts.addr = partner_addr_;
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wold-style-cast"
-    context = LibfabricContextPool::getInst()->getContext();
-    context->op_context = (ID_WRITE_DATA | (timeslice << 24) | (index_ << 8));
-    send_wr_ts.context = context;
-#pragma GCC diagnostic pop
-    if (i + 1 < num_sge || num_sge2 > 0) {
-      res = post_send_rdma(&send_wr_ts, FI_MORE);
-    } else {
-      res = post_send_rdma(&send_wr_ts,
-                           FI_FENCE | FI_DELIVERY_COMPLETE | FI_COMPLETION);
-      ++pending_write_requests_;
-    }
+  uint64_t remote_offset = cn_wp_data & cn_data_buffer_mask;
+  for (int i = 0; i < num_sge && res; i++) {
+    res = post_write_data(sge[i], desc[i], remote_offset,
+                          ID_WRITE_DATA | (timeslice << 24) | (index_ << 8),
+                          i + 1 == num_sge && num_sge2 == 0);
+    remote_offset += sge[i].iov_len;
   }
 
-  if (num_sge2 && res) {
-    uint64_t remote_addr = remote_info_.data.addr;
-    for (int i = 0; i < num_sge2; i++) {
-
-      rma_iov[0].addr = remote_addr;
-      rma_iov[0].len = sge2[i].iov_len;
-      rma_iov[0].key = remote_info_.data.rkey;
-
-      remote_addr += +sge2[i].iov_len;
-
-      memset(&send_wr_tswrap, 0, sizeof(send_wr_tswrap));
-      send_wr_tswrap.msg_iov = &sge2[i];
-      send_wr_tswrap.desc = &desc2[i];
-      send_wr_tswrap.iov_count = 1;
-      // addr
-      send_wr_tswrap.rma_iov = rma_iov;
-      send_wr_tswrap.rma_iov_count = 1;
-      send_wr_tswrap.addr = partner_addr_;
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wold-style-cast"
-      context = LibfabricContextPool::getInst()->getContext();
-      context->op_context =
-          (ID_WRITE_DATA_WRAP | (timeslice << 24) | (index_ << 8));
-      send_wr_tswrap.context = context;
-#pragma GCC diagnostic pop
-      if (i + 1 < num_sge2) {
-        res = post_send_rdma(&send_wr_tswrap, FI_MORE);
-      } else {
-        res = post_send_rdma(&send_wr_tswrap,
-                             FI_FENCE | FI_DELIVERY_COMPLETE | FI_COMPLETION);
-        ++pending_write_requests_;
-      }
-    }
+  remote_offset = 0;
+  for (int i = 0; i < num_sge2 && res; i++) {
+    res = post_write_data(sge2[i], desc2[i], remote_offset,
+                          ID_WRITE_DATA_WRAP | (timeslice << 24) |
+                              (index_ << 8),
+                          i + 1 == num_sge2);
+    remote_offset += sge2[i].iov_len;
   }
   if (!res)
     return false;
@@ -224,6 +174,66 @@ bool InputChannelConnection::send_data(struct iovec* sge,
   return true;
 }
 
+bool InputChannelConnection::post_write_data(struct iovec sge,
+                                             void* desc,
+                                             uint64_t remote_offset,
+                                             uint64_t op_context,
+                                             bool last) {
+  // the compute buffer may be registered in several memory regions, each
+  // written with its own key
+  bool chunked = remote_info_.data_chunk_count > 1;
+  uint64_t chunk_size =
+      chunked ? remote_chunks_.chunk_size
+              : UINT64_C(1) << remote_info_.data_buffer_size_exp;
+  bool res = true;
+  while (res) {
+    uint64_t chunk = remote_offset / chunk_size;
+    uint64_t chunk_offset = remote_offset % chunk_size;
+    assert(chunk < std::max<uint32_t>(remote_info_.data_chunk_count, 1));
+    const BufferInfo& target =
+        chunked ? remote_chunks_.chunk[chunk] : remote_info_.data;
+    size_t len = std::min<uint64_t>(sge.iov_len, chunk_size - chunk_offset);
+    bool last_part = (len == sge.iov_len);
+
+    struct iovec part = sge;
+    part.iov_len = len;
+    struct fi_rma_iov rma_iov;
+    memset(&rma_iov, 0, sizeof(rma_iov));
+    rma_iov.addr = target.addr + chunk_offset;
+    rma_iov.len = len;
+    rma_iov.key = target.rkey;
+
+    struct fi_msg_rma send_wr_ts;
+    memset(&send_wr_ts, 0, sizeof(send_wr_ts));
+    send_wr_ts.msg_iov = &part;
+    send_wr_ts.desc = &desc;
+    send_wr_ts.iov_count = 1;
+    send_wr_ts.rma_iov = &rma_iov;
+    send_wr_ts.rma_iov_count = 1;
+    send_wr_ts.addr = partner_addr_;
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+    struct fi_custom_context* context =
+        LibfabricContextPool::getInst()->getContext();
+    context->op_context = op_context;
+    send_wr_ts.context = context;
+#pragma GCC diagnostic pop
+    if (last && last_part) {
+      res = post_send_rdma(&send_wr_ts,
+                           FI_FENCE | FI_DELIVERY_COMPLETE | FI_COMPLETION);
+      ++pending_write_requests_;
+    } else {
+      res = post_send_rdma(&send_wr_ts, FI_MORE);
+    }
+    if (last_part)
+      break;
+    sge.iov_base = static_cast<uint8_t*>(sge.iov_base) + len;
+    sge.iov_len -= len;
+    remote_offset += len;
+  }
+  return res;
+}
+
 bool InputChannelConnection::write_request_available() {
   return (pending_write_requests_ < max_pending_write_requests_);
 }
@@ -238,11 +248,12 @@ void InputChannelConnection::inc_write_pointers(uint64_t data_size,
 void InputChannelConnection::check_inc_write_pointers() {
   uint64_t timeslice;
   fles::TimesliceComponentDescriptor descriptor;
+  rdma_write_acked_ = false;
   while (!timeslice_data_address_.empty() &&
          added_sent_descriptors_ < ConstVariables::MAX_DESCRIPTOR_ARRAY_SIZE) {
 
-    timeslice = pending_descriptors_.get_begin_iterator()->first;
-    descriptor = pending_descriptors_.get_begin_iterator()->second;
+    timeslice = pending_descriptors_.get_first_key();
+    descriptor = pending_descriptors_.get(timeslice);
     if (!InputSchedulerOrchestrator::is_timeslice_rdma_acked(index_,
                                                              descriptor.ts_num))
       break;
@@ -251,10 +262,23 @@ void InputChannelConnection::check_inc_write_pointers() {
     inc_write_pointers(timeslice_data_address_[0], 1);
     cn_wp_pending_.data -= timeslice_data_address_[0];
     cn_wp_pending_.desc -= 1;
-    timeslice_data_address_.erase(timeslice_data_address_.begin());
-    assert(pending_descriptors_.remove(timeslice));
+    timeslice_data_address_.pop_front();
+    pending_descriptors_.remove(timeslice);
     data_acked_ = true;
   }
+  // the remaining acknowledged writes go with the next status message
+  if (!timeslice_data_address_.empty() &&
+      added_sent_descriptors_ >= ConstVariables::MAX_DESCRIPTOR_ARRAY_SIZE) {
+    rdma_write_acked_ = true;
+  }
+}
+
+bool InputChannelConnection::sync_pending() const {
+  return send_buffer_available_ &&
+         (data_changed_ || data_acked_ || rdma_write_acked_ ||
+          sync_after_scheduling_decision_ ||
+          (finalize_ && (!send_status_message_.final ||
+                         send_status_message_.abort != abort_)));
 }
 
 bool InputChannelConnection::try_sync_buffer_positions() {
@@ -327,6 +351,10 @@ void InputChannelConnection::on_complete_recv() {
              << recv_status_message_.final;
   }
 
+  if (recv_status_message_.data_chunks.chunk_size != 0) {
+    remote_chunks_ = recv_status_message_.data_chunks;
+  }
+
   if (recv_status_message_.final ||
       InputSchedulerOrchestrator::is_connection_timed_out(index_)) {
     done_ = true;
@@ -348,6 +376,9 @@ void InputChannelConnection::on_complete_recv() {
     cn_ack_ = recv_status_message_.ack;
   }
 
+  // status messages double as heartbeats
+  if (!InputSchedulerOrchestrator::is_connection_timed_out(index_))
+    InputSchedulerOrchestrator::log_heartbeat(index_);
   post_recv_status_message();
 }
 
@@ -380,6 +411,9 @@ void InputChannelConnection::setup_mr(struct fid_domain* pd) {
   if (mr_send_ == nullptr)
     throw LibfabricException(
         "registration of memory region failed in InputChannelConnection2");
+
+  LibfabricMRCache::bind_to_endpoint(mr_recv_, ep_);
+  LibfabricMRCache::bind_to_endpoint(mr_send_, ep_);
 }
 
 void InputChannelConnection::setup() {
@@ -553,19 +587,7 @@ fi_addr_t InputChannelConnection::get_partner_addr() {
 }
 
 void InputChannelConnection::set_remote_info() {
-  this->remote_info_.data.addr = this->recv_status_message_.info.data.addr;
-  this->remote_info_.data.rkey = this->recv_status_message_.info.data.rkey;
-
-  this->remote_info_.desc.addr = this->recv_status_message_.info.desc.addr;
-  this->remote_info_.desc.rkey = this->recv_status_message_.info.desc.rkey;
-
-  this->remote_info_.data_buffer_size_exp =
-      this->recv_status_message_.info.data_buffer_size_exp;
-
-  this->remote_info_.desc_buffer_size_exp =
-      this->recv_status_message_.info.desc_buffer_size_exp;
-
-  this->remote_info_.index = this->recv_status_message_.info.index;
+  this->remote_info_ = this->recv_status_message_.info;
 }
 
 void InputChannelConnection::set_last_sent_timeslice(uint64_t sent_ts) {
@@ -605,7 +627,8 @@ void InputChannelConnection::on_complete_heartbeat_recv() {
     InputLoggerProxy::get_instance()->log_message_ACK_arrival(
         InputSchedulerOrchestrator::get_current_interval_index(), index_,
         recv_heartbeat_message_.message_id);
-    InputSchedulerOrchestrator::log_heartbeat(index_);
+    if (!InputSchedulerOrchestrator::is_connection_timed_out(index_))
+      InputSchedulerOrchestrator::log_heartbeat(index_);
   }
   if (InputSchedulerOrchestrator::is_connection_timed_out(index_)) {
     return;
@@ -631,6 +654,8 @@ void InputChannelConnection::on_complete_dfs_recv() {
 
   if (done_)
     return;
+  if (!InputSchedulerOrchestrator::is_connection_timed_out(index_))
+    InputSchedulerOrchestrator::log_heartbeat(index_);
   InputSchedulerOrchestrator::add_dfs_proposal(dfs_DDS_message_, index());
   post_recv_dfs_message();
 }
@@ -740,7 +765,7 @@ void InputChannelConnection::update_cn_wp_after_failure_action(
   while (!pending_descriptors_.empty() &&
          pending_descriptors_.get_last_key() >
              last_transmitted_timeslice_info.second) {
-    timeslice_data_address_.erase(--timeslice_data_address_.end());
+    timeslice_data_address_.pop_back();
     pending_descriptors_.remove(pending_descriptors_.get_last_key());
     data_acked_ = true;
   }
@@ -10,14 +10,17 @@
 #include "InputNodeInfo.hpp"
 #include "MicrosliceDescriptor.hpp"
 #include "RequestIdentifier.hpp"
+#include "RingIndexedTable.hpp"
 #include "TimesliceComponentDescriptor.hpp"
 #include "dfs/controller/InputSchedulerOrchestrator.hpp"
 #include "dfs/model/interval_manager/InputIntervalInfo.hpp"
 
 #include <cassert>
 #include <cstring>
+#include <deque>
 #include <rdma/fi_cm.h>
 #include <rdma/fi_rma.h>
+#include <utility>
 
 namespace tl_libfabric {
 /// Input node connection class.
@@ -27,6 +30,9 @@ namespace tl_libfabric {
 
 class InputChannelConnection : public Connection {
 public:
+  /// Maximum number of scatter/gather elements of a timeslice transfer.
+  static const int MAX_SEND_SGE = 16;
+
   /// The InputChannelConnection constructor.
   InputChannelConnection(struct fid_eq* eq,
                          uint_fast16_t connection_index,
@@ -40,14 +46,17 @@ public:
   /// Wait until enough space is available at target compute node.
   bool check_for_buffer_space(uint64_t data_size, uint64_t desc_size);
 
-  /// Send data and descriptors to compute node.
+  /// Send data and descriptors to compute node. The data and descriptor
+  /// positions of the last timeslice sent on this connection are passed by
+  /// the caller, so posting does not access the DFS scheduler.
   bool send_data(struct iovec* sge,
                  void** desc,
                  int num_sge,
                  uint64_t timeslice,
                  uint64_t desc_length,
                  uint64_t data_length,
-                 uint64_t skip);
+                 uint64_t skip,
+                 std::pair<uint64_t, uint64_t> last_timeslice_info);
 
   bool write_request_available();
 
@@ -68,6 +77,13 @@ public:
 
   void on_complete_write();
 
+  /// Note that the DFS scheduler recorded completed writes, which may let
+  /// the write pointers advance on the next synchronization.
+  void on_rdma_write_acked() { rdma_write_acked_ = true; }
+
+  /// Check whether try_sync_buffer_positions() has anything to send.
+  bool sync_pending() const;
+
   /// Handle Libfabric receive completion notification.
   void on_complete_recv() override;
 
@@ -161,6 +177,14 @@ private:
 
   void prepare_DFS_LB_message() override;
 
+  /// Post the RDMA writes of one gather list entry to the compute buffer,
+  /// split at the boundaries of its memory regions
+  bool post_write_data(struct iovec sge,
+                       void* desc,
+                       uint64_t remote_offset,
+                       uint64_t op_context,
+                       bool last);
+
   /// Flag, true if it is the input nodes's turn to send a pointer update.
   bool our_turn_ = true;
 
@@ -169,12 +193,19 @@ private:
 
   // ACK flag of the failure decision
   bool sync_after_scheduling_decision_ = false;
+
+  /// Set when writes were acknowledged since the write pointers were last
+  /// advanced.
+  bool rdma_write_acked_ = false;
   //
   uint32_t sync_failed_conn_ = -1;
 
   /// Access information for memory regions on remote end.
   ComputeNodeInfo remote_info_ = ComputeNodeInfo();
 
+  /// Memory regions of a remote data buffer registered in several chunks
+  DataChunkInfo remote_chunks_ = DataChunkInfo();
+
   /// Local copy of acknowledged-by-CN pointers
   ComputeNodeBufferPosition cn_ack_ = ComputeNodeBufferPosition();
 
@@ -217,10 +248,10 @@ private:
   uint64_t last_sent_timeslice_ = ConstVariables::MINUS_ONE;
 
   /// descriptors to be sent in the next sync messages <desc_ts,  descriptor>
-  SizedMap<uint64_t, fles::TimesliceComponentDescriptor> pending_descriptors_;
+  RingIndexedTable<fles::TimesliceComponentDescriptor> pending_descriptors_;
 
   /// Data addresses of the pending timeslices
-  std::vector<uint64_t> timeslice_data_address_;
+  std::deque<uint64_t> timeslice_data_address_;
 
   /// count of added descriptors to the sync message
   uint8_t added_sent_descriptors_ = 0;
@@ -2,6 +2,10 @@
 // Copyright 2016 Thorsten Schuett <schuett@zib.de>, Farouk Salem <salem@zib.de>
 
 #include "InputChannelSender.hpp"
+#include "dfs/controller/load_balancer/LoadBalancingPolicy.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 namespace tl_libfabric {
 InputChannelSender::InputChannelSender(
@@ -15,13 +19,32 @@ InputChannelSender::InputChannelSender(
     std::string input_node_name,
     uint32_t scheduler_interval_length,
     std::string log_directory,
-    bool enable_logging)
+    bool enable_logging,
+    uint32_t sender_threads,
+    std::vector<double> compute_weights,
+    uint32_t active_compute_count)
     : ConnectionGroup(input_node_name), input_index_(input_index),
       data_source_(data_source), compute_hostnames_(compute_hostnames),
       compute_services_(compute_services), timeslice_size_(timeslice_size),
       overlap_size_(overlap_size), max_timeslice_number_(max_timeslice_number),
       min_acked_desc_(data_source.desc_buffer().size() / 4),
-      min_acked_data_(data_source.data_buffer().size() / 4) {
+      min_acked_data_(data_source.data_buffer().size() / 4),
+      joined_compute_count_(
+          active_compute_count == 0
+              ? static_cast<uint32_t>(compute_hostnames.size())
+              : std::min(active_compute_count,
+                         static_cast<uint32_t>(compute_hostnames.size()))),
+      sender_threads_(sender_threads),
+      desc_metrics_("input_desc",
+                    metrics_labels("libfabric", "input", input_index)),
+      data_metrics_("input_data",
+                    metrics_labels("libfabric", "input", input_index)),
+      latency_tracer_(LatencyTracer::Role::input, "libfabric", input_index),
+      failover_metric_(MetricsRegistry::instance().histogram(
+          "flesnet_failover_recovery_microseconds",
+          "Time from a compute node failure decision until all timeslices "
+          "up to its trigger are processed",
+          metrics_labels("libfabric", "input", input_index))) {
 
   start_index_desc_ = sent_desc_ = acked_desc_ = cached_acked_desc_ =
       data_source.get_read_index().desc;
@@ -31,6 +54,23 @@ InputChannelSender::InputChannelSender(
   size_t min_ack_buffer_size =
       data_source_.desc_buffer().size() / timeslice_size_ + 1;
   ack_.alloc_with_size(min_ack_buffer_size);
+  for (size_t i = 0; i < ack_.size(); ++i) {
+    ack_.at(i).store(UINT64_MAX, std::memory_order_relaxed);
+  }
+
+  // connection i is served by completion queue i % MAX_CQ_INSTANCE, so a
+  // shard must own at least one completion queue and one connection
+  uint32_t max_shards =
+      std::min(static_cast<uint32_t>(MAX_CQ_INSTANCE),
+               static_cast<uint32_t>(compute_hostnames.size()));
+  if (sender_threads_ > max_shards) {
+    L_(warning) << "[i" << input_index_ << "] reducing sender threads from "
+                << sender_threads_ << " to " << max_shards;
+    sender_threads_ = max_shards;
+  }
+  create_shards();
+  // idle sender loops block on the completion queues instead of spinning
+  cq_wait_fd_ = true;
 
   if (Provider::getInst()->is_connection_oriented()) {
     connection_oriented_ = true;
@@ -38,36 +78,44 @@ InputChannelSender::InputChannelSender(
     connection_oriented_ = false;
   }
 
+  // standby compute nodes get no initial load
+  std::vector<double> initial_load = LoadBalancingPolicy::initial_load(
+      compute_weights, static_cast<uint32_t>(compute_hostnames.size()),
+      joined_compute_count_);
+
   InputSchedulerOrchestrator::initialize(
       input_index, compute_hostnames.size(),
       ConstVariables::INIT_HEARTBEAT_TIMEOUT,
-      ConstVariables::HEARTBEAT_TIMEOUT_HISTORY_SIZE,
-      ConstVariables::HEARTBEAT_TIMEOUT_FACTOR,
-      ConstVariables::HEARTBEAT_INACTIVE_FACTOR,
+      ConstVariables::HEARTBEAT_INACTIVE_PHI,
+      ConstVariables::HEARTBEAT_TIMEOUT_PHI,
       ConstVariables::HEARTBEAT_INACTIVE_RETRY_COUNT, scheduler_interval_length,
       data_source.get_write_index().desc, (timeslice_size + overlap_size),
-      start_index_desc_, timeslice_size, log_directory, enable_logging);
+      start_index_desc_, timeslice_size, initial_load, log_directory,
+      enable_logging);
+  InputSchedulerOrchestrator::update_compute_connection_count(
+      joined_compute_count_);
   InputSchedulerOrchestrator::update_data_source_desc(
       data_source.get_write_index().desc);
 }
 
 InputChannelSender::~InputChannelSender() {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wold-style-cast"
-  if (mr_desc_ != nullptr) {
-    fi_close((struct fid*)mr_desc_);
-    mr_desc_ = nullptr;
+  stop_shards();
+  for (Shard& shard : shards_) {
+    if (shard.event_fd >= 0) {
+      close(shard.event_fd);
+    }
   }
-
-  if (mr_data_ != nullptr) {
-    fi_close((struct fid*)(mr_data_));
-    mr_data_ = nullptr;
+  for (const auto* region : data_regions_) {
+    LibfabricMRCache::getInst()->release(region);
+  }
+  for (const auto* region : desc_regions_) {
+    LibfabricMRCache::getInst()->release(region);
   }
-#pragma GCC diagnostic pop
 }
 
 void InputChannelSender::report_status() {
   constexpr auto interval = std::chrono::seconds(1);
+  std::unique_lock<std::recursive_mutex> lock(state_mutex_);
 
   // if data_source.written pointers are lagging behind due to lazy updates,
   // use sent value instead
@@ -123,18 +171,30 @@ void InputChannelSender::report_status() {
            << human_readable_count(rate_data, true, "B/s") << " ("
            << human_readable_count(rate_desc, true, "Hz") << ")";
 
+  desc_metrics_.update(status_desc.used(), status_desc.sending(),
+                       status_desc.freeing(), status_desc.size,
+                       status_desc.acked - start_index_desc_);
+  data_metrics_.update(status_data.used(), status_data.sending(),
+                       status_data.freeing(), status_data.size,
+                       status_data.acked - start_index_data_);
+
   previous_send_buffer_status_desc_ = status_desc;
   previous_send_buffer_status_data_ = status_data;
+  lock.unlock();
 
   scheduler_.add(std::bind(&InputChannelSender::report_status, this),
                  now + interval);
 }
 
 void InputChannelSender::sync_data_source(bool schedule) {
-  if (acked_data_ > cached_acked_data_ || acked_desc_ > cached_acked_desc_) {
-    cached_acked_data_ = acked_data_;
-    cached_acked_desc_ = acked_desc_;
-    data_source_.set_read_index({cached_acked_desc_, cached_acked_data_});
+  {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+    update_acked_positions();
+    if (acked_data_ > cached_acked_data_ || acked_desc_ > cached_acked_desc_) {
+      cached_acked_data_ = acked_data_;
+      cached_acked_desc_ = acked_desc_;
+      data_source_.set_read_index({cached_acked_desc_, cached_acked_data_});
+    }
   }
 
   if (schedule) {
@@ -145,72 +205,360 @@ void InputChannelSender::sync_data_source(bool schedule) {
 }
 
 void InputChannelSender::sync_heartbeat() {
-  InputSchedulerOrchestrator::update_data_source_desc(
-      data_source_.get_write_index().desc);
-  HeartbeatFailedNodeInfo* failed_connection =
-      InputSchedulerOrchestrator::get_timed_out_connection();
-  if (failed_connection->index ==
-      ConstVariables::MINUS_ONE) { // Check inactive connections
-    send_heartbeat_to_inactive_connections();
-  } else { // Send timeout message to all active connections
-    for (auto& conn : conn_) {
-      if (conn->request_finalize_flag() && !conn->done()) {
-        mark_connection_completed(conn->index());
-      } else {
-        if (!InputSchedulerOrchestrator::is_connection_timed_out(
-                conn->index()) &&
-            !conn->done()) {
-          conn->prepare_heartbeat(failed_connection);
+  {
+    auto shard_locks = lock_all_shards();
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+    InputSchedulerOrchestrator::update_data_source_desc(
+        data_source_.get_write_index().desc);
+    HeartbeatFailedNodeInfo* failed_connection =
+        InputSchedulerOrchestrator::get_timed_out_connection();
+    if (failed_connection->index ==
+        ConstVariables::MINUS_ONE) { // Check inactive connections
+      send_heartbeat_to_inactive_connections();
+    } else { // Send timeout message to all active connections
+      for (auto& conn : conn_) {
+        if (conn->index() >= joined_compute_count_)
+          continue;
+        if (conn->request_finalize_flag() && !conn->done()) {
+          mark_connection_completed(conn->index());
+        } else {
+          if (!InputSchedulerOrchestrator::is_connection_timed_out(
+                  conn->index()) &&
+              !conn->done()) {
+            conn->prepare_heartbeat(failed_connection);
+          }
         }
       }
     }
   }
-  // TODO 1 second?
   scheduler_.add(std::bind(&InputChannelSender::sync_heartbeat, this),
-                 std::chrono::system_clock::now() + std::chrono::seconds(1));
+                 std::chrono::system_clock::now() +
+                     std::chrono::microseconds(
+                         ConstVariables::HEARTBEAT_CHECK_INTERVAL));
 }
 
-void InputChannelSender::send_timeslices() {
+void InputChannelSender::send_timeslices() { send_shard_timeslices(0); }
+
+void InputChannelSender::send_shard_timeslices(uint32_t shard) {
+  Shard& s = shards_[shard];
+  bool schedule_changed = s.schedule_changed.exchange(false);
+  if (!s.ready_pending.exchange(false) && !schedule_changed) {
+    return;
+  }
+
+  std::lock_guard<std::recursive_mutex> shard_lock(s.mutex);
+  if (schedule_changed) {
+    wake_shard_connections(shard, SendBlocker::Schedule);
+  }
+  if (s.ready.empty()) {
+    return;
+  }
+
+  uint64_t up_to_timeslice;
+  {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+    up_to_timeslice = InputSchedulerOrchestrator::get_last_timeslice_to_send();
+  }
 
-  uint64_t up_to_timeslice =
-      InputSchedulerOrchestrator::get_last_timeslice_to_send();
+  // each ready connection gets one attempt per pass; a connection that sent
+  // a timeslice lines up again behind the others
+  for (size_t count = s.ready.size(); count > 0; --count) {
+    uint32_t conn_index = s.ready.front();
+    s.ready.pop_front();
+    connection_queued_[conn_index] = 0;
+
+    uint64_t next_ts;
+    {
+      std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+      next_ts =
+          InputSchedulerOrchestrator::get_connection_next_timeslice(conn_index);
+    }
 
-  uint32_t conn_index = input_index_ % conn_.size();
-  do {
-    uint64_t next_ts =
-        InputSchedulerOrchestrator::get_connection_next_timeslice(conn_index);
+    if (next_ts == ConstVariables::MINUS_ONE || next_ts > up_to_timeslice ||
+        next_ts > max_timeslice_number_) {
+      send_blocker_[conn_index] = SendBlocker::Schedule;
+      awaited_timeslice_[conn_index] = next_ts;
+      continue;
+    }
 
-    if (next_ts != ConstVariables::MINUS_ONE && next_ts <= up_to_timeslice &&
-        next_ts <= max_timeslice_number_ &&
-        try_send_timeslice(next_ts, conn_index)) {
+    if (try_send_timeslice(next_ts, conn_index)) {
       conn_[conn_index]->set_last_sent_timeslice(next_ts);
-      /*// TODO nanos
-      uint32_t conn = (conn_index + 1) % conn_.size();
-      int64_t diff =
-          std::chrono::duration<double, std::chrono::nanoseconds::period>(
-              InputSchedulerOrchestrator::get_expected_ts_sent_time(
-                  InputSchedulerOrchestrator::get_connection_next_timeslice(
-                      conn)) -
-              std::chrono::high_resolution_clock::now())
-              .count();
-      if (diff <= 0)
-        diff = 1;
-      nanosleep((const struct timespec[]){{0, diff}}, NULL);*/
-    }
-    conn_index = (conn_index + 1) % conn_.size();
-  } while (conn_index != (input_index_ % conn_.size()));
-
-  if (InputSchedulerOrchestrator::get_sent_timeslices() <=
-      max_timeslice_number_)
-    scheduler_.add(std::bind(&InputChannelSender::send_timeslices, this),
-                   std::chrono::system_clock::now() +
-                       std::chrono::microseconds(
-                           InputSchedulerOrchestrator::get_next_fire_time()));
+      mark_connection_ready(conn_index);
+    }
+  }
+}
+
+void InputChannelSender::release_scheduled_timeslices() {
+  int64_t next_fire_time;
+  for (uint32_t shard = 0; shard < shards_.size(); ++shard) {
+    std::lock_guard<std::recursive_mutex> shard_lock(shards_[shard].mutex);
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+    uint64_t up_to_timeslice =
+        InputSchedulerOrchestrator::get_last_timeslice_to_send();
+    for (uint32_t cn : shards_[shard].connections) {
+      if (send_blocker_[cn] == SendBlocker::Schedule &&
+          (awaited_timeslice_[cn] == ConstVariables::MINUS_ONE ||
+           awaited_timeslice_[cn] <= up_to_timeslice)) {
+        mark_connection_ready(cn);
+      }
+    }
+    next_fire_time = InputSchedulerOrchestrator::get_next_fire_time();
+  }
+
+  if (sent_timeslices() <= max_timeslice_number_)
+    scheduler_.add(
+        std::bind(&InputChannelSender::release_scheduled_timeslices, this),
+        std::chrono::system_clock::now() +
+            std::chrono::microseconds(next_fire_time));
+}
+
+void InputChannelSender::mark_connection_ready(uint32_t cn) {
+  send_blocker_[cn] = SendBlocker::None;
+  if (connection_queued_[cn] == 0) {
+    connection_queued_[cn] = 1;
+    Shard& shard = shards_[connection_shard_[cn]];
+    shard.ready.push_back(cn);
+    shard.ready_pending = true;
+    notify_shard(connection_shard_[cn]);
+  }
+}
+
+void InputChannelSender::wake_connections(SendBlocker blocker) {
+  for (uint32_t shard = 0; shard < shards_.size(); ++shard) {
+    wake_shard_connections(shard, blocker);
+  }
+}
+
+void InputChannelSender::wake_shard_connections(uint32_t shard,
+                                                SendBlocker blocker) {
+  for (uint32_t cn : shards_[shard].connections) {
+    if (send_blocker_[cn] == blocker) {
+      mark_connection_ready(cn);
+    }
+  }
+}
+
+void InputChannelSender::retry_failed_posts() {
+  constexpr auto interval = std::chrono::milliseconds(1);
+  if (post_failed_.exchange(false)) {
+    for (uint32_t shard = 0; shard < shards_.size(); ++shard) {
+      std::lock_guard<std::recursive_mutex> shard_lock(shards_[shard].mutex);
+      wake_shard_connections(shard, SendBlocker::PostFailed);
+    }
+  }
+  scheduler_.add(std::bind(&InputChannelSender::retry_failed_posts, this),
+                 std::chrono::system_clock::now() + interval);
+}
+
+void InputChannelSender::check_input_data() {
+  {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+    if (min_awaited_desc_ == UINT64_MAX) {
+      return;
+    }
+    write_index_desc_ = data_source_.get_write_index().desc;
+    if (write_index_desc_ < min_awaited_desc_) {
+      return;
+    }
+    min_awaited_desc_ = UINT64_MAX;
+  }
+
+  for (uint32_t shard = 0; shard < shards_.size(); ++shard) {
+    std::lock_guard<std::recursive_mutex> shard_lock(shards_[shard].mutex);
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+    for (uint32_t cn : shards_[shard].connections) {
+      if (send_blocker_[cn] != SendBlocker::InputBuffer) {
+        continue;
+      }
+      if (awaited_desc_[cn] <= write_index_desc_) {
+        mark_connection_ready(cn);
+      } else {
+        min_awaited_desc_ = std::min(min_awaited_desc_, awaited_desc_[cn]);
+      }
+    }
+  }
+}
+
+void InputChannelSender::create_shards() {
+  uint32_t conn_count = compute_hostnames_.size();
+  for (uint32_t shard = 0; shard < sender_threads_; ++shard) {
+    shards_.emplace_back();
+    shards_.back().event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (shards_.back().event_fd < 0) {
+      throw LibfabricException("eventfd failed");
+    }
+  }
+  // keep the round-robin order starting at input_index_ inside each shard
+  uint32_t conn_index = input_index_ % conn_count;
+  for (uint32_t i = 0; i < conn_count; ++i) {
+    uint32_t shard = (conn_index % MAX_CQ_INSTANCE) % sender_threads_;
+    shards_[shard].connections.push_back(conn_index);
+    conn_index = (conn_index + 1) % conn_count;
+  }
+
+  // initially, every connection gets the chance to send
+  connection_shard_.assign(conn_count, 0);
+  connection_queued_.assign(conn_count, 0);
+  send_blocker_.assign(conn_count, SendBlocker::None);
+  awaited_timeslice_.assign(conn_count, ConstVariables::MINUS_ONE);
+  awaited_desc_.assign(conn_count, 0);
+  for (uint32_t shard = 0; shard < sender_threads_; ++shard) {
+    for (uint32_t cn : shards_[shard].connections) {
+      connection_shard_[cn] = shard;
+      mark_connection_ready(cn);
+    }
+  }
+}
+
+std::vector<std::unique_lock<std::recursive_mutex>>
+InputChannelSender::lock_all_shards() {
+  std::vector<std::unique_lock<std::recursive_mutex>> locks;
+  locks.reserve(shards_.size());
+  for (Shard& shard : shards_) {
+    locks.emplace_back(shard.mutex);
+  }
+  return locks;
+}
+
+void InputChannelSender::run_shard(uint32_t shard) {
+  try {
+    uint32_t idle_passes = 0;
+    while (!stop_shards_) {
+      bool busy =
+          shards_[shard].ready_pending || shards_[shard].schedule_changed;
+      send_shard_timeslices(shard);
+
+      // only the completion queues of this shard's connections are polled
+      busy = poll_completion(shard, sender_threads_) > 0 || busy;
+
+      sync_shard_buffer_positions(shard);
+
+      // all events that make a shard busy either complete on its queues or
+      // notify it, so an idle shard can block
+      if (busy) {
+        idle_passes = 0;
+      } else if (++idle_passes >= idle_spin_passes_) {
+        wait_shard(shard, idle_wait_max_);
+      }
+    }
+  } catch (std::exception& e) {
+    L_(fatal) << "exception in InputChannelSender shard " << shard << ": "
+              << e.what();
+    abort_ = true;
+  }
+}
+
+void InputChannelSender::start_shards() {
+  if (sender_threads_ < 2) {
+    return;
+  }
+  L_(info) << "[i" << input_index_ << "] sharding " << conn_.size()
+           << " compute connections across " << sender_threads_
+           << " sender threads";
+  stop_shards_ = false;
+  for (uint32_t shard = 0; shard < sender_threads_; ++shard) {
+    shard_threads_.emplace_back(&InputChannelSender::run_shard, this, shard);
+  }
+}
+
+void InputChannelSender::stop_shards() {
+  stop_shards_ = true;
+  for (uint32_t shard = 0; shard < shards_.size(); ++shard) {
+    notify_shard(shard);
+  }
+  for (auto& thread : shard_threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+  shard_threads_.clear();
+}
+
+uint64_t InputChannelSender::sent_timeslices() {
+  std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+  return InputSchedulerOrchestrator::get_sent_timeslices();
+}
+
+bool InputChannelSender::all_connections_done() {
+  std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+  return all_done_;
+}
+
+int InputChannelSender::progress() {
+  if (sender_threads_ == 1) {
+    int completions = poll_completion();
+    sync_joined_buffer_positions();
+    return completions;
+  }
+  // completions are handled by the shards, only publish their acks
+  update_acked_positions();
+  return 0;
+}
+
+void InputChannelSender::notify_shard(uint32_t shard) {
+  Shard& s = shards_[shard];
+  if (s.sleeping) {
+    uint64_t one = 1;
+    // a failed write leaves the counter set, which wakes the shard as well
+    ssize_t res = write(s.event_fd, &one, sizeof(one));
+    (void)res;
+  }
+}
+
+void InputChannelSender::wait_shard(uint32_t shard,
+                                    std::chrono::microseconds timeout) {
+  Shard& s = shards_[shard];
+  // announce the wait before the last check, so that a concurrent
+  // notify_shard() is either seen here or writes the event fd
+  s.sleeping = true;
+  if (!s.ready_pending && !s.schedule_changed && !stop_shards_) {
+    wait_completion(shard, sender_threads_, s.event_fd, timeout);
+  }
+  s.sleeping = false;
+  uint64_t count;
+  ssize_t res = read(s.event_fd, &count, sizeof(count));
+  (void)res;
+}
+
+void InputChannelSender::wait_when_idle(bool busy) {
+  if (busy) {
+    idle_passes_ = 0;
+    return;
+  }
+  if (++idle_passes_ < idle_spin_passes_) {
+    return;
+  }
+
+  // the arrival of input data is only noticed by polling
+  std::chrono::microseconds timeout = idle_wait_max_;
+  {
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+    if (min_awaited_desc_ != UINT64_MAX) {
+      timeout = input_wait_max_;
+    }
+  }
+  // the scheduler releases the timeslices of the next DFS round
+  auto now = std::chrono::system_clock::now();
+  auto next_event = scheduler_.next_event_time();
+  if (next_event <= now) {
+    return;
+  }
+  timeout = std::min(timeout,
+                     std::chrono::duration_cast<std::chrono::microseconds>(
+                         next_event - now));
+
+  if (sender_threads_ == 1) {
+    wait_shard(0, timeout);
+  } else {
+    // the shards handle the completions, nothing to wait for but the time
+    std::this_thread::sleep_for(timeout);
+  }
 }
 
 void InputChannelSender::bootstrap_with_connections() {
   connect();
-  while (connected_ != compute_hostnames_.size()) {
+  // standby compute nodes are connected later by join_compute_nodes()
+  while (connected_ < joined_compute_count_) {
     poll_cm_events();
   }
 }
@@ -233,13 +581,13 @@ void InputChannelSender::bootstrap_wo_connections() {
     conn_.at(i) = (std::move(connection));
   }
   int i = 0;
-  while (connected_ != compute_hostnames_.size()) {
+  while (connected_ < joined_compute_count_) {
     poll_completion();
     i++;
     if (i == 1000000) { // TODO retry for connectionless
       i = 0;
       // reconnecting
-      for (unsigned int i = 0; i < compute_hostnames_.size(); ++i) {
+      for (unsigned int i = 0; i < joined_compute_count_; ++i) {
         if (connected_indexes_.find(i) == connected_indexes_.end()) {
           L_(info) << "retrying to connect to " << compute_hostnames_[i] << ":"
                    << compute_services_[i];
@@ -261,6 +609,10 @@ void InputChannelSender::operator()() {
 
     data_source_.proceed();
 
+    // standby compute nodes do not take part in the barrier
+    for (uint32_t i = joined_compute_count_; i < conn_.size(); ++i) {
+      LibfabricBarrier::get_instance()->deactive_endpoint(i);
+    }
     L_(info) << "Calling Barrier ...";
     LibfabricBarrier::get_instance()->call_barrier();
     L_(info) << "Done Barrier ...";
@@ -272,19 +624,32 @@ void InputChannelSender::operator()() {
       conn_[indx]->set_time_MPI(time_begin_);
     }
 
-    sync_buffer_positions();
     sync_data_source(true);
     sync_heartbeat();
+    if (joined_compute_count_ < conn_.size()) {
+      join_compute_nodes();
+    }
     report_status();
-    send_timeslices();
+    release_scheduled_timeslices();
+    retry_failed_posts();
+    start_shards();
 
-    while (InputSchedulerOrchestrator::get_sent_timeslices() <=
-               max_timeslice_number_ &&
-           !abort_) {
+    while (sent_timeslices() <= max_timeslice_number_ && !abort_) {
       scheduler_.timer();
-      poll_completion();
+      int completions = progress();
       update_compute_schedulers();
-      data_source_.proceed();
+      {
+        std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+        data_source_.proceed();
+      }
+      check_input_data();
+      // only connections woken by one of the events above are served
+      bool ready = sender_threads_ == 1 && (shards_[0].ready_pending ||
+                                            shards_[0].schedule_changed);
+      if (ready) {
+        send_timeslices();
+      }
+      wait_when_idle(completions > 0 || ready);
     }
 
     L_(info) << "[i" << input_index_ << "]"
@@ -292,29 +657,46 @@ void InputChannelSender::operator()() {
 
     // wait for pending send completions
     while (acked_desc_ <
-           timeslice_size_ * InputSchedulerOrchestrator::get_sent_timeslices() +
-               start_index_desc_) {
-      poll_completion();
+           timeslice_size_ * sent_timeslices() + start_index_desc_) {
+      wait_when_idle(progress() > 0);
       scheduler_.timer();
     }
     sync_data_source(false);
 
     L_(debug) << "[i " << input_index_ << "] "
               << "Finalize Connections";
-    for (auto& c : conn_) {
-      c->finalize(abort_);
+    {
+      auto shard_locks = lock_all_shards();
+      std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+      for (auto& c : conn_) {
+        if (c->index() < joined_compute_count_) {
+          c->finalize(abort_);
+        } else if (!c->done()) {
+          // a standby compute node that never joined has nothing to finish
+          mark_connection_completed(c->index());
+        }
+      }
+    }
+    // the shards send the final status messages
+    for (uint32_t shard = 0; shard < shards_.size(); ++shard) {
+      notify_shard(shard);
     }
 
     L_(debug) << "[i" << input_index_ << "] "
               << "SENDER loop done";
-    while (!all_done_) {
-      poll_completion();
+    while (!all_connections_done()) {
+      wait_when_idle(progress() > 0);
       scheduler_.timer();
     }
+    stop_shards();
     time_end_ = std::chrono::high_resolution_clock::now();
 
     if (connection_oriented_) {
-      disconnect();
+      for (auto& c : conn_) {
+        if (connected_indexes_.count(c->index()) != 0) {
+          c->disconnect();
+        }
+      }
     }
 
     while (connected_ != 0) {
@@ -329,6 +711,7 @@ void InputChannelSender::operator()() {
 }
 
 bool InputChannelSender::try_send_timeslice(uint64_t timeslice, uint32_t cn) {
+  std::unique_lock<std::recursive_mutex> lock(state_mutex_);
   // wait until a complete timeslice is available in the input buffer
   uint64_t desc_offset = timeslice * timeslice_size_ + start_index_desc_;
   uint64_t desc_length = timeslice_size_ + overlap_size_;
@@ -338,6 +721,7 @@ bool InputChannelSender::try_send_timeslice(uint64_t timeslice, uint32_t cn) {
   }
   // check if microslice no. (desc_offset + desc_length - 1) is avail
   if (write_index_desc_ >= desc_offset + desc_length) {
+    latency_tracer_.mark(timeslice, LatencyTracer::available);
     InputSchedulerOrchestrator::log_timeslice_IB_blocked(cn, timeslice, true);
     uint64_t data_offset = data_source_.desc_buffer().at(desc_offset).offset;
     uint64_t data_end =
@@ -360,6 +744,7 @@ bool InputChannelSender::try_send_timeslice(uint64_t timeslice, uint32_t cn) {
       L_(debug) << "[" << input_index_ << "]"
                 << "max # of writes to " << cn;
       InputSchedulerOrchestrator::log_timeslice_MR_blocked(cn, timeslice);
+      send_blocker_[cn] = SendBlocker::WriteRequests;
       return false;
     }
     InputSchedulerOrchestrator::log_timeslice_MR_blocked(cn, timeslice, true);
@@ -369,8 +754,17 @@ bool InputChannelSender::try_send_timeslice(uint64_t timeslice, uint32_t cn) {
     total_length += skip;
 
     if (conn_[cn]->check_for_buffer_space(total_length, 1)) {
-      if (post_send_data(timeslice, cn, desc_offset, desc_length, data_offset,
-                         data_length, skip)) {
+      std::pair<uint64_t, uint64_t> last_timeslice_info =
+          InputSchedulerOrchestrator::get_data_and_desc_of_last_timeslice(cn);
+      // building the gather list and posting the writes only involve this
+      // connection, which is guarded by the lock of its shard
+      lock.unlock();
+      bool posted =
+          post_send_data(timeslice, cn, desc_offset, desc_length, data_offset,
+                         data_length, skip, last_timeslice_info);
+      lock.lock();
+      if (posted) {
+        latency_tracer_.mark(timeslice, LatencyTracer::posted);
         InputSchedulerOrchestrator::log_timeslice_CB_blocked(cn, timeslice,
                                                              true);
 
@@ -385,11 +779,17 @@ bool InputChannelSender::try_send_timeslice(uint64_t timeslice, uint32_t cn) {
         }
         return true;
       }
+      send_blocker_[cn] = SendBlocker::PostFailed;
+      post_failed_ = true;
     } else {
       InputSchedulerOrchestrator::log_timeslice_CB_blocked(cn, timeslice);
+      send_blocker_[cn] = SendBlocker::ComputeBuffer;
     }
   } else {
     InputSchedulerOrchestrator::log_timeslice_IB_blocked(cn, timeslice);
+    send_blocker_[cn] = SendBlocker::InputBuffer;
+    awaited_desc_[cn] = desc_offset + desc_length;
+    min_awaited_desc_ = std::min(min_awaited_desc_, awaited_desc_[cn]);
   }
 
   return false;
@@ -437,38 +837,26 @@ void InputChannelSender::connect() {
 }
 
 void InputChannelSender::on_connected(struct fid_domain* pd) {
-  if (mr_data_ == nullptr) {
-    // Register memory regions.
-    int err =
-        fi_mr_reg(pd, const_cast<uint8_t*>(data_source_.data_buffer().ptr()),
-                  data_source_.data_buffer().bytes(), FI_WRITE, 0,
-                  Provider::requested_key++, 0, &mr_data_, nullptr);
-    if (err != 0) {
-      L_(fatal) << "fi_mr_reg failed for data_send_buffer: " << err << "="
-                << fi_strerror(-err);
-      throw LibfabricException("fi_mr_reg failed for data_send_buffer");
+  data_regions_.resize(conn_.size(), nullptr);
+  desc_regions_.resize(conn_.size(), nullptr);
+
+  // the registrations are shared by all connections unless the provider
+  // binds memory regions to endpoints, in which case they are per endpoint
+  bool endpoint_bound = LibfabricMRCache::endpoint_bound();
+  for (uint32_t cn = 0; cn < conn_.size(); ++cn) {
+    if (data_regions_[cn] != nullptr || conn_[cn] == nullptr) {
+      continue;
     }
-
-    if (mr_data_ == nullptr) {
-      L_(fatal) << "fi_mr_reg failed for mr_data: " << strerror(errno);
-      throw LibfabricException("registration of memory region failed");
-    }
-
-    err = fi_mr_reg(pd,
-                    const_cast<fles::MicrosliceDescriptor*>(
-                        data_source_.desc_buffer().ptr()),
-                    data_source_.desc_buffer().bytes(), FI_WRITE, 0,
-                    Provider::requested_key++, 0, &mr_desc_, nullptr);
-    if (err != 0) {
-      L_(fatal) << "fi_mr_reg failed for desc_send_buffer: " << err << "="
-                << fi_strerror(-err);
-      throw LibfabricException("fi_mr_reg failed for desc_send_buffer");
-    }
-
-    if (mr_desc_ == nullptr) {
-      L_(fatal) << "fi_mr_reg failed for mr_desc: " << strerror(errno);
-      throw LibfabricException("registration of memory region failed");
+    struct fid_ep* ep = endpoint_bound ? conn_[cn]->endpoint() : nullptr;
+    if (endpoint_bound && ep == nullptr) {
+      continue;
     }
+    data_regions_[cn] = LibfabricMRCache::getInst()->register_buffer(
+        pd, data_source_.data_buffer().ptr(),
+        data_source_.data_buffer().bytes(), FI_WRITE, ep);
+    desc_regions_[cn] = LibfabricMRCache::getInst()->register_buffer(
+        pd, data_source_.desc_buffer().ptr(),
+        data_source_.desc_buffer().bytes(), FI_WRITE, ep);
   }
 }
 
@@ -481,6 +869,12 @@ void InputChannelSender::on_rejected(struct fi_eq_err_entry* event) {
   conn->on_rejected(event);
   uint_fast16_t i = conn->index();
   conn_.at(i) = nullptr;
+  // registrations bound to the rejected endpoint cannot be reused
+  if (LibfabricMRCache::endpoint_bound() && i < data_regions_.size()) {
+    LibfabricMRCache::getInst()->release(data_regions_[i]);
+    LibfabricMRCache::getInst()->release(desc_regions_[i]);
+    data_regions_[i] = desc_regions_[i] = nullptr;
+  }
 
   L_(debug) << "retrying: " << i;
   // immediately initiate retry
@@ -491,6 +885,13 @@ void InputChannelSender::on_rejected(struct fi_eq_err_entry* event) {
   conn_.at(i) = std::move(connection);
 }
 
+void InputChannelSender::on_established(struct fi_eq_cm_entry* event) {
+  InputChannelConnection* conn =
+      static_cast<InputChannelConnection*>(event->fid->context);
+  connected_indexes_.insert(conn->index());
+  ConnectionGroup::on_established(event);
+}
+
 std::string InputChannelSender::get_state_string() {
   std::ostringstream s;
 
@@ -518,38 +919,36 @@ bool InputChannelSender::post_send_data(uint64_t timeslice,
                                         uint64_t desc_length,
                                         uint64_t data_offset,
                                         uint64_t data_length,
-                                        uint64_t skip) {
+                                        uint64_t skip,
+                                        std::pair<uint64_t, uint64_t>
+                                            last_timeslice_info) {
   int num_sge = 0;
-  struct iovec sge[4];
-  void* descs[4];
+  struct iovec sge[InputChannelConnection::MAX_SEND_SGE];
+  void* descs[InputChannelConnection::MAX_SEND_SGE];
+  assert(desc_regions_.at(cn) != nullptr && data_regions_.at(cn) != nullptr);
   // descriptors
   if ((desc_offset & data_source_.desc_buffer().size_mask()) <=
       ((desc_offset + desc_length - 1) &
        data_source_.desc_buffer().size_mask())) {
     // one chunk
-    sge[num_sge].iov_base = &data_source_.desc_buffer().at(desc_offset);
-    sge[num_sge].iov_len = sizeof(fles::MicrosliceDescriptor) * desc_length;
-    assert(mr_desc_ != nullptr);
-    descs[num_sge++] = fi_mr_desc(mr_desc_);
-    // sge[num_sge++].lkey = mr_desc_->lkey;
+    append_segment(sge, descs, num_sge, desc_regions_[cn],
+                   &data_source_.desc_buffer().at(desc_offset),
+                   sizeof(fles::MicrosliceDescriptor) * desc_length);
   } else {
     // two chunks
-    sge[num_sge].iov_base = &data_source_.desc_buffer().at(desc_offset);
-    sge[num_sge].iov_len =
+    append_segment(
+        sge, descs, num_sge, desc_regions_[cn],
+        &data_source_.desc_buffer().at(desc_offset),
         sizeof(fles::MicrosliceDescriptor) *
-        (data_source_.desc_buffer().size() -
-         (desc_offset & data_source_.desc_buffer().size_mask()));
-    // sge[num_sge++].lkey = mr_desc_->lkey;
-    descs[num_sge++] = fi_mr_desc(mr_desc_);
-    sge[num_sge].iov_base = data_source_.desc_buffer().ptr();
-    sge[num_sge].iov_len =
+            (data_source_.desc_buffer().size() -
+             (desc_offset & data_source_.desc_buffer().size_mask())));
+    append_segment(
+        sge, descs, num_sge, desc_regions_[cn],
+        data_source_.desc_buffer().ptr(),
         sizeof(fles::MicrosliceDescriptor) *
-        (desc_length - data_source_.desc_buffer().size() +
-         (desc_offset & data_source_.desc_buffer().size_mask()));
-    // sge[num_sge++].lkey = mr_desc_->lkey;
-    descs[num_sge++] = fi_mr_desc(mr_desc_);
+            (desc_length - data_source_.desc_buffer().size() +
+             (desc_offset & data_source_.desc_buffer().size_mask())));
   }
-  // int num_desc_sge = num_sge;
   // data
   if (data_length == 0) {
     // zero chunks
@@ -557,37 +956,72 @@ bool InputChannelSender::post_send_data(uint64_t timeslice,
              ((data_offset + data_length - 1) &
               data_source_.data_buffer().size_mask())) {
     // one chunk
-    sge[num_sge].iov_base = &data_source_.data_buffer().at(data_offset);
-    sge[num_sge].iov_len = data_length;
-    descs[num_sge++] = fi_mr_desc(mr_data_);
+    append_segment(sge, descs, num_sge, data_regions_[cn],
+                   &data_source_.data_buffer().at(data_offset), data_length);
   } else {
     // two chunks
-    sge[num_sge].iov_base = &data_source_.data_buffer().at(data_offset);
-    sge[num_sge].iov_len =
-        data_source_.data_buffer().size() -
-        (data_offset & data_source_.data_buffer().size_mask());
-    descs[num_sge++] = fi_mr_desc(mr_data_);
-    sge[num_sge].iov_base = data_source_.data_buffer().ptr();
-    sge[num_sge].iov_len =
-        data_length - data_source_.data_buffer().size() +
-        (data_offset & data_source_.data_buffer().size_mask());
-    descs[num_sge++] = fi_mr_desc(mr_data_);
+    append_segment(sge, descs, num_sge, data_regions_[cn],
+                   &data_source_.data_buffer().at(data_offset),
+                   data_source_.data_buffer().size() -
+                       (data_offset & data_source_.data_buffer().size_mask()));
+    append_segment(sge, descs, num_sge, data_regions_[cn],
+                   data_source_.data_buffer().ptr(),
+                   data_length - data_source_.data_buffer().size() +
+                       (data_offset & data_source_.data_buffer().size_mask()));
   }
 
   return conn_[cn]->send_data(sge, descs, num_sge, timeslice, desc_length,
-                              data_length, skip);
+                              data_length, skip, last_timeslice_info);
+}
+
+void InputChannelSender::append_segment(struct iovec* sge,
+                                        void** descs,
+                                        int& num_sge,
+                                        const LibfabricMemoryRegion* region,
+                                        void* addr,
+                                        size_t length) {
+  uint8_t* p = static_cast<uint8_t*>(addr);
+  while (length > 0) {
+    if (num_sge == InputChannelConnection::MAX_SEND_SGE) {
+      throw LibfabricException(
+          "timeslice spans too many memory region chunks");
+    }
+    size_t size = std::min(length, region->chunk_remaining(p));
+    sge[num_sge].iov_base = p;
+    sge[num_sge].iov_len = size;
+    descs[num_sge++] = region->desc(p);
+    p += size;
+    length -= size;
+  }
 }
 
 void InputChannelSender::on_completion(uint64_t wr_id) {
-  switch (wr_id & 0xFF) {
-  case ID_WRITE_DESC:
-  case ID_WRITE_DATA:
-  case ID_WRITE_DATA_WRAP: {
+  // a completion concerns the connection of the polling shard, except for a
+  // failover, which changes the state of all connections
+  uint32_t conn_index = (wr_id >> 8) & 0xFFFF;
+  bool all_shards = (wr_id & 0xFF) == ID_HEARTBEAT_RECEIVE_STATUS ||
+                    conn_index >= connection_shard_.size();
+  std::vector<std::unique_lock<std::recursive_mutex>> shard_locks;
+  if (all_shards) {
+    shard_locks = lock_all_shards();
+  } else {
+    shard_locks.emplace_back(shards_[connection_shard_[conn_index]].mutex);
+  }
+
+  // write completions only concern their connection; the DFS scheduler
+  // records them in a batch when the shard synchronizes its buffer positions
+  uint64_t wr_type = wr_id & 0xFF;
+  if (wr_type == ID_WRITE_DESC || wr_type == ID_WRITE_DATA ||
+      wr_type == ID_WRITE_DATA_WRAP) {
     uint64_t ts = wr_id >> 24;
 
     int cn = (wr_id >> 8) & 0xFFFF;
-    InputSchedulerOrchestrator::mark_timeslice_rdma_write_acked(cn, ts);
+    shards_[connection_shard_[cn]].completed_writes.emplace_back(cn, ts);
+    latency_tracer_.mark_latest(ts, LatencyTracer::written);
     conn_[cn]->on_complete_write();
+    if (send_blocker_[cn] == SendBlocker::WriteRequests) {
+      mark_connection_ready(cn);
+    }
 
     if (false) {
       L_(info) << "[i" << input_index_ << "] "
@@ -595,8 +1029,21 @@ void InputChannelSender::on_completion(uint64_t wr_id) {
                << " complete, now: acked_data_=" << acked_data_
                << " acked_desc_=" << acked_desc_;
     }
-  } break;
+    return;
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+  // the scheduler has to know all completed writes of the locked shards
+  // before it handles acknowledgements and failovers
+  if (all_shards) {
+    for (uint32_t shard = 0; shard < shards_.size(); ++shard) {
+      apply_completed_writes(shard);
+    }
+  } else {
+    apply_completed_writes(connection_shard_[conn_index]);
+  }
 
+  switch (wr_type) {
   case ID_RECEIVE_STATUS: {
     int cn = wr_id >> 8;
     uint64_t last_desc = conn_[cn]->cn_ack_desc();
@@ -606,6 +1053,10 @@ void InputChannelSender::on_completion(uint64_t wr_id) {
 
     update_data_source(cn, last_desc, new_desc);
     InputSchedulerOrchestrator::mark_timeslices_acked(cn, new_desc);
+    // the acknowledgement freed space in the compute node buffer
+    if (send_blocker_[cn] == SendBlocker::ComputeBuffer) {
+      mark_connection_ready(cn);
+    }
 
     if (!connection_oriented_ && !conn_[cn]->get_partner_addr()) {
       conn_[cn]->set_partner_addr(av_);
@@ -636,7 +1087,7 @@ void InputChannelSender::on_completion(uint64_t wr_id) {
         data_source_.get_write_index().desc);
     bool was_decision_considered = true, is_decision_considered = false;
     uint64_t failed_index = ConstVariables::MINUS_ONE, last_desc,
-             last_completed_desc;
+             last_completed_desc, timeslice_trigger;
     // Updating data source before re-arranging timeslice
     if (conn_[cn]->get_recv_heartbeat_message().failure_info.index !=
         ConstVariables::MINUS_ONE) {
@@ -648,6 +1099,9 @@ void InputChannelSender::on_completion(uint64_t wr_id) {
         last_completed_desc = conn_[cn]
                                   ->get_recv_heartbeat_message()
                                   .failure_info.last_completed_desc;
+        timeslice_trigger = conn_[cn]
+                                ->get_recv_heartbeat_message()
+                                .failure_info.timeslice_trigger;
       }
     }
 
@@ -659,6 +1113,12 @@ void InputChannelSender::on_completion(uint64_t wr_id) {
     if (failed_index != ConstVariables::MINUS_ONE && !was_decision_considered &&
         is_decision_considered) {
 
+      L_(info) << "[i" << input_index_ << "] "
+               << "failover of compute node " << failed_index
+               << " started, trigger timeslice " << timeslice_trigger;
+      pending_failovers_.push_back(
+          {failed_index, timeslice_trigger, std::chrono::steady_clock::now()});
+      failover_pending_ = true;
       LibfabricBarrier::get_instance()->deactive_endpoint(failed_index);
       update_data_source(failed_index, last_desc, last_completed_desc);
 
@@ -669,6 +1129,10 @@ void InputChannelSender::on_completion(uint64_t wr_id) {
         }
       }
       mark_connection_completed(failed_index);
+      // the timeslices and buffer positions of the failed node are
+      // redistributed over the remaining connections
+      wake_connections(SendBlocker::Schedule);
+      wake_connections(SendBlocker::ComputeBuffer);
     }
   } break;
 
@@ -680,6 +1144,12 @@ void InputChannelSender::on_completion(uint64_t wr_id) {
   case ID_DFS_RECEIVE_STATUS: {
     int cn = wr_id >> 8;
     conn_[cn]->on_complete_dfs_recv();
+    // a new proposal may assign timeslices to idle connections, which their
+    // shards wake up
+    for (uint32_t shard = 0; shard < shards_.size(); ++shard) {
+      shards_[shard].schedule_changed = true;
+      notify_shard(shard);
+    }
     break;
   }
 
@@ -697,9 +1167,92 @@ void InputChannelSender::on_completion(uint64_t wr_id) {
 }
 
 void InputChannelSender::update_compute_schedulers() {
-  for (auto& c : conn_) {
-    c->ack_complete_interval_info();
+  for (Shard& shard : shards_) {
+    std::lock_guard<std::recursive_mutex> shard_lock(shard.mutex);
+    std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+    for (uint32_t cn : shard.connections) {
+      if (cn < joined_compute_count_) {
+        conn_[cn]->ack_complete_interval_info();
+      }
+    }
+  }
+}
+
+void InputChannelSender::sync_joined_buffer_positions() {
+  for (uint32_t shard = 0; shard < shards_.size(); ++shard) {
+    sync_shard_buffer_positions(shard);
+  }
+}
+
+void InputChannelSender::sync_shard_buffer_positions(uint32_t shard) {
+  Shard& s = shards_[shard];
+  std::lock_guard<std::recursive_mutex> shard_lock(s.mutex);
+  bool sync_pending = !s.completed_writes.empty();
+  for (uint32_t cn : s.connections) {
+    if (sync_pending) {
+      break;
+    }
+    sync_pending = cn < joined_compute_count_ && conn_[cn]->sync_pending();
+  }
+  if (!sync_pending) {
+    return;
+  }
+
+  std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+  apply_completed_writes(shard);
+  for (uint32_t cn : s.connections) {
+    if (cn < joined_compute_count_) {
+      conn_[cn]->try_sync_buffer_positions();
+    }
+  }
+}
+
+void InputChannelSender::apply_completed_writes(uint32_t shard) {
+  Shard& s = shards_[shard];
+  for (const auto& write : s.completed_writes) {
+    InputSchedulerOrchestrator::mark_timeslice_rdma_write_acked(write.first,
+                                                               write.second);
+    conn_[write.first]->on_rdma_write_acked();
+  }
+  s.completed_writes.clear();
+}
+
+void InputChannelSender::join_compute_nodes() {
+  auto shard_locks = lock_all_shards();
+  std::unique_lock<std::recursive_mutex> lock(state_mutex_);
+  if (connection_oriented_) {
+    poll_cm_events();
+  } else {
+    for (uint32_t cn = joined_compute_count_; cn < conn_.size(); ++cn) {
+      if (connected_indexes_.find(cn) == connected_indexes_.end()) {
+        conn_[cn]->reconnect();
+      }
+    }
+  }
+
+  // compute nodes join in index order to keep the joined ones contiguous
+  bool joined = false;
+  while (joined_compute_count_ < conn_.size() &&
+         connected_indexes_.find(joined_compute_count_) !=
+             connected_indexes_.end()) {
+    L_(info) << "[i" << input_index_ << "] "
+             << "compute node " << joined_compute_count_ << " joined";
+    ++joined_compute_count_;
+    joined = true;
+  }
+  if (joined) {
+    InputSchedulerOrchestrator::update_compute_connection_count(
+        joined_compute_count_);
+    // the shards synchronize the buffer positions of the joined connections
+    for (uint32_t shard = 0; shard < shards_.size(); ++shard) {
+      notify_shard(shard);
+    }
   }
+  lock.unlock();
+
+  if (joined_compute_count_ < conn_.size())
+    scheduler_.add(std::bind(&InputChannelSender::join_compute_nodes, this),
+                   std::chrono::system_clock::now() + std::chrono::seconds(1));
 }
 
 void InputChannelSender::update_data_source(uint32_t compute_index,
@@ -708,36 +1261,84 @@ void InputChannelSender::update_data_source(uint32_t compute_index,
   for (uint64_t desc = old_desc + 1; desc <= new_desc; ++desc) {
     uint64_t ts = InputSchedulerOrchestrator::get_timeslice_by_descriptor(
         compute_index, desc);
-    uint64_t acked_ts = (acked_desc_ - start_index_desc_) / timeslice_size_;
     assert(ts != ConstVariables::MINUS_ONE);
-    if (ts != acked_ts) {
-      // transmission has been reordered, store completion information
-      ack_.at(ts) = ts;
-    } else {
-      // completion is for earliest pending timeslice, update indices
-      do {
-        ++acked_ts;
-      } while (ack_.at(acked_ts) > ts);
-
-      // TODO Invalid when timeslices are not fixed in size
-      acked_desc_ = acked_ts * timeslice_size_ + start_index_desc_;
-      acked_data_ = data_source_.desc_buffer().at(acked_desc_ - 1).offset +
-                    data_source_.desc_buffer().at(acked_desc_ - 1).size;
-      if (acked_data_ >= cached_acked_data_ + min_acked_data_ ||
-          acked_desc_ >= cached_acked_desc_ + min_acked_desc_) {
-        cached_acked_data_ = acked_data_;
-        cached_acked_desc_ = acked_desc_;
-        data_source_.set_read_index({cached_acked_desc_, cached_acked_data_});
-      }
+    merge_acknowledged_timeslice(ts);
+  }
+  // in sharded mode, the main thread publishes the merged acknowledgements
+  if (sender_threads_ == 1) {
+    update_acked_positions();
+  }
+}
+
+void InputChannelSender::merge_acknowledged_timeslice(uint64_t timeslice) {
+  latency_tracer_.mark(timeslice, LatencyTracer::released);
+  ack_.at(timeslice).store(timeslice, std::memory_order_release);
+
+  // whoever sees the earliest pending timeslice acknowledged advances the
+  // shared index; reordered completions are picked up on the way
+  uint64_t acked_ts = acked_ts_.load(std::memory_order_acquire);
+  while (ack_.at(acked_ts).load(std::memory_order_acquire) == acked_ts) {
+    if (acked_ts_.compare_exchange_weak(acked_ts, acked_ts + 1,
+                                        std::memory_order_acq_rel)) {
+      ++acked_ts;
     }
   }
 }
 
+void InputChannelSender::update_acked_positions() {
+  uint64_t acked_ts = acked_ts_.load(std::memory_order_acquire);
+  uint64_t acked_desc = acked_ts * timeslice_size_ + start_index_desc_;
+  if (acked_desc <= acked_desc_.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  // TODO Invalid when timeslices are not fixed in size
+  uint64_t acked_data = data_source_.desc_buffer().at(acked_desc - 1).offset +
+                        data_source_.desc_buffer().at(acked_desc - 1).size;
+  acked_data_.store(acked_data, std::memory_order_relaxed);
+  acked_desc_.store(acked_desc, std::memory_order_release);
+
+  bool release = acked_data >= cached_acked_data_ + min_acked_data_ ||
+                 acked_desc >= cached_acked_desc_ + min_acked_desc_;
+  if (!release && !failover_pending_.load(std::memory_order_acquire)) {
+    return;
+  }
+  std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+  check_failover_recovery(acked_ts);
+  if (release) {
+    cached_acked_data_ = acked_data;
+    cached_acked_desc_ = acked_desc;
+    data_source_.set_read_index({cached_acked_desc_, cached_acked_data_});
+  }
+}
+
+void InputChannelSender::check_failover_recovery(uint64_t acked_ts) {
+  std::lock_guard<std::recursive_mutex> lock(state_mutex_);
+  // a failover is recovered once every timeslice up to its trigger, including
+  // the re-sent ones of the failed node, is processed by a compute node
+  while (!pending_failovers_.empty() &&
+         pending_failovers_.front().timeslice_trigger < acked_ts) {
+    const Failover& failover = pending_failovers_.front();
+    auto duration = std::chrono::steady_clock::now() - failover.start_time;
+    uint64_t micros = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(duration)
+            .count());
+    failover_metric_.record(micros);
+    L_(info) << "[i" << input_index_ << "] "
+             << "recovered from failure of compute node "
+             << failover.compute_index << " in " << micros / 1000 << " ms";
+    pending_failovers_.pop_front();
+  }
+  failover_pending_ = !pending_failovers_.empty();
+}
+
 void InputChannelSender::mark_connection_completed(uint32_t cn) {
+  std::lock_guard<std::recursive_mutex> lock(state_mutex_);
   conn_[cn]->mark_done();
   ++connections_done_;
   all_done_ = (connections_done_ == conn_.size());
-  if (!connection_oriented_) {
+  if (!connection_oriented_ &&
+      connected_indexes_.find(cn) != connected_indexes_.end()) {
     on_disconnected(nullptr, cn);
   }
   L_(warning) << "[i" << input_index_ << "] "
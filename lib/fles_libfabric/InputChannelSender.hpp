@@ -6,25 +6,31 @@
 #include "ConnectionGroup.hpp"
 #include "DualRingBuffer.hpp"
 #include "InputChannelConnection.hpp"
+#include "LatencyTracer.hpp"
+#include "Metrics.hpp"
 #include "MicrosliceDescriptor.hpp"
 #include "RingBuffer.hpp"
+#include "SendBufferStatus.hpp"
 #include "Utility.hpp"
 #include "dfs/controller/InputSchedulerOrchestrator.hpp"
 #include "dfs/model/interval_manager/InputIntervalInfo.hpp"
 #include "dfs/model/load_balancer/ComputeIntervalMetaDataStatistics.hpp"
+#include "providers/LibfabricMRCache.hpp"
 
-#include <boost/format.hpp>
 #include <rdma/fi_domain.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <deque>
 #include <iomanip>
 #include <mutex>
 #include <set>
 #include <string>
 #include <thread>
 #include <time.h>
+#include <utility>
 #include <vector>
 
 namespace tl_libfabric {
@@ -46,7 +52,10 @@ public:
                      std::string input_node_name,
                      uint32_t scheduler_interval_length,
                      std::string log_directory,
-                     bool enable_logging);
+                     bool enable_logging,
+                     uint32_t sender_threads = 1,
+                     std::vector<double> compute_weights = {},
+                     uint32_t active_compute_count = 0);
 
   InputChannelSender(const InputChannelSender&) = delete;
   void operator=(const InputChannelSender&) = delete;
@@ -62,9 +71,15 @@ public:
 
   void operator()() override;
 
-  // A scheduling calls to send timeslices to each connection
+  // Try to send the next timeslice on each ready connection
   void send_timeslices();
 
+  // Try to send the next timeslice on each ready connection of a shard
+  void send_shard_timeslices(uint32_t shard);
+
+  // A scheduling call to release the timeslices of the current DFS round
+  void release_scheduled_timeslices();
+
   /// The central function for distributing timeslice data.
   bool try_send_timeslice(uint64_t timeslice, uint32_t cn);
 
@@ -80,6 +95,9 @@ private:
   /// Handle RDMA_CM_REJECTED event.
   void on_rejected(struct fi_eq_err_entry* event) override;
 
+  /// Handle RDMA_CM_EVENT_ESTABLISHED event.
+  void on_established(struct fi_eq_cm_entry* event) override;
+
   /// Return string describing buffer contents, suitable for debug output.
   std::string get_state_string();
 
@@ -90,7 +108,17 @@ private:
                       uint64_t desc_length,
                       uint64_t data_offset,
                       uint64_t data_length,
-                      uint64_t skip);
+                      uint64_t skip,
+                      std::pair<uint64_t, uint64_t> last_timeslice_info);
+
+  /// Append a buffer segment to a gather list, split at the chunk
+  /// boundaries of its memory registration.
+  static void append_segment(struct iovec* sge,
+                             void** descs,
+                             int& num_sge,
+                             const LibfabricMemoryRegion* region,
+                             void* addr,
+                             size_t length);
 
   /// Completion notification event dispatcher. Called by the event loop.
   void on_completion(uint64_t wr_id) override;
@@ -104,6 +132,22 @@ private:
   /// Update compute scheduler when an interval is completed
   void update_compute_schedulers();
 
+  /// Synchronize the buffer positions of the joined compute connections.
+  void sync_joined_buffer_positions();
+
+  /// Hand the completed writes of a shard to the DFS scheduler and
+  /// synchronize the buffer positions of its joined connections. The state
+  /// mutex is only taken if one of them has anything to do.
+  void sync_shard_buffer_positions(uint32_t shard);
+
+  /// Record the completed writes of a shard in the DFS scheduler (with the
+  /// shard and the state mutex locked).
+  void apply_completed_writes(uint32_t shard);
+
+  /// Connect the standby compute nodes and let the connected ones join the
+  /// scheduling in index order (periodic task).
+  void join_compute_nodes();
+
   /// Update the data source after receiving the acknowledgement
   void update_data_source(uint32_t compute_index,
                           uint64_t old_desc,
@@ -112,22 +156,104 @@ private:
   /// Mark connection as completed in case of normal termination or failure
   void mark_connection_completed(uint32_t conn_id);
 
+  /// Record an acknowledged timeslice and advance the acknowledged index
+  /// over all contiguous acknowledged timeslices (lock-free, any thread).
+  void merge_acknowledged_timeslice(uint64_t timeslice);
+
+  /// Publish acked_desc_/acked_data_ from the merged acknowledgements and
+  /// hand freed space back to the data source (main thread only). The state
+  /// mutex is only taken when the data source or a failover is concerned.
+  void update_acked_positions();
+
+  /// Log and export the recovery time of the pending failovers that are
+  /// completed by the acknowledged timeslices.
+  void check_failover_recovery(uint64_t acked_ts);
+
+  /// Assign the compute connections to the sender shards.
+  void create_shards();
+
+  /// Lock the mutexes of all shards in index order, for operations on the
+  /// connections of several shards.
+  std::vector<std::unique_lock<std::recursive_mutex>> lock_all_shards();
+
+  /// The thread main function of a sender shard.
+  void run_shard(uint32_t shard);
+
+  /// Start and stop the additional sender shard threads.
+  void start_shards();
+  void stop_shards();
+
+  /// Reason why a connection cannot send its next timeslice.
+  enum class SendBlocker : uint8_t {
+    None,          // ready to send
+    Schedule,      // timeslice not (yet) released by the DFS scheduler
+    InputBuffer,   // timeslice not yet complete in the input buffer
+    WriteRequests, // no free write request slot
+    ComputeBuffer, // not enough space in the compute node buffer
+    PostFailed     // posting the writes failed, retried after a delay
+  };
+
+  /// Append a connection to the ready queue of its shard (with the shard
+  /// locked).
+  void mark_connection_ready(uint32_t cn);
+
+  /// Move all connections blocked for the given reason to the ready queues
+  /// (with all shards locked).
+  void wake_connections(SendBlocker blocker);
+
+  /// Move the connections of a shard blocked for the given reason to its
+  /// ready queue (with the shard locked).
+  void wake_shard_connections(uint32_t shard, SendBlocker blocker);
+
+  /// Retry the connections whose posting failed (periodic task).
+  void retry_failed_posts();
+
+  /// Wake the connections waiting for microslices that became available.
+  void check_input_data();
+
+  /// Retrieve the number of sent timeslices from the DFS scheduler.
+  uint64_t sent_timeslices();
+
+  /// Check whether all connections reached the done state.
+  bool all_connections_done();
+
+  /// Poll for completions in single-threaded mode, otherwise collect the
+  /// acknowledgements merged by the sender shards. Returns the number of
+  /// completions handled.
+  int progress();
+
+  /// Wake a sender shard blocked in wait_shard().
+  void notify_shard(uint32_t shard);
+
+  /// Block a sender shard until a completion of its queues arrives, a
+  /// connection becomes ready or the timeout expires.
+  void wait_shard(uint32_t shard, std::chrono::microseconds timeout);
+
+  /// Count a pass of the main loop and block once it was idle for
+  /// idle_spin_passes_ passes in a row, at most until the next scheduler
+  /// event.
+  void wait_when_idle(bool busy);
+
   uint64_t input_index_;
 
-  /// Libfabric memory region descriptor for input data buffer.
-  struct fid_mr* mr_data_ = nullptr;
+  /// Registration of the input data buffer, per connection (shared unless
+  /// the provider binds memory regions to endpoints).
+  std::vector<const LibfabricMemoryRegion*> data_regions_;
 
-  /// Libfabric memory region descriptor for input descriptor buffer.
-  struct fid_mr* mr_desc_ = nullptr;
+  /// Registration of the input descriptor buffer, per connection.
+  std::vector<const LibfabricMemoryRegion*> desc_regions_;
 
   /// Buffer to store acknowledged status of timeslices.
-  RingBuffer<uint64_t, true> ack_;
+  RingBuffer<std::atomic<uint64_t>> ack_;
+
+  /// Number of contiguously acknowledged timeslices, merged by all shards.
+  std::atomic<uint64_t> acked_ts_{0};
 
   /// Number of acknowledged microslices. Written to FLIB.
-  uint64_t acked_desc_ = 0;
+  std::atomic<uint64_t> acked_desc_{0};
 
   /// Number of acknowledged data bytes. Written to FLIB.
-  uint64_t acked_data_ = 0;
+  std::atomic<uint64_t> acked_data_{0};
 
   /// Data source (e.g., FLIB).
   InputBufferReadInterface& data_source_;
@@ -156,61 +282,117 @@ private:
 
   uint64_t write_index_desc_ = 0;
 
-  bool abort_ = false;
-
-  struct SendBufferStatus {
-    std::chrono::system_clock::time_point time;
-    uint64_t size;
-
-    uint64_t cached_acked;
-    uint64_t acked;
-    uint64_t sent;
-    uint64_t written;
-
-    int64_t used() const {
-      assert(sent <= written);
-      return written - sent;
-    }
-    int64_t sending() const {
-      assert(acked <= sent);
-      return sent - acked;
-    }
-    int64_t freeing() const {
-      assert(cached_acked <= acked);
-      return acked - cached_acked;
-    }
-    int64_t unused() const {
-      assert(written <= sent + size);
-      return sent + size - written;
-    }
-
-    float percentage(int64_t value) const {
-      return static_cast<float>(value) / static_cast<float>(size);
-    }
-
-    std::string caption() const {
-      return std::string("used/sending/freeing/free");
-    }
-
-    std::string percentage_str(int64_t value) const {
-      boost::format percent_fmt("%4.1f%%");
-      percent_fmt % (percentage(value) * 100);
-      std::string s = percent_fmt.str();
-      s.resize(4);
-      return s;
-    }
-
-    std::string percentages() const {
-      return percentage_str(used()) + " " + percentage_str(sending()) + " " +
-             percentage_str(freeing()) + " " + percentage_str(unused());
-    }
-
-    std::vector<int64_t> vector() const {
-      return std::vector<int64_t>{used(), sending(), freeing(), unused()};
-    }
+  std::atomic<bool> abort_{false};
+
+  /// Number of compute connections taking part in the scheduling; the
+  /// remaining ones belong to standby compute nodes that did not join yet.
+  uint32_t joined_compute_count_;
+
+  /// Number of threads the compute connections are sharded across.
+  uint32_t sender_threads_;
+
+  /// A group of compute connections served by one sender thread. The
+  /// shard mutex guards the connections and their send state. Lock order:
+  /// shard mutexes in index order, then state_mutex_.
+  struct Shard {
+    /// Compute connection indexes handled by the shard.
+    std::vector<uint32_t> connections;
+
+    /// Connections that may be able to send a timeslice.
+    std::deque<uint32_t> ready;
+
+    std::recursive_mutex mutex;
+
+    /// Set when a connection is queued, so that idle passes are skipped.
+    std::atomic<bool> ready_pending{false};
+
+    /// Set when DFS proposals may have released timeslices to connections
+    /// blocked by the schedule.
+    std::atomic<bool> schedule_changed{false};
+
+    /// Completed RDMA writes (connection, timeslice) not yet recorded in the
+    /// DFS scheduler.
+    std::vector<std::pair<uint32_t, uint64_t>> completed_writes;
+
+    /// Event file descriptor waking the shard from wait_shard().
+    int event_fd = -1;
+
+    /// Set while the shard is blocked (or about to block) in wait_shard().
+    std::atomic<bool> sleeping{false};
   };
 
+  std::deque<Shard> shards_;
+
+  /// Sender shard threads; in sharded mode the main thread only does the
+  /// housekeeping (data source, heartbeats, status reports).
+  std::vector<std::thread> shard_threads_;
+
+  /// Flag causing termination of the sender shard threads.
+  std::atomic<bool> stop_shards_{false};
+
+  /// Number of passes without work a sender loop spins before it blocks.
+  static constexpr uint32_t idle_spin_passes_ = 64;
+
+  /// Longest block of an idle sender loop.
+  static constexpr std::chrono::microseconds idle_wait_max_{1000};
+
+  /// Longest block while connections wait for input data, whose arrival
+  /// is not signalled.
+  static constexpr std::chrono::microseconds input_wait_max_{100};
+
+  /// Consecutive idle passes of the main loop.
+  uint32_t idle_passes_ = 0;
+
+  /// Serializes the DFS scheduler, the data source and the state shared by
+  /// the shards. The writes of a timeslice are posted, their completions
+  /// handled and the acknowledgements merged without it.
+  std::recursive_mutex state_mutex_;
+
+  /// Shard index of each connection.
+  std::vector<uint32_t> connection_shard_;
+
+  /// Flag whether a connection is currently in its ready queue (bytes, as
+  /// the shards write their elements concurrently).
+  std::vector<uint8_t> connection_queued_;
+
+  /// Reason why a connection left its ready queue.
+  std::vector<SendBlocker> send_blocker_;
+
+  /// Timeslice a connection blocked by the DFS scheduler waits for.
+  std::vector<uint64_t> awaited_timeslice_;
+
+  /// Microslice index a connection blocked by the input buffer waits for.
+  std::vector<uint64_t> awaited_desc_;
+
+  /// Lowest microslice index awaited by any connection.
+  uint64_t min_awaited_desc_ = UINT64_MAX;
+
+  /// Set when posting failed on a connection.
+  std::atomic<bool> post_failed_{false};
+
   SendBufferStatus previous_send_buffer_status_desc_ = SendBufferStatus();
   SendBufferStatus previous_send_buffer_status_data_ = SendBufferStatus();
+
+  /// Exported fill levels of the input buffers.
+  BufferMetrics desc_metrics_;
+  BufferMetrics data_metrics_;
+
+  /// Sampled latencies of the timeslice sending stages.
+  LatencyTracer latency_tracer_;
+
+  struct Failover {
+    uint64_t compute_index;
+    uint64_t timeslice_trigger;
+    std::chrono::steady_clock::time_point start_time;
+  };
+
+  /// Compute node failures whose timeslices are not all processed yet.
+  std::deque<Failover> pending_failovers_;
+
+  /// Set while pending_failovers_ is not empty, checked without the lock.
+  std::atomic<bool> failover_pending_{false};
+
+  /// Exported recovery time of compute node failures.
+  MetricsHistogram& failover_metric_;
 };
 } // namespace tl_libfabric
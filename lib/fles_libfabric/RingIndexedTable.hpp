@@ -0,0 +1,175 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <assert.h>
+#include <cstdint>
+#include <vector>
+
+namespace tl_libfabric {
+/**
+ * Table of values keyed by a monotonically advancing sequence number, e.g. a
+ * timeslice or descriptor index. The values live in a preallocated ring of
+ * power-of-two size and are addressed directly by key, so lookups, inserts
+ * and removals are O(1) and do not allocate. Keys of at most capacity()
+ * consecutive numbers are kept; advancing beyond that drops the oldest ones,
+ * so callers that must account for every entry check would_evict() first.
+ */
+template <typename VALUE> class RingIndexedTable {
+public:
+  RingIndexedTable(uint64_t min_capacity);
+  RingIndexedTable(const RingIndexedTable&) = delete;
+  RingIndexedTable& operator=(const RingIndexedTable&) = delete;
+  RingIndexedTable(RingIndexedTable&&) = default;
+  RingIndexedTable& operator=(RingIndexedTable&&) = default;
+
+  // Reserve the slot of a new key and return it for in-place initialization;
+  // nullptr if the key exists or is older than the window
+  VALUE* insert(const uint64_t key);
+
+  bool add(const uint64_t key, const VALUE& val);
+
+  bool remove(const uint64_t key);
+
+  bool contains(const uint64_t key) const;
+
+  // Whether inserting the key would drop the oldest key out of the window
+  bool would_evict(const uint64_t key) const;
+
+  bool empty() const;
+
+  uint64_t size() const;
+
+  uint64_t capacity() const;
+
+  VALUE& get(const uint64_t key);
+
+  const VALUE& get(const uint64_t key) const;
+
+  uint64_t get_first_key() const;
+
+  uint64_t get_last_key() const;
+
+private:
+  static constexpr uint64_t EMPTY_KEY = UINT64_MAX;
+
+  uint64_t slot(const uint64_t key) const { return key & (capacity_ - 1); }
+
+  uint64_t capacity_;
+  std::vector<uint64_t> keys_;
+  std::vector<VALUE> values_;
+  uint64_t size_ = 0;
+  uint64_t first_key_ = 0;
+  uint64_t last_key_ = 0;
+};
+
+template <typename VALUE>
+RingIndexedTable<VALUE>::RingIndexedTable(uint64_t min_capacity)
+    : capacity_(1) {
+  while (capacity_ < min_capacity)
+    capacity_ <<= 1;
+  keys_.resize(capacity_, EMPTY_KEY);
+  values_.resize(capacity_);
+}
+
+template <typename VALUE>
+VALUE* RingIndexedTable<VALUE>::insert(const uint64_t key) {
+  assert(key != EMPTY_KEY);
+  if (contains(key))
+    return nullptr;
+
+  if (size_ == 0) {
+    first_key_ = last_key_ = key;
+  } else if (key > last_key_) {
+    // drop the keys falling out of the window
+    while (size_ > 0 && key - first_key_ >= capacity_)
+      remove(first_key_);
+    if (size_ == 0)
+      first_key_ = key;
+    last_key_ = key;
+  } else if (key < first_key_) {
+    if (last_key_ - key >= capacity_)
+      return nullptr;
+    first_key_ = key;
+  }
+
+  keys_[slot(key)] = key;
+  ++size_;
+  return &values_[slot(key)];
+}
+
+template <typename VALUE>
+bool RingIndexedTable<VALUE>::add(const uint64_t key, const VALUE& val) {
+  VALUE* value = insert(key);
+  if (value == nullptr)
+    return false;
+  *value = val;
+  return true;
+}
+
+template <typename VALUE>
+bool RingIndexedTable<VALUE>::remove(const uint64_t key) {
+  if (!contains(key))
+    return false;
+
+  keys_[slot(key)] = EMPTY_KEY;
+  --size_;
+  if (size_ == 0)
+    return true;
+  if (key == first_key_) {
+    do {
+      ++first_key_;
+    } while (!contains(first_key_));
+  } else if (key == last_key_) {
+    do {
+      --last_key_;
+    } while (!contains(last_key_));
+  }
+  return true;
+}
+
+template <typename VALUE>
+bool RingIndexedTable<VALUE>::contains(const uint64_t key) const {
+  return key != EMPTY_KEY && keys_[slot(key)] == key;
+}
+
+template <typename VALUE>
+bool RingIndexedTable<VALUE>::would_evict(const uint64_t key) const {
+  return size_ > 0 && key > last_key_ && key - first_key_ >= capacity_;
+}
+
+template <typename VALUE> bool RingIndexedTable<VALUE>::empty() const {
+  return size_ == 0;
+}
+
+template <typename VALUE> uint64_t RingIndexedTable<VALUE>::size() const {
+  return size_;
+}
+
+template <typename VALUE> uint64_t RingIndexedTable<VALUE>::capacity() const {
+  return capacity_;
+}
+
+template <typename VALUE>
+VALUE& RingIndexedTable<VALUE>::get(const uint64_t key) {
+  assert(contains(key));
+  return values_[slot(key)];
+}
+
+template <typename VALUE>
+const VALUE& RingIndexedTable<VALUE>::get(const uint64_t key) const {
+  assert(contains(key));
+  return values_[slot(key)];
+}
+
+template <typename VALUE>
+uint64_t RingIndexedTable<VALUE>::get_first_key() const {
+  assert(!empty());
+  return first_key_;
+}
+
+template <typename VALUE>
+uint64_t RingIndexedTable<VALUE>::get_last_key() const {
+  assert(!empty());
+  return last_key_;
+}
+} // namespace tl_libfabric
@@ -21,6 +21,9 @@ TimesliceBuilder::TimesliceBuilder(
     uint32_t scheduler_speedup_interval_count,
     uint32_t scheduler_balancer_difference_percentage,
     uint32_t scheduler_balancer_interval_count,
+    std::string scheduler_balancer_policies,
+    std::vector<double> scheduler_compute_weights,
+    uint32_t active_compute_count,
     std::string log_directory,
     bool enable_logging)
     : ConnectionGroup(local_node_name), compute_index_(compute_index),
@@ -28,7 +31,14 @@ TimesliceBuilder::TimesliceBuilder(
       num_input_nodes_(num_input_nodes), timeslice_size_(timeslice_size),
       ack_(timeslice_buffer_.get_desc_size_exp()),
       signal_status_(signal_status), local_node_name_(local_node_name),
-      drop_(drop), log_directory_(log_directory) {
+      drop_(drop), standby_(compute_index >= active_compute_count),
+      latency_tracer_(LatencyTracer::Role::compute, "libfabric",
+                      compute_index),
+      lost_metric_(MetricsRegistry::instance().counter(
+          "flesnet_timeslices_lost_total",
+          "Timeslices completed without processing after a timeout",
+          metrics_labels("libfabric", "compute", compute_index))),
+      log_directory_(log_directory) {
   listening_cq_ = nullptr;
   assert(timeslice_buffer_.get_num_input_nodes() == num_input_nodes);
   assert(not local_node_name_.empty());
@@ -39,14 +49,15 @@ TimesliceBuilder::TimesliceBuilder(
   }
   DDSchedulerOrchestrator::initialize(
       compute_index, num_input_nodes, ConstVariables::INIT_HEARTBEAT_TIMEOUT,
-      ConstVariables::HEARTBEAT_TIMEOUT_HISTORY_SIZE,
-      ConstVariables::HEARTBEAT_TIMEOUT_FACTOR,
-      ConstVariables::HEARTBEAT_INACTIVE_FACTOR,
+      ConstVariables::HEARTBEAT_INACTIVE_PHI,
+      ConstVariables::HEARTBEAT_TIMEOUT_PHI,
       ConstVariables::HEARTBEAT_INACTIVE_RETRY_COUNT, scheduler_history_size,
       scheduler_interval_length, scheduler_speedup_difference_percentage,
       scheduler_speedup_percentage, scheduler_speedup_interval_count,
       scheduler_balancer_difference_percentage,
-      scheduler_balancer_interval_count, log_directory, enable_logging);
+      scheduler_balancer_interval_count, scheduler_balancer_policies,
+      scheduler_compute_weights, active_compute_count, log_directory,
+      enable_logging);
 }
 
 TimesliceBuilder::~TimesliceBuilder() {}
@@ -57,15 +68,34 @@ void TimesliceBuilder::report_status() {
   std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
 
   L_(debug) << "[c" << compute_index_ << "] " << completely_written_
-            << " completely written, " << acked_ << " acked";
+            << " completely written, " << ack_.acked() << " acked";
 
   // LOGGING
   // TODO should be double
   std::vector<uint64_t> buffer_percentage(conn_.size());
   //
+  if (data_metrics_.size() < conn_.size()) {
+    desc_metrics_.resize(conn_.size());
+    data_metrics_.resize(conn_.size());
+  }
   for (auto& c : conn_) {
     auto status_desc = c->buffer_status_desc();
     auto status_data = c->buffer_status_data();
+    if (!data_metrics_[c->index()]) {
+      std::string labels = metrics_labels("libfabric", "compute",
+                                          compute_index_) +
+                           ",input=\"" + std::to_string(c->index()) + "\"";
+      desc_metrics_[c->index()] =
+          std::make_unique<BufferMetrics>("timeslice_desc", labels);
+      data_metrics_[c->index()] =
+          std::make_unique<BufferMetrics>("timeslice_data", labels);
+    }
+    desc_metrics_[c->index()]->update(status_desc.used(), 0,
+                                      status_desc.freeing(), status_desc.size,
+                                      status_desc.acked);
+    data_metrics_[c->index()]->update(status_data.used(), 0,
+                                      status_data.freeing(), status_data.size,
+                                      status_data.acked);
     L_(debug) << "[c" << compute_index_ << "] desc "
               << status_desc.percentages() << " (used..free) | "
               << human_readable_count(status_desc.acked, true, "")
@@ -108,8 +138,7 @@ void TimesliceBuilder::bootstrap_with_connections() {
 }
 
 // @todo duplicate code
-void TimesliceBuilder::make_endpoint_named(struct fi_info* info,
-                                           const std::string& hostname,
+void TimesliceBuilder::make_endpoint_named(const std::string& hostname,
                                            const std::string& service,
                                            struct fid_ep** ep) {
 
@@ -117,19 +146,14 @@ void TimesliceBuilder::make_endpoint_named(struct fi_info* info,
   int res;
 
   struct fi_info* info2 = nullptr;
-  struct fi_info* hints = Provider::get_hints(
-      info->ep_attr->type, info->fabric_attr->prov_name); // fi_dupinfo(info);
-
-  int err = fi_getinfo(FIVERSION, hostname.c_str(), service.c_str(), FI_SOURCE,
-                       hints, &info2);
+  int err = Provider::getInst()->get_named_info(hostname, service, FI_SOURCE,
+                                                &info2);
   if (err != 0) {
     L_(fatal) << "fi_getinfo failed in make_endpoint named: " << err << "="
               << fi_strerror(-err);
     throw LibfabricException("fi_getinfo failed in make_endpoint named");
   }
 
-  fi_freeinfo(hints);
-
   // private cq for listening ep
   struct fi_cq_attr cq_attr;
   memset(&cq_attr, 0, sizeof(cq_attr));
@@ -196,6 +220,7 @@ void TimesliceBuilder::make_endpoint_named(struct fi_info* info,
     throw LibfabricException(
         "registration of memory region failed in TimesliceBuilder");
   }
+  LibfabricMRCache::bind_to_endpoint(mr_recv_, *ep);
 }
 
 void TimesliceBuilder::bootstrap_wo_connections() {
@@ -211,8 +236,7 @@ void TimesliceBuilder::bootstrap_wo_connections() {
                                             pd_, true);
 
   // listening endpoint with private cq
-  make_endpoint_named(Provider::getInst()->get_info(), local_node_name_,
-                      std::to_string(service_), &ep_);
+  make_endpoint_named(local_node_name_, std::to_string(service_), &ep_);
 
   // setup connection objects
   for (size_t index = 0; index < conn_.size(); index++) {
@@ -224,7 +248,7 @@ void TimesliceBuilder::bootstrap_wo_connections() {
         eq_, pd_, completion_queue(index), av_, index, compute_index_, data_ptr,
         timeslice_buffer_.get_data_size_exp(), desc_ptr,
         timeslice_buffer_.get_desc_size_exp()));
-    conn->setup_mr(pd_);
+    // the memory regions are set up with the endpoint of the connection
     conn->setup();
     conn_.at(index) = std::move(conn);
   }
@@ -238,6 +262,7 @@ void TimesliceBuilder::bootstrap_wo_connections() {
               << "=" << fi_strerror(-err);
     throw LibfabricException("fi_mr_reg failed for recv msg in compute-buffer");
   }
+  LibfabricMRCache::bind_to_endpoint(mr_recv_connect, ep_);
 
   // prepare recv message
   recv_sge.iov_base = &recv_connect_message;
@@ -329,9 +354,16 @@ void TimesliceBuilder::operator()() {
       bootstrap_wo_connections();
     }
 
-    L_(info) << "Calling Barrier ...";
-    LibfabricBarrier::get_instance()->call_barrier();
-    L_(info) << "Done Barrier ...";
+    // a standby compute node joins after the running input nodes passed
+    // their barrier; it is added to the load distribution once all of them
+    // are connected
+    if (standby_) {
+      L_(info) << "[c" << compute_index_ << "] joining the running system";
+    } else {
+      L_(info) << "Calling Barrier ...";
+      LibfabricBarrier::get_instance()->call_barrier();
+      L_(info) << "Done Barrier ...";
+    }
     time_begin_ = std::chrono::high_resolution_clock::now();
     DDSchedulerOrchestrator::set_begin_time(time_begin_);
 
@@ -363,6 +395,8 @@ void TimesliceBuilder::operator()() {
 
     build_time_file();
     summary();
+    L_(info) << "summary: " << lost_timeslices_
+             << " timeslices lost due to timeouts";
   } catch (std::exception& e) {
     L_(error) << "exception in TimesliceBuilder: " << e.what();
   }
@@ -442,7 +476,15 @@ void TimesliceBuilder::on_completion(uint64_t wr_id) {
   } break;
 
   case ID_RECEIVE_STATUS: {
+    uint64_t old_desc = conn_[in]->cn_wp().desc;
     conn_[in]->on_complete_recv();
+    uint64_t new_desc = conn_[in]->cn_wp().desc;
+    if (new_desc > old_desc) {
+      latency_tracer_.mark_range(old_desc, new_desc,
+                                 LatencyTracer::first_contribution);
+      latency_tracer_.mark_latest_range(old_desc, new_desc,
+                                        LatencyTracer::last_contribution);
+    }
   } break;
 
   case ID_HEARTBEAT_RECEIVE_STATUS: {
@@ -478,19 +520,19 @@ void TimesliceBuilder::poll_ts_completion() {
     fles::TimesliceCompletion c;
     if (!timeslice_buffer_.try_receive_completion(c))
       break;
-    if (c.ts_pos == acked_) {
-      do {
-        DDSchedulerOrchestrator::log_timeslice_processing_completion(acked_);
-        ++acked_;
-      } while (ack_.at(acked_) > c.ts_pos);
+    latency_tracer_.mark(c.ts_pos, LatencyTracer::completed);
+    uint64_t acked = ack_.acked();
+    if (ack_.acknowledge(c.ts_pos)) {
+      for (; acked < ack_.acked(); ++acked) {
+        DDSchedulerOrchestrator::log_timeslice_processing_completion(acked);
+      }
       for (auto& connection : conn_) {
         // check timed out timeslice
-        if (acked_ > connection->cn_wp().desc)
+        if (acked > connection->cn_wp().desc)
           continue;
-        connection->inc_ack_pointers(acked_);
+        connection->inc_ack_pointers(acked);
       }
-    } else
-      ack_.at(c.ts_pos) = c.ts_pos;
+    }
   }
 }
 
@@ -544,11 +586,16 @@ void TimesliceBuilder::process_completed_timeslices() {
       const fles::TimesliceComponentDescriptor& acked_ts =
           timeslice_buffer_.get_desc(0, ts_pos);
       uint64_t ts_index = acked_ts.ts_num;
+      latency_tracer_.mark(ts_pos, LatencyTracer::dispatched);
       timeslice_buffer_.send_work_item({{ts_index, ts_pos, timeslice_size_,
                                          static_cast<uint32_t>(conn_.size())},
                                         timeslice_buffer_.get_data_size_exp(),
                                         timeslice_buffer_.get_desc_size_exp()});
     } else {
+      if (timed_out) {
+        ++lost_timeslices_;
+        lost_metric_.add();
+      }
       timeslice_buffer_.send_completion({ts_pos});
     }
   }
@@ -561,7 +608,9 @@ void TimesliceBuilder::sync_heartbeat() {
   check_inactive_connections();
 
   scheduler_.add(std::bind(&TimesliceBuilder::sync_heartbeat, this),
-                 std::chrono::system_clock::now() + std::chrono::seconds(1));
+                 std::chrono::system_clock::now() +
+                     std::chrono::microseconds(
+                         ConstVariables::HEARTBEAT_CHECK_INTERVAL));
 }
 
 void TimesliceBuilder::check_missing_connections_failure_info() {
@@ -2,11 +2,13 @@
 // Copyright 2016 Thorsten Schuett <schuett@zib.de>, Farouk Salem <salem@zib.de>
 #pragma once
 
+#include "AckRing.hpp"
 #include "ChildProcessManager.hpp"
 #include "ComputeNodeConnection.hpp"
 #include "ConnectionGroup.hpp"
+#include "LatencyTracer.hpp"
+#include "Metrics.hpp"
 #include "RequestIdentifier.hpp"
-#include "RingBuffer.hpp"
 #include "TimesliceBuffer.hpp"
 #include "TimesliceCompletion.hpp"
 #include "TimesliceComponentDescriptor.hpp"
@@ -50,6 +52,9 @@ public:
                    uint32_t scheduler_speedup_interval_count,
                    uint32_t scheduler_balancer_difference_percentage,
                    uint32_t scheduler_balancer_interval_count,
+                   std::string scheduler_balancer_policies,
+                   std::vector<double> scheduler_compute_weights,
+                   uint32_t active_compute_count,
                    std::string log_directory,
                    bool enable_logging);
 
@@ -83,8 +88,7 @@ private:
   /// setup connections between nodes
   void bootstrap_wo_connections();
 
-  void make_endpoint_named(struct fi_info* info,
-                           const std::string& hostname,
+  void make_endpoint_named(const std::string& hostname,
                            const std::string& service,
                            struct fid_ep** ep);
 
@@ -132,10 +136,9 @@ private:
   uint32_t timeslice_size_;
 
   uint64_t completely_written_ = 0;
-  uint64_t acked_ = 0;
 
-  /// Buffer to store acknowledged status of timeslices.
-  RingBuffer<uint64_t, true> ack_;
+  /// Acknowledgment status of timeslices.
+  AckRing ack_;
 
   volatile sig_atomic_t* signal_status_;
 
@@ -143,6 +146,24 @@ private:
 
   bool drop_;
 
+  /// Whether this compute node joins the running system instead of starting
+  /// the run.
+  bool standby_;
+
+  /// Exported fill levels of the per-connection receive buffers.
+  std::vector<std::unique_ptr<BufferMetrics>> desc_metrics_;
+  std::vector<std::unique_ptr<BufferMetrics>> data_metrics_;
+
+  /// Sampled latencies of the timeslice building stages.
+  LatencyTracer latency_tracer_;
+
+  /// Number of timeslices completed without processing because not all of
+  /// their contributions arrived, e.g., after an input node failure.
+  uint64_t lost_timeslices_ = 0;
+
+  /// Exported count of the lost timeslices.
+  MetricsCounter& lost_metric_;
+
   // LOGGING
   std::string log_directory_;
   // END OF LOGGING
@@ -0,0 +1,217 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace tl_libfabric {
+/**
+ * Assignment of timeslices to compute nodes, kept per interval instead of per
+ * timeslice. An interval is described by its first and last timeslice and the
+ * load of each compute node. The load is quantized into integer weights and
+ * interleaved by smooth weighted round robin into a pattern of sum(weights)
+ * slots that repeats until the end of the interval. Every node holding the
+ * same intervals thus derives the same owner of any timeslice. The owner is
+ * found by a binary search over the intervals and is then O(1) within the
+ * interval; next() and count() only visit the intervals they span.
+ */
+class TimesliceSchedule {
+public:
+  static constexpr uint64_t NONE = UINT64_MAX;
+  static constexpr uint32_t NO_OWNER = UINT32_MAX;
+
+  // Slots of the repeating pattern per unit of load
+  static constexpr uint32_t DEFAULT_RESOLUTION = 32;
+
+  explicit TimesliceSchedule(uint32_t resolution = DEFAULT_RESOLUTION)
+      : resolution_(resolution) {
+    assert(resolution_ > 0);
+  }
+
+  // Schedule the timeslices [start_ts, last_ts], which have to follow the
+  // last scheduled timeslice directly
+  void add(uint64_t start_ts,
+           uint64_t last_ts,
+           const std::vector<double>& load);
+
+  // Drop the schedule of all timeslices after last_ts
+  void truncate(uint64_t last_ts);
+
+  // Drop the intervals that end before timeslice
+  void release(uint64_t timeslice);
+
+  bool empty() const { return intervals_.empty(); }
+
+  // The first timeslice that is not scheduled yet
+  uint64_t end() const {
+    return intervals_.empty() ? 0 : intervals_.back().last_ts + 1;
+  }
+
+  // The compute node of a timeslice, NO_OWNER if it is not scheduled
+  uint32_t owner(uint64_t timeslice) const;
+
+  // The first timeslice from timeslice on that is assigned to a compute node,
+  // NONE if there is no such scheduled timeslice
+  uint64_t next(uint32_t compute_index, uint64_t timeslice) const;
+
+  // The count of timeslices in [first_ts, last_ts] assigned to a compute node
+  uint64_t count(uint32_t compute_index,
+                 uint64_t first_ts,
+                 uint64_t last_ts) const;
+
+private:
+  struct Interval {
+    uint64_t start_ts;
+    uint64_t last_ts;
+    // The compute node of each slot of the pattern
+    std::vector<uint32_t> pattern;
+    // The slots of each compute node in ascending order
+    std::vector<std::vector<uint32_t>> slots;
+  };
+
+  // The first interval that does not end before a timeslice
+  std::deque<Interval>::const_iterator first_from(uint64_t timeslice) const;
+
+  // The interval containing a timeslice, nullptr if none
+  const Interval* find(uint64_t timeslice) const;
+
+  // The count of timeslices in [start_ts, timeslice] of an interval assigned
+  // to a compute node
+  static uint64_t count_up_to(const Interval& interval,
+                              uint32_t compute_index,
+                              uint64_t timeslice);
+
+  uint32_t resolution_;
+
+  std::deque<Interval> intervals_;
+};
+
+inline void TimesliceSchedule::add(uint64_t start_ts,
+                                   uint64_t last_ts,
+                                   const std::vector<double>& load) {
+  assert(intervals_.empty() || start_ts == end());
+  assert(start_ts <= last_ts && !load.empty());
+
+  std::vector<uint32_t> weights(load.size());
+  uint32_t total = 0;
+  for (uint32_t i = 0; i < load.size(); ++i) {
+    weights[i] = static_cast<uint32_t>(
+        std::lround(std::max(load[i], 0.0) * resolution_));
+    total += weights[i];
+  }
+  if (total == 0) {
+    std::fill(weights.begin(), weights.end(), 1);
+    total = static_cast<uint32_t>(weights.size());
+  }
+
+  Interval interval{start_ts, last_ts, {}, {}};
+  interval.pattern.reserve(total);
+  interval.slots.resize(weights.size());
+  std::vector<int64_t> current(weights.size(), 0);
+  for (uint32_t slot = 0; slot < total; ++slot) {
+    uint32_t selected = 0;
+    for (uint32_t i = 0; i < weights.size(); ++i) {
+      current[i] += weights[i];
+      if (current[i] > current[selected])
+        selected = i;
+    }
+    current[selected] -= total;
+    interval.pattern.push_back(selected);
+    interval.slots[selected].push_back(slot);
+  }
+  intervals_.push_back(std::move(interval));
+}
+
+inline void TimesliceSchedule::truncate(uint64_t last_ts) {
+  while (!intervals_.empty() && intervals_.back().start_ts > last_ts)
+    intervals_.pop_back();
+  if (!intervals_.empty() && intervals_.back().last_ts > last_ts)
+    intervals_.back().last_ts = last_ts;
+}
+
+inline void TimesliceSchedule::release(uint64_t timeslice) {
+  while (!intervals_.empty() && intervals_.front().last_ts < timeslice)
+    intervals_.pop_front();
+}
+
+inline uint32_t TimesliceSchedule::owner(uint64_t timeslice) const {
+  const Interval* interval = find(timeslice);
+  if (interval == nullptr)
+    return NO_OWNER;
+  return interval->pattern[(timeslice - interval->start_ts) %
+                           interval->pattern.size()];
+}
+
+inline uint64_t TimesliceSchedule::next(uint32_t compute_index,
+                                        uint64_t timeslice) const {
+  for (auto it = first_from(timeslice); it != intervals_.end(); ++it) {
+    const Interval& interval = *it;
+    if (compute_index >= interval.slots.size() ||
+        interval.slots[compute_index].empty())
+      continue;
+    const std::vector<uint32_t>& slots = interval.slots[compute_index];
+    uint64_t period = interval.pattern.size();
+    uint64_t offset =
+        timeslice > interval.start_ts ? timeslice - interval.start_ts : 0;
+    uint64_t period_start = offset - offset % period;
+    auto slot = std::lower_bound(slots.begin(), slots.end(), offset % period);
+    uint64_t next_ts =
+        interval.start_ts +
+        (slot != slots.end() ? period_start + *slot
+                             : period_start + period + slots.front());
+    if (next_ts <= interval.last_ts)
+      return next_ts;
+  }
+  return NONE;
+}
+
+inline uint64_t TimesliceSchedule::count(uint32_t compute_index,
+                                         uint64_t first_ts,
+                                         uint64_t last_ts) const {
+  uint64_t count = 0;
+  for (auto it = first_from(first_ts);
+       it != intervals_.end() && it->start_ts <= last_ts; ++it) {
+    const Interval& interval = *it;
+    count += count_up_to(interval, compute_index,
+                         std::min(last_ts, interval.last_ts));
+    if (first_ts > interval.start_ts)
+      count -= count_up_to(interval, compute_index, first_ts - 1);
+  }
+  return count;
+}
+
+inline std::deque<TimesliceSchedule::Interval>::const_iterator
+TimesliceSchedule::first_from(uint64_t timeslice) const {
+  // the intervals are contiguous, so their last timeslices are sorted
+  return std::lower_bound(intervals_.begin(), intervals_.end(), timeslice,
+                          [](const Interval& interval, uint64_t ts) {
+                            return interval.last_ts < ts;
+                          });
+}
+
+inline const TimesliceSchedule::Interval*
+TimesliceSchedule::find(uint64_t timeslice) const {
+  auto it = first_from(timeslice);
+  if (it == intervals_.end() || it->start_ts > timeslice)
+    return nullptr;
+  return &*it;
+}
+
+inline uint64_t TimesliceSchedule::count_up_to(const Interval& interval,
+                                               uint32_t compute_index,
+                                               uint64_t timeslice) {
+  if (compute_index >= interval.slots.size())
+    return 0;
+  const std::vector<uint32_t>& slots = interval.slots[compute_index];
+  uint64_t period = interval.pattern.size();
+  uint64_t offset = timeslice - interval.start_ts;
+  return (offset / period) * slots.size() +
+         static_cast<uint64_t>(std::upper_bound(slots.begin(), slots.end(),
+                                                offset % period) -
+                               slots.begin());
+}
+} // namespace tl_libfabric
@@ -5,13 +5,18 @@
 
 namespace tl_libfabric {
 
-uint64_t StatisticsCalculator::get_median_of_list(std::vector<uint64_t> list) {
-  std::sort(list.begin(), list.end());
-  return list[(list.size() / 2)];
+uint64_t
+StatisticsCalculator::get_median_of_list(const std::vector<uint64_t>& list) {
+  assert(!list.empty());
+  std::vector<uint64_t> values(list);
+  auto middle = values.begin() + values.size() / 2;
+  std::nth_element(values.begin(), middle, values.end());
+  return *middle;
 }
 
 StatisticsCalculator::ListStatistics
-StatisticsCalculator::calculate_list_statistics(std::vector<uint64_t> list) {
+StatisticsCalculator::calculate_list_statistics(
+    const std::vector<uint64_t>& list) {
   // TODO assert(!list.empty());
   StatisticsCalculator::ListStatistics stats;
   if (list.empty()) {
@@ -1,4 +1,7 @@
 // Copyright 2020 Farouk Salem <salem@zib.de>
+#pragma once
+
+#include "HdrHistogram.hpp"
 
 #include <algorithm>
 #include <cassert>
@@ -16,8 +19,14 @@ public:
     uint64_t min_val, max_val, median_val, sum_val;
     uint32_t min_indx, max_indx;
   };
-  static uint64_t get_median_of_list(std::vector<uint64_t> list);
-  static ListStatistics calculate_list_statistics(std::vector<uint64_t> list);
+
+  // Fixed-memory distribution of durations/latencies (in microseconds) with
+  // O(1) insertion and removal, used instead of sorting value histories
+  using Histogram = HdrHistogram<>;
+
+  static uint64_t get_median_of_list(const std::vector<uint64_t>& list);
+  static ListStatistics
+  calculate_list_statistics(const std::vector<uint64_t>& list);
 };
 
 } /* namespace tl_libfabric */
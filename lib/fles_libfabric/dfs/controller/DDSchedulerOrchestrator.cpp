@@ -9,9 +9,8 @@ void DDSchedulerOrchestrator::initialize(
     uint32_t scheduler_index,
     uint32_t input_scheduler_count,
     uint64_t init_heartbeat_timeout,
-    uint32_t timeout_history_size,
-    uint32_t timeout_factor,
-    uint32_t inactive_factor,
+    double inactive_phi,
+    double timeout_phi,
     uint32_t inactive_retry_count,
     uint32_t history_size,
     uint32_t interval_length,
@@ -20,11 +19,19 @@ void DDSchedulerOrchestrator::initialize(
     uint32_t speedup_interval_count,
     uint32_t balancer_difference_percentage,
     uint32_t balancer_interval_count,
+    std::string balancer_policies,
+    std::vector<double> compute_weights,
+    uint32_t compute_count,
     std::string log_directory,
     bool enable_logging) {
   compute_interval_data_manager_ = ComputeIntervalDataManager::get_instance(
       scheduler_index, history_size, log_directory, enable_logging);
   ComputeLoggerProxy::init_instance(input_scheduler_count);
+  if (enable_logging) {
+    TraceRecorder::start(log_directory + "/" +
+                             std::to_string(scheduler_index) + ".compute.trace",
+                         1, scheduler_index);
+  }
   interval_scheduler_ = DDScheduler::get_instance(
       scheduler_index, input_scheduler_count, history_size, interval_length,
       speedup_difference_percentage, speedup_percentage, speedup_interval_count,
@@ -34,14 +41,14 @@ void DDSchedulerOrchestrator::initialize(
       enable_logging);
   heartbeat_manager_ = ComputeHeartbeatManager::get_instance(
       scheduler_index, input_scheduler_count, init_heartbeat_timeout,
-      timeout_history_size, timeout_factor, inactive_factor,
-      inactive_retry_count, log_directory, enable_logging);
-  // TODO correct the params
-  // CN count is needed
+      inactive_phi, timeout_phi, inactive_retry_count, log_directory,
+      enable_logging);
+  // the compute nodes after compute_count are standby nodes that join later
+  standby_ = scheduler_index >= compute_count;
   load_balancer_manager_ = DDLoadBalancerManager::get_instance(
-      scheduler_index, input_scheduler_count,
-      input_scheduler_count /*wrong assumption*/, history_size,
-      balancer_difference_percentage, log_directory, enable_logging);
+      scheduler_index, input_scheduler_count, compute_count, history_size,
+      balancer_difference_percentage, balancer_policies, compute_weights,
+      log_directory, enable_logging);
   SchedulerOrchestrator::initialize(heartbeat_manager_);
 }
 
@@ -61,9 +68,9 @@ void DDSchedulerOrchestrator::set_begin_time(
 
 void DDSchedulerOrchestrator::generate_log_files() {
   interval_scheduler_->generate_log_files();
-  compute_interval_data_manager_->generate_log_files();
   load_balancer_manager_->generate_log_files();
   // heartbeat_manager_->generate_log_files();
+  TraceRecorder::stop();
 }
 
 //// DDScheduler Methods
@@ -81,10 +88,14 @@ void DDSchedulerOrchestrator::add_actual_meta_data(
 const ComputeProposedIntervalMetaData*
 DDSchedulerOrchestrator::get_proposed_meta_data(uint32_t input_index,
                                                 uint64_t interval_index) {
+  if (standby_)
+    return nullptr;
   return interval_scheduler_->get_proposed_meta_data(input_index,
                                                      interval_index);
 }
 
+bool DDSchedulerOrchestrator::is_standby() { return standby_; }
+
 const ComputeIntervalMetaDataStatistics*
 DDSchedulerOrchestrator::get_actual_meta_data_statistics(
     uint64_t interval_index) {
@@ -239,5 +250,7 @@ ComputeIntervalDataManager*
 DDLoadBalancerManager* DDSchedulerOrchestrator::load_balancer_manager_ =
     nullptr;
 
+bool DDSchedulerOrchestrator::standby_ = false;
+
 bool DDSchedulerOrchestrator::SHOW_LOG_ = false;
 } // namespace tl_libfabric
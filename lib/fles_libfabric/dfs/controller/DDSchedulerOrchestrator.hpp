@@ -24,9 +24,8 @@ public:
   static void initialize(uint32_t scheduler_index,
                          uint32_t input_scheduler_count,
                          uint64_t init_heartbeat_timeout,
-                         uint32_t timeout_history_size,
-                         uint32_t timeout_factor,
-                         uint32_t inactive_factor,
+                         double inactive_phi,
+                         double timeout_phi,
                          uint32_t inactive_retry_count,
                          uint32_t history_size,
                          uint32_t interval_length,
@@ -35,6 +34,9 @@ public:
                          uint32_t speedup_interval_count,
                          uint32_t balancer_difference_percentage,
                          uint32_t balancer_interval_count,
+                         std::string balancer_policies,
+                         std::vector<double> compute_weights,
+                         uint32_t compute_count,
                          std::string log_directory,
                          bool enable_logging);
 
@@ -59,10 +61,16 @@ public:
       InputIntervalMetaData meta_data,
       ComputeIntervalMetaDataStatistics* prev_interval_compute_stats);
 
-  // Return the proposed interval meta-data to ComputeNodeConnection
+  // Return the proposed interval meta-data to ComputeNodeConnection, nullptr
+  // if nothing is proposed
   static const ComputeProposedIntervalMetaData*
   get_proposed_meta_data(uint32_t input_index, uint64_t interval_index);
 
+  // Whether this compute node joined the running system. Its load balancer
+  // does not know the current load distribution, so it reports statistics
+  // without proposing.
+  static bool is_standby();
+
   // Return the  interval meta-data Statistics of a completed interval
   static const ComputeIntervalMetaDataStatistics*
   get_actual_meta_data_statistics(uint64_t interval_index);
@@ -150,5 +158,6 @@ private:
   static ComputeHeartbeatManager* heartbeat_manager_;
   static ComputeIntervalDataManager* compute_interval_data_manager_;
   static DDLoadBalancerManager* load_balancer_manager_;
+  static bool standby_;
 };
 } // namespace tl_libfabric
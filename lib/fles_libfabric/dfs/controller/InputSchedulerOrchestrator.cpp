@@ -8,37 +8,41 @@ namespace tl_libfabric {
 void InputSchedulerOrchestrator::initialize(uint32_t scheduler_index,
                                             uint32_t compute_conn_count,
                                             uint64_t init_heartbeat_timeout,
-                                            uint32_t timeout_history_size,
-                                            uint32_t timeout_factor,
-                                            uint32_t inactive_factor,
+                                            double inactive_phi,
+                                            double timeout_phi,
                                             uint32_t inactive_retry_count,
                                             uint32_t interval_length,
                                             uint64_t data_source_desc,
                                             uint64_t desc_length,
                                             uint64_t start_index_desc,
                                             uint64_t timeslice_size,
+                                            std::vector<double> compute_weights,
                                             std::string log_directory,
                                             bool enable_logging) {
   InputLoggerProxy::init_instance(compute_conn_count);
+  if (enable_logging) {
+    TraceRecorder::start(log_directory + "/" +
+                             std::to_string(scheduler_index) + ".input.trace",
+                         0, scheduler_index);
+  }
   interval_scheduler_ = InputIntervalScheduler::get_instance(
       scheduler_index, compute_conn_count, interval_length, log_directory,
       enable_logging);
   timeslice_manager_ = InputTimesliceManager::get_instance(
       scheduler_index, compute_conn_count, interval_length, data_source_desc,
-      desc_length, start_index_desc, timeslice_size, log_directory,
-      enable_logging);
+      desc_length, start_index_desc, timeslice_size, compute_weights,
+      log_directory, enable_logging);
   heartbeat_manager_ = InputHeartbeatManager::get_instance(
-      scheduler_index, compute_conn_count, init_heartbeat_timeout,
-      timeout_history_size, timeout_factor, inactive_factor,
-      inactive_retry_count, log_directory, enable_logging);
+      scheduler_index, compute_conn_count, init_heartbeat_timeout, inactive_phi,
+      timeout_phi, inactive_retry_count, log_directory, enable_logging);
   SchedulerOrchestrator::initialize(heartbeat_manager_);
 }
 
 void InputSchedulerOrchestrator::update_compute_connection_count(
     uint32_t compute_count) {
-  // TODO remove
-  assert(false);
   interval_scheduler_->update_compute_connection_count(compute_count);
+  timeslice_manager_->update_compute_connection_count(compute_count);
+  heartbeat_manager_->update_connection_count(compute_count);
 }
 
 void InputSchedulerOrchestrator::update_input_begin_time(
@@ -52,13 +56,20 @@ uint32_t InputSchedulerOrchestrator::get_compute_connection_count() {
 
 void InputSchedulerOrchestrator::generate_log_files() {
   interval_scheduler_->generate_log_files();
-  timeslice_manager_->generate_log_files();
+  TraceRecorder::stop();
 }
 
 //// InputIntervalScheduler Methods
 
 void InputSchedulerOrchestrator::add_dfs_proposal(
     const DDSLoadBalancerMessage proposal, uint32_t compute_index) {
+  if (proposal.statistics_only) {
+    // compute nodes that joined at runtime do not propose
+    interval_scheduler_->add_actual_interval_compute_statistics(
+        proposal.last_completed_statistics.interval_index, compute_index,
+        proposal.last_completed_statistics);
+    return;
+  }
   if (proposal.proposed_interval_metadata.interval_index ==
       ConstVariables::MINUS_ONE)
     return;
@@ -28,15 +28,15 @@ public:
   static void initialize(std::uint32_t scheduler_index,
                          std::uint32_t compute_conn_count,
                          uint64_t init_heartbeat_timeout,
-                         uint32_t timeout_history_size,
-                         uint32_t timeout_factor,
-                         uint32_t inactive_factor,
+                         double inactive_phi,
+                         double timeout_phi,
                          uint32_t inactive_retry_count,
                          std::uint32_t interval_length,
                          uint64_t data_source_desc,
                          uint64_t desc_length,
                          uint64_t start_index_desc,
                          uint64_t timeslice_size,
+                         std::vector<double> compute_weights,
                          std::string log_directory,
                          bool enable_logging);
 
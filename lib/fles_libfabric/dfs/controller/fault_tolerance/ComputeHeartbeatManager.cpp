@@ -8,23 +8,19 @@ ComputeHeartbeatManager::ComputeHeartbeatManager(
     uint32_t index,
     uint32_t init_connection_count,
     uint64_t init_heartbeat_timeout,
-    uint32_t timeout_history_size,
-    uint32_t timeout_factor,
-    uint32_t inactive_factor,
+    double inactive_phi,
+    double timeout_phi,
     uint32_t inactive_retry_count,
     std::string log_directory,
     bool enable_logging)
     : HeartbeatManager(index,
                        init_connection_count,
                        init_heartbeat_timeout,
-                       timeout_history_size,
-                       timeout_factor,
-                       inactive_factor,
+                       inactive_phi,
+                       timeout_phi,
                        inactive_retry_count,
                        log_directory,
-                       enable_logging) {
-  update_latency_log_ = false;
-}
+                       enable_logging) {}
 
 void ComputeHeartbeatManager::calculate_failure_decision(uint32_t failed_node) {
   std::vector<FailureRequestedInfo*> collected_info =
@@ -61,17 +57,15 @@ ComputeHeartbeatManager*
 ComputeHeartbeatManager::get_instance(uint32_t index,
                                       uint32_t init_connection_count,
                                       uint64_t init_heartbeat_timeout,
-                                      uint32_t timeout_history_size,
-                                      uint32_t timeout_factor,
-                                      uint32_t inactive_factor,
+                                      double inactive_phi,
+                                      double timeout_phi,
                                       uint32_t inactive_retry_count,
                                       std::string log_directory,
                                       bool enable_logging) {
   if (instance_ == nullptr) {
     instance_ = new ComputeHeartbeatManager(
-        index, init_connection_count, init_heartbeat_timeout,
-        timeout_history_size, timeout_factor, inactive_factor,
-        inactive_retry_count, log_directory, enable_logging);
+        index, init_connection_count, init_heartbeat_timeout, inactive_phi,
+        timeout_phi, inactive_retry_count, log_directory, enable_logging);
   }
   return instance_;
 }
@@ -227,7 +221,9 @@ ComputeHeartbeatManager::retrieve_long_waiting_finalized_connections() {
                 << duration << "init_heartbeat_timeout_ "
                 << init_heartbeat_timeout_ << " ? "
                 << (init_heartbeat_timeout_);
-      if (duration >= init_heartbeat_timeout_ * inactive_factor_) {
+      // resend the final message after as many heartbeat timeouts as
+      // heartbeat probes are sent to an inactive connection
+      if (duration >= init_heartbeat_timeout_ * inactive_retry_count_) {
         conns.push_back(it->first);
       }
     }
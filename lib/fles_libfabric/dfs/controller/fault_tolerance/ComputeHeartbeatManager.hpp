@@ -28,9 +28,8 @@ public:
   static ComputeHeartbeatManager* get_instance(uint32_t index,
                                                uint32_t init_connection_count,
                                                uint64_t init_heartbeat_timeout,
-                                               uint32_t timeout_history_size,
-                                               uint32_t timeout_factor,
-                                               uint32_t inactive_factor,
+                                               double inactive_phi,
+                                               double timeout_phi,
                                                uint32_t inactive_retry_count,
                                                std::string log_directory,
                                                bool enable_logging);
@@ -92,9 +91,8 @@ private:
   ComputeHeartbeatManager(uint32_t index,
                           uint32_t init_connection_count,
                           uint64_t init_heartbeat_timeout,
-                          uint32_t timeout_history_size,
-                          uint32_t timeout_factor,
-                          uint32_t inactive_factor,
+                          double inactive_phi,
+                          double timeout_phi,
                           uint32_t inactive_retry_count,
                           std::string log_directory,
                           bool enable_logging);
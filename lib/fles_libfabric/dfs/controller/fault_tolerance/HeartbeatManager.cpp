@@ -7,36 +7,40 @@ namespace tl_libfabric {
 HeartbeatManager::HeartbeatManager(uint32_t index,
                                    uint32_t init_connection_count,
                                    uint64_t init_heartbeat_timeout,
-                                   uint32_t timeout_history_size,
-                                   uint32_t timeout_factor,
-                                   uint32_t inactive_factor,
+                                   double inactive_phi,
+                                   double timeout_phi,
                                    uint32_t inactive_retry_count,
                                    std::string log_directory,
                                    bool enable_logging)
     : index_(index), connection_count_(init_connection_count),
       init_heartbeat_timeout_(init_heartbeat_timeout),
-      timeout_history_size_(timeout_history_size),
-      timeout_factor_(timeout_factor), inactive_factor_(inactive_factor),
+      inactive_phi_(inactive_phi), timeout_phi_(timeout_phi),
       inactive_retry_count_(inactive_retry_count),
       log_directory_(log_directory), enable_logging_(enable_logging) {
 
-  assert(inactive_factor_ < timeout_factor_);
+  assert(inactive_phi_ < timeout_phi_);
 
-  update_latency_log_ = false;
   for (uint32_t i = 0; i < init_connection_count; i++) {
     unacked_sent_messages_.add(i, new std::set<uint64_t>());
-    connection_heartbeat_time_.push_back(new ConnectionHeartbeatInfo(
-        timeout_history_size * init_heartbeat_timeout));
-    connection_heartbeat_time_[i]->latency_history.resize(
-        timeout_history_size, init_heartbeat_timeout);
+    connection_heartbeat_time_.push_back(
+        new ConnectionHeartbeatInfo(init_heartbeat_timeout));
   }
   pending_messages_.resize(init_connection_count);
 
   L_(debug) << "[HeartbeatManager] init_heartbeat_timeout "
-            << init_heartbeat_timeout << " timeout_history_size "
-            << timeout_history_size << " timeout_factor " << timeout_factor
-            << " inactive_factor " << inactive_factor
-            << " inactive_retry_count " << inactive_retry_count;
+            << init_heartbeat_timeout << " inactive_phi " << inactive_phi
+            << " timeout_phi " << timeout_phi << " inactive_retry_count "
+            << inactive_retry_count;
+}
+
+double HeartbeatManager::connection_phi(uint32_t connection_id) {
+  ConnectionHeartbeatInfo* conn_info =
+      connection_heartbeat_time_[connection_id];
+  uint64_t silence = std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::high_resolution_clock::now() -
+                         conn_info->last_received_message)
+                         .count();
+  return conn_info->detector.phi(silence);
 }
 
 bool HeartbeatManager::check_whether_connection_inactive(
@@ -51,19 +55,7 @@ bool HeartbeatManager::check_whether_connection_inactive(
     return true;
   }
 
-  double duration =
-      std::chrono::duration_cast<std::chrono::microseconds>(
-          std::chrono::high_resolution_clock::now() -
-          connection_heartbeat_time_[connection_id]->last_received_message)
-          .count();
-  uint64_t avg_latency =
-      connection_heartbeat_time_[connection_id]->sum_latency /
-      timeout_history_size_;
-
-  if (duration >= (avg_latency * inactive_factor_)) {
-    return true;
-  }
-  return false;
+  return connection_phi(connection_id) >= inactive_phi_;
 }
 
 bool HeartbeatManager::check_whether_connection_timed_out(
@@ -72,18 +64,7 @@ bool HeartbeatManager::check_whether_connection_timed_out(
   if (timeout_node_info_.contains(connection_id)) {
     return true;
   }
-  double duration =
-      std::chrono::duration_cast<std::chrono::microseconds>(
-          std::chrono::high_resolution_clock::now() -
-          connection_heartbeat_time_[connection_id]->last_received_message)
-          .count();
-  uint64_t avg_latency =
-      connection_heartbeat_time_[connection_id]->sum_latency /
-      timeout_history_size_;
-
-  if (duration >= (avg_latency * timeout_factor_))
-    return true;
-  return false;
+  return connection_phi(connection_id) >= timeout_phi_;
 }
 
 void HeartbeatManager::log_sent_heartbeat_message(uint32_t connection_id,
@@ -171,34 +152,16 @@ void HeartbeatManager::log_heartbeat(uint32_t connection_id) {
       inactive_connection_.find(connection_id);
   if (inactive != inactive_connection_.end()) {
     inactive_connection_.erase(inactive);
-  }
-  if (update_latency_log_) {
-    log_new_latency(connection_id, time_gap);
-  }
-}
-
-void HeartbeatManager::log_new_latency(uint32_t connection_id,
-                                       uint64_t latency) {
-  assert(connection_id < connection_heartbeat_time_.size());
-  if (timeout_node_info_.contains(connection_id)) {
-    L_(warning) << "logging new latency of timeout connection "
-                << connection_id;
+    // the gap ends with the answer to a probe and would only stretch the
+    // learned intervals of an idle connection
     return;
   }
-  // L_(info) << "Latency of [" << connection_id << "] is " << latency;
-  ConnectionHeartbeatInfo* conn_info =
-      connection_heartbeat_time_[connection_id];
-  conn_info->sum_latency =
-      conn_info->sum_latency -
-      conn_info->latency_history[conn_info->next_latency_index] + latency;
-  conn_info->latency_history[conn_info->next_latency_index] = latency;
-  conn_info->next_latency_index =
-      (conn_info->next_latency_index + 1) % timeout_history_size_;
+  conn_info->detector.add_interval(time_gap);
 }
 
 std::vector<uint32_t> HeartbeatManager::retrieve_new_inactive_connections() {
   std::vector<uint32_t> conns;
-  for (uint32_t i = 0; i < connection_heartbeat_time_.size(); i++) {
+  for (uint32_t i = 0; i < connection_count_; i++) {
     if (check_whether_connection_inactive(i) &&
         count_unacked_messages(i) < inactive_retry_count_) {
       if (inactive_connection_.find(i) == inactive_connection_.end()) {
@@ -248,6 +211,15 @@ bool HeartbeatManager::is_connection_timed_out(uint32_t connection_id) {
   return false;
 }
 
+void HeartbeatManager::update_connection_count(uint32_t connection_count) {
+  assert(connection_count <= connection_heartbeat_time_.size());
+  // a joining connection is monitored from now on
+  for (uint32_t i = connection_count_; i < connection_count; i++)
+    connection_heartbeat_time_[i]->last_received_message =
+        std::chrono::high_resolution_clock::now();
+  connection_count_ = connection_count;
+}
+
 uint32_t HeartbeatManager::get_active_connection_count() {
   assert(timeout_node_info_.size() <= connection_count_);
   return connection_count_ - timeout_node_info_.size();
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "ConstVariables.hpp"
+#include "PhiAccrualDetector.hpp"
 #include "SizedMap.hpp"
 #include "dfs/model/fault_tolerance/HeartbeatFailedNodeInfo.hpp"
 #include "dfs/model/fault_tolerance/HeartbeatMessage.hpp"
@@ -47,7 +48,8 @@ public:
   // Remove all pending messages of a connection when it times out
   void clear_pending_messages(uint32_t connection_id);
 
-  // Set the begin time to be used in logging
+  // Log the arrival of any message of a connection; status and DFS messages
+  // count as heartbeats, so busy connections need no extra messages
   void log_heartbeat(uint32_t connection_id);
 
   // Retrieve the inactive connections to send heartbeat message
@@ -66,6 +68,9 @@ public:
   // Check whether a connection is already timedout
   bool is_connection_timed_out(uint32_t connection_id);
 
+  // Update the number of monitored connections when compute nodes join
+  void update_connection_count(uint32_t connection_count);
+
   // Get the number of active connections
   uint32_t get_active_connection_count();
 
@@ -88,20 +93,19 @@ protected:
   struct ConnectionHeartbeatInfo {
     std::chrono::high_resolution_clock::time_point last_received_message =
         std::chrono::high_resolution_clock::now();
-    std::vector<uint64_t> latency_history; // in microseconds
-    uint64_t sum_latency;
-    uint32_t next_latency_index = 0;
-    ConnectionHeartbeatInfo(uint64_t init_sum_latency) {
-      sum_latency = init_sum_latency;
-    }
+    // inter-arrival times of the messages of the connection
+    PhiAccrualDetector detector;
+    explicit ConnectionHeartbeatInfo(uint64_t init_interval)
+        : detector(init_interval,
+                   ConstVariables::HEARTBEAT_MIN_STD_DEVIATION,
+                   ConstVariables::HEARTBEAT_ACCEPTABLE_PAUSE) {}
   };
 
   HeartbeatManager(uint32_t index,
                    uint32_t init_connection_count,
                    uint64_t init_heartbeat_timeout,
-                   uint32_t timeout_history_size,
-                   uint32_t timeout_factor,
-                   uint32_t inactive_factor,
+                   double inactive_phi,
+                   double timeout_phi,
                    uint32_t inactive_retry_count,
                    std::string log_directory,
                    bool enable_logging);
@@ -112,9 +116,8 @@ protected:
   // Check whether a connection should be timed out
   bool check_whether_connection_timed_out(uint32_t connection_id);
 
-  // Upon receiving a sync message, the latency is calculated and used
-  // accordingly
-  void log_new_latency(uint32_t connection_id, uint64_t latency);
+  // The suspicion level of a connection since its last received message
+  double connection_phi(uint32_t connection_id);
 
   // Compute process index
   uint32_t index_;
@@ -145,15 +148,11 @@ protected:
 
   uint64_t init_heartbeat_timeout_;
 
-  // history size of latency to detect timeout connections
-  // high for unstable networks
-  uint32_t timeout_history_size_;
-
-  // # of timeout value before considering a connection timed out
-  uint32_t timeout_factor_;
+  // Suspicion level to probe a connection with heartbeat messages
+  double inactive_phi_;
 
-  // # of timeout messages before considering a connection is inactive
-  uint32_t inactive_factor_;
+  // Suspicion level to consider a connection timed out
+  double timeout_phi_;
 
   uint32_t inactive_retry_count_;
 
@@ -161,7 +160,5 @@ protected:
   std::string log_directory_;
 
   bool enable_logging_;
-
-  bool update_latency_log_;
 };
 } // namespace tl_libfabric
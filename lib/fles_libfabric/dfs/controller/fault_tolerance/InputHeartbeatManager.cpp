@@ -8,17 +8,15 @@ InputHeartbeatManager*
 InputHeartbeatManager::get_instance(uint32_t index,
                                     uint32_t init_connection_count,
                                     uint64_t init_heartbeat_timeout,
-                                    uint32_t timeout_history_size,
-                                    uint32_t timeout_factor,
-                                    uint32_t inactive_factor,
+                                    double inactive_phi,
+                                    double timeout_phi,
                                     uint32_t inactive_retry_count,
                                     std::string log_directory,
                                     bool enable_logging) {
   if (instance_ == nullptr) {
     instance_ = new InputHeartbeatManager(
-        index, init_connection_count, init_heartbeat_timeout,
-        timeout_history_size, timeout_factor, inactive_factor,
-        inactive_retry_count, log_directory, enable_logging);
+        index, init_connection_count, init_heartbeat_timeout, inactive_phi,
+        timeout_phi, inactive_retry_count, log_directory, enable_logging);
   }
   return instance_;
 }
@@ -30,18 +28,16 @@ InputHeartbeatManager* InputHeartbeatManager::get_instance() {
 InputHeartbeatManager::InputHeartbeatManager(uint32_t index,
                                              uint32_t init_connection_count,
                                              uint64_t init_heartbeat_timeout,
-                                             uint32_t timeout_history_size,
-                                             uint32_t timeout_factor,
-                                             uint32_t inactive_factor,
+                                             double inactive_phi,
+                                             double timeout_phi,
                                              uint32_t inactive_retry_count,
                                              std::string log_directory,
                                              bool enable_logging)
     : HeartbeatManager(index,
                        init_connection_count,
                        init_heartbeat_timeout,
-                       timeout_history_size,
-                       timeout_factor,
-                       inactive_factor,
+                       inactive_phi,
+                       timeout_phi,
                        inactive_retry_count,
                        log_directory,
                        enable_logging) {}
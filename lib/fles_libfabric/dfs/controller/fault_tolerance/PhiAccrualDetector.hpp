@@ -0,0 +1,68 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace tl_libfabric {
+/**
+ * Phi accrual failure detector of a single connection. The inter-arrival
+ * time of the messages is modelled as a normal distribution whose mean and
+ * variance are exponentially weighted moving averages, so each arrival is
+ * an O(1) update. The suspicion level phi of a silence of t is
+ * -log10(P(next arrival later than t)); phi = 1 means a 10% chance of being
+ * wrong, phi = 3 a 0.1% chance, and so on.
+ */
+class PhiAccrualDetector {
+public:
+  // Weight of a new sample in the moving averages
+  static constexpr double DEFAULT_ALPHA = 0.125;
+
+  // Reported phi when the arrival probability underflows
+  static constexpr double MAX_PHI = 1000;
+
+  PhiAccrualDetector(uint64_t init_interval,
+                     uint64_t min_std_deviation,
+                     uint64_t acceptable_pause,
+                     double alpha = DEFAULT_ALPHA)
+      : mean_(static_cast<double>(init_interval)),
+        variance_(static_cast<double>(init_interval) * init_interval / 16),
+        min_std_deviation_(static_cast<double>(min_std_deviation)),
+        acceptable_pause_(static_cast<double>(acceptable_pause)),
+        alpha_(alpha) {}
+
+  // Add the time between two consecutive arrivals (in microseconds)
+  void add_interval(uint64_t interval) {
+    double diff = static_cast<double>(interval) - mean_;
+    double increment = alpha_ * diff;
+    mean_ += increment;
+    variance_ = (1 - alpha_) * (variance_ + diff * increment);
+  }
+
+  // The suspicion level after a silence of elapsed microseconds
+  double phi(uint64_t elapsed) const {
+    double std_deviation = std::max(std::sqrt(variance_), min_std_deviation_);
+    // a silence of up to acceptable_pause_ beyond the mean is not
+    // suspicious, it covers load spikes that delay the messages
+    double y = (static_cast<double>(elapsed) - mean_ - acceptable_pause_) /
+               std_deviation;
+    double p_later = 0.5 * std::erfc(y / std::sqrt(2.0));
+    if (p_later < std::numeric_limits<double>::min())
+      return MAX_PHI;
+    return std::min(-std::log10(p_later), MAX_PHI);
+  }
+
+  double mean() const { return mean_; }
+
+  double std_deviation() const { return std::sqrt(variance_); }
+
+private:
+  double mean_;
+  double variance_;
+  double min_std_deviation_;
+  double acceptable_pause_;
+  double alpha_;
+};
+} // namespace tl_libfabric
@@ -29,11 +29,17 @@ ComputeTimesliceManager::ComputeTimesliceManager(
     uint32_t max_interval_length,
     std::string log_directory,
     bool enable_logging)
-    : compute_index_(compute_index),
+    : timeslice_arrivals_(max_interval_length), compute_index_(compute_index),
       input_connection_count_(input_connection_count),
       log_directory_(log_directory), enable_logging_(enable_logging),
-      timeslice_first_arrival_time_(max_interval_length),
-      timeslice_arrived_count_(max_interval_length) {
+      completion_metric_(MetricsRegistry::instance().histogram(
+          "flesnet_timeslice_arrival_microseconds",
+          "Time from the first to the last contribution of a timeslice",
+          metrics_labels("libfabric", "compute", compute_index))),
+      timed_out_metric_(MetricsRegistry::instance().counter(
+          "flesnet_timeslices_timed_out_total",
+          "Timeslices whose contributions did not all arrive in time",
+          metrics_labels("libfabric", "compute", compute_index))) {
   assert(input_connection_count > 0);
   timeout_ = ConstVariables::TIMESLICE_TIMEOUT;
   compute_interval_data_manager_ = ComputeIntervalDataManager::get_instance();
@@ -43,6 +49,34 @@ void ComputeTimesliceManager::update_input_connection_count(
     uint32_t input_connection_count) {
   assert(input_connection_count > 0);
   input_connection_count_ = input_connection_count;
+  if (timeslice_arrivals_.empty())
+    return;
+  size_t words = (input_connection_count_ + 63) / 64;
+  for (uint64_t ts = timeslice_arrivals_.get_first_key();
+       ts <= timeslice_arrivals_.get_last_key(); ++ts) {
+    if (timeslice_arrivals_.contains(ts))
+      timeslice_arrivals_.get(ts).arrived_connections.resize(words, 0);
+  }
+}
+
+ComputeTimesliceManager::TimesliceArrival*
+ComputeTimesliceManager::add_timeslice_arrival(
+    uint64_t timeslice,
+    std::chrono::high_resolution_clock::time_point first_arrival_time) {
+  while (timeslice_arrivals_.would_evict(timeslice)) {
+    uint64_t oldest = timeslice_arrivals_.get_first_key();
+    L_(warning) << "timeslice " << oldest << " is still incomplete when "
+                << "timeslice " << timeslice << " arrives, timing it out";
+    time_out_timeslice(oldest);
+  }
+  TimesliceArrival* arrival = timeslice_arrivals_.insert(timeslice);
+  if (arrival == nullptr)
+    return nullptr;
+  arrival->first_arrival_time = first_arrival_time;
+  arrival->arrived_count = 0;
+  // the bitset storage of a slot is reused by later timeslices
+  arrival->arrived_connections.assign((input_connection_count_ + 63) / 64, 0);
+  return arrival;
 }
 
 bool ComputeTimesliceManager::log_contribution_arrival(uint32_t connection_id,
@@ -55,31 +89,32 @@ bool ComputeTimesliceManager::log_contribution_arrival(uint32_t connection_id,
           timeslice)) {
     return false;
   }
-  if (!timeslice_first_arrival_time_.contains(timeslice)) {
-    timeslice_first_arrival_time_.add(
-        timeslice, std::chrono::high_resolution_clock::now());
-  }
-
-  std::set<uint32_t>* arrived_count;
-  if (timeslice_arrived_count_.contains(timeslice)) {
-    arrived_count = timeslice_arrived_count_.get(timeslice);
-    if (arrived_count->find(connection_id) != arrived_count->end())
-      return false;
-    arrived_count->insert(connection_id);
+  TimesliceArrival* arrival;
+  if (timeslice_arrivals_.contains(timeslice)) {
+    arrival = &timeslice_arrivals_.get(timeslice);
   } else {
-    arrived_count = new std::set<uint32_t>();
-    arrived_count->insert(connection_id);
-    timeslice_arrived_count_.add(timeslice, arrived_count);
+    arrival = add_timeslice_arrival(timeslice,
+                                    std::chrono::high_resolution_clock::now());
+    if (arrival == nullptr) {
+      L_(warning) << "contribution of timeslice " << timeslice
+                  << " arrived out of the tracking window";
+      return false;
+    }
   }
 
-  bool completed = false;
-  assert(arrived_count->size() <= input_connection_count_);
-  if (arrived_count->size() == input_connection_count_) {
+  uint64_t& word = arrival->arrived_connections[connection_id / 64];
+  uint64_t bit = UINT64_C(1) << (connection_id % 64);
+  if ((word & bit) != 0)
+    return false;
+  word |= bit;
+  ++arrival->arrived_count;
+
+  assert(arrival->arrived_count <= input_connection_count_);
+  if (arrival->arrived_count == input_connection_count_) {
     trigger_timeslice_completion(timeslice);
-    completed = true;
+    return true;
   }
-  arrived_count = nullptr;
-  return completed;
+  return false;
 }
 
 bool ComputeTimesliceManager::undo_log_contribution_arrival(
@@ -87,18 +122,18 @@ bool ComputeTimesliceManager::undo_log_contribution_arrival(
 
   if (compute_interval_data_manager_->contain_timeslice_completion_duration(
           timeslice)) {
-    std::set<uint32_t>* arrived_count = new std::set<uint32_t>();
-    for (uint32_t conn = 0; conn < input_connection_count_; conn++)
-      if (conn != connection_id)
-        arrived_count->insert(conn);
-
-    timeslice_arrived_count_.add(timeslice, arrived_count);
     uint64_t dur =
         compute_interval_data_manager_->get_timeslice_completion_duration(
             timeslice);
-    timeslice_first_arrival_time_.add(
+    TimesliceArrival* arrival = add_timeslice_arrival(
         timeslice, std::chrono::high_resolution_clock::now() -
                        std::chrono::microseconds(dur));
+    assert(arrival != nullptr);
+    for (uint32_t conn = 0; conn < input_connection_count_; conn++)
+      if (conn != connection_id)
+        arrival->arrived_connections[conn / 64] |= UINT64_C(1) << (conn % 64);
+    arrival->arrived_count = input_connection_count_ - 1;
+
     compute_interval_data_manager_->remove_timeslice_completion_duration(
         timeslice);
 
@@ -110,10 +145,13 @@ bool ComputeTimesliceManager::undo_log_contribution_arrival(
     return true;
   }
 
-  if (timeslice_arrived_count_.contains(timeslice)) {
-    std::set<uint32_t>* arrived_count = timeslice_arrived_count_.get(timeslice);
-    if (arrived_count->find(connection_id) != arrived_count->end()) {
-      arrived_count->erase(connection_id);
+  if (timeslice_arrivals_.contains(timeslice)) {
+    TimesliceArrival& arrival = timeslice_arrivals_.get(timeslice);
+    uint64_t& word = arrival.arrived_connections[connection_id / 64];
+    uint64_t bit = UINT64_C(1) << (connection_id % 64);
+    if ((word & bit) != 0) {
+      word &= ~bit;
+      --arrival.arrived_count;
       return true;
     }
   }
@@ -121,30 +159,39 @@ bool ComputeTimesliceManager::undo_log_contribution_arrival(
 }
 
 void ComputeTimesliceManager::log_timeout_timeslice() {
-  SizedMap<uint64_t, std::chrono::high_resolution_clock::time_point>::iterator
-      it;
   double taken_duration;
   uint64_t timeslice;
-  while (!timeslice_first_arrival_time_.empty()) {
-    it = timeslice_first_arrival_time_.get_begin_iterator();
-    taken_duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-                         std::chrono::high_resolution_clock::now() - it->second)
-                         .count();
+  while (!timeslice_arrivals_.empty()) {
+    timeslice = timeslice_arrivals_.get_first_key();
+    taken_duration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::high_resolution_clock::now() -
+            timeslice_arrivals_.get(timeslice).first_arrival_time)
+            .count();
     if (taken_duration < (timeout_ * 1000.0))
       break;
-    timeslice = it->first;
 
     L_(info) << "----Timeslice " << timeslice << " is timed out after "
              << taken_duration << " ms (timeout=" << (timeout_ * 1000.0)
              << " ms) ---";
 
-    compute_interval_data_manager_->add_timeslice_timed_out_duration(
-        timeslice, taken_duration);
-    assert(timeslice_first_arrival_time_.remove(timeslice));
-    assert(timeslice_arrived_count_.remove(timeslice));
+    time_out_timeslice(timeslice);
   }
 }
 
+void ComputeTimesliceManager::time_out_timeslice(uint64_t timeslice) {
+  double taken_duration =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::high_resolution_clock::now() -
+          timeslice_arrivals_.get(timeslice).first_arrival_time)
+          .count();
+  compute_interval_data_manager_->add_timeslice_timed_out_duration(
+      timeslice, taken_duration);
+  timed_out_metric_.add();
+  timeslice_arrivals_.remove(timeslice);
+  advance_last_ordered_timeslice(timeslice);
+}
+
 uint64_t ComputeTimesliceManager::get_last_ordered_completed_timeslice() {
   return last_ordered_timeslice_;
 }
@@ -152,14 +199,20 @@ uint64_t ComputeTimesliceManager::get_last_ordered_completed_timeslice() {
 void ComputeTimesliceManager::trigger_timeslice_completion(uint64_t timeslice) {
   double duration = std::chrono::duration_cast<std::chrono::microseconds>(
                         std::chrono::high_resolution_clock::now() -
-                        timeslice_first_arrival_time_.get(timeslice))
+                        timeslice_arrivals_.get(timeslice).first_arrival_time)
                         .count();
   compute_interval_data_manager_->add_timeslice_completion_duration(timeslice,
                                                                     duration);
+  completion_metric_.record(static_cast<uint64_t>(duration));
 
-  timeslice_first_arrival_time_.remove(timeslice);
-  timeslice_arrived_count_.remove(timeslice);
+  timeslice_arrivals_.remove(timeslice);
+  advance_last_ordered_timeslice(timeslice);
+  // L_(info) << "----Timeslice " << timeslice << " is COMPLETED after " <<
+  // duration << " ms, last_ordered_timeslice_ = " << last_ordered_timeslice_;
+}
 
+void ComputeTimesliceManager::advance_last_ordered_timeslice(
+    uint64_t timeslice) {
   if (last_ordered_timeslice_ == ConstVariables::MINUS_ONE && timeslice == 0)
     last_ordered_timeslice_ = 0;
   while (last_ordered_timeslice_ != ConstVariables::MINUS_ONE &&
@@ -168,8 +221,6 @@ void ComputeTimesliceManager::trigger_timeslice_completion(uint64_t timeslice) {
           compute_interval_data_manager_->contain_timeslice_timed_out_duration(
               last_ordered_timeslice_ + 1)))
     ++last_ordered_timeslice_;
-  // L_(info) << "----Timeslice " << timeslice << " is COMPLETED after " <<
-  // duration << " ms, last_ordered_timeslice_ = " << last_ordered_timeslice_;
 }
 
 ComputeTimesliceManager* ComputeTimesliceManager::instance_ = nullptr;
@@ -3,7 +3,8 @@
 #pragma once
 
 #include "ConstVariables.hpp"
-#include "SizedMap.hpp"
+#include "Metrics.hpp"
+#include "RingIndexedTable.hpp"
 #include "dfs/model/interval_manager/ComputeIntervalDataManager.hpp"
 
 #include <cassert>
@@ -11,8 +12,8 @@
 #include <log.hpp>
 #include <map>
 #include <math.h>
-#include <set>
 #include <string>
+#include <vector>
 
 #include <fstream>
 #include <iomanip>
@@ -53,6 +54,15 @@ public:
   void log_timeout_timeslice();
 
 private:
+  struct TimesliceArrival {
+    // The first arrival time of the timeslice
+    std::chrono::high_resolution_clock::time_point first_arrival_time;
+    // The number of received contributions
+    uint32_t arrived_count;
+    // Bitset of the input connections whose contribution arrived
+    std::vector<uint64_t> arrived_connections;
+  };
+
   ComputeTimesliceManager(uint32_t compute_index,
                           uint32_t input_connection_count,
                           uint32_t max_interval_length,
@@ -62,12 +72,20 @@ private:
   // Complete a timeslice and log the completion duration
   void trigger_timeslice_completion(uint64_t timeslice);
 
-  // The first arrival time of each timeslice
-  SizedMap<uint64_t, std::chrono::high_resolution_clock::time_point>
-      timeslice_first_arrival_time_;
+  // Give up on an uncompleted timeslice and log it as timed out
+  void time_out_timeslice(uint64_t timeslice);
+
+  // Move last_ordered_timeslice_ past the completed and timed out timeslices
+  void advance_last_ordered_timeslice(uint64_t timeslice);
+
+  // Start tracking the contributions of a timeslice; the oldest timeslices
+  // that would fall out of the tracking window are timed out first
+  TimesliceArrival* add_timeslice_arrival(
+      uint64_t timeslice,
+      std::chrono::high_resolution_clock::time_point first_arrival_time);
 
-  // Counts the number of received contributions of each timeslice
-  SizedMap<uint64_t, std::set<uint32_t>*> timeslice_arrived_count_;
+  // The arrived contributions of each uncompleted timeslice
+  RingIndexedTable<TimesliceArrival> timeslice_arrivals_;
 
   // The singleton instance for this class
   static ComputeTimesliceManager* instance_;
@@ -91,5 +109,11 @@ private:
 
   //
   ComputeIntervalDataManager* compute_interval_data_manager_;
+
+  // Exported durations from the first to the last contribution of a timeslice
+  MetricsHistogram& completion_metric_;
+
+  // Exported number of timeslices given up as timed out
+  MetricsCounter& timed_out_metric_;
 };
 } // namespace tl_libfabric
@@ -202,7 +202,9 @@ void DDScheduler::calculate_interval_info(uint64_t interval_index) {
   uint64_t average_start_timeslice =
       get_average_start_timeslice(interval_index);
   uint64_t average_last_timeslice = get_average_last_timeslice(interval_index);
-  compute_node_count_ = get_average_compute_node_count(interval_index);
+  compute_node_count_ = get_joined_compute_node_count(interval_index);
+  DDLoadBalancerManager::get_instance()->update_compute_count(
+      interval_index, compute_node_count_);
   // TODO
   ComputeLoggerProxy* logger = ComputeLoggerProxy::get_instance();
 
@@ -466,13 +468,14 @@ uint64_t DDScheduler::get_average_last_timeslice(uint64_t interval_index) {
   return last_timeslice / input_connection_count_;
 }
 
-uint32_t DDScheduler::get_average_compute_node_count(uint64_t interval_index) {
-  uint32_t node_count = 0;
+uint32_t DDScheduler::get_joined_compute_node_count(uint64_t interval_index) {
+  // a joining compute node counts once all input nodes are connected to it
+  uint32_t node_count = ConstVariables::MINUS_ONE;
   for (uint32_t i = 0; i < input_connection_count_; i++)
-    node_count += input_scheduler_info_[i]
-                      ->interval_info_.get(interval_index)
-                      .compute_node_count;
-  return node_count / input_connection_count_;
+    node_count = std::min(node_count, input_scheduler_info_[i]
+                                          ->interval_info_.get(interval_index)
+                                          .compute_node_count);
+  return node_count;
 }
 
 uint64_t DDScheduler::get_max_round_duration_history() {
@@ -654,8 +657,9 @@ void DDScheduler::add_interval_compute_statistics(
 
 ComputeIntervalMetaDataStatistics*
 DDScheduler::get_actual_interval_statistics(uint64_t interval_index) {
-  assert(compute_interval_data_manager_->contain_actual_interval_meta_data(
-      interval_index));
+  if (!compute_interval_data_manager_->contain_actual_interval_meta_data(
+          interval_index))
+    return nullptr;
   ComputeCompletedIntervalMetaData* completed_metadata =
       compute_interval_data_manager_->get_actual_interval_meta_data(
           interval_index);
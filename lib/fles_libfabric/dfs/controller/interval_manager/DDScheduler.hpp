@@ -78,6 +78,8 @@ public:
   void add_interval_compute_statistics(
       ComputeIntervalMetaDataStatistics* compute_stats);
 
+  // The statistics of this compute node of a completed interval, nullptr if
+  // the interval is not completed
   ComputeIntervalMetaDataStatistics*
   get_actual_interval_statistics(uint64_t interval_index);
 
@@ -181,8 +183,8 @@ private:
   // Get average last timeslice of an interval
   uint64_t get_average_last_timeslice(uint64_t interval_index);
 
-  // Get average last timeslice of an interval
-  uint32_t get_average_compute_node_count(uint64_t interval_index);
+  // Get the count of compute nodes that all input nodes use in an interval
+  uint32_t get_joined_compute_node_count(uint64_t interval_index);
 
   // Get maximum round duration from the history
   uint64_t get_max_round_duration_history();
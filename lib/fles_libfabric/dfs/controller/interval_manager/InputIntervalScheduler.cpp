@@ -66,10 +66,14 @@ void InputIntervalScheduler::add_actual_interval_compute_statistics(
     uint64_t interval_index,
     uint32_t compute_index,
     ComputeIntervalMetaDataStatistics stats) {
-  assert(actual_interval_compute_statistics_.contains(interval_index));
+  // the statistics of a joined compute node may refer to intervals before
+  // this input node counted it
+  if (!actual_interval_compute_statistics_.contains(interval_index) ||
+      actual_interval_compute_statistics_.get(interval_index)->size() <=
+          compute_index)
+    return;
   std::vector<ComputeIntervalMetaDataStatistics>* compute_stats =
       actual_interval_compute_statistics_.get(interval_index);
-  assert(compute_stats->size() > compute_index);
   compute_stats->at(compute_index) = stats;
   assert(actual_interval_compute_statistics_.get(interval_index)
              ->at(compute_index)
@@ -236,7 +240,15 @@ InputIntervalScheduler::InputIntervalScheduler(uint32_t scheduler_index,
                                                bool enable_logging)
     : scheduler_index_(scheduler_index), compute_count_(compute_conn_count),
       interval_length_(interval_length), log_directory_(log_directory),
-      enable_logging_(enable_logging) {
+      enable_logging_(enable_logging),
+      interval_duration_metric_(MetricsRegistry::instance().histogram(
+          "flesnet_dfs_interval_duration_microseconds",
+          "Actual duration of DFS scheduling intervals",
+          metrics_labels("libfabric", "input", scheduler_index))),
+      interval_overrun_metric_(MetricsRegistry::instance().gauge(
+          "flesnet_dfs_interval_overrun_microseconds",
+          "Actual minus proposed duration of the last DFS interval",
+          metrics_labels("libfabric", "input", scheduler_index))) {
   minimum_ack_percentage_to_start_new_interval_ = 0.995;
 }
 
@@ -311,6 +323,10 @@ void InputIntervalScheduler::create_actual_interval_meta_data(
           std::chrono::high_resolution_clock::now() -
           interval_info->actual_start_time)
           .count();
+  interval_duration_metric_.record(interval_info->actual_duration);
+  interval_overrun_metric_.set(
+      static_cast<double>(interval_info->actual_duration) -
+      static_cast<double>(interval_info->proposed_duration));
 
   uint32_t compute_connection_count = get_compute_connection_count();
   InputLoggerProxy* logger = InputLoggerProxy::get_instance();
@@ -5,6 +5,7 @@
 #include "ComputeIntervalMetaDataStatistics.hpp"
 #include "ComputeProposedIntervalMetaData.hpp"
 #include "ConstVariables.hpp"
+#include "Metrics.hpp"
 #include "InputIntervalInfo.hpp"
 #include "InputIntervalMetaData.hpp"
 #include "InputLoggerProxy.hpp"
@@ -176,5 +177,9 @@ private:
   bool enable_logging_;
 
   double minimum_ack_percentage_to_start_new_interval_;
+
+  // Exported actual interval durations and their deviation from the proposal
+  MetricsHistogram& interval_duration_metric_;
+  MetricsGauge& interval_overrun_metric_;
 };
 } // namespace tl_libfabric
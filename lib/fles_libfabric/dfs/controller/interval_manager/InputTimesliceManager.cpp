@@ -1,10 +1,9 @@
 // Copyright 2018 Farouk Salem <salem@zib.de>
 
 #include "dfs/controller/interval_manager/InputTimesliceManager.hpp"
+#include "dfs/controller/load_balancer/LoadBalancingPolicy.hpp"
 
 // TO BE REMOVED
-#include <fstream>
-#include <iomanip>
 
 namespace tl_libfabric {
 
@@ -15,49 +14,48 @@ InputTimesliceManager::InputTimesliceManager(uint32_t scheduler_index,
                                              uint64_t desc_length,
                                              uint64_t start_index_desc,
                                              uint64_t timeslice_size,
+                                             std::vector<double> weights,
                                              std::string log_directory,
                                              bool enable_logging)
-    : compute_count_(compute_conn_count), scheduler_index_(scheduler_index),
+    : compute_count_(compute_conn_count),
+      joined_compute_count_(compute_conn_count),
+      scheduler_index_(scheduler_index),
       interval_length_(interval_length), data_source_desc_(data_source_desc),
       desc_length_(desc_length), start_index_desc_(start_index_desc),
       timeslice_size_(timeslice_size), log_directory_(log_directory),
-      enable_logging_(enable_logging) {
+      enable_logging_(enable_logging),
+      timeslice_owner_(static_cast<uint64_t>(interval_length) * 2 *
+                       compute_conn_count),
+      rdma_ack_metric_(MetricsRegistry::instance().histogram(
+          "flesnet_timeslice_rdma_ack_microseconds",
+          "Time from sending a timeslice to the RDMA write acknowledgement",
+          metrics_labels("libfabric", "input", scheduler_index))),
+      completion_ack_metric_(MetricsRegistry::instance().histogram(
+          "flesnet_timeslice_completion_ack_microseconds",
+          "Time from sending a timeslice to its completion acknowledgement",
+          metrics_labels("libfabric", "input", scheduler_index))),
+      resent_metric_(MetricsRegistry::instance().counter(
+          "flesnet_timeslices_resent_total",
+          "Transmitted timeslices of failed compute nodes that are resent",
+          metrics_labels("libfabric", "input", scheduler_index))) {
 
   last_conn_desc_.resize(compute_count_, 0);
   last_conn_timeslice_.resize(compute_count_, ConstVariables::MINUS_ONE);
-  for (uint32_t i = 0; i < compute_count_; ++i) {
-    conn_timeslice_info_.add(
-        i, new SizedMap<uint64_t, TimesliceInfo*>(interval_length * 2));
-    conn_desc_timeslice_info_.add(
-        i, new SizedMap<uint64_t, uint64_t>(interval_length * 2));
-    future_conn_timeslices_.add(i, new std::set<uint64_t>());
-  }
-  // refill_future_timeslices(interval_length_);
+  conn_first_unacked_desc_.resize(compute_count_, 1);
+  conn_schedule_position_.resize(compute_count_, 0);
+  rescheduled_conn_timeslices_.resize(compute_count_);
+  conn_timeslice_info_.reserve(compute_count_);
+  for (uint32_t i = 0; i < compute_count_; ++i)
+    conn_timeslice_info_.emplace_back(interval_length * 2);
   // TODO add the first two intervals
+  // The first intervals are distributed by the configured capacities until the
+  // compute nodes propose a load distribution
   update_load_distribution(
       0, (interval_length_ * 2) - (interval_length_ * 2 % compute_count_) - 1,
-      std::vector<double>(compute_count_, 1));
+      LoadBalancingPolicy::initial_load(weights, compute_count_));
   logger_ = InputLoggerProxy::get_instance();
 }
 
-/*void InputTimesliceManager::refill_future_timeslices(uint64_t up_to_timeslice)
-{ assert(false); if (next_start_future_timeslice_ >= up_to_timeslice) return; if
-(false) L_(info) << "[refill_future_timeslices] next_start_future_timeslice_: "
-             << next_start_future_timeslice_
-             << ", requested up_to_timeslice: " << up_to_timeslice;
-
-  uint32_t comp_index = next_start_future_timeslice_ % virtual_compute_count_;
-  for (uint64_t ts = next_start_future_timeslice_; ts < up_to_timeslice; ++ts) {
-    while (redistribution_decisions_log_.contains(
-        virtual_physical_compute_mapping_[comp_index]))
-      comp_index = (comp_index + 1) % virtual_compute_count_;
-    future_conn_timeslices_.get(virtual_physical_compute_mapping_[comp_index])
-        ->insert(ts);
-    comp_index = (comp_index + 1) % virtual_compute_count_;
-  }
-  next_start_future_timeslice_ = up_to_timeslice;
-}*/
-
 void InputTimesliceManager::update_load_distribution(
     uint64_t start_timeslice,
     uint64_t last_timeslice,
@@ -73,25 +71,13 @@ void InputTimesliceManager::update_load_distribution(
              << " dist: " << ConstVariables::vector_to_string(load_dist);
 
   assert(start_timeslice == next_start_future_timeslice_);
-  std::vector<double> remaining_load(load_dist);
-  uint32_t comp_index = start_timeslice % load_dist.size();
-  for (uint64_t ts = start_timeslice; ts <= last_timeslice; ts++) {
-    while (remaining_load[comp_index] < 1) {
-      remaining_load[comp_index] += load_dist[comp_index];
-      comp_index = (comp_index + 1) % load_dist.size();
-    }
-    /*L_(info) << "[update_load_distribution] ts: " << ts
-             << " to cn: " << comp_index
-             << " remaining: " << remaining_load[comp_index]
-             << " load: " << load_dist[comp_index];*/
-
-    remaining_load[comp_index] -= 1.0;
-    future_conn_timeslices_.get(comp_index)->insert(ts);
-    if (remaining_load[comp_index] < 1.0) {
-      remaining_load[comp_index] += load_dist[comp_index] - 1;
-      comp_index = (comp_index + 1) % load_dist.size();
-    }
-  }
+  // The intervals before the first future timeslice are no longer needed
+  uint64_t first_future_ts = TimesliceSchedule::NONE;
+  for (uint32_t conn = 0; conn < compute_count_; ++conn)
+    first_future_ts = std::min(
+        first_future_ts, schedule_.next(conn, conn_schedule_position_[conn]));
+  schedule_.release(std::min(first_future_ts, start_timeslice));
+  schedule_.add(start_timeslice, last_timeslice, load_dist);
   next_start_future_timeslice_ = last_timeslice + 1;
 }
 
@@ -103,6 +89,8 @@ void InputTimesliceManager::check_to_add_rescheduled_timeslices(
   SizedMap<uint64_t, std::vector<std::set<uint64_t>*>>::iterator it =
       to_be_moved_timeslices_.get_begin_iterator();
   std::set<uint64_t>* rescheduled_timeslices;
+  std::set<uint64_t>& conn_rescheduled_timeslices =
+      rescheduled_conn_timeslices_[compute_index];
   while (it != to_be_moved_timeslices_.get_end_iterator()) {
     L_(debug) << "[" << compute_index << "]check to add: trigger " << it->first
               << " next " << get_connection_next_timeslice(compute_index)
@@ -112,14 +100,11 @@ void InputTimesliceManager::check_to_add_rescheduled_timeslices(
         !it->second[compute_index]->empty()) {
       L_(debug) << "adding rescheduled timeslices after " << it->first << " to "
                 << compute_index << " ... last transmitted is "
-                << conn_timeslice_info_.get(compute_index)->get_last_key();
+                << last_conn_timeslice_[compute_index];
       rescheduled_timeslices = it->second[compute_index];
       assert(rescheduled_timeslices != nullptr);
-      std::set<uint64_t>::iterator set_it = rescheduled_timeslices->begin();
-      while (set_it != rescheduled_timeslices->end()) {
-        future_conn_timeslices_.get(compute_index)->insert(*set_it);
-        ++set_it;
-      }
+      conn_rescheduled_timeslices.insert(rescheduled_timeslices->begin(),
+                                         rescheduled_timeslices->end());
       delete rescheduled_timeslices;
       it->second[compute_index] = rescheduled_timeslices = nullptr;
     }
@@ -150,46 +135,42 @@ InputTimesliceManager::undo_transmitted_timeslices_after_trigger(
   if (timeslice_trigger > next_start_future_timeslice_)
     return undo_timeslices;
 
-  SizedMap<uint64_t, TimesliceInfo*>* timeslices_map;
-  TimesliceInfo* last_timeslice_info;
-  std::set<uint64_t>* future_timeslices;
   for (uint32_t conn = 0; conn < compute_count_; ++conn) {
-    timeslices_map = conn_timeslice_info_.get(conn);
+    RingIndexedTable<TimesliceInfo>& timeslices = conn_timeslice_info_[conn];
     uint64_t last_timeslice;
-    while (!timeslices_map->empty()) {
-      last_timeslice = timeslices_map->get_last_key();
+    while (!timeslices.empty()) {
+      uint64_t last_desc = timeslices.get_last_key();
+      const TimesliceInfo& last_timeslice_info = timeslices.get(last_desc);
+      last_timeslice = last_timeslice_info.timeslice;
       if (last_timeslice <= timeslice_trigger)
         break;
-      last_timeslice_info = timeslices_map->get(last_timeslice);
-      assert(last_timeslice_info->completion_acked_duration == 0);
-      assert(last_timeslice_info->compute_desc == last_conn_desc_[conn]);
+      assert(last_timeslice_info.completion_acked_duration == 0);
+      assert(last_desc == last_conn_desc_[conn]);
       assert(last_timeslice == last_conn_timeslice_[conn]);
-      // remove conn_desc_timeslices
-      assert(conn_desc_timeslice_info_.get(conn)->remove(
-          last_timeslice_info->compute_desc));
-      // remove conn_timeslice_info
-      assert(timeslices_map->remove(last_timeslice));
+      // the descriptor is no longer pending completion
+      assert(conn_first_unacked_desc_[conn] <= last_desc);
+      if (timeslice_owner_.contains(last_timeslice) &&
+          timeslice_owner_.get(last_timeslice).compute_index == conn)
+        timeslice_owner_.remove(last_timeslice);
+      timeslices.remove(last_desc);
       undo_timeslices.push_back(last_timeslice);
       L_(debug) << "Removing " << last_timeslice << " from " << conn;
       // update the last_conn_desc
       last_conn_desc_[conn]--;
       // update last_conn_timeslice
-      last_conn_timeslice_[conn] = timeslices_map->get_last_key();
+      last_conn_timeslice_[conn] =
+          timeslices.empty()
+              ? ConstVariables::MINUS_ONE
+              : timeslices.get(timeslices.get_last_key()).timeslice;
     }
     // remove future_timeslices
-    future_timeslices = future_conn_timeslices_.get(conn);
-    while (!future_timeslices->empty()) {
-      last_timeslice = *(--future_timeslices->end());
-      if (last_timeslice <= timeslice_trigger) {
-        L_(debug) << "last_timeslice of " << conn << " is " << last_timeslice;
-        break;
-      }
-      future_timeslices->erase(last_timeslice);
-    }
+    std::set<uint64_t>& rescheduled = rescheduled_conn_timeslices_[conn];
+    rescheduled.erase(rescheduled.upper_bound(timeslice_trigger),
+                      rescheduled.end());
+    conn_schedule_position_[conn] =
+        std::min(conn_schedule_position_[conn], timeslice_trigger + 1);
   }
-  timeslices_map = nullptr;
-  last_timeslice_info = nullptr;
-  future_timeslices = nullptr;
+  schedule_.truncate(timeslice_trigger);
   return undo_timeslices;
 }
 
@@ -202,12 +183,13 @@ InputTimesliceManager::get_instance(uint32_t scheduler_index,
                                     uint64_t desc_length,
                                     uint64_t start_index_desc,
                                     uint64_t timeslice_size,
+                                    std::vector<double> weights,
                                     std::string log_directory,
                                     bool enable_logging) {
   if (instance_ == nullptr) {
     instance_ = new InputTimesliceManager(
         scheduler_index, compute_conn_count, interval_length, data_source_desc,
-        desc_length, start_index_desc, timeslice_size, log_directory,
+        desc_length, start_index_desc, timeslice_size, weights, log_directory,
         enable_logging);
   }
   return instance_;
@@ -220,21 +202,13 @@ InputTimesliceManager* InputTimesliceManager::get_instance() {
 
 uint64_t
 InputTimesliceManager::get_connection_next_timeslice(uint32_t compute_index) {
-  if ((future_conn_timeslices_.get(compute_index)->empty() /*&&
-       std::find(virtual_physical_compute_mapping_.begin(),
-                 virtual_physical_compute_mapping_.end(),
-                 compute_index) == virtual_physical_compute_mapping_.end()*/) /*||
-      (compute_index == 0 && next_start_future_timeslice_ > 1100000)*/) {
-    return ConstVariables::MINUS_ONE;
-  }
-  if (future_conn_timeslices_.get(compute_index)->empty()) {
-    assert(false);
-    // refill_future_timeslices(next_start_future_timeslice_ +
-    // interval_length_);
-  }
-  return future_conn_timeslices_.get(compute_index)->empty()
-             ? ConstVariables::MINUS_ONE
-             : (*future_conn_timeslices_.get(compute_index)->begin());
+  uint64_t next = schedule_.next(compute_index,
+                                 conn_schedule_position_[compute_index]);
+  const std::set<uint64_t>& rescheduled =
+      rescheduled_conn_timeslices_[compute_index];
+  if (!rescheduled.empty() && *rescheduled.begin() < next)
+    next = *rescheduled.begin();
+  return next == TimesliceSchedule::NONE ? ConstVariables::MINUS_ONE : next;
 }
 
 void InputTimesliceManager::log_timeslice_transmit_time(uint32_t compute_index,
@@ -242,9 +216,8 @@ void InputTimesliceManager::log_timeslice_transmit_time(uint32_t compute_index,
                                                         uint64_t size) {
 
   logger_->log_rdma_transmission(compute_index, timeslice);
-  if (conn_timeslice_info_.get(compute_index)->contains(timeslice)) {
-    TimesliceInfo* timeslice_info =
-        conn_timeslice_info_.get(compute_index)->get(timeslice);
+  TimesliceInfo* timeslice_info = get_timeslice_info(compute_index, timeslice);
+  if (timeslice_info != nullptr) {
     L_(info) << "[log_timeslice_transmit_time] compute_index: " << compute_index
              << ", timeslice: " << timeslice << ", completion_acked_duration: "
              << timeslice_info->completion_acked_duration
@@ -252,26 +225,35 @@ void InputTimesliceManager::log_timeslice_transmit_time(uint32_t compute_index,
              << ", compute_desc: " << timeslice_info->compute_desc
              << ", data: " << timeslice_info->data;
   }
-  assert(!conn_timeslice_info_.get(compute_index)->contains(timeslice));
+  assert(timeslice_info == nullptr);
 
+  RingIndexedTable<TimesliceInfo>& timeslices =
+      conn_timeslice_info_[compute_index];
   uint64_t descriptor_index = last_conn_desc_[compute_index] + 1,
            timeslice_data =
                size +
                (last_conn_timeslice_[compute_index] == ConstVariables::MINUS_ONE
                     ? 0
-                    : conn_timeslice_info_.get(compute_index)
-                          ->get(last_conn_timeslice_[compute_index])
-                          ->data);
+                    : timeslices.get(last_conn_desc_[compute_index]).data);
 
-  TimesliceInfo* timeslice_info = new TimesliceInfo();
+  timeslice_info = timeslices.insert(descriptor_index);
+  assert(timeslice_info != nullptr);
+  timeslice_info->timeslice = timeslice;
   timeslice_info->data = timeslice_data;
   timeslice_info->compute_desc = descriptor_index;
   timeslice_info->transmit_time = std::chrono::high_resolution_clock::now();
-  assert(
-      conn_timeslice_info_.get(compute_index)->add(timeslice, timeslice_info));
-  assert(conn_desc_timeslice_info_.get(compute_index)
-             ->add(descriptor_index, timeslice));
-  assert(future_conn_timeslices_.get(compute_index)->erase(timeslice) == 1);
+  timeslice_info->rdma_acked_duration = 0;
+  timeslice_info->completion_acked_duration = 0;
+
+  // a rescheduled timeslice moves from the failed connection to this one
+  timeslice_owner_.remove(timeslice);
+  timeslice_owner_.add(timeslice,
+                       TimesliceOwner{compute_index, descriptor_index});
+  if (rescheduled_conn_timeslices_[compute_index].erase(timeslice) == 0) {
+    assert(schedule_.owner(timeslice) == compute_index &&
+           timeslice >= conn_schedule_position_[compute_index]);
+    conn_schedule_position_[compute_index] = timeslice + 1;
+  }
   ++last_conn_desc_[compute_index];
   last_conn_timeslice_[compute_index] = timeslice;
   ++sent_timeslices_;
@@ -283,13 +265,12 @@ bool InputTimesliceManager::acknowledge_timeslice_rdma_write(
     uint64_t interval_index, uint32_t compute_index, uint64_t timeslice) {
 
   logger_->log_rdma_ACK_arrival(interval_index, compute_index, timeslice);
-  if (!conn_timeslice_info_.get(compute_index)->contains(timeslice)) {
+  TimesliceInfo* timeslice_info = get_timeslice_info(compute_index, timeslice);
+  if (timeslice_info == nullptr) {
     L_(warning) << "[i_" << scheduler_index_ << "][ACK_RDMA_WRITE] ts "
                 << timeslice << " does not belong to conn_" << compute_index;
     return false;
   }
-  TimesliceInfo* timeslice_info =
-      conn_timeslice_info_.get(compute_index)->get(timeslice);
   if (timeslice_info->rdma_acked_duration != 0) {
     timeslice_info = nullptr;
     return false;
@@ -299,6 +280,7 @@ bool InputTimesliceManager::acknowledge_timeslice_rdma_write(
           std::chrono::high_resolution_clock::now() -
           timeslice_info->transmit_time)
           .count();
+  rdma_ack_metric_.record(timeslice_info->rdma_acked_duration);
   timeslice_info = nullptr;
   return true;
 }
@@ -307,50 +289,38 @@ double InputTimesliceManager::acknowledge_timeslices_completion(
     uint32_t compute_index, uint64_t up_to_descriptor_id) {
   uint64_t sum_latency = 0;
   uint32_t count = 0;
-  SizedMap<uint64_t, uint64_t>* desc_timeslice_list =
-      conn_desc_timeslice_info_.get(compute_index);
-  assert(desc_timeslice_list != nullptr);
-
-  SizedMap<uint64_t, uint64_t>::iterator transmitted_timeslice_iterator =
-      desc_timeslice_list->get_begin_iterator();
-  TimesliceInfo* timeslice_info;
-  while (transmitted_timeslice_iterator !=
-             desc_timeslice_list->get_end_iterator() &&
-         transmitted_timeslice_iterator->first <= up_to_descriptor_id) {
-    timeslice_info = conn_timeslice_info_.get(compute_index)
-                         ->get(transmitted_timeslice_iterator->second);
-    assert(timeslice_info != nullptr);
-    timeslice_info->completion_acked_duration =
+  RingIndexedTable<TimesliceInfo>& timeslices =
+      conn_timeslice_info_[compute_index];
+  uint64_t& desc = conn_first_unacked_desc_[compute_index];
+  std::chrono::high_resolution_clock::time_point now =
+      std::chrono::high_resolution_clock::now();
+  while (desc <= last_conn_desc_[compute_index] &&
+         desc <= up_to_descriptor_id) {
+    TimesliceInfo& timeslice_info = timeslices.get(desc);
+    timeslice_info.completion_acked_duration =
         std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::high_resolution_clock::now() -
-            timeslice_info->transmit_time)
+            now - timeslice_info.transmit_time)
             .count();
+    completion_ack_metric_.record(timeslice_info.completion_acked_duration);
 
     // Calculate the latency
-    sum_latency += timeslice_info->completion_acked_duration -
-                   timeslice_info->rdma_acked_duration;
+    sum_latency += timeslice_info.completion_acked_duration -
+                   timeslice_info.rdma_acked_duration;
     ++count;
-
-    assert(
-        desc_timeslice_list->contains(transmitted_timeslice_iterator->first));
-    // assert(desc_timeslice_list->remove(transmitted_timeslice_iterator->first));
-    assert(desc_timeslice_list->remove(transmitted_timeslice_iterator));
-    transmitted_timeslice_iterator =
-        conn_desc_timeslice_info_.get(compute_index)->get_begin_iterator();
+    ++desc;
   }
   return count == 0 ? 0 : sum_latency / count;
 }
 
 bool InputTimesliceManager::is_timeslice_rdma_acked(uint32_t compute_index,
                                                     uint64_t timeslice) {
-  if (!conn_timeslice_info_.get(compute_index)->contains(timeslice)) {
+  TimesliceInfo* timeslice_info = get_timeslice_info(compute_index, timeslice);
+  if (timeslice_info == nullptr) {
     L_(warning) << "[i_" << scheduler_index_ << "] [RDMA ACKED] ts "
                 << timeslice << " does not belong to conn_" << compute_index;
     return true;
   }
 
-  TimesliceInfo* timeslice_info =
-      conn_timeslice_info_.get(compute_index)->get(timeslice);
   if (timeslice_info->rdma_acked_duration != 0 ||
       timeslice_info->completion_acked_duration != 0) {
     timeslice_info = nullptr;
@@ -365,96 +335,77 @@ bool InputTimesliceManager::is_timeslice_belongs_to_timeout_connection(
     assert(false);
     // refill_future_timeslices(timeslice + 1);
   }
-  std::set<uint32_t>::iterator it = timeout_connections.begin();
-  std::set<uint64_t>* future_ts;
-  while (it != timeout_connections.end()) {
-    future_ts = future_conn_timeslices_.get(*it);
-    if (future_ts->find(timeslice) != future_ts->end() ||
-        conn_timeslice_info_.get(*it)->contains(timeslice)) {
-      future_ts = nullptr;
+  uint32_t owner = schedule_.owner(timeslice);
+  for (uint32_t conn : timeout_connections) {
+    if ((owner == conn && timeslice >= conn_schedule_position_[conn]) ||
+        rescheduled_conn_timeslices_[conn].count(timeslice) != 0 ||
+        get_timeslice_info(conn, timeslice) != nullptr)
       return true;
-    }
-    ++it;
   }
-  future_ts = nullptr;
   return false;
 }
 
+InputTimesliceManager::TimesliceInfo*
+InputTimesliceManager::get_timeslice_info(uint32_t compute_index,
+                                          uint64_t timeslice) {
+  if (!timeslice_owner_.contains(timeslice))
+    return nullptr;
+  const TimesliceOwner& owner = timeslice_owner_.get(timeslice);
+  if (owner.compute_index != compute_index ||
+      !conn_timeslice_info_[compute_index].contains(owner.compute_desc))
+    return nullptr;
+  return &conn_timeslice_info_[compute_index].get(owner.compute_desc);
+}
+
 uint32_t InputTimesliceManager::get_compute_connection_count() {
   return compute_count_;
 }
 
+void InputTimesliceManager::update_compute_connection_count(
+    uint32_t compute_count) {
+  assert(compute_count <= compute_count_);
+  joined_compute_count_ = compute_count;
+}
+
 uint64_t
 InputTimesliceManager::get_last_acked_descriptor(uint32_t compute_index) {
-  if (conn_desc_timeslice_info_.get(compute_index)->empty()) {
-    if (conn_timeslice_info_.get(compute_index)->empty())
+  if (conn_first_unacked_desc_[compute_index] >
+      last_conn_desc_[compute_index]) {
+    if (conn_timeslice_info_[compute_index].empty())
       return 0;
-    return conn_timeslice_info_.get(compute_index)
-        ->get(conn_timeslice_info_.get(compute_index)->get_last_key())
-        ->compute_desc;
+    return conn_timeslice_info_[compute_index].get_last_key();
   }
-  return conn_desc_timeslice_info_.get(compute_index)
-             ->get_begin_iterator()
-             ->first -
-         1;
+  return conn_first_unacked_desc_[compute_index] - 1;
 }
 
 uint64_t
 InputTimesliceManager::get_timeslice_by_descriptor(uint32_t compute_index,
                                                    uint64_t descriptor) {
-  if (conn_desc_timeslice_info_.get(compute_index)->contains(descriptor))
-    return conn_desc_timeslice_info_.get(compute_index)->get(descriptor);
-
-  uint64_t timeslice = ConstVariables::MINUS_ONE;
-
-  SizedMap<uint64_t, TimesliceInfo*>* timeslice_info_list =
-      conn_timeslice_info_.get(compute_index);
-  SizedMap<uint64_t, TimesliceInfo*>::iterator timeslice_info_it =
-      timeslice_info_list->get_end_iterator();
-  do {
-    --timeslice_info_it;
-    if (timeslice_info_it->second->compute_desc == descriptor) {
-      timeslice = timeslice_info_it->first;
-      break;
-    }
-  } while (timeslice_info_it != timeslice_info_list->get_begin_iterator());
-
-  timeslice_info_list = nullptr;
-  return timeslice;
+  if (!conn_timeslice_info_[compute_index].contains(descriptor))
+    return ConstVariables::MINUS_ONE;
+  return conn_timeslice_info_[compute_index].get(descriptor).timeslice;
 }
 
 uint64_t
 InputTimesliceManager::get_last_rdma_acked_timeslice(uint32_t compute_index) {
-  SizedMap<uint64_t, uint64_t>* incompleted_desc_timeslices =
-      conn_desc_timeslice_info_.get(compute_index);
-  if (incompleted_desc_timeslices->empty()) {
+  uint64_t first_desc = conn_first_unacked_desc_[compute_index];
+  if (first_desc > last_conn_desc_[compute_index]) {
     return last_conn_timeslice_[compute_index];
   }
 
-  uint64_t timeslice = ConstVariables::MINUS_ONE;
-
-  SizedMap<uint64_t, uint64_t>::iterator incompleted_it =
-      incompleted_desc_timeslices->get_end_iterator();
-  SizedMap<uint64_t, TimesliceInfo*>* conn_timeslice_list =
-      conn_timeslice_info_.get(compute_index);
-  TimesliceInfo* timeslice_info;
-  do {
-    --incompleted_it;
-    timeslice_info = conn_timeslice_list->get(incompleted_it->second);
-    if (timeslice_info->rdma_acked_duration != 0) {
-      timeslice = incompleted_it->second;
-      break;
+  RingIndexedTable<TimesliceInfo>& timeslices =
+      conn_timeslice_info_[compute_index];
+  for (uint64_t desc = last_conn_desc_[compute_index]; desc >= first_desc;
+       --desc) {
+    if (timeslices.contains(desc) &&
+        timeslices.get(desc).rdma_acked_duration != 0) {
+      return timeslices.get(desc).timeslice;
     }
-
-  } while (incompleted_it != incompleted_desc_timeslices->get_begin_iterator());
-
-  // When all the timeslices in conn_desc_timeslice_info_ are not RDMA acked
-  // yet, return the last one not in the conn_desc_timeslice_info_
-  if (timeslice == ConstVariables::MINUS_ONE) {
-    timeslice =
-        get_timeslice_by_descriptor(compute_index, incompleted_it->first - 1);
   }
-  return timeslice;
+
+  // When all the uncompleted timeslices are not RDMA acked yet, return the
+  // last completed one
+  return get_timeslice_by_descriptor(compute_index, first_desc - 1);
 }
 
 uint64_t InputTimesliceManager::get_last_timeslice_before_blockage(
@@ -494,22 +445,19 @@ uint64_t InputTimesliceManager::get_last_connection_descriptor_index(
 uint64_t InputTimesliceManager::count_timeslices_of_interval(
     uint32_t compute_index, uint64_t start_ts, uint64_t end_ts) {
   uint64_t count = 0;
-  SizedMap<uint64_t, TimesliceInfo*>* timesliceInfos =
-      conn_timeslice_info_.get(compute_index);
-  if (timesliceInfos->empty()) {
-    timesliceInfos = nullptr;
+  RingIndexedTable<TimesliceInfo>& timeslices =
+      conn_timeslice_info_[compute_index];
+  if (timeslices.empty()) {
     return count;
   }
 
-  SizedMap<uint64_t, TimesliceInfo*>::iterator timesliceInfo_it =
-      timesliceInfos->get_end_iterator();
-  do {
-    --timesliceInfo_it;
-    if (timesliceInfo_it->first >= start_ts &&
-        timesliceInfo_it->first <= end_ts)
+  for (uint64_t desc = timeslices.get_first_key();
+       desc <= timeslices.get_last_key(); ++desc) {
+    if (timeslices.contains(desc) &&
+        timeslices.get(desc).timeslice >= start_ts &&
+        timeslices.get(desc).timeslice <= end_ts)
       ++count;
-  } while (timesliceInfo_it != timesliceInfos->get_begin_iterator());
-  timesliceInfos = nullptr;
+  }
   return count;
 }
 
@@ -518,65 +466,46 @@ uint64_t InputTimesliceManager::count_unacked_timeslices_of_interval(
 
   // TODO refill_future_timeslices(end_ts + 1);
   uint64_t count = 0;
-  SizedMap<uint64_t, uint64_t>* desc_timeslices =
-      conn_desc_timeslice_info_.get(compute_index);
-  if (desc_timeslices->empty()) {
-    return 0;
-  }
-
-  if (desc_timeslices->get_begin_iterator()->second >= start_ts &&
-      (--desc_timeslices->get_end_iterator())->second <= end_ts)
-    return desc_timeslices->size();
-
-  SizedMap<uint64_t, uint64_t>::iterator desc_timeslice_it =
-      desc_timeslices->get_end_iterator();
-  do {
-    --desc_timeslice_it;
-    if (desc_timeslice_it->second >= start_ts &&
-        desc_timeslice_it->second <= end_ts)
+  RingIndexedTable<TimesliceInfo>& timeslices =
+      conn_timeslice_info_[compute_index];
+  for (uint64_t desc = conn_first_unacked_desc_[compute_index];
+       desc <= last_conn_desc_[compute_index]; ++desc) {
+    if (timeslices.contains(desc) &&
+        timeslices.get(desc).timeslice >= start_ts &&
+        timeslices.get(desc).timeslice <= end_ts)
       ++count;
-  } while (desc_timeslice_it != desc_timeslices->get_begin_iterator());
-
+  }
   return count;
 }
 
 uint64_t InputTimesliceManager::count_future_timeslices_of_interval(
     uint32_t compute_index, uint64_t start_ts, uint64_t end_ts) {
-  // TODO refill_future_timeslices(end_ts + 1);
   uint64_t count = 0;
-  std::set<uint64_t> future_timeslices =
-      (*future_conn_timeslices_.get(compute_index));
-  if (future_timeslices.empty())
-    return 0;
-
-  if (*future_timeslices.begin() >= start_ts &&
-      *(--future_timeslices.end()) <= end_ts)
-    return future_timeslices.size();
-
-  for (uint64_t ts : future_timeslices) {
-    if (ts >= start_ts && ts <= end_ts)
-      ++count;
-  }
+  uint64_t first_ts =
+      std::max(start_ts, conn_schedule_position_[compute_index]);
+  if (first_ts <= end_ts)
+    count = schedule_.count(compute_index, first_ts, end_ts);
+
+  const std::set<uint64_t>& rescheduled =
+      rescheduled_conn_timeslices_[compute_index];
+  if (start_ts <= end_ts)
+    count += std::distance(rescheduled.lower_bound(start_ts),
+                           rescheduled.upper_bound(end_ts));
   return count;
 }
 
 std::pair<uint64_t, uint64_t>
 InputTimesliceManager::get_data_and_desc_of_timeslice(uint32_t compute_index,
                                                       uint32_t timeslice) {
-  if (!conn_timeslice_info_.get(compute_index)->contains(timeslice)) {
+  TimesliceInfo* timeslice_info = get_timeslice_info(compute_index, timeslice);
+  if (timeslice_info == nullptr) {
     L_(fatal) << "compute index " << compute_index << " timeslice " << timeslice
               << " last conn_timeslice " << last_conn_timeslice_[compute_index]
               << " conn_timeslice_info size "
-              << conn_timeslice_info_.get(compute_index)->size();
+              << conn_timeslice_info_[compute_index].size();
     assert(false);
   }
-  TimesliceInfo* timeslice_info =
-      conn_timeslice_info_.get(compute_index)->get(timeslice);
-  std::pair<uint64_t, uint64_t> info =
-      std::make_pair(timeslice_info->data, timeslice_info->compute_desc);
-
-  timeslice_info = nullptr;
-  return info;
+  return std::make_pair(timeslice_info->data, timeslice_info->compute_desc);
 }
 
 std::pair<uint64_t, uint64_t>
@@ -591,13 +520,17 @@ InputTimesliceManager::get_data_and_desc_of_last_timeslice(
 std::vector<uint64_t> InputTimesliceManager::consider_reschedule_decision(
     HeartbeatFailedNodeInfo failed_node_info,
     const std::set<uint32_t> timeout_connections) {
-  assert(compute_count_ > timeout_connections.size());
+  assert(joined_compute_count_ > timeout_connections.size());
   std::vector<uint64_t> undo_timeslices =
       manage_after_trigger_timeslices_on_failure(failed_node_info);
   std::vector<uint64_t> failed_timeslices =
       retrieve_failed_timeslices_on_failure(failed_node_info);
   undo_timeslices.insert(undo_timeslices.end(), failed_timeslices.begin(),
                          failed_timeslices.end());
+  resent_metric_.add(failed_timeslices.size());
+  L_(info) << "[consider_reschedule_decision] " << failed_timeslices.size()
+           << " transmitted timeslices of failed compute node "
+           << failed_node_info.index << " are resent";
 
   distribute_failed_timeslices_on_active_connections(failed_node_info,
                                                      timeout_connections);
@@ -643,22 +576,19 @@ std::vector<uint64_t>
 InputTimesliceManager::retrieve_failed_timeslices_on_failure(
     HeartbeatFailedNodeInfo failed_node_info) {
   std::vector<uint64_t> undo_timeslices;
-  std::set<uint64_t>* failed_timeslice =
-      future_conn_timeslices_.get(failed_node_info.index);
-  // clean the conn_desc_timeslice_info_ and move them back to future
-  // timeslices
-  SizedMap<uint64_t, uint64_t>* failed_conn_desc_timeslice_info =
-      conn_desc_timeslice_info_.get(failed_node_info.index);
-  assert(failed_conn_desc_timeslice_info->empty() ||
-         failed_conn_desc_timeslice_info->get_begin_iterator()->first ==
-             failed_node_info.last_completed_desc + 1);
-  while (!failed_conn_desc_timeslice_info->empty()) {
-    failed_timeslice->insert(
-        failed_conn_desc_timeslice_info->get_begin_iterator()->second);
-    undo_timeslices.push_back(
-        failed_conn_desc_timeslice_info->get_begin_iterator()->second);
-    assert(failed_conn_desc_timeslice_info->remove(
-        failed_conn_desc_timeslice_info->get_begin_iterator()->first));
+  std::set<uint64_t>& failed_timeslice =
+      rescheduled_conn_timeslices_[failed_node_info.index];
+  // move the uncompleted timeslices back to future timeslices
+  RingIndexedTable<TimesliceInfo>& timeslices =
+      conn_timeslice_info_[failed_node_info.index];
+  uint64_t& desc = conn_first_unacked_desc_[failed_node_info.index];
+  uint64_t last_desc = last_conn_desc_[failed_node_info.index];
+  assert(desc > last_desc || desc == failed_node_info.last_completed_desc + 1);
+  for (; desc <= last_desc; ++desc) {
+    if (!timeslices.contains(desc))
+      continue;
+    failed_timeslice.insert(timeslices.get(desc).timeslice);
+    undo_timeslices.push_back(timeslices.get(desc).timeslice);
   }
   return undo_timeslices;
 }
@@ -667,102 +597,35 @@ void InputTimesliceManager::distribute_failed_timeslices_on_active_connections(
     HeartbeatFailedNodeInfo failed_node_info,
     const std::set<uint32_t> timeout_connections) {
 
-  std::set<uint64_t>* failed_timeslice =
-      future_conn_timeslices_.get(failed_node_info.index);
+  uint32_t failed_index = failed_node_info.index;
+  std::set<uint64_t>& failed_timeslice =
+      rescheduled_conn_timeslices_[failed_index];
+  // The scheduled timeslices of the failed node that are not transmitted yet
+  for (uint64_t ts =
+           schedule_.next(failed_index, conn_schedule_position_[failed_index]);
+       ts != TimesliceSchedule::NONE; ts = schedule_.next(failed_index, ts + 1))
+    failed_timeslice.insert(ts);
+  conn_schedule_position_[failed_index] = next_start_future_timeslice_;
+
   // Distribute failed_timeslices over active connections in a temporary array
-  if (!failed_timeslice->empty()) {
+  if (!failed_timeslice.empty()) {
     std::vector<std::set<uint64_t>*> movable_ts(compute_count_, nullptr);
     uint32_t compute_index = 0;
-    while (!failed_timeslice->empty()) {
+    while (!failed_timeslice.empty()) {
+      // standby compute nodes that did not join yet take no timeslices
       while (timeout_connections.find(compute_index) !=
              timeout_connections.end())
-        compute_index = (compute_index + 1) % compute_count_;
+        compute_index = (compute_index + 1) % joined_compute_count_;
       if (movable_ts[compute_index] == nullptr)
         movable_ts[compute_index] = new std::set<uint64_t>();
-      movable_ts[compute_index]->insert((*failed_timeslice->begin()));
-      // L_(info) << "ts "<< (*failed_timeslice->begin()) << " of CN " <<
+      movable_ts[compute_index]->insert((*failed_timeslice.begin()));
+      // L_(info) << "ts "<< (*failed_timeslice.begin()) << " of CN " <<
       // failed_node_info.index << " moved to " << compute_index;
-      failed_timeslice->erase((*failed_timeslice->begin()));
-      compute_index = (compute_index + 1) % compute_count_;
+      failed_timeslice.erase((*failed_timeslice.begin()));
+      compute_index = (compute_index + 1) % joined_compute_count_;
     }
     to_be_moved_timeslices_.add(failed_node_info.timeslice_trigger, movable_ts);
   }
-  failed_timeslice = nullptr;
-}
-
-void InputTimesliceManager::generate_log_files() {
-  if (!enable_logging_)
-    return;
-
-  /////////////////////////////////////////////////////////////////
-  std::ofstream blocked_duration_log_file;
-  blocked_duration_log_file.open(log_directory_ + "/" +
-                                 std::to_string(scheduler_index_) +
-                                 ".input.ts_blocked_duration.out");
-
-  blocked_duration_log_file << std::setw(25) << "Timeslice" << std::setw(25)
-                            << "Compute Index" << std::setw(25) << "IB"
-                            << std::setw(25) << "CB" << std::setw(25) << "MR"
-                            << "\n";
-  /*
-    uint64_t last_ts = std::max(
-        (timeslice_IB_blocked_duration_log_.empty()
-             ? 0
-             : timeslice_IB_blocked_duration_log_.get_last_key()),
-        std::max((timeslice_CB_blocked_duration_log_.empty()
-                      ? 0
-                      : timeslice_CB_blocked_duration_log_.get_last_key()),
-                 (timeslice_MR_blocked_duration_log_.empty()
-                      ? 0
-                      : timeslice_MR_blocked_duration_log_.get_last_key())));
-    for (uint64_t ts = 0; ts <= last_ts; ts++) {
-      blocked_duration_log_file
-          << std::setw(25) << ts << std::setw(25) << (ts % compute_count_)
-          << std::setw(25)
-          << (timeslice_IB_blocked_duration_log_.contains(ts)
-                  ? timeslice_IB_blocked_duration_log_.get(ts) / 1000.0
-                  : 0)
-          << std::setw(25)
-          << (timeslice_CB_blocked_duration_log_.contains(ts)
-                  ? timeslice_CB_blocked_duration_log_.get(ts) / 1000.0
-                  : 0)
-          << std::setw(25)
-          << (timeslice_MR_blocked_duration_log_.contains(ts)
-                  ? timeslice_MR_blocked_duration_log_.get(ts) / 1000.0
-                  : 0)
-          << "\n";
-    }
-  */
-  blocked_duration_log_file.flush();
-  blocked_duration_log_file.close();
-
-  /////////////////////////////////////////////////////////////////
-
-  std::ofstream block_log_file;
-  block_log_file.open(log_directory_ + "/" + std::to_string(scheduler_index_) +
-                      ".input.ts_info.out");
-
-  block_log_file << std::setw(25) << "Timeslice" << std::setw(25)
-                 << "Compute Index" << std::setw(25) << "RDMA ACK duration"
-                 << std::setw(25) << "Completion ACK duration"
-                 << "\n";
-  /*
-    for (uint32_t i = 0; i < conn_timeslice_info_.size(); ++i) {
-      SizedMap<uint64_t, TimesliceInfo*>::iterator delaying_time =
-          conn_timeslice_info_.get(i)->get_begin_iterator();
-      while (delaying_time != conn_timeslice_info_.get(i)->get_end_iterator()) {
-        block_log_file << std::setw(25) << delaying_time->first << std::setw(25)
-                       << i << std::setw(25)
-                       << delaying_time->second->rdma_acked_duration
-                       << std::setw(25)
-                       << delaying_time->second->completion_acked_duration
-                       << "\n";
-        delaying_time++;
-      }
-    }
-    */
-  block_log_file.flush();
-  block_log_file.close();
 }
 
 void InputTimesliceManager::log_timeslice_IB_blocked(uint64_t interval,
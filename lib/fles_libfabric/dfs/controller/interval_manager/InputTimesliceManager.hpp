@@ -3,7 +3,10 @@
 #pragma once
 
 #include "ConstVariables.hpp"
+#include "Metrics.hpp"
+#include "RingIndexedTable.hpp"
 #include "SizedMap.hpp"
+#include "TimesliceSchedule.hpp"
 #include "dfs/logger/InputLoggerProxy.hpp"
 #include "dfs/model/fault_tolerance/HeartbeatFailedNodeInfo.hpp"
 
@@ -33,6 +36,7 @@ public:
                                              uint64_t desc_length,
                                              uint64_t start_index_desc,
                                              uint64_t timeslice_size,
+                                             std::vector<double> weights,
                                              std::string log_directory,
                                              bool enable_logging);
 
@@ -72,6 +76,10 @@ public:
   // Get the number of current compute node connections
   uint32_t get_compute_connection_count();
 
+  // Update the number of compute connections taking part in the scheduling
+  // when standby compute nodes join
+  void update_compute_connection_count(uint32_t compute_count);
+
   // Get the last acked descriptor ID of a compute node
   uint64_t get_last_acked_descriptor(uint32_t compute_index);
 
@@ -124,9 +132,6 @@ public:
   consider_reschedule_decision(HeartbeatFailedNodeInfo failed_node_info,
                                const std::set<uint32_t> timeout_connections);
 
-  // Generate log files of the stored data
-  void generate_log_files();
-
   void log_timeslice_IB_blocked(uint64_t interval,
                                 uint32_t compute_index,
                                 uint64_t timeslice,
@@ -159,12 +164,18 @@ public:
 private:
   struct TimesliceInfo {
     std::chrono::high_resolution_clock::time_point transmit_time;
+    uint64_t timeslice;
     uint64_t data;
     uint64_t compute_desc;
     uint64_t rdma_acked_duration = 0;
     uint64_t completion_acked_duration = 0;
   };
 
+  struct TimesliceOwner {
+    uint32_t compute_index;
+    uint64_t compute_desc;
+  };
+
   InputTimesliceManager(uint32_t scheduler_index,
                         uint32_t compute_conn_count,
                         uint32_t interval_length,
@@ -172,12 +183,13 @@ private:
                         uint64_t desc_length,
                         uint64_t start_index_desc,
                         uint64_t timeslice_size,
+                        std::vector<double> weights,
                         std::string log_directory,
                         bool enable_logging);
 
-  // Refill the array of the future timeslices of each connection (considering
-  // timeout connections)
-  // void refill_future_timeslices(uint64_t up_to_timeslice);
+  // Get the transmission info of a timeslice sent to a compute node, nullptr
+  // if the timeslice is not (or no longer) assigned to this compute node
+  TimesliceInfo* get_timeslice_info(uint32_t compute_index, uint64_t timeslice);
 
   // Insert rescheduled timeslices after the correct timeslice
   void check_to_add_rescheduled_timeslices(uint32_t compute_index);
@@ -207,6 +219,10 @@ private:
   // The number of compute connections
   uint32_t compute_count_;
 
+  // The number of compute connections taking part in the scheduling; the
+  // remaining ones belong to standby compute nodes that did not join yet
+  uint32_t joined_compute_count_;
+
   // Input Scheduler index
   uint32_t scheduler_index_;
 
@@ -234,14 +250,24 @@ private:
   // Check whether to generate log files
   bool enable_logging_;
 
-  // Mapping of connections and their transmitted timeslices
-  SizedMap<uint32_t, SizedMap<uint64_t, TimesliceInfo*>*> conn_timeslice_info_;
+  // Transmitted timeslices of each connection indexed by descriptor ID
+  std::vector<RingIndexedTable<TimesliceInfo>> conn_timeslice_info_;
+
+  // The connection and descriptor ID of each transmitted timeslice
+  RingIndexedTable<TimesliceOwner> timeslice_owner_;
+
+  // First descriptor ID of each connection that is not completion acked yet
+  std::vector<uint64_t> conn_first_unacked_desc_;
 
-  // Mapping of timeslice and its descriptor ID of each compute node
-  SizedMap<uint32_t, SizedMap<uint64_t, uint64_t>*> conn_desc_timeslice_info_;
+  // The compute connection of each future timeslice, per interval
+  TimesliceSchedule schedule_;
 
-  // Future Timeslices for each compute connection <conn_id, <timeslices>>
-  SizedMap<uint32_t, std::set<uint64_t>*> future_conn_timeslices_;
+  // The first timeslice in schedule_ of each connection that is not
+  // transmitted yet
+  std::vector<uint64_t> conn_schedule_position_;
+
+  // Timeslices of failed connections that are rescheduled to each connection
+  std::vector<std::set<uint64_t>> rescheduled_conn_timeslices_;
 
   // The received decisions of redistribution
   SizedMap<uint32_t, uint64_t> redistribution_decisions_log_;
@@ -254,12 +280,17 @@ private:
   std::vector<uint64_t> last_conn_desc_;
   std::vector<uint64_t> last_conn_timeslice_;
 
-  // Indicator of the timeslice, to start from, to refill the
-  // future_conn_timeslices_ list
+  // The first timeslice that is not scheduled yet
   uint64_t next_start_future_timeslice_ = ConstVariables::ZERO;
 
   /// LOGGING
   // Input Buffer blockage
   InputLoggerProxy* logger_;
+
+  // Exported durations from sending a timeslice to its RDMA and completion
+  // acknowledgements
+  MetricsHistogram& rdma_ack_metric_;
+  MetricsHistogram& completion_ack_metric_;
+  MetricsCounter& resent_metric_;
 };
 } // namespace tl_libfabric
@@ -0,0 +1,54 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "BufferFillLevelPolicy.hpp"
+#include "ConstVariables.hpp"
+#include "log.hpp"
+
+namespace tl_libfabric {
+
+BufferFillLevelPolicy::BufferFillLevelPolicy(uint32_t variance_percentage)
+    : variance_percentage_(variance_percentage) {}
+
+LoadBalancingDecision BufferFillLevelPolicy::decide(
+    const std::vector<ComputeNodeLoadStatistics>& statistics,
+    const std::vector<double>& last_load,
+    bool calculate) {
+  LoadBalancingDecision decision;
+  decision.load = last_load;
+  if (statistics.size() != last_load.size() || statistics.empty())
+    return decision;
+
+  std::vector<uint64_t> fill_level(statistics.size());
+  for (uint32_t i = 0; i < statistics.size(); ++i)
+    fill_level[i] = std::min<uint64_t>(statistics[i].buffer_fill_level, 100);
+  StatisticsCalculator::ListStatistics fill_stats =
+      StatisticsCalculator::calculate_list_statistics(fill_level);
+  decision.stats = fill_stats;
+  decision.variance = (fill_stats.max_val - fill_stats.median_val) / 100.0;
+
+  L_(info) << "[" << name() << "] min fill level: " << fill_stats.min_val
+           << "% max fill level: " << fill_stats.max_val
+           << "% max index: " << fill_stats.max_indx
+           << " median: " << fill_stats.median_val
+           << "% max_variance_percentage_: " << variance_percentage_ << "%";
+  if (fill_stats.max_val - fill_stats.median_val <= variance_percentage_ ||
+      fill_stats.median_val == 100)
+    return decision;
+
+  decision.redistribute = true;
+  if (!calculate)
+    return decision;
+
+  std::vector<double>& load = decision.load;
+  double median_free = 100.0 - fill_stats.median_val;
+  for (uint32_t i = 0; i < load.size(); ++i) {
+    double free = 100.0 - fill_level[i];
+    // full buffers still get a small share to detect their recovery
+    load[i] *= std::max(free, 1.0) / median_free;
+  }
+  normalize(load);
+  L_(info) << "[" << name() << "] new load "
+           << ConstVariables::vector_to_string(load);
+  return decision;
+}
+} // namespace tl_libfabric
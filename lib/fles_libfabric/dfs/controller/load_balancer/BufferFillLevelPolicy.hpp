@@ -0,0 +1,28 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#pragma once
+
+#include "LoadBalancingPolicy.hpp"
+
+namespace tl_libfabric {
+/**
+ * Policy shifting load away from compute nodes whose buffers are fuller than
+ * the median of all compute nodes by more than the allowed variance (in
+ * percentage points). Each load is scaled by the node's free buffer share
+ * relative to the median free share.
+ */
+class BufferFillLevelPolicy : public LoadBalancingPolicy {
+public:
+  BufferFillLevelPolicy(uint32_t variance_percentage);
+
+  std::string name() const override { return "buffer-fill-level"; }
+
+  LoadBalancingDecision
+  decide(const std::vector<ComputeNodeLoadStatistics>& statistics,
+         const std::vector<double>& last_load,
+         bool calculate) override;
+
+private:
+  uint32_t variance_percentage_;
+};
+} // namespace tl_libfabric
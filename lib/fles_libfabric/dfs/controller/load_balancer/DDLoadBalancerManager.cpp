@@ -12,11 +12,14 @@ DDLoadBalancerManager::get_instance(uint32_t scheduler_index,
                                     uint32_t compute_connection_count,
                                     uint32_t max_history_size,
                                     uint32_t variance_percentage,
+                                    std::string policies,
+                                    std::vector<double> weights,
                                     std::string log_directory,
                                     bool enable_logging) {
   instance_ = new DDLoadBalancerManager(
       scheduler_index, input_connection_count, compute_connection_count,
-      max_history_size, variance_percentage, log_directory, enable_logging);
+      max_history_size, variance_percentage, policies, weights, log_directory,
+      enable_logging);
   return instance_;
 }
 
@@ -31,24 +34,18 @@ std::vector<double> DDLoadBalancerManager::get_last_distribution_load() {
 }
 
 bool DDLoadBalancerManager::needs_redistribute_load(
-    uint64_t interval_index,
+    uint64_t /*interval_index*/,
     uint64_t speedup_start_interval_index,
     uint64_t speedup_end_interval_index) {
-  /*L_(info) << "[needs_redistribute_load] interval_index: " << interval_index
-           << " speedup_start_interval_index: " << speedup_start_interval_index
-           << " speedup_end_interval_index: " << speedup_end_interval_index;*/
-  if (get_load_by_rdma_latency(interval_index, speedup_start_interval_index,
-                               speedup_end_interval_index, false)
-          .first ||
-      get_load_by_ts_processing_duration(interval_index,
-                                         speedup_start_interval_index,
-                                         speedup_end_interval_index, false)
-          .first ||
-      get_load_by_ts_completion_duration(interval_index,
-                                         speedup_start_interval_index,
-                                         speedup_end_interval_index, false)
-          .first)
-    return true;
+  if (speedup_start_interval_index < last_join_interval_)
+    return false;
+  std::vector<ComputeNodeLoadStatistics> statistics = retrieve_load_statistics(
+      speedup_start_interval_index, speedup_end_interval_index);
+  std::vector<double> last_load = get_last_distribution_load();
+  for (auto& policy : policies_) {
+    if (policy->decide(statistics, last_load, false).redistribute)
+      return true;
+  }
   return false;
 }
 
@@ -56,33 +53,29 @@ std::vector<double> DDLoadBalancerManager::calculate_new_distribtion_load(
     uint64_t interval_index,
     uint64_t speedup_start_interval_index,
     uint64_t speedup_end_interval_index) {
+  if (speedup_start_interval_index < last_join_interval_)
+    return get_last_distribution_load();
+  std::vector<ComputeNodeLoadStatistics> statistics = retrieve_load_statistics(
+      speedup_start_interval_index, speedup_end_interval_index);
+  L_(info) << "[calculate_new_distribtion_load] speedup_start_interval_index: "
+           << speedup_start_interval_index
+           << " speedup_end_interval_index: " << speedup_end_interval_index
+           << " # conns: " << statistics.size();
+  std::vector<double> last_load = get_last_distribution_load();
   std::vector<std::vector<double>> loads;
-  // (1) Find load by observed write-RDMA latency from INs
-  loads.push_back(get_load_by_rdma_latency(interval_index,
-                                           speedup_start_interval_index,
-                                           speedup_end_interval_index)
-                      .second);
-  // (2) Find load by observed msg latency from INs
-  /* TODO loads.push_back(get_load_by_msg_latency(interval_index,
-    speedup_start_interval_index, speedup_end_interval_index));*/
-  // (3) Find load by observed CN blockage durations
-  // find_blockgable_compute_node_by_buffer_blockage_time();
-  // (4) Find load by observed IN blockage durations
-  //
-  // (5) Find load by observed processing duration at CNs
-  loads.push_back(get_load_by_ts_processing_duration(
-                      interval_index, speedup_start_interval_index,
-                      speedup_end_interval_index)
-                      .second);
-  // (6) Find load by observed completion duration at CNs
-  loads.push_back(get_load_by_ts_completion_duration(
-                      interval_index, speedup_start_interval_index,
-                      speedup_end_interval_index)
-                      .second);
-  // (7) Find load by observed buffer fill-level at CNs
-  /*std::vector<double> buffer_fill_level_load = get_load_by_buffer_fill_level(
-      speedup_start_interval_index, speedup_end_interval_index);*/
-  //
+  for (uint32_t i = 0; i < policies_.size(); ++i) {
+    LoadBalancingDecision decision =
+        policies_[i]->decide(statistics, last_load, true);
+    loads.push_back(decision.load);
+    if (decision.redistribute) {
+      MatrixLog log;
+      log.stats = decision.stats;
+      log.variance = decision.variance;
+      log.load_to_distribute = decision.load_to_distribute;
+      load_balancing_logs_.add(
+          std::pair<uint64_t, uint32_t>(interval_index, i), log);
+    }
+  }
   return calculate_aggregated_average_load_distribution(loads);
 }
 
@@ -96,255 +89,51 @@ std::vector<double> DDLoadBalancerManager::consider_new_distribtion_load(
   return new_load;
 }
 
+void DDLoadBalancerManager::update_compute_count(uint64_t interval_index,
+                                                 uint32_t compute_count) {
+  if (compute_count <= compute_connection_count_)
+    return;
+  std::vector<double> load = LoadBalancingPolicy::join_load(
+      get_last_distribution_load(), weights_, compute_count);
+  L_(info) << "[" << scheduler_index_ << "] interval " << interval_index
+           << ": " << compute_count - compute_connection_count_
+           << " compute nodes joined, new load: "
+           << ConstVariables::vector_to_string(load);
+  compute_connection_count_ = compute_count;
+  last_join_interval_ = interval_index + 1;
+
+  uint64_t last_interval = interval_load_distribution_.get_last_key();
+  if (interval_index <= last_interval)
+    interval_load_distribution_.update(last_interval, load);
+  else
+    interval_load_distribution_.add(interval_index, load);
+}
+
 DDLoadBalancerManager::DDLoadBalancerManager(uint32_t scheduler_index,
                                              uint32_t input_connection_count,
                                              uint32_t compute_connection_count,
                                              uint32_t max_history_size,
                                              uint32_t variance_percentage,
+                                             std::string policies,
+                                             std::vector<double> weights,
                                              std::string log_directory,
                                              bool enable_logging)
     : scheduler_index_(scheduler_index),
       input_connection_count_(input_connection_count),
       compute_connection_count_(compute_connection_count),
       max_history_size_(max_history_size),
-      variance_percentage_(variance_percentage), log_directory_(log_directory),
-      enable_logging_(enable_logging) {
+      variance_percentage_(variance_percentage), weights_(weights),
+      log_directory_(log_directory),
+      enable_logging_(enable_logging),
+      policies_(LoadBalancingPolicy::create(policies, variance_percentage)) {
   assert(max_history_size_ >= 1);
   compute_interval_data_manager_ = ComputeIntervalDataManager::get_instance();
+  // The dynamic load balancing starts from the configured capacities of the
+  // compute nodes that start the run
+  if (weights.size() > compute_connection_count_)
+    weights.resize(compute_connection_count_);
   interval_load_distribution_.add(
-      0, std::vector<double>(compute_connection_count_, 1));
-}
-
-////////////////////// Business Logic //////////////////////
-/**
- *
- * Prerequisite: Sum of all loads = # of compute nodes
- * ------------- Algo ----------------
- * TODO (1) assert that this call is after a speedup interval
- * (2) Get the median latency[i] of each CN during the speedup phase
- *            Hint: at least one speedup interval is still running!
- * (3) Calculate Statistics (min, median, max, sum) of step#(2)
- * (4) if (max-median)/max <= variance_percentage RETURN
- * (5) Calculate the overload to distribute on other nodes
- * (6) calculate the new load of slowest node
- * (7) distribute the overload equally on all compute nodes to maintain the same
- *     variance
- * TODO For better performance, use weighed load distribution
- *      (closer to median, more share to get)
- *
- */
-std::pair<bool, std::vector<double>>
-DDLoadBalancerManager::get_load_by_ts_processing_duration(
-    uint64_t interval_index,
-    uint64_t speedup_start_interval_index,
-    uint64_t speedup_end_interval_index,
-    bool calculate) {
-
-  std::vector<uint64_t> median_processing_duration =
-      retrieve_median_ts_duration(speedup_start_interval_index,
-                                  speedup_end_interval_index, true);
-  if (true)
-    L_(info)
-        << "[get_load_by_ts_processing_duration] speedup_start_interval_index: "
-        << speedup_start_interval_index
-        << " speedup_end_interval_index: " << speedup_end_interval_index
-        << " # conns: " << median_processing_duration.size();
-
-  // TODO REMOVE LOGGING PART
-  MatrixLog* log = new MatrixLog();
-  std::pair<bool, std::vector<double>> load =
-      get_load_by_lowering_duration(median_processing_duration, log, calculate);
-  if (load.first)
-    load_balancing_logs_.add(
-        std::pair<uint64_t, MatrixType>(interval_index, MatrixType::TS_PROC),
-        log);
-  return load;
-}
-
-/**
- *
- * Prerequisite: Sum of all loads = # of compute nodes
- * ------------- Algo ----------------
- * TODO (1) assert that this call is after a speedup interval
- * (2) Get the median comp duration[i] of each CN during the speedup phase
- *            Hint: at least one speedup interval is still running!
- * (3) Calculate Statistics (min, median, max, sum) of step#(2)
- * (4) if (max-median)/max <= variance_percentage RETURN
- * (5) Calculate the overload to distribute on other nodes
- * (6) calculate the new load of slowest node
- * (7) distribute the overload equally on all compute nodes to maintain the same
- *     variance
- * TODO For better performance, use weighed load distribution
- *      (closer to median, more share to get)
- *
- */
-std::pair<bool, std::vector<double>>
-DDLoadBalancerManager::get_load_by_ts_completion_duration(
-    uint64_t interval_index,
-    uint64_t speedup_start_interval_index,
-    uint64_t speedup_end_interval_index,
-    bool calculate) {
-
-  std::vector<uint64_t> median_completion_duration =
-      retrieve_median_ts_duration(speedup_start_interval_index,
-                                  speedup_end_interval_index, false);
-  if (true)
-    L_(info)
-        << "[get_load_by_ts_completion_duration] speedup_start_interval_index: "
-        << speedup_start_interval_index
-        << " speedup_end_interval_index: " << speedup_end_interval_index
-        << " # conns: " << median_completion_duration.size();
-
-  // TODO REMOVE LOGGING PART
-  MatrixLog* log = new MatrixLog();
-  std::pair<bool, std::vector<double>> load =
-      get_load_by_lowering_duration(median_completion_duration, log, calculate);
-  if (load.first)
-    load_balancing_logs_.add(
-        std::pair<uint64_t, MatrixType>(interval_index, MatrixType::TS_COMP),
-        log);
-  return load;
-}
-
-/**
- *
- * Prerequisite: Sum of all loads = # of compute nodes
- * ------------- Algo ----------------
- * TODO (1) assert that this call is after a speedup interval
- * (2) Get the median rdma-write latency[i] of each CN
- *            Hint: at least one speedup interval is still running!
- * (3) Calculate Statistics (min, median, max, sum) of step#(2)
- * (4) if (max-median)/max <= variance_percentage RETURN
- * (5) Calculate the overload to distribute on other nodes
- * (6) calculate the new load of slowest node
- * (7) distribute the overload equally on all compute nodes to maintain the same
- *     variance
- * TODO For better performance, use weighed load distribution
- *      (closer to median, more share to get)
- *
- */
-std::pair<bool, std::vector<double>>
-DDLoadBalancerManager::get_load_by_rdma_latency(
-    uint64_t interval_index,
-    uint64_t speedup_start_interval_index,
-    uint64_t speedup_end_interval_index,
-    bool calculate) {
-  std::vector<uint64_t> median_processing_duration =
-      retrieve_median_input_latency(speedup_start_interval_index,
-                                    speedup_end_interval_index, true);
-  if (true)
-    L_(info) << "[get_load_by_rdma_latency] speedup_start_interval_index: "
-             << speedup_start_interval_index
-             << " speedup_end_interval_index: " << speedup_end_interval_index
-             << " # conns: " << median_processing_duration.size();
-  // TODO REMOVE LOGGING PART
-  MatrixLog* log = new MatrixLog();
-  std::pair<bool, std::vector<double>> load =
-      get_load_by_lowering_duration(median_processing_duration, log, calculate);
-  if (load.first)
-    load_balancing_logs_.add(std::pair<uint64_t, MatrixType>(
-                                 interval_index, MatrixType::RDMA_LATENCY),
-                             log);
-  return load;
-}
-
-/**
- *
- * Prerequisite: Sum of all loads = # of compute nodes
- * ------------- Algo ----------------
- * TODO (1) assert that this call is after a speedup interval
- * (2) Get the median msg latency[i] of each CN
- *            Hint: at least one speedup interval is still running!
- * (3) Calculate Statistics (min, median, max, sum) of step#(2)
- * (4) if (max-median)/max <= variance_percentage RETURN
- * (5) Calculate the overload to distribute on other nodes
- * (6) calculate the new load of slowest node
- * (7) distribute the overload equally on all compute nodes to maintain the same
- *     variance
- * TODO For better performance, use weighed load distribution
- *      (closer to median, more share to get)
- *
- */
-std::pair<bool, std::vector<double>>
-DDLoadBalancerManager::get_load_by_msg_latency(
-    uint64_t interval_index,
-    uint64_t speedup_start_interval_index,
-    uint64_t speedup_end_interval_index,
-    bool calculate) {
-  std::vector<uint64_t> median_processing_duration =
-      retrieve_median_input_latency(speedup_start_interval_index,
-                                    speedup_end_interval_index, false);
-  if (true)
-    L_(info) << "[get_load_by_msg_latency] speedup_start_interval_index: "
-             << speedup_start_interval_index
-             << " speedup_end_interval_index: " << speedup_end_interval_index
-             << " # conns: " << median_processing_duration.size();
-
-  // TODO REMOVE LOGGING PART
-  MatrixLog* log = new MatrixLog();
-  std::pair<bool, std::vector<double>> load =
-      get_load_by_lowering_duration(median_processing_duration, log, calculate);
-  if (load.first)
-    load_balancing_logs_.add(std::pair<uint64_t, MatrixType>(
-                                 interval_index, MatrixType::MSG_LATENCY),
-                             log);
-  return load;
-}
-
-////////////////////// Common Business Logic //////////////////////
-std::pair<bool, std::vector<double>>
-DDLoadBalancerManager::get_load_by_lowering_duration(
-    std::vector<uint64_t> median_duration, MatrixLog* log, bool calculate) {
-  StatisticsCalculator::ListStatistics duration_stats =
-      StatisticsCalculator::calculate_list_statistics(median_duration);
-
-  double current_variance =
-      ((duration_stats.max_val - duration_stats.median_val) * 1.0) /
-      (duration_stats.max_val * 1.0);
-
-  log->stats = duration_stats;
-  log->variance = current_variance;
-  std::vector<double> load = get_last_distribution_load();
-  if (true)
-    L_(info) << "[get_load_by_lowering_duration] min duration: "
-             << duration_stats.min_val
-             << " min index: " << duration_stats.min_indx
-             << " max duration: " << duration_stats.max_val
-             << " max index: " << duration_stats.max_indx
-             << " median: " << duration_stats.median_val << " diff_pecentage "
-             << current_variance * 100.0
-             << "% max_variance_percentage_: " << variance_percentage_ << "%"
-             << ", # of conns: " << median_duration.size()
-             << ", prev load conns: " << load.size();
-  if (current_variance * 100.0 <= variance_percentage_) {
-    return std::pair<bool, std::vector<double>>(false, load);
-  }
-  if (calculate) {
-
-    double load_to_distribute =
-        load[duration_stats.max_indx] * current_variance;
-    log->load_to_distribute = load_to_distribute;
-    load[duration_stats.max_indx] *= (1.0 - current_variance);
-    // TODO For better performance, use weighed load distribution
-    // (closer to median, more share to get)
-    double sum_new_load = 0.0;
-    for (uint32_t i = 0; i < load.size(); i++) {
-      // load.size() === sum of all loads
-      load[i] += load[i] * load_to_distribute /
-                 ((load.size() * 1.0) - load_to_distribute);
-      sum_new_load += load[i];
-    }
-    if (true)
-      L_(info) << "[get_load_by_lowering_duration] load_to_distribute: "
-               << load_to_distribute << ", sum_new_load: " << sum_new_load
-               << ", # of conns: " << load.size() << ", new load "
-               << ConstVariables::vector_to_string(load);
-    // Add the small fraction to the fastest node to keep the load constant (sum
-    // of all loads === # of compute nodes)
-    // assert(sum_new_load <= (load.size() * 1.0));
-    load[duration_stats.min_indx] += (load.size() * 1.0) - sum_new_load;
-  }
-  return std::pair<bool, std::vector<double>>(true, load);
+      0, LoadBalancingPolicy::initial_load(weights, compute_connection_count_));
 }
 
 ////////////////////// Helper Methods //////////////////////
@@ -353,7 +142,7 @@ std::vector<uint64_t> DDLoadBalancerManager::retrieve_median_ts_duration(
     uint64_t start_interval_index,
     uint64_t end_interval_index,
     bool processing_duration) {
-  std::vector<std::vector<uint64_t>> processing_duration_history;
+  uint32_t compute_node_count = 0;
 
   uint64_t duration;
   // Collect the procession
@@ -361,9 +150,8 @@ std::vector<uint64_t> DDLoadBalancerManager::retrieve_median_ts_duration(
        interval++) {
     ComputeCompletedIntervalMetaData* meta_data =
         compute_interval_data_manager_->get_actual_interval_meta_data(interval);
-    if (processing_duration_history.size() < meta_data->compute_node_count) {
-      processing_duration_history.resize(meta_data->compute_node_count);
-    }
+    compute_node_count =
+        std::max(compute_node_count, meta_data->compute_node_count);
     for (uint32_t cn_indx = 0; cn_indx < meta_data->compute_node_count;
          ++cn_indx) {
       if (meta_data->compute_statistics[cn_indx] == nullptr)
@@ -374,17 +162,17 @@ std::vector<uint64_t> DDLoadBalancerManager::retrieve_median_ts_duration(
       else
         duration = meta_data->compute_statistics[cn_indx]
                        ->median_timeslice_completion_duration;
-      processing_duration_history[cn_indx].push_back(duration);
+      duration_histogram(cn_indx).record(duration);
     }
   }
-  return calculate_median_normalization(processing_duration_history);
+  return calculate_median_normalization(compute_node_count);
 }
 
 std::vector<uint64_t> DDLoadBalancerManager::retrieve_median_input_latency(
     uint64_t start_interval_index,
     uint64_t end_interval_index,
     bool rdma_write) {
-  std::vector<std::vector<uint64_t>> duration_history;
+  uint32_t compute_node_count = 0;
 
   uint64_t latency;
   // Collect the procession
@@ -392,9 +180,8 @@ std::vector<uint64_t> DDLoadBalancerManager::retrieve_median_input_latency(
        interval++) {
     ComputeCompletedIntervalMetaData* meta_data =
         compute_interval_data_manager_->get_actual_interval_meta_data(interval);
-    if (duration_history.size() < meta_data->compute_node_count) {
-      duration_history.resize(meta_data->compute_node_count);
-    }
+    compute_node_count =
+        std::max(compute_node_count, meta_data->compute_node_count);
     for (uint32_t in_indx = 0; in_indx < input_connection_count_; ++in_indx) {
       if (meta_data->input_statistics[in_indx] == nullptr)
         continue;
@@ -406,20 +193,29 @@ std::vector<uint64_t> DDLoadBalancerManager::retrieve_median_input_latency(
         else
           latency = meta_data->input_statistics[in_indx]
                         ->median_message_latency[cn_indx];
-        duration_history[cn_indx].push_back(latency);
+        duration_histogram(cn_indx).record(latency);
       }
     }
   }
-  return calculate_median_normalization(duration_history);
+  return calculate_median_normalization(compute_node_count);
+}
+
+StatisticsCalculator::Histogram&
+DDLoadBalancerManager::duration_histogram(uint32_t compute_index) {
+  while (duration_histograms_.size() <= compute_index)
+    duration_histograms_.push_back(
+        std::make_unique<StatisticsCalculator::Histogram>());
+  return *duration_histograms_[compute_index];
 }
 
 std::vector<uint64_t> DDLoadBalancerManager::calculate_median_normalization(
-    std::vector<std::vector<uint64_t>> duration_history) {
+    uint32_t compute_node_count) {
   // Calculate median
-  std::vector<uint64_t> median_duration(duration_history.size());
+  std::vector<uint64_t> median_duration(compute_node_count);
   for (uint32_t i = 0; i < median_duration.size(); ++i) {
-    median_duration[i] =
-        StatisticsCalculator::get_median_of_list(duration_history[i]);
+    StatisticsCalculator::Histogram& histogram = duration_histogram(i);
+    median_duration[i] = histogram.median();
+    histogram.reset();
   }
   return median_duration;
 }
@@ -439,14 +235,70 @@ DDLoadBalancerManager::calculate_aggregated_average_load_distribution(
   return new_load;
 }
 
+std::vector<ComputeNodeLoadStatistics>
+DDLoadBalancerManager::retrieve_load_statistics(
+    uint64_t start_interval_index, uint64_t end_interval_index) {
+  std::vector<uint64_t> processing_duration = retrieve_median_ts_duration(
+                            start_interval_index, end_interval_index, true),
+                        completion_duration = retrieve_median_ts_duration(
+                            start_interval_index, end_interval_index, false),
+                        rdma_latency = retrieve_median_input_latency(
+                            start_interval_index, end_interval_index, true),
+                        message_latency = retrieve_median_input_latency(
+                            start_interval_index, end_interval_index, false),
+                        buffer_fill_level = retrieve_median_buffer_fill_level(
+                            start_interval_index, end_interval_index);
+
+  std::vector<ComputeNodeLoadStatistics> statistics(
+      std::max(processing_duration.size(), rdma_latency.size()));
+  for (uint32_t i = 0; i < statistics.size(); ++i) {
+    if (i < processing_duration.size()) {
+      statistics[i].ts_processing_duration = processing_duration[i];
+      statistics[i].ts_completion_duration = completion_duration[i];
+      statistics[i].buffer_fill_level =
+          static_cast<uint32_t>(buffer_fill_level[i]);
+    }
+    if (i < rdma_latency.size()) {
+      statistics[i].rdma_latency = rdma_latency[i];
+      statistics[i].message_latency = message_latency[i];
+    }
+  }
+  return statistics;
+}
+
+std::vector<uint64_t> DDLoadBalancerManager::retrieve_median_buffer_fill_level(
+    uint64_t start_interval_index, uint64_t end_interval_index) {
+  uint32_t compute_node_count = 0;
+
+  // Collect the fill level averaged over the input connections of each CN
+  for (uint64_t interval = start_interval_index; interval <= end_interval_index;
+       interval++) {
+    ComputeCompletedIntervalMetaData* meta_data =
+        compute_interval_data_manager_->get_actual_interval_meta_data(interval);
+    compute_node_count =
+        std::max(compute_node_count, meta_data->compute_node_count);
+    for (uint32_t cn_indx = 0; cn_indx < meta_data->compute_node_count;
+         ++cn_indx) {
+      if (meta_data->compute_statistics[cn_indx] == nullptr)
+        continue;
+      const uint32_t* fill_level =
+          meta_data->compute_statistics[cn_indx]->median_buffer_level;
+      uint64_t sum_fill_level = 0;
+      for (uint32_t in_indx = 0; in_indx < input_connection_count_; ++in_indx)
+        sum_fill_level += fill_level[in_indx];
+      duration_histogram(cn_indx).record(sum_fill_level /
+                                         input_connection_count_);
+    }
+  }
+  return calculate_median_normalization(compute_node_count);
+}
+
 void DDLoadBalancerManager::generate_log_files() {
   if (!enable_logging_)
     return;
 
-  generate_matrix_stats_logs(MatrixType::RDMA_LATENCY);
-  generate_matrix_stats_logs(MatrixType::MSG_LATENCY);
-  generate_matrix_stats_logs(MatrixType::TS_COMP);
-  generate_matrix_stats_logs(MatrixType::TS_PROC);
+  for (uint32_t i = 0; i < policies_.size(); ++i)
+    generate_matrix_stats_logs(i);
 
   std::ofstream log_file;
   log_file.open(log_directory_ + "/" + std::to_string(scheduler_index_) +
@@ -471,25 +323,11 @@ void DDLoadBalancerManager::generate_log_files() {
   log_file.close();
 }
 
-void DDLoadBalancerManager::generate_matrix_stats_logs(MatrixType type) {
-
-  std::string type_str = "";
-  switch (type) {
-  case RDMA_LATENCY:
-    type_str = "RDMA_LATENCY";
-    break;
-  case MSG_LATENCY:
-    type_str = "MSG_LATENCY";
-    break;
-  case TS_COMP:
-    type_str = "TS_COMP";
-    break;
-  case TS_PROC:
-    type_str = "TS_PROC";
-    break;
-  }
+void DDLoadBalancerManager::generate_matrix_stats_logs(uint32_t policy_index) {
+  if (load_balancing_logs_.empty())
+    return;
+  std::string type_str = policies_[policy_index]->name();
   uint64_t max_interval_index = load_balancing_logs_.get_last_key().first;
-  MatrixLog* log;
 
   std::ofstream log_file;
   log_file.open(log_directory_ + "/" + std::to_string(scheduler_index_) +
@@ -505,14 +343,17 @@ void DDLoadBalancerManager::generate_matrix_stats_logs(MatrixType type) {
   for (uint64_t i = 0; i <= max_interval_index; i++) {
 
     if (!load_balancing_logs_.contains(
-            std::pair<uint64_t, MatrixType>(i, type)))
+            std::pair<uint64_t, uint32_t>(i, policy_index)))
       continue;
-    log = load_balancing_logs_.get(std::pair<uint64_t, MatrixType>(i, type));
-    log_file << std::setw(25) << i << std::setw(25) << log->stats.min_indx
-             << std::setw(25) << log->stats.min_val << std::setw(25)
-             << log->stats.max_indx << std::setw(25) << log->stats.max_val
-             << std::setw(25) << log->stats.median_val << std::setw(25)
-             << log->variance << std::setw(25) << log->load_to_distribute
+    const MatrixLog& log =
+        load_balancing_logs_
+            .get_iterator(std::pair<uint64_t, uint32_t>(i, policy_index))
+            ->second;
+    log_file << std::setw(25) << i << std::setw(25) << log.stats.min_indx
+             << std::setw(25) << log.stats.min_val << std::setw(25)
+             << log.stats.max_indx << std::setw(25) << log.stats.max_val
+             << std::setw(25) << log.stats.median_val << std::setw(25)
+             << log.variance << std::setw(25) << log.load_to_distribute
              << "\n";
   }
 
@@ -4,20 +4,24 @@
 
 #include "ConstVariables.hpp"
 #include "SizedMap.hpp"
+#include "LoadBalancingPolicy.hpp"
 #include "dfs/StatisticsCalculator.hpp"
 #include "dfs/model/interval_manager/ComputeIntervalDataManager.hpp"
 #include "dfs/model/load_balancer/ComputeIntervalMetaDataStatistics.hpp"
+#include "dfs/model/load_balancer/ComputeNodeLoadStatistics.hpp"
 #include "log.hpp"
 
 #include <cassert>
 #include <chrono>
 #include <cmath>
+#include <memory>
 #include <vector>
 
 namespace tl_libfabric {
 /**
  * Singleton load balancer manager that determine the slow nodes and
- * redistribute load accordingly
+ * redistribute load accordingly. The load distribution is the average of the
+ * distributions of the configured LoadBalancingPolicy instances.
  */
 class DDLoadBalancerManager {
 public:
@@ -27,6 +31,8 @@ public:
                                              uint32_t compute_connection_count,
                                              uint32_t max_history_size,
                                              uint32_t variance_percentage,
+                                             std::string policies,
+                                             std::vector<double> weights,
                                              std::string log_directory,
                                              bool enable_logging);
 
@@ -53,6 +59,11 @@ public:
                                 uint64_t speedup_start_interval_index,
                                 uint64_t speedup_end_interval_index);
 
+  // Add the compute nodes that joined the running system from an interval on.
+  // They get a load according to their configured weights relative to the
+  // running compute nodes.
+  void update_compute_count(uint64_t interval_index, uint32_t compute_count);
+
   // Generate log files of the stored data
   void generate_log_files();
 
@@ -62,65 +73,18 @@ private:
                         uint32_t compute_connection_count,
                         uint32_t max_history_size,
                         uint32_t variance_percentage,
+                        std::string policies,
+                        std::vector<double> weights,
                         std::string log_directory,
                         bool enable_logging);
 
   // TODO REMOVE LOGS
-  typedef enum { RDMA_LATENCY, MSG_LATENCY, TS_COMP, TS_PROC } MatrixType;
   struct MatrixLog {
     StatisticsCalculator::ListStatistics stats;
-    // std::vector<uint64_t> median_values;
     double variance;
     double load_to_distribute = 0;
   };
 
-  ////////////////////// Business Logic //////////////////////
-  // Get load distribution based on TS processing duration of compute node
-  // during a speedup phase
-  std::pair<bool, std::vector<double>>
-  get_load_by_ts_processing_duration(uint64_t interval_index,
-                                     uint64_t speedup_start_interval_index,
-                                     uint64_t speedup_end_interval_index,
-                                     bool calculate = true);
-
-  // Get load distribution based on TS completion duration of compute node
-  // during a speedup phase
-  std::pair<bool, std::vector<double>>
-  get_load_by_ts_completion_duration(uint64_t interval_index,
-                                     uint64_t speedup_start_interval_index,
-                                     uint64_t speedup_end_interval_index,
-                                     bool calculate = true);
-
-  // Get load distribution based on the buffer fill level
-  /*std::vector<double>
-  get_load_by_buffer_fill_level(uint64_t speedup_start_interval_index,
-                                uint64_t speedup_end_interval_index);*/
-
-  // Get the load distribution based on the RDMA writes latency observed at
-  // Input nodes for each compute node
-  std::pair<bool, std::vector<double>>
-  get_load_by_rdma_latency(uint64_t interval_index,
-                           uint64_t speedup_start_interval_index,
-                           uint64_t speedup_end_interval_index,
-                           bool calculate = true);
-
-  // Get the load distribution based on the message latency observed at
-  // Input nodes for each compute node
-  std::pair<bool, std::vector<double>>
-  get_load_by_msg_latency(uint64_t interval_index,
-                          uint64_t speedup_start_interval_index,
-                          uint64_t speedup_end_interval_index,
-                          bool calculate = true);
-
-  ////////////////////// Common Business Logic //////////////////////
-  /**
-   * Return <new_load, load>; when new_load is false, then last load is returned
-   */
-  std::pair<bool, std::vector<double>>
-  get_load_by_lowering_duration(std::vector<uint64_t> median_duration,
-                                MatrixLog* log,
-                                bool calculate = true);
-
   ////////////////////// Helper Methods /////////////////////////
 
   // Calculate the median TS processing/completion duration of compute nodes
@@ -137,9 +101,25 @@ private:
                                 uint64_t end_interval_index,
                                 bool rdma_write);
 
-  // Takes 2D array and calculates the median of each array
-  std::vector<uint64_t> calculate_median_normalization(
-      std::vector<std::vector<uint64_t>> duration_history);
+  // Calculate the median statistics of each compute node from
+  // start_interval_index to end_interval_index intervals inclusive
+  std::vector<ComputeNodeLoadStatistics>
+  retrieve_load_statistics(uint64_t start_interval_index,
+                           uint64_t end_interval_index);
+
+  // Calculate the median buffer fill level of compute nodes from
+  // start_interval_index to end_interval_index intervals inclusive
+  std::vector<uint64_t>
+  retrieve_median_buffer_fill_level(uint64_t start_interval_index,
+                                    uint64_t end_interval_index);
+
+  // Duration histogram of a compute node, allocated on first use
+  StatisticsCalculator::Histogram& duration_histogram(uint32_t compute_index);
+
+  // Calculates the median of the first compute_node_count duration histograms
+  // and resets them
+  std::vector<uint64_t>
+  calculate_median_normalization(uint32_t compute_node_count);
 
   // Calculate aggregated average load distribution out of a set of
   // distributions
@@ -148,7 +128,7 @@ private:
 
   // LOGS
 
-  void generate_matrix_stats_logs(MatrixType type);
+  void generate_matrix_stats_logs(uint32_t policy_index);
   ////////////////////// TO BE UPDATED //////////////////////
   /*
     //
@@ -182,7 +162,7 @@ private:
 
   //
   uint32_t input_connection_count_;
-  //
+  // The count of compute nodes in the load distribution
   uint32_t compute_connection_count_;
 
   //
@@ -191,14 +171,30 @@ private:
   //
   uint32_t variance_percentage_;
 
+  // The configured capacity weights of all compute nodes, including the
+  // standby ones (empty: all equal)
+  std::vector<double> weights_;
+
+  // The first interval after the last join of compute nodes. The statistics
+  // of earlier intervals lack the joined nodes.
+  uint64_t last_join_interval_ = 0;
+
   // The log directory
   std::string log_directory_;
 
   //
   bool enable_logging_;
 
+  // The policies whose load distributions are averaged
+  std::vector<std::unique_ptr<LoadBalancingPolicy>> policies_;
+
   ComputeIntervalDataManager* compute_interval_data_manager_;
 
+  // Per compute node distributions of the durations/latencies collected over
+  // a speedup phase, reused across load calculations
+  std::vector<std::unique_ptr<StatisticsCalculator::Histogram>>
+      duration_histograms_;
+
   // Log of load distribution <start_interval_index, distribution>
   SizedMap<uint64_t, std::vector<double>> interval_load_distribution_;
 
@@ -207,6 +203,7 @@ private:
 
   // TODO REMOVE LOGS
 
-  SizedMap<std::pair<uint64_t, MatrixType>, MatrixLog*> load_balancing_logs_;
+  // Decisions of the policies <<interval_index, policy_index>, log>
+  SizedMap<std::pair<uint64_t, uint32_t>, MatrixLog> load_balancing_logs_;
 };
 } // namespace tl_libfabric
@@ -0,0 +1,132 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "LoadBalancingPolicy.hpp"
+#include "BufferFillLevelPolicy.hpp"
+#include "LoweringDurationPolicy.hpp"
+#include "PIDLoadBalancingPolicy.hpp"
+#include "ProportionalThroughputPolicy.hpp"
+#include "log.hpp"
+
+#include <sstream>
+#include <stdexcept>
+
+namespace tl_libfabric {
+
+const std::vector<std::string> LoadBalancingPolicy::POLICY_NAMES = {
+    "rdma-latency",
+    "msg-latency",
+    "processing-duration",
+    "completion-duration",
+    "proportional-throughput",
+    "pid",
+    "buffer-fill-level"};
+
+const std::string LoadBalancingPolicy::DEFAULT_POLICIES =
+    "rdma-latency,processing-duration,completion-duration";
+
+std::vector<std::unique_ptr<LoadBalancingPolicy>>
+LoadBalancingPolicy::create(const std::string& names,
+                            uint32_t variance_percentage) {
+  using Metric = LoweringDurationPolicy::Metric;
+  std::vector<std::unique_ptr<LoadBalancingPolicy>> policies;
+  std::istringstream stream(names);
+  std::string name;
+  while (std::getline(stream, name, ',')) {
+    if (name.empty())
+      continue;
+    if (name == "rdma-latency")
+      policies.push_back(std::make_unique<LoweringDurationPolicy>(
+          Metric::RDMA_LATENCY, variance_percentage));
+    else if (name == "msg-latency")
+      policies.push_back(std::make_unique<LoweringDurationPolicy>(
+          Metric::MSG_LATENCY, variance_percentage));
+    else if (name == "processing-duration")
+      policies.push_back(std::make_unique<LoweringDurationPolicy>(
+          Metric::TS_PROCESSING_DURATION, variance_percentage));
+    else if (name == "completion-duration")
+      policies.push_back(std::make_unique<LoweringDurationPolicy>(
+          Metric::TS_COMPLETION_DURATION, variance_percentage));
+    else if (name == "proportional-throughput")
+      policies.push_back(
+          std::make_unique<ProportionalThroughputPolicy>(variance_percentage));
+    else if (name == "pid")
+      policies.push_back(
+          std::make_unique<PIDLoadBalancingPolicy>(variance_percentage));
+    else if (name == "buffer-fill-level")
+      policies.push_back(
+          std::make_unique<BufferFillLevelPolicy>(variance_percentage));
+    else
+      throw std::invalid_argument("unknown load balancing policy: " + name);
+  }
+  if (policies.empty())
+    throw std::invalid_argument("no load balancing policy given");
+  return policies;
+}
+
+std::vector<double>
+LoadBalancingPolicy::initial_load(const std::vector<double>& weights,
+                                  uint32_t compute_count) {
+  if (weights.empty())
+    return std::vector<double>(compute_count, 1);
+  if (weights.size() != compute_count) {
+    L_(warning) << "[initial_load] " << weights.size()
+                << " compute node weights given for " << compute_count
+                << " compute nodes, using equal loads";
+    return std::vector<double>(compute_count, 1);
+  }
+  std::vector<double> load(weights);
+  normalize(load);
+  return load;
+}
+
+std::vector<double>
+LoadBalancingPolicy::initial_load(const std::vector<double>& weights,
+                                  uint32_t compute_count,
+                                  uint32_t active_count) {
+  std::vector<double> load = initial_load(weights, compute_count);
+  if (active_count == 0 || active_count >= compute_count)
+    return load;
+  std::fill(load.begin() + active_count, load.end(), 0.0);
+  normalize(load);
+  return load;
+}
+
+std::vector<double>
+LoadBalancingPolicy::join_load(const std::vector<double>& last_load,
+                               const std::vector<double>& weights,
+                               uint32_t compute_count) {
+  if (last_load.empty())
+    return std::vector<double>(compute_count, 1);
+  std::vector<double> load(last_load);
+  if (compute_count <= load.size())
+    return load;
+
+  double mean_load = 0;
+  for (double l : last_load)
+    mean_load += l;
+  mean_load /= last_load.size();
+  double mean_weight = 0;
+  if (weights.size() >= compute_count) {
+    for (uint32_t i = 0; i < last_load.size(); ++i)
+      mean_weight += weights[i];
+    mean_weight /= last_load.size();
+  }
+
+  for (uint32_t i = last_load.size(); i < compute_count; ++i)
+    load.push_back(mean_weight > 0 ? mean_load * weights[i] / mean_weight
+                                   : mean_load);
+  normalize(load);
+  return load;
+}
+
+void LoadBalancingPolicy::normalize(std::vector<double>& load) {
+  double sum = 0;
+  for (double l : load)
+    sum += l;
+  if (sum <= 0)
+    return;
+  double factor = load.size() / sum;
+  for (double& l : load)
+    l *= factor;
+}
+} // namespace tl_libfabric
@@ -0,0 +1,79 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#pragma once
+
+#include "dfs/StatisticsCalculator.hpp"
+#include "dfs/model/load_balancer/ComputeNodeLoadStatistics.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tl_libfabric {
+/// Outcome of a load balancing policy
+struct LoadBalancingDecision {
+  // whether the load should be redistributed
+  bool redistribute = false;
+  // the new load (the last load if not redistributed or not calculated)
+  std::vector<double> load;
+  // statistics of the metric the decision is based on
+  StatisticsCalculator::ListStatistics stats{};
+  double variance = 0;
+  double load_to_distribute = 0;
+};
+
+/**
+ * Strategy deciding how the timeslices are distributed among compute nodes
+ * based on the statistics observed during a speedup phase.
+ *
+ * Loads are relative shares; the sum of all loads is the number of compute
+ * nodes (a load of 1 is the fair share).
+ */
+class LoadBalancingPolicy {
+public:
+  virtual ~LoadBalancingPolicy() = default;
+
+  // Name of the policy as used in the configuration
+  virtual std::string name() const = 0;
+
+  // Decide whether the load should be redistributed and, if calculate is set,
+  // calculate the new load. Policies must not change their state when
+  // calculate is not set.
+  virtual LoadBalancingDecision
+  decide(const std::vector<ComputeNodeLoadStatistics>& statistics,
+         const std::vector<double>& last_load,
+         bool calculate) = 0;
+
+  // Create the policies of a comma-separated list of names (see
+  // POLICY_NAMES); throws std::invalid_argument on unknown names
+  static std::vector<std::unique_ptr<LoadBalancingPolicy>>
+  create(const std::string& names, uint32_t variance_percentage);
+
+  // The names of all available policies
+  static const std::vector<std::string> POLICY_NAMES;
+
+  // The policies used if none are configured
+  static const std::string DEFAULT_POLICIES;
+
+  // The load before any observation: the configured capacity weights of the
+  // compute nodes, or equal loads if no (or not compute_count) weights given
+  static std::vector<double> initial_load(const std::vector<double>& weights,
+                                          uint32_t compute_count);
+
+  // The initial load if only the first active_count compute nodes start the
+  // run. The remaining (standby) compute nodes get no load until they join.
+  static std::vector<double> initial_load(const std::vector<double>& weights,
+                                          uint32_t compute_count,
+                                          uint32_t active_count);
+
+  // Extend a load by the compute nodes that joined the running system. A
+  // joined node gets the mean load of the running nodes, scaled by its weight
+  // relative to their mean weight if weights are given for all nodes.
+  static std::vector<double> join_load(const std::vector<double>& last_load,
+                                       const std::vector<double>& weights,
+                                       uint32_t compute_count);
+
+  // Scale the loads such that their sum is the number of compute nodes
+  static void normalize(std::vector<double>& load);
+};
+} // namespace tl_libfabric
@@ -0,0 +1,120 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "LoweringDurationPolicy.hpp"
+#include "ConstVariables.hpp"
+#include "log.hpp"
+
+namespace tl_libfabric {
+
+LoweringDurationPolicy::LoweringDurationPolicy(Metric metric,
+                                               uint32_t variance_percentage)
+    : metric_(metric), variance_percentage_(variance_percentage) {}
+
+std::string LoweringDurationPolicy::name() const {
+  switch (metric_) {
+  case Metric::TS_PROCESSING_DURATION:
+    return "processing-duration";
+  case Metric::TS_COMPLETION_DURATION:
+    return "completion-duration";
+  case Metric::RDMA_LATENCY:
+    return "rdma-latency";
+  case Metric::MSG_LATENCY:
+    return "msg-latency";
+  }
+  return "";
+}
+
+uint64_t LoweringDurationPolicy::metric_value(
+    const ComputeNodeLoadStatistics& statistics) const {
+  switch (metric_) {
+  case Metric::TS_PROCESSING_DURATION:
+    return statistics.ts_processing_duration;
+  case Metric::TS_COMPLETION_DURATION:
+    return statistics.ts_completion_duration;
+  case Metric::RDMA_LATENCY:
+    return statistics.rdma_latency;
+  case Metric::MSG_LATENCY:
+    return statistics.message_latency;
+  }
+  return 0;
+}
+
+/**
+ *
+ * Prerequisite: Sum of all loads = # of compute nodes
+ * ------------- Algo ----------------
+ * (1) Get the median duration/latency[i] of each CN during the speedup phase
+ * (2) Calculate Statistics (min, median, max, sum) of step#(1)
+ * (3) if (max-median)/max <= variance_percentage RETURN
+ * (4) Calculate the overload to distribute on other nodes
+ * (5) calculate the new load of slowest node
+ * (6) distribute the overload equally on all compute nodes to maintain the same
+ *     variance
+ * TODO For better performance, use weighed load distribution
+ *      (closer to median, more share to get)
+ *
+ */
+LoadBalancingDecision LoweringDurationPolicy::decide(
+    const std::vector<ComputeNodeLoadStatistics>& statistics,
+    const std::vector<double>& last_load,
+    bool calculate) {
+  LoadBalancingDecision decision;
+  decision.load = last_load;
+  if (statistics.empty())
+    return decision;
+
+  std::vector<uint64_t> median_duration(statistics.size());
+  for (uint32_t i = 0; i < statistics.size(); ++i)
+    median_duration[i] = metric_value(statistics[i]);
+
+  StatisticsCalculator::ListStatistics duration_stats =
+      StatisticsCalculator::calculate_list_statistics(median_duration);
+  decision.stats = duration_stats;
+  if (duration_stats.max_val == 0)
+    return decision;
+
+  double current_variance =
+      ((duration_stats.max_val - duration_stats.median_val) * 1.0) /
+      (duration_stats.max_val * 1.0);
+  decision.variance = current_variance;
+
+  std::vector<double>& load = decision.load;
+  L_(info) << "[" << name() << "] min duration: " << duration_stats.min_val
+           << " min index: " << duration_stats.min_indx
+           << " max duration: " << duration_stats.max_val
+           << " max index: " << duration_stats.max_indx
+           << " median: " << duration_stats.median_val << " diff_pecentage "
+           << current_variance * 100.0
+           << "% max_variance_percentage_: " << variance_percentage_ << "%"
+           << ", # of conns: " << median_duration.size()
+           << ", prev load conns: " << load.size();
+  if (current_variance * 100.0 <= variance_percentage_ ||
+      duration_stats.max_indx >= load.size())
+    return decision;
+
+  decision.redistribute = true;
+  if (calculate) {
+    double load_to_distribute =
+        load[duration_stats.max_indx] * current_variance;
+    decision.load_to_distribute = load_to_distribute;
+    load[duration_stats.max_indx] *= (1.0 - current_variance);
+    double sum_new_load = 0.0;
+    for (uint32_t i = 0; i < load.size(); i++) {
+      // load.size() === sum of all loads
+      load[i] += load[i] * load_to_distribute /
+                 ((load.size() * 1.0) - load_to_distribute);
+      sum_new_load += load[i];
+    }
+    L_(info) << "[" << name()
+             << "] load_to_distribute: " << load_to_distribute
+             << ", sum_new_load: " << sum_new_load
+             << ", # of conns: " << load.size() << ", new load "
+             << ConstVariables::vector_to_string(load);
+    // Add the small fraction to the fastest node to keep the load constant (sum
+    // of all loads === # of compute nodes)
+    if (duration_stats.min_indx < load.size())
+      load[duration_stats.min_indx] += (load.size() * 1.0) - sum_new_load;
+  }
+  return decision;
+}
+} // namespace tl_libfabric
@@ -0,0 +1,38 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#pragma once
+
+#include "LoadBalancingPolicy.hpp"
+
+namespace tl_libfabric {
+/**
+ * Policy shifting load away from the compute node with the highest median
+ * duration/latency of a metric, as long as it deviates from the median of all
+ * compute nodes by more than the allowed variance.
+ */
+class LoweringDurationPolicy : public LoadBalancingPolicy {
+public:
+  enum class Metric {
+    TS_PROCESSING_DURATION,
+    TS_COMPLETION_DURATION,
+    RDMA_LATENCY,
+    MSG_LATENCY
+  };
+
+  LoweringDurationPolicy(Metric metric, uint32_t variance_percentage);
+
+  std::string name() const override;
+
+  LoadBalancingDecision
+  decide(const std::vector<ComputeNodeLoadStatistics>& statistics,
+         const std::vector<double>& last_load,
+         bool calculate) override;
+
+private:
+  uint64_t metric_value(const ComputeNodeLoadStatistics& statistics) const;
+
+  Metric metric_;
+
+  uint32_t variance_percentage_;
+};
+} // namespace tl_libfabric
@@ -0,0 +1,73 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "PIDLoadBalancingPolicy.hpp"
+#include "ConstVariables.hpp"
+#include "log.hpp"
+
+#include <cmath>
+
+namespace tl_libfabric {
+
+PIDLoadBalancingPolicy::PIDLoadBalancingPolicy(uint32_t variance_percentage,
+                                               double proportional_gain,
+                                               double integral_gain,
+                                               double derivative_gain)
+    : variance_percentage_(variance_percentage),
+      proportional_gain_(proportional_gain), integral_gain_(integral_gain),
+      derivative_gain_(derivative_gain) {}
+
+LoadBalancingDecision PIDLoadBalancingPolicy::decide(
+    const std::vector<ComputeNodeLoadStatistics>& statistics,
+    const std::vector<double>& last_load,
+    bool calculate) {
+  LoadBalancingDecision decision;
+  decision.load = last_load;
+  if (statistics.size() != last_load.size() || statistics.empty())
+    return decision;
+
+  double mean = 0;
+  for (const ComputeNodeLoadStatistics& stats : statistics)
+    mean += stats.ts_completion_duration;
+  mean /= statistics.size();
+  if (mean == 0)
+    return decision;
+
+  std::vector<double> error(statistics.size());
+  double max_error = 0;
+  for (uint32_t i = 0; i < statistics.size(); ++i) {
+    // relative deviation, bounded to (-1, 1)
+    error[i] = (statistics[i].ts_completion_duration - mean) /
+               (statistics[i].ts_completion_duration + mean);
+    max_error = std::max(max_error, std::fabs(error[i]));
+  }
+  decision.variance = max_error;
+  L_(info) << "[" << name() << "] max error " << max_error * 100.0
+           << "% max_variance_percentage_: " << variance_percentage_ << "%";
+  if (max_error * 100.0 <= variance_percentage_)
+    return decision;
+
+  decision.redistribute = true;
+  if (!calculate)
+    return decision;
+
+  if (integral_error_.size() != error.size()) {
+    integral_error_.assign(error.size(), 0);
+    last_error_.assign(error.size(), 0);
+  }
+  std::vector<double>& load = decision.load;
+  for (uint32_t i = 0; i < load.size(); ++i) {
+    integral_error_[i] += error[i];
+    double correction = proportional_gain_ * error[i] +
+                        integral_gain_ * integral_error_[i] +
+                        derivative_gain_ * (error[i] - last_error_[i]);
+    last_error_[i] = error[i];
+    correction =
+        std::min(MAX_CORRECTION, std::max(-MAX_CORRECTION, correction));
+    load[i] = std::max(MIN_LOAD, load[i] * (1.0 - correction));
+  }
+  normalize(load);
+  L_(info) << "[" << name() << "] new load "
+           << ConstVariables::vector_to_string(load);
+  return decision;
+}
+} // namespace tl_libfabric
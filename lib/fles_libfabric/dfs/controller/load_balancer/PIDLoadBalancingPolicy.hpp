@@ -0,0 +1,45 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#pragma once
+
+#include "LoadBalancingPolicy.hpp"
+
+namespace tl_libfabric {
+/**
+ * Policy treating the relative deviation of each compute node's median
+ * timeslice completion duration from the mean as control error of a PID
+ * controller, which scales the node's load down (slower than average) or up
+ * (faster than average) over consecutive speedup phases.
+ */
+class PIDLoadBalancingPolicy : public LoadBalancingPolicy {
+public:
+  PIDLoadBalancingPolicy(uint32_t variance_percentage,
+                         double proportional_gain = 0.5,
+                         double integral_gain = 0.1,
+                         double derivative_gain = 0.1);
+
+  std::string name() const override { return "pid"; }
+
+  LoadBalancingDecision
+  decide(const std::vector<ComputeNodeLoadStatistics>& statistics,
+         const std::vector<double>& last_load,
+         bool calculate) override;
+
+private:
+  // The lowest load a compute node is reduced to
+  static constexpr double MIN_LOAD = 0.05;
+
+  // The highest relative change of a load in a single decision
+  static constexpr double MAX_CORRECTION = 0.5;
+
+  uint32_t variance_percentage_;
+
+  double proportional_gain_;
+  double integral_gain_;
+  double derivative_gain_;
+
+  // Accumulated and last error of each compute node
+  std::vector<double> integral_error_;
+  std::vector<double> last_error_;
+};
+} // namespace tl_libfabric
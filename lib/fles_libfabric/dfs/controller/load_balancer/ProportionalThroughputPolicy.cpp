@@ -0,0 +1,51 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "ProportionalThroughputPolicy.hpp"
+#include "ConstVariables.hpp"
+#include "log.hpp"
+
+#include <cmath>
+
+namespace tl_libfabric {
+
+ProportionalThroughputPolicy::ProportionalThroughputPolicy(
+    uint32_t variance_percentage)
+    : variance_percentage_(variance_percentage) {}
+
+LoadBalancingDecision ProportionalThroughputPolicy::decide(
+    const std::vector<ComputeNodeLoadStatistics>& statistics,
+    const std::vector<double>& last_load,
+    bool calculate) {
+  LoadBalancingDecision decision;
+  decision.load = last_load;
+  if (statistics.size() != last_load.size() || statistics.empty())
+    return decision;
+
+  std::vector<double> load(statistics.size());
+  for (uint32_t i = 0; i < statistics.size(); ++i) {
+    // nodes without observations keep their share
+    if (statistics[i].ts_processing_duration == 0)
+      return decision;
+    load[i] = 1.0 / statistics[i].ts_processing_duration;
+  }
+  normalize(load);
+
+  double max_change = 0;
+  for (uint32_t i = 0; i < load.size(); ++i) {
+    if (last_load[i] > 0)
+      max_change = std::max(max_change,
+                            std::fabs(load[i] - last_load[i]) / last_load[i]);
+  }
+  decision.variance = max_change;
+  L_(info) << "[" << name() << "] max change " << max_change * 100.0
+           << "% max_variance_percentage_: " << variance_percentage_
+           << "%, load " << ConstVariables::vector_to_string(load);
+  if (max_change * 100.0 <= variance_percentage_)
+    return decision;
+
+  decision.redistribute = true;
+  if (calculate)
+    decision.load = load;
+  return decision;
+}
+} // namespace tl_libfabric
@@ -0,0 +1,28 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#pragma once
+
+#include "LoadBalancingPolicy.hpp"
+
+namespace tl_libfabric {
+/**
+ * Policy distributing the load proportionally to the observed throughput of
+ * each compute node, i.e. inversely proportional to its median timeslice
+ * processing duration. The load is redistributed when any share changes by
+ * more than the allowed variance.
+ */
+class ProportionalThroughputPolicy : public LoadBalancingPolicy {
+public:
+  ProportionalThroughputPolicy(uint32_t variance_percentage);
+
+  std::string name() const override { return "proportional-throughput"; }
+
+  LoadBalancingDecision
+  decide(const std::vector<ComputeNodeLoadStatistics>& statistics,
+         const std::vector<double>& last_load,
+         bool calculate) override;
+
+private:
+  uint32_t variance_percentage_;
+};
+} // namespace tl_libfabric
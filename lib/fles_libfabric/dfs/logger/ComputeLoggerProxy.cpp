@@ -30,6 +30,8 @@ void ComputeLoggerProxy::log_buffer_level(
   for (uint32_t i = 0; i < individual_levels.size(); i++) {
     timeslice_filling_logger_->process_calculated_duration(
         interval_index, i, individual_levels[i]);
+    TraceRecorder::record(BUFFER_LEVEL, i, interval_index,
+                          individual_levels[i]);
   }
 }
 
@@ -60,6 +62,9 @@ void ComputeLoggerProxy::log_start_timeslice_operation(
   assert(operation != FILLING);
   get_timeslice_operation_object(operation)->log_event_start(destination_index,
                                                              timeslice);
+  TraceRecorder::record(operation == COMPLETING ? TS_COMPLETING_START
+                                                : TS_PROCESSING_START,
+                        destination_index, timeslice);
 }
 
 void ComputeLoggerProxy::log_timeslice_operation_completion(
@@ -70,6 +75,9 @@ void ComputeLoggerProxy::log_timeslice_operation_completion(
   assert(operation != FILLING);
   get_timeslice_operation_object(operation)->log_event_completion(
       interval_index, destination_index, timeslice);
+  TraceRecorder::record(operation == COMPLETING ? TS_COMPLETING_END
+                                                : TS_PROCESSING_END,
+                        destination_index, timeslice, interval_index);
 }
 
 std::vector<uint64_t>
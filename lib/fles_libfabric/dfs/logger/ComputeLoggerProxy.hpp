@@ -2,8 +2,8 @@
 
 #pragma once
 
-#include "IntervalBufferLogger.hpp"
 #include "IntervalEventDurationMedianLogger.hpp"
+#include "TraceRecorder.hpp"
 #include "log.hpp"
 
 namespace tl_libfabric {
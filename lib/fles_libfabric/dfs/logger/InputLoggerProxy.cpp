@@ -47,6 +47,9 @@ void InputLoggerProxy::log_timeslice_blockage(enum LOG_TYPE blockage_type,
   IntervalEventDurationSumLogger* logger = get_blockage_object(blockage_type);
   assert(logger != nullptr);
   logger->log_event_start(destination_index, timeslice);
+  TraceRecorder::record(blockage_type == LOCAL_BLOCKAGE ? LOCAL_BLOCKAGE_START
+                                                        : REMOTE_BLOCKAGE_START,
+                        destination_index, timeslice);
 }
 
 void InputLoggerProxy::log_timeslice_completion(enum LOG_TYPE blockage_type,
@@ -56,6 +59,9 @@ void InputLoggerProxy::log_timeslice_completion(enum LOG_TYPE blockage_type,
   IntervalEventDurationSumLogger* logger = get_blockage_object(blockage_type);
   assert(logger != nullptr);
   logger->log_event_completion(interval_index, destination_index, timeslice);
+  TraceRecorder::record(blockage_type == LOCAL_BLOCKAGE ? LOCAL_BLOCKAGE_END
+                                                        : REMOTE_BLOCKAGE_END,
+                        destination_index, timeslice, interval_index);
 }
 
 std::vector<uint64_t>
@@ -79,6 +85,7 @@ void InputLoggerProxy::log_message_transmission(/*uint64_t interval_index,*/
                                                 uint32_t destination_index,
                                                 uint64_t message_id) {
   timeslice_message_latency_->log_event_start(destination_index, message_id);
+  TraceRecorder::record(MESSAGE_SENT, destination_index, message_id);
 }
 
 void InputLoggerProxy::log_message_ACK_arrival(uint64_t interval_index,
@@ -86,6 +93,8 @@ void InputLoggerProxy::log_message_ACK_arrival(uint64_t interval_index,
                                                uint64_t message_id) {
   timeslice_message_latency_->log_event_completion(
       interval_index, destination_index, message_id);
+  TraceRecorder::record(MESSAGE_ACKED, destination_index, message_id,
+                        interval_index);
 }
 
 std::vector<uint64_t>
@@ -109,6 +118,7 @@ void InputLoggerProxy::log_rdma_transmission(/*uint64_t interval_index,*/
                                              uint32_t destination_index,
                                              uint64_t message_id) {
   timeslice_write_latency_->log_event_start(destination_index, message_id);
+  TraceRecorder::record(RDMA_WRITE_SENT, destination_index, message_id);
 }
 
 void InputLoggerProxy::log_rdma_ACK_arrival(uint64_t interval_index,
@@ -116,6 +126,8 @@ void InputLoggerProxy::log_rdma_ACK_arrival(uint64_t interval_index,
                                             uint64_t message_id) {
   timeslice_write_latency_->log_event_completion(interval_index,
                                                  destination_index, message_id);
+  TraceRecorder::record(RDMA_WRITE_ACKED, destination_index, message_id,
+                        interval_index);
 }
 
 std::vector<uint64_t>
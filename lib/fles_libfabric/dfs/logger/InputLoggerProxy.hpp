@@ -2,9 +2,9 @@
 
 #pragma once
 
-#include "IntervalBufferLogger.hpp"
 #include "IntervalEventDurationMedianLogger.hpp"
 #include "IntervalEventDurationSumLogger.hpp"
+#include "TraceRecorder.hpp"
 #include "log.hpp"
 
 namespace tl_libfabric {
@@ -10,17 +10,7 @@ IntervalEventDurationLogger::IntervalEventDurationLogger(
     uint32_t destination_count)
     : destination_count_(destination_count) {}
 
-IntervalEventDurationLogger::~IntervalEventDurationLogger() {
-
-  while (!pending_events_.empty()) {
-    pending_events_.remove(pending_events_.get_last_key());
-  }
-
-  while (!calculated_interval_duration_.empty()) {
-    calculated_interval_duration_.remove(
-        calculated_interval_duration_.get_last_key());
-  }
-}
+IntervalEventDurationLogger::~IntervalEventDurationLogger() = default;
 
 void IntervalEventDurationLogger::log_event_start(/*uint64_t interval_index,*/
                                                   uint32_t destination_index,
@@ -70,9 +60,7 @@ IntervalEventDurationLogger::retrieve_calculated_events_duration(
   if (!calculated_interval_duration_.contains(interval_index))
     return std::vector<uint64_t>();
 
-  std::vector<uint64_t>* calculated_durations =
-      calculated_interval_duration_.get(interval_index);
-  return *calculated_durations;
+  return calculated_interval_duration_.get(interval_index);
 }
 
 uint64_t IntervalEventDurationLogger::get_calculated_events_duration(
@@ -82,12 +70,12 @@ uint64_t IntervalEventDurationLogger::get_calculated_events_duration(
   if (!calculated_interval_duration_.contains(interval_index))
     return ConstVariables::ZERO;
 
-  std::vector<uint64_t>* calculated_durations =
-      calculated_interval_duration_.get(interval_index);
-  if (calculated_durations->size() <= destination_index)
+  const std::vector<uint64_t>& calculated_durations =
+      calculated_interval_duration_.get_iterator(interval_index)->second;
+  if (calculated_durations.size() <= destination_index)
     return ConstVariables::ZERO;
 
-  return (*calculated_durations)[destination_index];
+  return calculated_durations[destination_index];
 }
 
 uint64_t IntervalEventDurationLogger::get_next_event_id() {
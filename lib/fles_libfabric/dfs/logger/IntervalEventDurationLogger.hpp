@@ -75,8 +75,9 @@ protected:
 
   uint32_t destination_count_;
 
-  // <interval, <buffer_index, calculated value>>
-  SizedMap<uint64_t, std::vector<uint64_t>*> calculated_interval_duration_;
+  // <interval, <buffer_index, calculated value>>, only the most recent
+  // intervals are kept; the full event history goes to the TraceRecorder
+  SizedMap<uint64_t, std::vector<uint64_t>> calculated_interval_duration_;
 
   uint64_t last_recieved_event_id_ = 0;
 };
@@ -34,7 +34,7 @@ private:
   void trigger_interval_completion(uint64_t interval_index) override;
 
   // <interval, <buffer_index, durations>>
-  SizedMap<uint64_t, SizedMap<uint64_t, std::vector<uint64_t>*>*>
+  SizedMap<uint64_t, std::vector<std::vector<uint64_t>>>
       pending_interval_duration_;
 };
 } // namespace tl_libfabric
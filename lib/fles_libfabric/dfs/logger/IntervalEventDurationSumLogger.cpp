@@ -10,14 +10,16 @@ IntervalEventDurationSumLogger::IntervalEventDurationSumLogger(
 
 void IntervalEventDurationSumLogger::process_calculated_duration(
     uint64_t interval_index, uint32_t destination_index, uint64_t duration) {
-  std::vector<uint64_t>* sum;
-  if (calculated_interval_duration_.contains(interval_index)) {
-    sum = calculated_interval_duration_.get(interval_index);
-  } else {
-    sum = new std::vector<uint64_t>(destination_count_, 0);
-    calculated_interval_duration_.add(interval_index, sum);
+  if (!calculated_interval_duration_.contains(interval_index)) {
+    calculated_interval_duration_.add(
+        interval_index, std::vector<uint64_t>(destination_count_, 0));
   }
-  (*sum)[destination_index] += duration;
+  std::vector<uint64_t>& sum =
+      calculated_interval_duration_.get_iterator(interval_index)->second;
+  // destinations that joined at runtime
+  if (sum.size() <= destination_index)
+    sum.resize(destination_index + 1, 0);
+  sum[destination_index] += duration;
 }
 
 void IntervalEventDurationSumLogger::trigger_interval_completion(
@@ -0,0 +1,72 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#pragma once
+
+#include <cstdint>
+
+namespace tl_libfabric {
+/**
+ * Binary layout of the DFS trace files. A file starts with a TraceFileHeader
+ * followed by fixed-size TraceRecords in flush order (records of different
+ * threads may interleave out of time order).
+ */
+enum TraceEvent : uint16_t {
+  LOCAL_BLOCKAGE_START,
+  LOCAL_BLOCKAGE_END,
+  REMOTE_BLOCKAGE_START,
+  REMOTE_BLOCKAGE_END,
+  MESSAGE_SENT,
+  MESSAGE_ACKED,
+  RDMA_WRITE_SENT,
+  RDMA_WRITE_ACKED,
+  TS_COMPLETING_START,
+  TS_COMPLETING_END,
+  TS_PROCESSING_START,
+  TS_PROCESSING_END,
+  BUFFER_LEVEL,
+  // value: duration since the first contribution arrived (us)
+  TS_COMPLETED,
+  // value: duration since the first contribution arrived (ms)
+  TS_TIMED_OUT,
+  TRACE_EVENT_COUNT
+};
+
+inline const char* trace_event_name(uint16_t event) {
+  static const char* names[TRACE_EVENT_COUNT] = {
+      "local_blockage_start", "local_blockage_end",  "remote_blockage_start",
+      "remote_blockage_end",  "message_sent",        "message_acked",
+      "rdma_write_sent",      "rdma_write_acked",    "ts_completing_start",
+      "ts_completing_end",    "ts_processing_start", "ts_processing_end",
+      "buffer_level",         "ts_completed",        "ts_timed_out"};
+  return event < TRACE_EVENT_COUNT ? names[event] : "unknown";
+}
+
+struct TraceFileHeader {
+  // "DFSTRACE" in little endian byte order
+  static constexpr uint64_t MAGIC = UINT64_C(0x4543415254534644);
+  static constexpr uint32_t VERSION = 1;
+
+  uint64_t magic = MAGIC;
+  uint32_t version = VERSION;
+  uint32_t record_size = 0;
+  // 0: input node, 1: compute node
+  uint32_t node_role = 0;
+  uint32_t node_index = 0;
+  // wall clock time (ns since epoch) of the steady clock time 0 of the records
+  int64_t clock_offset_ns = 0;
+};
+
+struct TraceRecord {
+  // steady clock time in ns
+  uint64_t time_ns;
+  // timeslice, message or interval index depending on the event
+  uint64_t id;
+  // interval index or measured value depending on the event
+  uint64_t value;
+  uint32_t destination;
+  uint16_t event;
+  uint16_t thread;
+};
+
+static_assert(sizeof(TraceRecord) == 32, "unexpected TraceRecord padding");
+} // namespace tl_libfabric
@@ -0,0 +1,173 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "TraceRecorder.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace tl_libfabric {
+
+namespace {
+// interval between two flushes of the thread rings
+constexpr std::chrono::milliseconds flush_interval(100);
+
+// ring of the calling thread and the recorder it belongs to
+thread_local void* thread_ring_owner = nullptr;
+thread_local void* thread_ring = nullptr;
+} // namespace
+
+TraceRecorder::TraceRecorder(std::FILE* file, uint32_t ring_size)
+    : file_(file), ring_size_(ring_size) {
+  flusher_ = std::thread(&TraceRecorder::flush_loop, this);
+}
+
+TraceRecorder::~TraceRecorder() {
+  if (file_ != nullptr)
+    shutdown();
+}
+
+void TraceRecorder::shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(flusher_mutex_);
+    stopping_ = true;
+  }
+  flusher_cv_.notify_one();
+  if (flusher_.joinable())
+    flusher_.join();
+  flush_rings();
+
+  uint64_t dropped = 0;
+  {
+    // late threads may still register a ring
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    for (auto& ring : rings_)
+      dropped += ring->dropped.load(std::memory_order_relaxed);
+  }
+  std::fclose(file_);
+  file_ = nullptr;
+  L_(info) << "DFS trace: " << written_records_ << " records written, "
+           << dropped << " dropped";
+}
+
+void TraceRecorder::start(const std::string& file_path,
+                          uint32_t node_role,
+                          uint32_t node_index,
+                          uint32_t ring_size) {
+  std::lock_guard<std::mutex> lock(start_mutex_);
+  if (instance_.load() != nullptr)
+    return;
+  assert(ring_size > 0 && (ring_size & (ring_size - 1)) == 0);
+
+  std::FILE* file = std::fopen(file_path.c_str(), "wb");
+  if (file == nullptr) {
+    L_(error) << "could not open DFS trace file " << file_path;
+    return;
+  }
+
+  TraceFileHeader header;
+  header.record_size = sizeof(TraceRecord);
+  header.node_role = node_role;
+  header.node_index = node_index;
+  header.clock_offset_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count() -
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count();
+  std::fwrite(&header, sizeof(header), 1, file);
+
+  instance_.store(new TraceRecorder(file, ring_size),
+                  std::memory_order_release);
+  L_(info) << "DFS trace is written to " << file_path;
+}
+
+void TraceRecorder::stop() {
+  std::lock_guard<std::mutex> lock(start_mutex_);
+  TraceRecorder* recorder = instance_.exchange(nullptr);
+  if (recorder == nullptr)
+    return;
+  recorder->shutdown();
+  // threads may still be inside append(), so the rings stay allocated
+  retired_.push_back(std::unique_ptr<TraceRecorder>(recorder));
+}
+
+void TraceRecorder::append(uint16_t event,
+                           uint32_t destination,
+                           uint64_t id,
+                           uint64_t value) {
+  ThreadRing* ring = static_cast<ThreadRing*>(thread_ring);
+  if (thread_ring_owner != this) {
+    ring = register_thread();
+    thread_ring_owner = this;
+    thread_ring = ring;
+  }
+
+  uint64_t head = ring->head.load(std::memory_order_relaxed);
+  if (head - ring->tail.load(std::memory_order_acquire) > ring->mask) {
+    ring->dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  TraceRecord& rec = ring->records[head & ring->mask];
+  rec.time_ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+  rec.id = id;
+  rec.value = value;
+  rec.destination = destination;
+  rec.event = event;
+  rec.thread = ring->thread;
+  ring->head.store(head + 1, std::memory_order_release);
+}
+
+TraceRecorder::ThreadRing* TraceRecorder::register_thread() {
+  std::lock_guard<std::mutex> lock(rings_mutex_);
+  rings_.push_back(std::unique_ptr<ThreadRing>(
+      new ThreadRing(ring_size_, static_cast<uint16_t>(rings_.size()))));
+  return rings_.back().get();
+}
+
+void TraceRecorder::flush_loop() {
+  std::unique_lock<std::mutex> lock(flusher_mutex_);
+  while (!stopping_) {
+    flusher_cv_.wait_for(lock, flush_interval);
+    lock.unlock();
+    if (flush_rings() > 0)
+      std::fflush(file_);
+    lock.lock();
+  }
+}
+
+uint64_t TraceRecorder::flush_rings() {
+  std::vector<ThreadRing*> rings;
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    for (auto& ring : rings_)
+      rings.push_back(ring.get());
+  }
+
+  uint64_t count = 0;
+  for (ThreadRing* ring : rings) {
+    uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+    while (tail != head) {
+      // write the contiguous part up to the end of the ring at once
+      uint64_t offset = tail & ring->mask;
+      uint64_t length = std::min(head - tail, ring->mask + 1 - offset);
+      std::fwrite(&ring->records[offset], sizeof(TraceRecord), length, file_);
+      tail += length;
+      count += length;
+    }
+    ring->tail.store(tail, std::memory_order_release);
+  }
+  written_records_ += count;
+  return count;
+}
+
+std::atomic<TraceRecorder*> TraceRecorder::instance_{nullptr};
+std::mutex TraceRecorder::start_mutex_;
+std::vector<std::unique_ptr<TraceRecorder>> TraceRecorder::retired_;
+} // namespace tl_libfabric
@@ -0,0 +1,107 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#pragma once
+
+#include "TraceFormat.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tl_libfabric {
+/**
+ * Always-on binary event trace of the DFS. Each thread appends fixed-size
+ * records to its own bounded ring without locking; a background thread
+ * drains the rings continuously into a trace file. Records are dropped (and
+ * counted) when a ring is full, so memory use stays constant for any run
+ * length. Use the dfs_trace tool to convert trace files to CSV.
+ */
+class TraceRecorder {
+public:
+  ~TraceRecorder();
+
+  TraceRecorder(const TraceRecorder&) = delete;
+  TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+  // Start tracing to a file; node_role is 0 for input and 1 for compute nodes
+  static void start(const std::string& file_path,
+                    uint32_t node_role,
+                    uint32_t node_index,
+                    uint32_t ring_size = DEFAULT_RING_SIZE);
+
+  // Flush the remaining records and close the trace file
+  static void stop();
+
+  // Append a record to the ring of the calling thread
+  static void record(uint16_t event,
+                     uint32_t destination,
+                     uint64_t id,
+                     uint64_t value = 0) {
+    TraceRecorder* recorder = instance_.load(std::memory_order_acquire);
+    if (recorder != nullptr)
+      recorder->append(event, destination, id, value);
+  }
+
+  static const uint32_t DEFAULT_RING_SIZE = 1 << 16;
+
+private:
+  struct ThreadRing {
+    ThreadRing(uint32_t size, uint16_t thread_id)
+        : records(size), mask(size - 1), thread(thread_id) {}
+    std::vector<TraceRecord> records;
+    const uint64_t mask;
+    const uint16_t thread;
+    // written by the owning thread
+    std::atomic<uint64_t> head{0};
+    // written by the flusher thread
+    std::atomic<uint64_t> tail{0};
+    std::atomic<uint64_t> dropped{0};
+  };
+
+  TraceRecorder(std::FILE* file, uint32_t ring_size);
+
+  void append(uint16_t event,
+              uint32_t destination,
+              uint64_t id,
+              uint64_t value);
+
+  ThreadRing* register_thread();
+
+  // Stop the flusher, write the remaining records and close the file
+  void shutdown();
+
+  // Background loop writing the ring contents to the trace file
+  void flush_loop();
+
+  // Write all pending records of all rings, returns the number written
+  uint64_t flush_rings();
+
+  static std::atomic<TraceRecorder*> instance_;
+
+  static std::mutex start_mutex_;
+
+  // stopped recorders, kept until exit
+  static std::vector<std::unique_ptr<TraceRecorder>> retired_;
+
+  std::FILE* file_;
+
+  uint32_t ring_size_;
+
+  // rings of all threads that ever recorded; never shrinks
+  std::vector<std::unique_ptr<ThreadRing>> rings_;
+  std::mutex rings_mutex_;
+
+  std::thread flusher_;
+  std::mutex flusher_mutex_;
+  std::condition_variable flusher_cv_;
+  bool stopping_ = false;
+
+  uint64_t written_records_ = 0;
+};
+} // namespace tl_libfabric
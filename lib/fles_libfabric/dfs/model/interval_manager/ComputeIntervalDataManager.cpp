@@ -2,6 +2,8 @@
 
 #include "ComputeIntervalDataManager.hpp"
 
+#include "dfs/logger/TraceRecorder.hpp"
+
 namespace tl_libfabric {
 
 ComputeIntervalDataManager*
@@ -36,6 +38,8 @@ bool ComputeIntervalDataManager::add_timeslice_completion_duration(
     uint64_t timeslice, double duration) {
   if (contain_timeslice_completion_duration(timeslice))
     return false;
+  TraceRecorder::record(TS_COMPLETED, scheduler_index_, timeslice,
+                        static_cast<uint64_t>(duration));
   return timeslice_completion_duration_.add(timeslice, duration);
 }
 
@@ -63,6 +67,8 @@ bool ComputeIntervalDataManager::add_timeslice_timed_out_duration(
     uint64_t timeslice, double duration) {
   if (contain_timeslice_timed_out_duration(timeslice))
     return false;
+  TraceRecorder::record(TS_TIMED_OUT, scheduler_index_, timeslice,
+                        static_cast<uint64_t>(duration));
   return timeslice_timed_out_.add(timeslice, duration);
 }
 
@@ -164,45 +170,5 @@ ComputeIntervalDataManager::get_actual_interval_meta_data_end_interator() {
   return actual_interval_meta_data_.get_end_iterator();
 }
 
-///
-void ComputeIntervalDataManager::generate_log_files() {
-  if (!enable_logging_)
-    return;
-  std::ofstream log_file;
-
-  /// Duration to complete each timeslice
-  log_file.open(log_directory_ + "/" + std::to_string(scheduler_index_) +
-                ".compute.arrival_diff.out");
-
-  log_file << std::setw(25) << "Timeslice" << std::setw(25) << "Diff"
-           << "\n";
-  SizedMap<uint64_t, double>::iterator it =
-      timeslice_completion_duration_.get_begin_iterator();
-  while (it != timeslice_completion_duration_.get_end_iterator()) {
-    log_file << std::setw(25) << it->first << std::setw(25) << it->second
-             << "\n";
-    ++it;
-  }
-
-  log_file.flush();
-  log_file.close();
-
-  /// Timed out timeslices
-  log_file.open(log_directory_ + "/" + std::to_string(scheduler_index_) +
-                ".compute.timeout_ts.out");
-
-  log_file << std::setw(25) << "Timeslice" << std::setw(25) << "Duration"
-           << "\n";
-  it = timeslice_timed_out_.get_begin_iterator();
-  while (it != timeslice_timed_out_.get_end_iterator()) {
-    log_file << std::setw(25) << it->first << std::setw(25) << it->second
-             << "\n";
-    ++it;
-  }
-
-  log_file.flush();
-  log_file.close();
-}
-
 ComputeIntervalDataManager* ComputeIntervalDataManager::instance_ = nullptr;
 } // namespace tl_libfabric
@@ -97,9 +97,6 @@ public:
   SizedMap<uint64_t, ComputeCompletedIntervalMetaData*>::iterator
   get_actual_interval_meta_data_end_interator();
 
-  //////// Generate log files of the stored data
-  void generate_log_files();
-
 private:
   ComputeIntervalDataManager(uint32_t scheduler_index,
                              uint64_t max_history_size,
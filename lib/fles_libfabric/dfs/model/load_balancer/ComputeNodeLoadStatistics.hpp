@@ -0,0 +1,19 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#pragma once
+
+#include <cstdint>
+
+namespace tl_libfabric {
+/// Statistics of a compute node collected over a speedup phase, as the input
+/// of the load balancing policies. Durations and latencies are medians in
+/// microseconds.
+struct ComputeNodeLoadStatistics {
+  uint64_t ts_processing_duration = 0;
+  uint64_t ts_completion_duration = 0;
+  uint64_t rdma_latency = 0;
+  uint64_t message_latency = 0;
+  // median fill level of the compute buffers in percent
+  uint32_t buffer_fill_level = 0;
+};
+} // namespace tl_libfabric
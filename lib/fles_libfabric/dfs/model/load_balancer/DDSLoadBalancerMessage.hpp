@@ -23,6 +23,10 @@ struct DDSLoadBalancerMessage {
 
   ComputeIntervalMetaDataStatistics last_completed_statistics;
 
+  // Set by compute nodes that joined at runtime, which report their
+  // statistics without proposing
+  bool statistics_only = false;
+
   // TODO
   double load_distribution[ConstVariables::MAX_CONNECTION_COUNT];
 };
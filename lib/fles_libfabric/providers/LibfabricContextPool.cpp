@@ -33,7 +33,7 @@ LibfabricContextPool::~LibfabricContextPool() {
 }
 
 struct fi_custom_context* LibfabricContextPool::getContext() {
-  pool_mutex_.lock();
+  std::lock_guard<std::mutex> lock(pool_mutex_);
   if (available_.empty()) {
     struct fi_custom_context* context = new fi_custom_context();
     context->id = context_counter_++;
@@ -43,11 +43,11 @@ struct fi_custom_context* LibfabricContextPool::getContext() {
     in_use_.push_front(available_.front());
     available_.pop_front();
   }
-  pool_mutex_.unlock();
   return (*in_use_.begin());
 }
 
 void LibfabricContextPool::releaseContext(struct fi_custom_context* context) {
+  std::lock_guard<std::mutex> lock(pool_mutex_);
   uint32_t count = 0;
   for (auto it = in_use_.begin(); it != in_use_.end(); it++) {
     if (context->id == (*it)->id) {
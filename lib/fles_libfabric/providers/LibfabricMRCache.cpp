@@ -0,0 +1,216 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "LibfabricMRCache.hpp"
+#include "LibfabricException.hpp"
+#include "Provider.hpp"
+
+#include <rdma/fi_errno.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace tl_libfabric {
+
+namespace {
+// smallest chunk size tried before giving up on a registration
+constexpr size_t min_region_size = UINT64_C(1) << 21;
+constexpr size_t page_size = UINT64_C(1) << 12;
+
+int domain_mr_mode() {
+  return Provider::getInst()->get_info()->domain_attr->mr_mode;
+}
+} // namespace
+
+size_t LibfabricMemoryRegion::chunk_index(const void* addr) const {
+  const uint8_t* p = static_cast<const uint8_t*>(addr);
+  assert(p >= base_ && p < base_ + length_);
+  return static_cast<size_t>(p - base_) / chunk_size_;
+}
+
+void* LibfabricMemoryRegion::desc(const void* addr) const {
+  return fi_mr_desc(mrs_[chunk_index(addr)]);
+}
+
+uint64_t LibfabricMemoryRegion::key(const void* addr) const {
+  return fi_mr_key(mrs_[chunk_index(addr)]);
+}
+
+uint64_t LibfabricMemoryRegion::remote_addr(const void* addr) const {
+  if (virt_addr_) {
+    return reinterpret_cast<uintptr_t>(addr);
+  }
+  // offset based addressing is relative to the start of the chunk
+  return static_cast<uint64_t>(static_cast<const uint8_t*>(addr) - base_) %
+         chunk_size_;
+}
+
+size_t LibfabricMemoryRegion::chunk_remaining(const void* addr) const {
+  size_t offset =
+      static_cast<size_t>(static_cast<const uint8_t*>(addr) - base_);
+  size_t chunk_end =
+      std::min((offset / chunk_size_ + 1) * chunk_size_, length_);
+  return chunk_end - offset;
+}
+
+std::unique_ptr<LibfabricMRCache>& LibfabricMRCache::getInst() {
+  if (LibfabricMRCache::mr_cache_ == nullptr)
+    LibfabricMRCache::mr_cache_ =
+        std::unique_ptr<LibfabricMRCache>(new LibfabricMRCache());
+
+  return LibfabricMRCache::mr_cache_;
+}
+
+LibfabricMRCache::~LibfabricMRCache() {
+  // the regions are released by their owners before the domain is closed;
+  // closing them here could outlive the fabric
+  if (!regions_.empty()) {
+    L_(debug) << "LibfabricMRCache deconstructor: " << regions_.size()
+              << " registrations still referenced";
+  }
+}
+
+bool LibfabricMRCache::endpoint_bound() {
+  int mode = domain_mr_mode();
+  return mode != FI_MR_BASIC && mode != FI_MR_SCALABLE &&
+         (mode & FI_MR_ENDPOINT) != 0;
+}
+
+void LibfabricMRCache::bind_to_endpoint(struct fid_mr* mr,
+                                        struct fid_ep* ep) {
+  if (!endpoint_bound()) {
+    return;
+  }
+  if (ep == nullptr) {
+    throw LibfabricException(
+        "memory registration requires an endpoint (FI_MR_ENDPOINT)");
+  }
+  int err = fi_mr_bind(mr, &ep->fid, 0);
+  if (err == 0) {
+    err = fi_mr_enable(mr);
+  }
+  if (err != 0) {
+    L_(fatal) << "binding memory region to endpoint failed: " << err << "="
+              << fi_strerror(-err);
+    throw LibfabricException("fi_mr_bind failed");
+  }
+}
+
+const LibfabricMemoryRegion*
+LibfabricMRCache::register_buffer(struct fid_domain* pd,
+                                  const void* addr,
+                                  size_t length,
+                                  uint64_t access,
+                                  struct fid_ep* ep) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  const uint8_t* begin = static_cast<const uint8_t*>(addr);
+  if (!endpoint_bound()) {
+    ep = nullptr;
+  } else if (ep == nullptr) {
+    throw LibfabricException(
+        "memory registration requires an endpoint (FI_MR_ENDPOINT)");
+  }
+
+  for (auto& region : regions_) {
+    if (region.pd_ == pd && region.ep_ == ep && region.access_ == access &&
+        region.base_ <= begin &&
+        begin + length <= region.base_ + region.length_) {
+      ++region.ref_count_;
+      return &region;
+    }
+  }
+
+  int mode = domain_mr_mode();
+  LibfabricMemoryRegion region;
+  region.pd_ = pd;
+  region.ep_ = ep;
+  region.base_ = begin;
+  region.length_ = length;
+  region.access_ = access;
+  region.virt_addr_ = (mode == FI_MR_BASIC || (mode & FI_MR_VIRT_ADDR) != 0);
+  region.chunk_size_ = length;
+  if (max_region_size_ != 0 && max_region_size_ < length) {
+    region.chunk_size_ = max_region_size_;
+  }
+
+  // halve the chunk size until the provider accepts all registrations
+  while (!try_register(region)) {
+    if (Provider::on_demand_paging ||
+        region.chunk_size_ <= min_region_size) {
+      L_(fatal) << "memory registration of " << length << " bytes failed";
+      throw LibfabricException("fi_mr_reg failed");
+    }
+    region.chunk_size_ =
+        std::max(min_region_size,
+                 ((region.chunk_size_ / 2 + page_size - 1) / page_size) *
+                     page_size);
+  }
+
+  if (region.mrs_.size() > 1) {
+    L_(info) << "registered " << length << " bytes in " << region.mrs_.size()
+             << " memory regions of " << region.chunk_size_ << " bytes";
+  }
+  region.ref_count_ = 1;
+  regions_.push_back(std::move(region));
+  return &regions_.back();
+}
+
+bool LibfabricMRCache::try_register(LibfabricMemoryRegion& region) {
+  int mode = domain_mr_mode();
+  bool prov_key = (mode == FI_MR_BASIC || (mode & FI_MR_PROV_KEY) != 0);
+
+  for (size_t offset = 0; offset < region.length_;
+       offset += region.chunk_size_) {
+    size_t size = std::min(region.chunk_size_, region.length_ - offset);
+    struct fid_mr* mr = nullptr;
+    int err = fi_mr_reg(region.pd_, region.base_ + offset, size,
+                        region.access_, 0,
+                        prov_key ? 0 : Provider::requested_key++, 0, &mr,
+                        nullptr);
+    if (err != 0 || mr == nullptr) {
+      L_(debug) << "fi_mr_reg of " << size << " bytes failed: " << err << "="
+                << fi_strerror(-err);
+      close(region);
+      return false;
+    }
+    region.mrs_.push_back(mr);
+
+    if (region.ep_ != nullptr) {
+      try {
+        bind_to_endpoint(mr, region.ep_);
+      } catch (...) {
+        close(region);
+        throw;
+      }
+    }
+  }
+  return true;
+}
+
+void LibfabricMRCache::release(const LibfabricMemoryRegion* region) {
+  if (region == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  for (auto it = regions_.begin(); it != regions_.end(); ++it) {
+    if (&(*it) == region) {
+      if (--it->ref_count_ == 0) {
+        close(*it);
+        regions_.erase(it);
+      }
+      return;
+    }
+  }
+}
+
+void LibfabricMRCache::close(LibfabricMemoryRegion& region) {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+  for (auto* mr : region.mrs_) {
+    fi_close((struct fid*)mr);
+  }
+#pragma GCC diagnostic pop
+  region.mrs_.clear();
+}
+
+std::unique_ptr<LibfabricMRCache> LibfabricMRCache::mr_cache_;
+} // namespace tl_libfabric
@@ -0,0 +1,105 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+/**
+ * A cache of libfabric memory registrations. Large buffers are registered in
+ * equally sized chunks if the provider refuses a single registration, and
+ * registrations are shared between connections and reused on reconnect.
+ */
+#pragma once
+
+#include <log.hpp>
+#include <rdma/fabric.h>
+#include <rdma/fi_domain.h>
+#include <rdma/fi_endpoint.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace tl_libfabric {
+
+/// A registered buffer, consisting of one or more memory regions.
+class LibfabricMemoryRegion {
+public:
+  /// Local descriptor of the chunk containing the given address.
+  void* desc(const void* addr) const;
+
+  /// Remote access key of the chunk containing the given address.
+  uint64_t key(const void* addr) const;
+
+  /// Address to be used by a remote peer to access the given address.
+  uint64_t remote_addr(const void* addr) const;
+
+  /// Number of bytes from the given address to the end of its chunk.
+  size_t chunk_remaining(const void* addr) const;
+
+  size_t chunk_count() const { return mrs_.size(); }
+
+  /// Size of each chunk except the last one.
+  size_t chunk_size() const { return chunk_size_; }
+
+private:
+  friend class LibfabricMRCache;
+
+  size_t chunk_index(const void* addr) const;
+
+  struct fid_domain* pd_ = nullptr;
+  struct fid_ep* ep_ = nullptr;
+  const uint8_t* base_ = nullptr;
+  size_t length_ = 0;
+  uint64_t access_ = 0;
+  size_t chunk_size_ = 0;
+  bool virt_addr_ = true;
+  uint32_t ref_count_ = 0;
+  std::vector<struct fid_mr*> mrs_;
+};
+
+class LibfabricMRCache {
+public:
+  ~LibfabricMRCache();
+
+  LibfabricMRCache(const LibfabricMRCache&) = delete;
+  LibfabricMRCache& operator=(const LibfabricMRCache&) = delete;
+
+  /// Register a buffer or return a cached registration covering it. The
+  /// endpoint is needed for providers requiring FI_MR_ENDPOINT.
+  const LibfabricMemoryRegion* register_buffer(struct fid_domain* pd,
+                                               const void* addr,
+                                               size_t length,
+                                               uint64_t access,
+                                               struct fid_ep* ep = nullptr);
+
+  /// Drop a reference; the memory regions are closed with the last one.
+  void release(const LibfabricMemoryRegion* region);
+
+  /// Limit the size of a single memory region (0: try the whole buffer).
+  void set_max_region_size(size_t size) { max_region_size_ = size; }
+
+  /// Check whether memory regions have to be bound to an endpoint.
+  static bool endpoint_bound();
+
+  /// Bind and enable a memory region on its endpoint if the provider
+  /// requires it (FI_MR_ENDPOINT).
+  static void bind_to_endpoint(struct fid_mr* mr, struct fid_ep* ep);
+
+  static std::unique_ptr<LibfabricMRCache>& getInst();
+
+private:
+  LibfabricMRCache() = default;
+
+  bool try_register(LibfabricMemoryRegion& region);
+
+  void close(LibfabricMemoryRegion& region);
+
+  static std::unique_ptr<LibfabricMRCache> mr_cache_;
+
+  std::list<LibfabricMemoryRegion> regions_;
+
+  size_t max_region_size_ = 0;
+
+  std::mutex cache_mutex_;
+};
+} // namespace tl_libfabric
@@ -27,6 +27,9 @@ public:
   bool has_av() const override { return false; };
   bool has_eq_at_eps() const override { return true; };
   bool is_connection_oriented() const override { return true; };
+  bool on_demand_paging_enabled() const override {
+    return verbs_on_demand_paging();
+  };
 
   struct fi_info* get_info() override {
     assert(info_ != nullptr);
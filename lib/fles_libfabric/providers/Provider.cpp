@@ -6,10 +6,16 @@
 #include "MsgVerbsProvider.hpp"
 #include "RDMGNIProvider.hpp"
 #include "RDMOmniPathProvider.hpp"
+#include "RDMShmProvider.hpp"
 #include "RDMSocketsProvider.hpp"
+#include "RxMTcpProvider.hpp"
 #include "RxMVerbsProvider.hpp"
 
+#include <netdb.h>
+#include <netinet/in.h>
+
 #include <cassert>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <memory>
@@ -22,6 +28,24 @@
 
 namespace tl_libfabric {
 
+void Provider::init(std::string local_host_name) {
+  prov = get_provider(local_host_name);
+  if (on_demand_paging && !prov->on_demand_paging_enabled()) {
+    L_(fatal) << "on-demand paging is not enabled in the libfabric provider "
+                 "(verbs: set FI_VERBS_USE_ODP=1)";
+    throw LibfabricException("on-demand paging not available");
+  }
+}
+
+bool Provider::verbs_on_demand_paging() {
+  // libfabric offers on-demand paging only as a verbs provider parameter,
+  // which is read from the environment when the provider is loaded
+  const char* use_odp = std::getenv("FI_VERBS_USE_ODP");
+  return use_odp != nullptr && std::strcmp(use_odp, "0") != 0 &&
+         std::strcmp(use_odp, "false") != 0 &&
+         std::strcmp(use_odp, "no") != 0;
+}
+
 std::unique_ptr<Provider> Provider::get_provider(std::string local_host_name) {
   // std::cout << "Provider::get_provider()" << std::endl;
   struct fi_info* fiinfo = RDMOmniPathProvider::exists(local_host_name);
@@ -54,6 +78,33 @@ std::unique_ptr<Provider> Provider::get_provider(std::string local_host_name) {
     return std::unique_ptr<Provider>(new RDMGNIProvider(fiinfo));
   }
 
+  // the tcp and shm providers are preferred over the deprecated sockets
+  // provider; peers on the local host communicate via shared memory
+  bool local_peers = is_loopback(local_host_name);
+  if (local_peers) {
+    fiinfo = RDMShmProvider::exists(local_host_name);
+    if (fiinfo != nullptr) {
+      L_(info) << "found shared memory";
+      return std::unique_ptr<Provider>(new RDMShmProvider(fiinfo));
+    }
+  }
+
+  fiinfo = RxMTcpProvider::exists(local_host_name);
+  if (fiinfo != nullptr) {
+    L_(info) << "found RxM TCP";
+    return std::unique_ptr<Provider>(new RxMTcpProvider(fiinfo));
+  }
+
+  // e.g., selected via FI_PROVIDER=shm for a host name that is not a
+  // loopback address
+  if (!local_peers) {
+    fiinfo = RDMShmProvider::exists(local_host_name);
+    if (fiinfo != nullptr) {
+      L_(info) << "found shared memory";
+      return std::unique_ptr<Provider>(new RDMShmProvider(fiinfo));
+    }
+  }
+
   fiinfo = MsgSocketsProvider::exists(local_host_name);
   if (fiinfo != nullptr) {
     L_(info) << "found Sockets";
@@ -69,6 +120,43 @@ std::unique_ptr<Provider> Provider::get_provider(std::string local_host_name) {
   throw LibfabricException("no known Libfabric provider found");
 }
 
+bool Provider::is_loopback(const std::string& host_name) {
+  struct addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  struct addrinfo* result = nullptr;
+  if (getaddrinfo(host_name.c_str(), nullptr, &hints, &result) != 0) {
+    return false;
+  }
+
+  bool loopback = true;
+  for (struct addrinfo* ai = result; ai != nullptr; ai = ai->ai_next) {
+    if (ai->ai_family == AF_INET) {
+      auto* sin = reinterpret_cast<struct sockaddr_in*>(ai->ai_addr);
+      loopback = loopback && (ntohl(sin->sin_addr.s_addr) >> 24) == 127;
+    } else if (ai->ai_family == AF_INET6) {
+      auto* sin6 = reinterpret_cast<struct sockaddr_in6*>(ai->ai_addr);
+      loopback = loopback && IN6_IS_ADDR_LOOPBACK(&sin6->sin6_addr);
+    } else {
+      loopback = false;
+    }
+  }
+  freeaddrinfo(result);
+  return loopback;
+}
+
+int Provider::get_named_info(const std::string& hostname,
+                             const std::string& service,
+                             uint64_t flags,
+                             struct fi_info** info) {
+  struct fi_info* hints =
+      get_hints(get_info()->ep_attr->type, get_info()->fabric_attr->prov_name);
+  int res = fi_getinfo(FIVERSION, hostname.c_str(), service.c_str(), flags,
+                       hints, info);
+  fi_freeinfo(hints);
+  return res;
+}
+
 struct fi_info* Provider::get_hints(enum fi_ep_type ep_type, std::string prov) {
   struct fi_info* hints = fi_allocinfo();
 
@@ -81,6 +169,12 @@ struct fi_info* Provider::get_hints(enum fi_ep_type ep_type, std::string prov) {
   hints->domain_attr->mr_mode = FI_MR_BASIC;
   hints->fabric_attr->prov_name = strdup(prov.c_str());
 
+  // tcp and shm only progress manually, which the completion queue polling
+  // of flesnet provides anyway
+  if (prov == "tcp;ofi_rxm" || prov == "shm") {
+    hints->domain_attr->data_progress = FI_PROGRESS_UNSPEC;
+  }
+
   return hints;
 }
 
@@ -89,4 +183,6 @@ uint64_t Provider::requested_key = 0;
 std::unique_ptr<Provider> Provider::prov;
 
 int Provider::vector = 0;
+
+bool Provider::on_demand_paging = false;
 } // namespace tl_libfabric
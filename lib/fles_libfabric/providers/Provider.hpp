@@ -32,6 +32,7 @@ public:
   virtual bool has_av() const { return false; };
   virtual bool has_eq_at_eps() const { return true; };
   virtual bool is_connection_oriented() const { return true; };
+  virtual bool on_demand_paging_enabled() const { return false; };
 
   virtual struct fi_info* get_info() = 0;
   virtual struct fid_fabric* get_fabric() = 0;
@@ -51,9 +52,14 @@ public:
                        size_t paramlen,
                        void* addr) = 0;
 
-  static void init(std::string local_host_name) {
-    prov = get_provider(local_host_name);
-  }
+  /// Look up the fabric address of the named endpoint a compute node
+  /// listens on, with FI_SOURCE in flags for the local endpoint.
+  virtual int get_named_info(const std::string& hostname,
+                             const std::string& service,
+                             uint64_t flags,
+                             struct fi_info** info);
+
+  static void init(std::string local_host_name);
 
   virtual void set_hostnames_and_services(
       struct fid_av* /*av*/,
@@ -71,7 +77,19 @@ public:
 
   static int vector;
 
+  /// Register buffers with on-demand paging instead of pinning them. Has to
+  /// be set before init().
+  static bool on_demand_paging;
+
+protected:
+  /// Check the verbs provider parameter FI_VERBS_USE_ODP.
+  static bool verbs_on_demand_paging();
+
 private:
+  /// Check if a host name only refers to the local host, so that all peers
+  /// reached through it are local processes.
+  static bool is_loopback(const std::string& host_name);
+
   static std::unique_ptr<Provider> get_provider(std::string local_host_name);
   static std::unique_ptr<Provider> prov;
 };
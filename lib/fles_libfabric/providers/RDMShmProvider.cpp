@@ -0,0 +1,19 @@
+// Copyright 2016 Thorsten Schuett <schuett@zib.de>, Farouk Salem <salem@zib.de>
+
+#include "RDMShmProvider.hpp"
+
+namespace tl_libfabric {
+
+int RDMShmProvider::get_named_info(const std::string& /*hostname*/,
+                                   const std::string& service,
+                                   uint64_t flags,
+                                   struct fi_info** info) {
+  // all peers are local, so the service alone identifies the endpoint of a
+  // compute node; the provider turns the name into fi_shm://flesnet_ep_<n>
+  std::string name = "flesnet_ep_" + service;
+  struct fi_info* hints = Provider::get_hints(FI_EP_RDM, "shm");
+  int res = fi_getinfo(FIVERSION, name.c_str(), nullptr, flags, hints, info);
+  fi_freeinfo(hints);
+  return res;
+}
+} // namespace tl_libfabric
@@ -0,0 +1,25 @@
+// Copyright 2016 Thorsten Schuett <schuett@zib.de>, Farouk Salem <salem@zib.de>
+#pragma once
+
+#include "RDMUtilProvider.hpp"
+
+#include <string>
+
+namespace tl_libfabric {
+
+/// The shared memory provider for peers on the local host.
+class RDMShmProvider : public RDMUtilProvider {
+public:
+  RDMShmProvider(struct fi_info* info) : RDMUtilProvider(info) {}
+
+  static struct fi_info* exists(const std::string& local_host_name) {
+    return RDMUtilProvider::exists(local_host_name, "shm");
+  }
+
+  /// Shared memory endpoints are addressed by name, not by host and port.
+  int get_named_info(const std::string& hostname,
+                     const std::string& service,
+                     uint64_t flags,
+                     struct fi_info** info) override;
+};
+} // namespace tl_libfabric
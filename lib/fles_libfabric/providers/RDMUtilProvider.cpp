@@ -0,0 +1,92 @@
+// Copyright 2016 Thorsten Schuett <schuett@zib.de>, Farouk Salem <salem@zib.de>
+
+#include "RDMUtilProvider.hpp"
+
+#include <rdma/fi_cm.h>
+#include <rdma/fi_domain.h>
+#include <rdma/fi_endpoint.h>
+#include <rdma/fi_errno.h>
+
+#include "LibfabricException.hpp"
+
+namespace tl_libfabric {
+
+RDMUtilProvider::~RDMUtilProvider() {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+  fi_freeinfo(info_);
+  fi_close((fid_t)fabric_);
+#pragma GCC diagnostic pop
+}
+
+struct fi_info* RDMUtilProvider::exists(const std::string& local_host_name,
+                                        const std::string& prov_name) {
+  struct fi_info* hints = Provider::get_hints(FI_EP_RDM, prov_name);
+  struct fi_info* info = nullptr;
+
+  int res = fi_getinfo(FIVERSION, local_host_name.c_str(), nullptr, FI_SOURCE,
+                       hints, &info);
+
+  fi_freeinfo(hints);
+  if (res == 0) {
+    return info;
+  }
+
+  fi_freeinfo(info);
+
+  return nullptr;
+}
+
+RDMUtilProvider::RDMUtilProvider(struct fi_info* info) : info_(info) {
+  int res = fi_fabric(info_->fabric_attr, &fabric_, nullptr);
+  if (res != 0) {
+    L_(fatal) << "fi_fabric failed: " << res << "=" << fi_strerror(-res);
+    throw LibfabricException("fi_fabric failed");
+  }
+}
+
+void RDMUtilProvider::accept(struct fid_pep* /*pep*/,
+                             const std::string& /*hostname*/,
+                             unsigned short /*port*/,
+                             unsigned int /*count*/,
+                             fid_eq* /*eq*/) {
+  // there is no accept for RDM
+}
+
+void RDMUtilProvider::connect(fid_ep* /*ep*/,
+                              uint32_t /*max_send_wr*/,
+                              uint32_t /*max_send_sge*/,
+                              uint32_t /*max_recv_wr*/,
+                              uint32_t /*max_recv_sge*/,
+                              uint32_t /*max_inline_data*/,
+                              const void* /*param*/,
+                              size_t /*param_len*/,
+                              void* /*addr*/) {}
+
+void RDMUtilProvider::set_hostnames_and_services(
+    struct fid_av* av,
+    const std::vector<std::string>& compute_hostnames,
+    const std::vector<std::string>& compute_services,
+    std::vector<fi_addr_t>& fi_addrs) {
+  for (size_t i = 0; i < compute_hostnames.size(); i++) {
+    fi_addr_t fi_addr;
+    struct fi_info* info = nullptr;
+
+    int res = get_named_info(compute_hostnames[i], compute_services[i], 0,
+                             &info);
+    if (res != 0 || info == nullptr || info->dest_addr == nullptr) {
+      L_(fatal) << "lookup of " << compute_hostnames[i] << ":"
+                << compute_services[i] << " failed: " << res << "="
+                << fi_strerror(-res);
+      throw LibfabricException("lookup of compute node address failed");
+    }
+    res = fi_av_insert(av, info->dest_addr, 1, &fi_addr, 0, nullptr);
+    fi_freeinfo(info);
+    if (res != 1) {
+      L_(fatal) << "fi_av_insert failed: " << res << "=" << fi_strerror(-res);
+      throw LibfabricException("fi_av_insert failed");
+    }
+    fi_addrs.push_back(fi_addr);
+  }
+}
+} // namespace tl_libfabric
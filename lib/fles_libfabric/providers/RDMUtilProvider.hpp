@@ -0,0 +1,69 @@
+// Copyright 2016 Thorsten Schuett <schuett@zib.de>, Farouk Salem <salem@zib.de>
+#pragma once
+
+#include <rdma/fabric.h>
+
+#include "Provider.hpp"
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+namespace tl_libfabric {
+
+/// Base of the connectionless providers built on the libfabric utility
+/// code (tcp;ofi_rxm and shm): reliable datagram endpoints addressed
+/// through an address vector, without connection management.
+class RDMUtilProvider : public Provider {
+  struct fi_info* info_ = nullptr;
+  struct fid_fabric* fabric_ = nullptr;
+
+public:
+  RDMUtilProvider(struct fi_info* info);
+
+  RDMUtilProvider(const RDMUtilProvider&) = delete;
+  void operator=(const RDMUtilProvider&) = delete;
+
+  /// The RDMUtilProvider default destructor.
+  ~RDMUtilProvider() override;
+
+  bool has_av() const override { return true; };
+  bool has_eq_at_eps() const override { return false; };
+  bool is_connection_oriented() const override { return false; };
+
+  struct fi_info* get_info() override {
+    assert(info_ != nullptr);
+    return info_;
+  }
+
+  void
+  set_hostnames_and_services(struct fid_av* av,
+                             const std::vector<std::string>& compute_hostnames,
+                             const std::vector<std::string>& compute_services,
+                             std::vector<fi_addr_t>& fi_addrs) override;
+
+  struct fid_fabric* get_fabric() override {
+    return fabric_;
+  };
+
+  void accept(struct fid_pep* pep,
+              const std::string& hostname,
+              unsigned short port,
+              unsigned int count,
+              fid_eq* eq) override;
+
+  void connect(fid_ep* ep,
+               uint32_t max_send_wr,
+               uint32_t max_send_sge,
+               uint32_t max_recv_wr,
+               uint32_t max_recv_sge,
+               uint32_t max_inline_data,
+               const void* param,
+               size_t paramlen,
+               void* addr) override;
+
+protected:
+  static struct fi_info* exists(const std::string& local_host_name,
+                                const std::string& prov_name);
+};
+} // namespace tl_libfabric
@@ -0,0 +1,19 @@
+// Copyright 2016 Thorsten Schuett <schuett@zib.de>, Farouk Salem <salem@zib.de>
+#pragma once
+
+#include "RDMUtilProvider.hpp"
+
+#include <string>
+
+namespace tl_libfabric {
+
+/// The tcp provider with the RxM utility layer on top.
+class RxMTcpProvider : public RDMUtilProvider {
+public:
+  RxMTcpProvider(struct fi_info* info) : RDMUtilProvider(info) {}
+
+  static struct fi_info* exists(const std::string& local_host_name) {
+    return RDMUtilProvider::exists(local_host_name, "tcp;ofi_rxm");
+  }
+};
+} // namespace tl_libfabric
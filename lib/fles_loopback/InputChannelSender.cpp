@@ -0,0 +1,244 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "InputChannelSender.hpp"
+#include "MicrosliceDescriptor.hpp"
+#include "TimesliceComponentDescriptor.hpp"
+#include "Utility.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <thread>
+
+namespace tl_loopback {
+
+namespace {
+/// Time to sleep in a run loop cycle without progress.
+constexpr std::chrono::microseconds idle_sleep{10};
+} // namespace
+
+InputChannelSender::InputChannelSender(uint64_t input_index,
+                                       InputBufferReadInterface& data_source,
+                                       LoopbackNetwork& network,
+                                       uint32_t timeslice_size,
+                                       uint32_t overlap_size,
+                                       uint32_t max_timeslice_number)
+    : input_index_(input_index), data_source_(data_source), network_(network),
+      timeslice_size_(timeslice_size), overlap_size_(overlap_size),
+      max_timeslice_number_(max_timeslice_number),
+      send_buffer_(data_source, timeslice_size),
+      desc_metrics_("input_desc",
+                    metrics_labels("loopback", "input", input_index)),
+      data_metrics_("input_data",
+                    metrics_labels("loopback", "input", input_index)),
+      latency_tracer_(LatencyTracer::Role::input, "loopback", input_index) {
+  assert(input_index < network_.num_inputs());
+}
+
+void InputChannelSender::report_status() {
+  constexpr auto interval = std::chrono::seconds(1);
+
+  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+  SendBufferStatus status_desc = send_buffer_.status_desc(now);
+  SendBufferStatus status_data = send_buffer_.status_data(now);
+
+  double delta_t =
+      std::chrono::duration<double, std::chrono::seconds::period>(
+          status_desc.time - previous_send_buffer_status_desc_.time)
+          .count();
+  double rate_desc =
+      static_cast<double>(status_desc.acked -
+                          previous_send_buffer_status_desc_.acked) /
+      delta_t;
+  double rate_data =
+      static_cast<double>(status_data.acked -
+                          previous_send_buffer_status_data_.acked) /
+      delta_t;
+
+  L_(status) << "[i" << input_index_ << "]   |"
+             << bar_graph(status_data.vector(), "#x._", 20) << "|"
+             << bar_graph(status_desc.vector(), "#x._", 10) << "| "
+             << human_readable_count(rate_data, true, "B/s") << " ("
+             << human_readable_count(rate_desc, true, "Hz") << ")";
+
+  desc_metrics_.update(status_desc.used(), status_desc.sending(),
+                       status_desc.freeing(), status_desc.size,
+                       status_desc.acked - send_buffer_.start_index().desc);
+  data_metrics_.update(status_data.used(), status_data.sending(),
+                       status_data.freeing(), status_data.size,
+                       status_data.acked - send_buffer_.start_index().data);
+
+  previous_send_buffer_status_desc_ = status_desc;
+  previous_send_buffer_status_data_ = status_data;
+
+  scheduler_.add(std::bind(&InputChannelSender::report_status, this),
+                 now + interval);
+}
+
+void InputChannelSender::sync_data_source(bool schedule) {
+  send_buffer_.sync_data_source();
+
+  if (schedule) {
+    auto now = std::chrono::system_clock::now();
+    scheduler_.add(std::bind(&InputChannelSender::sync_data_source, this, true),
+                   now + std::chrono::milliseconds(100));
+  }
+}
+
+/// The thread main function.
+void InputChannelSender::operator()() {
+  try {
+    connect();
+
+    data_source_.proceed();
+    time_begin_ = std::chrono::high_resolution_clock::now();
+
+    uint64_t timeslice = 0;
+    sync_data_source(true);
+    report_status();
+    while (timeslice < max_timeslice_number_ && !abort_) {
+      bool sent = try_send_timeslice(timeslice);
+      if (sent) {
+        timeslice++;
+        if (timeslice == 1) {
+          L_(info) << "[i" << input_index_ << "] "
+                   << "first timeslice processed";
+        }
+      }
+      data_source_.proceed();
+      scheduler_.timer();
+      for (auto& target : targets_) {
+        if (target.channel->abort_requested()) {
+          abort_ = true;
+        }
+      }
+      if (!sent) {
+        std::this_thread::sleep_for(idle_sleep);
+      }
+    }
+    sync_data_source(false);
+
+    for (auto& target : targets_) {
+      target.channel->finalize();
+    }
+
+    L_(debug) << "[i" << input_index_ << "] "
+              << "SENDER loop done";
+
+    time_end_ = std::chrono::high_resolution_clock::now();
+
+    summary();
+  } catch (std::exception& e) {
+    L_(error) << "exception in InputChannelSender: " << e.what();
+  }
+}
+
+bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
+  // wait until a complete timeslice is available in the input buffer
+  uint64_t desc_offset =
+      timeslice * timeslice_size_ + send_buffer_.start_index().desc;
+  uint64_t desc_length = timeslice_size_ + overlap_size_;
+
+  if (write_index_desc_ < desc_offset + desc_length) {
+    write_index_desc_ = data_source_.get_write_index().desc;
+  }
+  if (write_index_desc_ < desc_offset + desc_length) {
+    return false;
+  }
+  latency_tracer_.mark(timeslice, LatencyTracer::available);
+
+  auto& desc_buffer = data_source_.desc_buffer();
+  uint64_t data_offset = desc_buffer.at(desc_offset).offset;
+  uint64_t data_end = desc_buffer.at(desc_offset + desc_length - 1).offset +
+                      desc_buffer.at(desc_offset + desc_length - 1).size;
+  assert(data_end >= data_offset);
+
+  uint64_t data_length = data_end - data_offset;
+  uint64_t desc_bytes = desc_length * sizeof(fles::MicrosliceDescriptor);
+  uint64_t total_length = data_length + desc_bytes;
+
+  Target& target = targets_[timeslice % targets_.size()];
+  assert(total_length <= target.data_size);
+
+  // place the component contiguously, skipping the rest of the buffer if
+  // necessary, as the network transports do
+  uint64_t wp = target.wp.data & (target.data_size - 1);
+  uint64_t skip =
+      (wp + total_length <= target.data_size) ? 0 : target.data_size - wp;
+
+  DualIndex ack = target.channel->ack_index();
+  if (target.wp.desc - ack.desc >= target.desc_size ||
+      target.wp.data + skip + total_length - ack.data > target.data_size) {
+    return false;
+  }
+  latency_tracer_.mark(timeslice, LatencyTracer::posted);
+
+  target.wp.data += skip;
+  uint8_t* dst = target.buffer->get_data_ptr(input_index_) +
+                 (target.wp.data & (target.data_size - 1));
+  copy_range(dst, desc_buffer, desc_offset, desc_length);
+  copy_range(dst + desc_bytes, data_source_.data_buffer(), data_offset,
+             data_length);
+  bytes_copied_ += total_length;
+
+  fles::TimesliceComponentDescriptor& tscdesc =
+      target.buffer->get_desc(input_index_, target.wp.desc);
+  tscdesc.ts_num = timeslice;
+  tscdesc.offset = target.wp.data;
+  tscdesc.size = total_length;
+  tscdesc.num_microslices = desc_length;
+
+  target.wp.data += total_length;
+  ++target.wp.desc;
+  target.channel->set_write_index(target.wp);
+  latency_tracer_.mark(timeslice, LatencyTracer::written);
+
+  // the copy is complete, the input buffer range may be released
+  send_buffer_.mark_sent({desc_offset + desc_length, data_end});
+  uint64_t acked_ts = send_buffer_.acked_timeslices();
+  if (send_buffer_.acknowledge(timeslice)) {
+    latency_tracer_.mark_range(acked_ts, send_buffer_.acked_timeslices(),
+                               LatencyTracer::released);
+  }
+
+  return true;
+}
+
+template <typename T_>
+void InputChannelSender::copy_range(uint8_t* dst,
+                                    RingBufferView<T_>& src,
+                                    uint64_t offset,
+                                    uint64_t length) {
+  if (length == 0) {
+    return;
+  }
+  uint64_t size1 = std::min(length, src.size() - (offset & src.size_mask()));
+  std::memcpy(dst, &src.at(offset), sizeof(T_) * size1);
+  if (size1 < length) {
+    std::memcpy(dst + sizeof(T_) * size1, src.ptr(),
+                sizeof(T_) * (length - size1));
+  }
+}
+
+void InputChannelSender::connect() {
+  for (uint32_t i = 0; i < network_.num_outputs(); ++i) {
+    TimesliceBuffer& buffer = network_.timeslice_buffer(i);
+    targets_.push_back({&network_.channel(input_index_, i), &buffer,
+                        UINT64_C(1) << buffer.get_data_size_exp(),
+                        UINT64_C(1) << buffer.get_desc_size_exp(),
+                        DualIndex{0, 0}});
+  }
+}
+
+void InputChannelSender::summary() const {
+  double runtime = std::chrono::duration_cast<std::chrono::microseconds>(
+                       time_end_ - time_begin_)
+                       .count();
+  double rate = static_cast<double>(bytes_copied_) / runtime;
+  L_(info) << "[i" << input_index_ << "] "
+           << "summary: " << human_readable_count(bytes_copied_)
+           << " copied in " << runtime / 1000000. << " s (" << rate
+           << " MB/s)";
+}
+
+} // namespace tl_loopback
@@ -0,0 +1,110 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "ConnectionGroupWorker.hpp"
+#include "DualRingBuffer.hpp"
+#include "LatencyTracer.hpp"
+#include "LoopbackNetwork.hpp"
+#include "Metrics.hpp"
+#include "Scheduler.hpp"
+#include "SendBufferTracker.hpp"
+#include <chrono>
+#include <vector>
+
+namespace tl_loopback {
+
+/// In-process input channel sender class.
+/** An InputChannelSender object represents an input buffer (filled by a
+    FLIB or a pattern generator) and copies its timeslice components
+    directly into the timeslice buffers of the timeslice builders in the
+    same process. There is no network: a component is complete as soon as
+    it has been copied, so the input buffer is released right away. */
+
+class InputChannelSender : public ConnectionGroupWorker {
+public:
+  /// The InputChannelSender constructor.
+  InputChannelSender(uint64_t input_index,
+                     InputBufferReadInterface& data_source,
+                     LoopbackNetwork& network,
+                     uint32_t timeslice_size,
+                     uint32_t overlap_size,
+                     uint32_t max_timeslice_number);
+
+  InputChannelSender(const InputChannelSender&) = delete;
+  void operator=(const InputChannelSender&) = delete;
+
+  ~InputChannelSender() override = default;
+
+  void report_status();
+
+  void sync_data_source(bool schedule);
+
+  void operator()() override;
+
+  /// The central function for distributing timeslice data.
+  bool try_send_timeslice(uint64_t timeslice);
+
+private:
+  /// Sender side state of a channel to a timeslice builder.
+  struct Target {
+    LoopbackChannel* channel;
+    TimesliceBuffer* buffer;
+    uint64_t data_size;
+    uint64_t desc_size;
+
+    /// Write indexes in the timeslice buffer.
+    DualIndex wp;
+  };
+
+  /// Copy a range of an input ring buffer to contiguous memory.
+  template <typename T_>
+  static void copy_range(uint8_t* dst,
+                         RingBufferView<T_>& src,
+                         uint64_t offset,
+                         uint64_t length);
+
+  /// Look up the timeslice buffers of all outputs.
+  void connect();
+
+  /// Log the transfer summary.
+  void summary() const;
+
+  uint64_t input_index_;
+
+  /// Data source (e.g., FLIB).
+  InputBufferReadInterface& data_source_;
+
+  LoopbackNetwork& network_;
+
+  const uint32_t timeslice_size_;
+  const uint32_t overlap_size_;
+  const uint32_t max_timeslice_number_;
+
+  std::vector<Target> targets_;
+
+  /// Sent, acknowledged and released positions in the input buffer.
+  SendBufferTracker send_buffer_;
+
+  uint64_t write_index_desc_ = 0;
+
+  bool abort_ = false;
+
+  uint64_t bytes_copied_ = 0;
+
+  std::chrono::high_resolution_clock::time_point time_begin_;
+  std::chrono::high_resolution_clock::time_point time_end_;
+
+  Scheduler scheduler_;
+
+  SendBufferStatus previous_send_buffer_status_desc_ = SendBufferStatus();
+  SendBufferStatus previous_send_buffer_status_data_ = SendBufferStatus();
+
+  /// Exported fill levels of the input buffers.
+  BufferMetrics desc_metrics_;
+  BufferMetrics data_metrics_;
+
+  /// Sampled latencies of the timeslice sending stages.
+  LatencyTracer latency_tracer_;
+};
+
+} // namespace tl_loopback
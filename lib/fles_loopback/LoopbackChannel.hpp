@@ -0,0 +1,75 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "DualRingBuffer.hpp"
+#include <atomic>
+#include <cstdint>
+
+namespace tl_loopback {
+
+/// In-process timeslice building channel class.
+/** A LoopbackChannel object connects an input channel sender to a
+    timeslice builder in the same process. It takes the place of the
+    network connection and its status messages: the sender publishes its
+    write indexes in the builder's timeslice buffer, the builder publishes
+    the indexes up to which the timeslices have been processed. Each index
+    is written by one thread only and only ever grows, so a stale value
+    read by the other side is safe. */
+
+class alignas(64) LoopbackChannel {
+public:
+  /// Publish the write indexes after the data has been written (sender).
+  void set_write_index(DualIndex wp) {
+    wp_data_.store(wp.data, std::memory_order_relaxed);
+    wp_desc_.store(wp.desc, std::memory_order_release);
+  }
+
+  /// Retrieve the number of completely written components (builder).
+  uint64_t write_index_desc() const {
+    return wp_desc_.load(std::memory_order_acquire);
+  }
+
+  /// Retrieve the write indexes (builder).
+  DualIndex write_index() const {
+    uint64_t desc = wp_desc_.load(std::memory_order_acquire);
+    return {desc, wp_data_.load(std::memory_order_relaxed)};
+  }
+
+  /// Publish the acknowledged indexes (builder).
+  void set_ack_index(DualIndex ack) {
+    ack_data_.store(ack.data, std::memory_order_relaxed);
+    ack_desc_.store(ack.desc, std::memory_order_release);
+  }
+
+  /// Retrieve the acknowledged indexes (sender).
+  DualIndex ack_index() const {
+    uint64_t desc = ack_desc_.load(std::memory_order_acquire);
+    return {desc, ack_data_.load(std::memory_order_relaxed)};
+  }
+
+  /// Signal that no more components will be written (sender).
+  void finalize() { final_.store(true, std::memory_order_release); }
+
+  /// Check whether the sender has finished (builder).
+  bool final() const { return final_.load(std::memory_order_acquire); }
+
+  /// Ask the sender to stop (builder).
+  void request_abort() { abort_.store(true, std::memory_order_relaxed); }
+
+  /// Check whether the builder asked to stop (sender).
+  bool abort_requested() const {
+    return abort_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<uint64_t> wp_desc_{0};
+  std::atomic<uint64_t> wp_data_{0};
+  std::atomic<bool> final_{false};
+
+  // keep the builder's fields off the sender's cache line
+  alignas(64) std::atomic<uint64_t> ack_desc_{0};
+  std::atomic<uint64_t> ack_data_{0};
+  std::atomic<bool> abort_{false};
+};
+
+} // namespace tl_loopback
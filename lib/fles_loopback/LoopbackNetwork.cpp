@@ -0,0 +1,31 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "LoopbackNetwork.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace tl_loopback {
+
+LoopbackNetwork::LoopbackNetwork(uint32_t num_inputs, uint32_t num_outputs)
+    : num_inputs_(num_inputs), num_outputs_(num_outputs),
+      channels_(static_cast<size_t>(num_inputs) * num_outputs),
+      timeslice_buffers_(num_outputs, nullptr) {}
+
+void LoopbackNetwork::attach(uint32_t output,
+                             TimesliceBuffer& timeslice_buffer) {
+  if (timeslice_buffer.get_num_input_nodes() != num_inputs_) {
+    throw std::runtime_error("timeslice buffer input count mismatch");
+  }
+  timeslice_buffers_.at(output) = &timeslice_buffer;
+}
+
+TimesliceBuffer& LoopbackNetwork::timeslice_buffer(uint32_t output) {
+  TimesliceBuffer* buffer = timeslice_buffers_.at(output);
+  if (buffer == nullptr) {
+    throw std::runtime_error("no timeslice buffer attached for output " +
+                             std::to_string(output));
+  }
+  return *buffer;
+}
+
+} // namespace tl_loopback
@@ -0,0 +1,48 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "LoopbackChannel.hpp"
+#include "TimesliceBuffer.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace tl_loopback {
+
+/// In-process timeslice building network class.
+/** A LoopbackNetwork object holds the channels between all input channel
+    senders and timeslice builders of a process, and the timeslice buffers
+    the senders write to. The builders attach their timeslice buffers on
+    construction; the senders look them up when they start running. */
+
+class LoopbackNetwork {
+public:
+  /// The LoopbackNetwork constructor.
+  LoopbackNetwork(uint32_t num_inputs, uint32_t num_outputs);
+
+  LoopbackNetwork(const LoopbackNetwork&) = delete;
+  void operator=(const LoopbackNetwork&) = delete;
+
+  uint32_t num_inputs() const { return num_inputs_; }
+  uint32_t num_outputs() const { return num_outputs_; }
+
+  /// Retrieve the channel from an input to an output.
+  LoopbackChannel& channel(uint32_t input, uint32_t output) {
+    return channels_.at(static_cast<size_t>(output) * num_inputs_ + input);
+  }
+
+  /// Register the timeslice buffer of an output.
+  void attach(uint32_t output, TimesliceBuffer& timeslice_buffer);
+
+  /// Retrieve the timeslice buffer of an output.
+  TimesliceBuffer& timeslice_buffer(uint32_t output);
+
+private:
+  const uint32_t num_inputs_;
+  const uint32_t num_outputs_;
+
+  std::vector<LoopbackChannel> channels_;
+  std::vector<TimesliceBuffer*> timeslice_buffers_;
+};
+
+} // namespace tl_loopback
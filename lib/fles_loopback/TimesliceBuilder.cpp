@@ -0,0 +1,209 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "TimesliceBuilder.hpp"
+#include "Utility.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <thread>
+
+namespace tl_loopback {
+
+namespace {
+/// Time to sleep in a run loop cycle without progress.
+constexpr std::chrono::microseconds idle_sleep{10};
+} // namespace
+
+TimesliceBuilder::TimesliceBuilder(uint64_t compute_index,
+                                   TimesliceBuffer& timeslice_buffer,
+                                   LoopbackNetwork& network,
+                                   uint32_t timeslice_size,
+                                   volatile sig_atomic_t* signal_status,
+                                   bool drop)
+    : compute_index_(compute_index), timeslice_buffer_(timeslice_buffer),
+      timeslice_size_(timeslice_size), signal_status_(signal_status),
+      desc_metrics_("timeslice_desc",
+                    metrics_labels("loopback", "compute", compute_index)),
+      data_metrics_("timeslice_data",
+                    metrics_labels("loopback", "compute", compute_index)),
+      latency_tracer_(LatencyTracer::Role::compute, "loopback",
+                      compute_index),
+      timeslices_(timeslice_buffer, timeslice_size, latency_tracer_, drop) {
+  auto index = static_cast<uint32_t>(compute_index);
+  network.attach(index, timeslice_buffer_);
+  for (uint32_t i = 0; i < network.num_inputs(); ++i) {
+    channels_.push_back(&network.channel(i, index));
+  }
+}
+
+void TimesliceBuilder::report_status() {
+  constexpr auto interval = std::chrono::seconds(1);
+
+  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+
+  // the timeslice buffer as a whole: the descriptor positions are the same
+  // for all inputs, the data buffers are summed up
+  uint64_t received_desc = std::numeric_limits<uint64_t>::max();
+  uint64_t received_data = 0;
+  uint64_t acked_data = 0;
+  for (auto* channel : channels_) {
+    DualIndex wp = channel->write_index();
+    received_desc = std::min(received_desc, wp.desc);
+    received_data += wp.data;
+    acked_data += channel->ack_index().data;
+  }
+  uint64_t data_size = (UINT64_C(1) << timeslice_buffer_.get_data_size_exp()) *
+                       channels_.size();
+  uint64_t desc_size = UINT64_C(1) << timeslice_buffer_.get_desc_size_exp();
+
+  ReceiveBufferStatus status_desc{now, desc_size, timeslices_.acked(),
+                                  timeslices_.acked(), received_desc};
+  ReceiveBufferStatus status_data{now, data_size, acked_data, acked_data,
+                                  received_data};
+
+  double delta_t =
+      std::chrono::duration<double, std::chrono::seconds::period>(
+          status_desc.time - previous_recv_buffer_status_desc_.time)
+          .count();
+  double rate_desc =
+      static_cast<double>(status_desc.received -
+                          previous_recv_buffer_status_desc_.received) /
+      delta_t;
+  double rate_data =
+      static_cast<double>(status_data.received -
+                          previous_recv_buffer_status_data_.received) /
+      delta_t;
+
+  L_(debug) << "[c" << compute_index_ << "] " << timeslices_.dispatched()
+            << " completely written, " << timeslices_.acked() << " acked";
+
+  L_(status) << "[c" << compute_index_ << "]   |"
+             << bar_graph(status_data.vector(), "#._", 20) << "|"
+             << bar_graph(status_desc.vector(), "#._", 10) << "| "
+             << human_readable_count(rate_data, true, "B/s") << " ("
+             << human_readable_count(rate_desc, true, "Hz") << ")";
+
+  desc_metrics_.update(status_desc.used(), 0, status_desc.freeing(),
+                       status_desc.size, status_desc.acked);
+  data_metrics_.update(status_data.used(), 0, status_data.freeing(),
+                       status_data.size, status_data.acked);
+
+  previous_recv_buffer_status_desc_ = status_desc;
+  previous_recv_buffer_status_data_ = status_data;
+
+  scheduler_.add(std::bind(&TimesliceBuilder::report_status, this),
+                 now + interval);
+}
+
+void TimesliceBuilder::request_abort() {
+  L_(info) << "[c" << compute_index_ << "] "
+           << "request abort";
+
+  abort_ = true;
+  for (auto* channel : channels_) {
+    channel->request_abort();
+  }
+}
+
+/// The thread main function.
+void TimesliceBuilder::operator()() {
+  try {
+    time_begin_ = std::chrono::high_resolution_clock::now();
+
+    report_status();
+    while (!done()) {
+      bool dispatched = dispatch_timeslices();
+      bool completions = poll_ts_completion();
+      scheduler_.timer();
+      if (*signal_status_ != 0) {
+        *signal_status_ = 0;
+        request_abort();
+      }
+      if (!dispatched && !completions) {
+        std::this_thread::sleep_for(idle_sleep);
+      }
+    }
+
+    time_end_ = std::chrono::high_resolution_clock::now();
+
+    if (!abort_) {
+      assert(timeslice_buffer_.get_num_work_items() == 0);
+      assert(timeslice_buffer_.get_num_completions() == 0);
+    }
+    timeslice_buffer_.send_end_work_item();
+    timeslice_buffer_.send_end_completion();
+
+    summary();
+  } catch (std::exception& e) {
+    L_(error) << "exception in TimesliceBuilder: " << e.what();
+  }
+}
+
+bool TimesliceBuilder::dispatch_timeslices() {
+  uint64_t completely_written = std::numeric_limits<uint64_t>::max();
+  for (auto* channel : channels_) {
+    completely_written =
+        std::min(completely_written, channel->write_index_desc());
+  }
+  if (timeslices_.dispatched() >= completely_written) {
+    return false;
+  }
+  latency_tracer_.mark_range(timeslices_.dispatched(), completely_written,
+                             LatencyTracer::last_contribution);
+  while (timeslices_.dispatched() < completely_written) {
+    timeslices_.dispatch(
+        timeslice_buffer_.get_desc(0, timeslices_.dispatched()).ts_num);
+  }
+  return true;
+}
+
+bool TimesliceBuilder::poll_ts_completion() {
+  uint64_t acked = timeslices_.acked();
+  bool any = false;
+  while (timeslices_.poll_completion()) {
+    any = true;
+  }
+  if (timeslices_.acked() != acked) {
+    acked = timeslices_.acked();
+    for (uint32_t i = 0; i < channels_.size(); ++i) {
+      const auto& desc = timeslice_buffer_.get_desc(i, acked - 1);
+      channels_[i]->set_ack_index({acked, desc.offset + desc.size});
+    }
+  }
+  return any;
+}
+
+bool TimesliceBuilder::done() {
+  // the final flags have to be read before the write indexes
+  bool all_final =
+      std::all_of(channels_.begin(), channels_.end(),
+                  [](const LoopbackChannel* c) { return c->final(); });
+  if (!all_final) {
+    return false;
+  }
+  if (abort_) {
+    return true;
+  }
+  // components of timeslices not sent by all inputs (after an abort) are
+  // discarded
+  dispatch_timeslices();
+  return timeslices_.acked() == timeslices_.dispatched();
+}
+
+void TimesliceBuilder::summary() const {
+  double runtime = std::chrono::duration_cast<std::chrono::microseconds>(
+                       time_end_ - time_begin_)
+                       .count();
+  uint64_t bytes_received = 0;
+  for (auto* channel : channels_) {
+    bytes_received += channel->write_index().data;
+  }
+  double rate = static_cast<double>(bytes_received) / runtime;
+  L_(info) << "[c" << compute_index_ << "] "
+           << "summary: " << timeslices_.acked() << " timeslices, "
+           << human_readable_count(bytes_received) << " received in "
+           << runtime / 1000000. << " s (" << rate << " MB/s)";
+}
+
+} // namespace tl_loopback
@@ -0,0 +1,93 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "ConnectionGroupWorker.hpp"
+#include "LatencyTracer.hpp"
+#include "LoopbackNetwork.hpp"
+#include "Metrics.hpp"
+#include "ReceiveBufferStatus.hpp"
+#include "Scheduler.hpp"
+#include "TimesliceBuffer.hpp"
+#include "TimesliceBufferTracker.hpp"
+#include <chrono>
+#include <csignal>
+#include <memory>
+#include <vector>
+
+namespace tl_loopback {
+
+/// In-process timeslice builder class.
+/** A TimesliceBuilder object represents a timeslice buffer that is filled
+    directly by the input channel senders of the same process. It hands
+    complete timeslices to the timeslice processors and passes their
+    completions back to the senders. */
+
+class TimesliceBuilder : public ConnectionGroupWorker {
+public:
+  /// The TimesliceBuilder constructor.
+  TimesliceBuilder(uint64_t compute_index,
+                   TimesliceBuffer& timeslice_buffer,
+                   LoopbackNetwork& network,
+                   uint32_t timeslice_size,
+                   volatile sig_atomic_t* signal_status,
+                   bool drop);
+
+  TimesliceBuilder(const TimesliceBuilder&) = delete;
+  void operator=(const TimesliceBuilder&) = delete;
+
+  ~TimesliceBuilder() override = default;
+
+  void report_status();
+
+  void request_abort();
+
+  void operator()() override;
+
+private:
+  /// Dispatch the timeslices written by all inputs, return false if there
+  /// were none.
+  bool dispatch_timeslices();
+
+  /// Handle timeslice completions, return false if there were none.
+  bool poll_ts_completion();
+
+  /// Check whether all inputs have finished and all timeslices are done.
+  bool done();
+
+  /// Log the transfer summary.
+  void summary() const;
+
+  uint64_t compute_index_;
+  TimesliceBuffer& timeslice_buffer_;
+
+  /// Channels from all input channel senders.
+  std::vector<LoopbackChannel*> channels_;
+
+  uint32_t timeslice_size_;
+
+  volatile sig_atomic_t* signal_status_;
+
+  bool abort_ = false;
+
+  std::chrono::high_resolution_clock::time_point time_begin_;
+  std::chrono::high_resolution_clock::time_point time_end_;
+
+  Scheduler scheduler_;
+
+  ReceiveBufferStatus previous_recv_buffer_status_desc_ =
+      ReceiveBufferStatus();
+  ReceiveBufferStatus previous_recv_buffer_status_data_ =
+      ReceiveBufferStatus();
+
+  /// Exported fill levels of the timeslice buffer.
+  BufferMetrics desc_metrics_;
+  BufferMetrics data_metrics_;
+
+  /// Sampled latencies of the timeslice building stages.
+  LatencyTracer latency_tracer_;
+
+  /// Dispatched and acknowledged timeslices in the timeslice buffer.
+  TimesliceBufferTracker timeslices_;
+};
+
+} // namespace tl_loopback
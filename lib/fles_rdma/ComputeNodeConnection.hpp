@@ -5,8 +5,8 @@
 #include "IBConnection.hpp"
 #include "InputChannelStatusMessage.hpp"
 #include "InputNodeInfo.hpp"
+#include "ReceiveBufferStatus.hpp"
 #include "TimesliceComponentDescriptor.hpp"
-#include <boost/format.hpp>
 #include <chrono>
 
 /// Compute node connection class.
@@ -62,54 +62,18 @@ public:
 
   std::unique_ptr<std::vector<uint8_t>> get_private_data() override;
 
-  struct BufferStatus {
-    std::chrono::system_clock::time_point time;
-    uint64_t size;
-
-    uint64_t cached_acked;
-    uint64_t acked;
-    uint64_t received;
-
-    int64_t used() const { return received - acked; }
-    int64_t freeing() const { return acked - cached_acked; }
-    int64_t unused() const { return cached_acked + size - received; }
-
-    float percentage(int64_t value) const {
-      return static_cast<float>(value) / static_cast<float>(size);
-    }
-
-    static std::string caption() { return std::string("used/freeing/free"); }
-
-    std::string percentage_str(int64_t value) const {
-      boost::format percent_fmt("%4.1f%%");
-      percent_fmt % (percentage(value) * 100);
-      std::string s = percent_fmt.str();
-      s.resize(4);
-      return s;
-    }
-
-    std::string percentages() const {
-      return percentage_str(used()) + " " + percentage_str(freeing()) + " " +
-             percentage_str(unused());
-    }
-
-    std::vector<int64_t> vector() const {
-      return std::vector<int64_t>{used(), freeing(), unused()};
-    }
-  };
-
-  BufferStatus buffer_status_data() const {
-    return BufferStatus{std::chrono::system_clock::now(),
-                        (UINT64_C(1) << data_buffer_size_exp_),
-                        send_status_message_.ack.data, cn_ack_.data,
-                        cn_wp_.data};
+  ReceiveBufferStatus buffer_status_data() const {
+    return ReceiveBufferStatus{std::chrono::system_clock::now(),
+                               (UINT64_C(1) << data_buffer_size_exp_),
+                               send_status_message_.ack.data, cn_ack_.data,
+                               cn_wp_.data};
   }
 
-  BufferStatus buffer_status_desc() const {
-    return BufferStatus{std::chrono::system_clock::now(),
-                        (UINT64_C(1) << desc_buffer_size_exp_),
-                        send_status_message_.ack.desc, cn_ack_.desc,
-                        cn_wp_.desc};
+  ReceiveBufferStatus buffer_status_desc() const {
+    return ReceiveBufferStatus{std::chrono::system_clock::now(),
+                               (UINT64_C(1) << desc_buffer_size_exp_),
+                               send_status_message_.ack.desc, cn_ack_.desc,
+                               cn_wp_.desc};
   }
 
 private:
@@ -3,6 +3,7 @@
 
 #include "ConnectionGroupWorker.hpp"
 #include "InfinibandException.hpp"
+#include "Metrics.hpp"
 #include <chrono>
 #include <cstring>
 #include <fcntl.h>
@@ -175,6 +176,12 @@ public:
       }
     }
 
+    cq_polls_metric_.add();
+    if (ne_total > 0) {
+      cq_completions_metric_.add(static_cast<uint64_t>(ne_total));
+      cq_batch_metric_.record(static_cast<uint64_t>(ne_total));
+    }
+
     return ne_total;
   }
 
@@ -376,4 +383,14 @@ private:
 
   /// Total number of RECV work requests.
   uint64_t aggregate_recv_requests_ = 0;
+
+  /// Exported completion queue statistics
+  MetricsCounter& cq_polls_metric_ = MetricsRegistry::instance().counter(
+      "flesnet_cq_polls_total", "Completion queue polls", "transport=\"rdma\"");
+  MetricsCounter& cq_completions_metric_ = MetricsRegistry::instance().counter(
+      "flesnet_cq_completions_total", "Completions read from the queues",
+      "transport=\"rdma\"");
+  MetricsHistogram& cq_batch_metric_ = MetricsRegistry::instance().histogram(
+      "flesnet_cq_batch_size", "Completions handled per non-empty poll",
+      "transport=\"rdma\"");
 };
@@ -26,17 +26,12 @@ InputChannelSender::InputChannelSender(
       compute_hostnames_(compute_hostnames),
       compute_services_(compute_services), timeslice_size_(timeslice_size),
       overlap_size_(overlap_size), max_timeslice_number_(max_timeslice_number),
-      min_acked_desc_(data_source.desc_buffer().size() / 4),
-      min_acked_data_(data_source.data_buffer().size() / 4) {
-  start_index_desc_ = sent_desc_ = acked_desc_ = cached_acked_desc_ =
-      data_source.get_read_index().desc;
-  start_index_data_ = sent_data_ = acked_data_ = cached_acked_data_ =
-      data_source.get_read_index().data;
-
-  size_t min_ack_buffer_size =
-      data_source_.desc_buffer().size() / timeslice_size_ + 1;
-  ack_.alloc_with_size(min_ack_buffer_size);
-
+      send_buffer_(data_source, timeslice_size),
+      desc_metrics_("input_desc",
+                    metrics_labels("rdma", "input", input_index)),
+      data_metrics_("input_data",
+                    metrics_labels("rdma", "input", input_index)),
+      latency_tracer_(LatencyTracer::Role::input, "rdma", input_index) {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wold-style-cast"
   VALGRIND_MAKE_MEM_DEFINED(data_source_.data_buffer().ptr(),
@@ -72,30 +67,9 @@ InputChannelSender::~InputChannelSender() {
 void InputChannelSender::report_status() {
   constexpr auto interval = std::chrono::seconds(1);
 
-  // if data_source.written pointers are lagging behind due to lazy updates,
-  // use sent value instead
-  uint64_t written_desc = data_source_.get_write_index().desc;
-  if (written_desc < sent_desc_) {
-    written_desc = sent_desc_;
-  }
-  uint64_t written_data = data_source_.get_write_index().data;
-  if (written_data < sent_data_) {
-    written_data = sent_data_;
-  }
-
   std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
-  SendBufferStatus status_desc{now,
-                               data_source_.desc_buffer().size(),
-                               cached_acked_desc_,
-                               acked_desc_,
-                               sent_desc_,
-                               written_desc};
-  SendBufferStatus status_data{now,
-                               data_source_.data_buffer().size(),
-                               cached_acked_data_,
-                               acked_data_,
-                               sent_data_,
-                               written_data};
+  SendBufferStatus status_desc = send_buffer_.status_desc(now);
+  SendBufferStatus status_data = send_buffer_.status_data(now);
 
   double delta_t =
       std::chrono::duration<double, std::chrono::seconds::period>(
@@ -114,12 +88,12 @@ void InputChannelSender::report_status() {
   // from most current MicrosliceDescriptor
   fles::SubsystemIdentifier sys_id = static_cast<fles::SubsystemIdentifier>(0);
   std::string eq_id("Undefined");
-  if (written_desc > 0) {
+  if (status_desc.written > 0) {
     sys_id = static_cast<fles::SubsystemIdentifier>(
-        data_source_.desc_buffer().at(written_desc - 1).sys_id);
+        data_source_.desc_buffer().at(status_desc.written - 1).sys_id);
     std::stringstream eq_id_ss;
     eq_id_ss << std::hex << std::uppercase << std::setfill('0') << std::setw(4)
-             << data_source_.desc_buffer().at(written_desc - 1).eq_id;
+             << data_source_.desc_buffer().at(status_desc.written - 1).eq_id;
     eq_id = eq_id_ss.str();
   }
 
@@ -189,6 +163,13 @@ void InputChannelSender::report_status() {
     }
   }
 
+  desc_metrics_.update(status_desc.used(), status_desc.sending(),
+                       status_desc.freeing(), status_desc.size,
+                       status_desc.acked - send_buffer_.start_index().desc);
+  data_metrics_.update(status_data.used(), status_data.sending(),
+                       status_data.freeing(), status_data.size,
+                       status_data.acked - send_buffer_.start_index().data);
+
   previous_send_buffer_status_desc_ = status_desc;
   previous_send_buffer_status_data_ = status_data;
 
@@ -207,11 +188,7 @@ void InputChannelSender::sync_buffer_positions() {
 }
 
 void InputChannelSender::sync_data_source(bool schedule) {
-  if (acked_data_ > cached_acked_data_ || acked_desc_ > cached_acked_desc_) {
-    cached_acked_data_ = acked_data_;
-    cached_acked_desc_ = acked_desc_;
-    data_source_.set_read_index({cached_acked_desc_, cached_acked_data_});
-  }
+  send_buffer_.sync_data_source();
 
   if (schedule) {
     auto now = std::chrono::system_clock::now();
@@ -252,7 +229,7 @@ void InputChannelSender::operator()() {
     }
 
     // wait for pending send completions
-    while (acked_desc_ < timeslice_size_ * timeslice + start_index_desc_) {
+    while (send_buffer_.acked_timeslices() < timeslice) {
       poll_completion();
       scheduler_.timer();
     }
@@ -288,7 +265,8 @@ void InputChannelSender::operator()() {
 
 bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
   // wait until a complete timeslice is available in the input buffer
-  uint64_t desc_offset = timeslice * timeslice_size_ + start_index_desc_;
+  uint64_t desc_offset =
+      timeslice * timeslice_size_ + send_buffer_.start_index().desc;
   uint64_t desc_length = timeslice_size_ + overlap_size_;
 
   if (write_index_desc_ < desc_offset + desc_length) {
@@ -296,6 +274,7 @@ bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
   }
   // check if microslice no. (desc_offset + desc_length - 1) is avail
   if (write_index_desc_ >= desc_offset + desc_length) {
+    latency_tracer_.mark(timeslice, LatencyTracer::available);
 
     uint64_t data_offset = data_source_.desc_buffer().at(desc_offset).offset;
     uint64_t data_end =
@@ -329,11 +308,11 @@ bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
 
       post_send_data(timeslice, cn, desc_offset, desc_length, data_offset,
                      data_length, skip);
+      latency_tracer_.mark(timeslice, LatencyTracer::posted);
 
       conn_[cn]->inc_write_pointers(total_length, 1);
 
-      sent_desc_ = desc_offset + desc_length;
-      sent_data_ = data_end;
+      send_buffer_.mark_sent({desc_offset + desc_length, data_end});
 
       return true;
     }
@@ -433,7 +412,7 @@ std::string InputChannelSender::get_state_string() {
     s << " (" << i << ")" << data_source_.desc_buffer().at(i).offset;
   }
   s << std::endl;
-  s << "| acked_desc_ = " << acked_desc_ << std::endl;
+  s << "| acked_desc = " << send_buffer_.acked().desc << std::endl;
   s << "/--- data buf ---" << std::endl;
   s << "|";
   for (unsigned int i = 0; i < data_source_.data_buffer().size(); ++i) {
@@ -441,7 +420,7 @@ std::string InputChannelSender::get_state_string() {
       << std::dec;
   }
   s << std::endl;
-  s << "| acked_data_ = " << acked_data_ << std::endl;
+  s << "| acked_data = " << send_buffer_.acked().data << std::endl;
   s << "\\---------";
 
   return s.str();
@@ -519,31 +498,18 @@ void InputChannelSender::on_completion(const struct ibv_wc& wc) {
 
     int cn = (wc.wr_id >> 8) & 0xFFFF;
     conn_[cn]->on_complete_write();
+    latency_tracer_.mark(ts, LatencyTracer::written);
 
-    uint64_t acked_ts = (acked_desc_ - start_index_desc_) / timeslice_size_;
-    if (ts != acked_ts) {
-      // transmission has been reordered, store completion information
-      ack_.at(ts) = ts;
-    } else {
-      // completion is for earliest pending timeslice, update indices
-      do {
-        ++acked_ts;
-      } while (ack_.at(acked_ts) > ts);
-      acked_desc_ = acked_ts * timeslice_size_ + start_index_desc_;
-      acked_data_ = data_source_.desc_buffer().at(acked_desc_ - 1).offset +
-                    data_source_.desc_buffer().at(acked_desc_ - 1).size;
-      if (acked_data_ >= cached_acked_data_ + min_acked_data_ ||
-          acked_desc_ >= cached_acked_desc_ + min_acked_desc_) {
-        cached_acked_data_ = acked_data_;
-        cached_acked_desc_ = acked_desc_;
-        data_source_.set_read_index({cached_acked_desc_, cached_acked_data_});
-      }
+    uint64_t acked_ts = send_buffer_.acked_timeslices();
+    if (send_buffer_.acknowledge(ts)) {
+      latency_tracer_.mark_range(acked_ts, send_buffer_.acked_timeslices(),
+                                 LatencyTracer::released);
     }
     if (false) {
       L_(trace) << "[i" << input_index_ << "] "
                 << "write timeslice " << ts
-                << " complete, now: acked_data_=" << acked_data_
-                << " acked_desc_=" << acked_desc_;
+                << " complete, now: acked_data=" << send_buffer_.acked().data
+                << " acked_desc=" << send_buffer_.acked().desc;
     }
   } break;
 
@@ -4,9 +4,9 @@
 #include "DualRingBuffer.hpp"
 #include "IBConnectionGroup.hpp"
 #include "InputChannelConnection.hpp"
-#include "RingBuffer.hpp"
-#include <boost/format.hpp>
-#include <cassert>
+#include "LatencyTracer.hpp"
+#include "Metrics.hpp"
+#include "SendBufferTracker.hpp"
 #define _TURN_OFF_PLATFORM_STRING
 #include <cpprest/http_client.h>
 
@@ -83,24 +83,9 @@ private:
   /// InfiniBand memory region descriptor for input descriptor buffer.
   struct ibv_mr* mr_desc_ = nullptr;
 
-  /// Buffer to store acknowledged status of timeslices.
-  RingBuffer<uint64_t, true> ack_;
-
-  /// Number of acknowledged microslices. Written to FLIB.
-  uint64_t acked_desc_;
-
-  /// Number of acknowledged data bytes. Written to FLIB.
-  uint64_t acked_data_;
-
   /// Data source (e.g., FLIB).
   InputBufferReadInterface& data_source_;
 
-  /// Number of sent microslices, for statistics.
-  uint64_t sent_desc_;
-
-  /// Number of sent data bytes, for statistics.
-  uint64_t sent_data_;
-
   const std::vector<std::string> compute_hostnames_;
   const std::vector<std::string> compute_services_;
 
@@ -108,14 +93,8 @@ private:
   const uint32_t overlap_size_;
   const uint32_t max_timeslice_number_;
 
-  const uint64_t min_acked_desc_;
-  const uint64_t min_acked_data_;
-
-  uint64_t cached_acked_desc_;
-  uint64_t cached_acked_data_;
-
-  uint64_t start_index_desc_;
-  uint64_t start_index_data_;
+  /// Sent, acknowledged and released positions in the input buffer.
+  SendBufferTracker send_buffer_;
 
   uint64_t write_index_desc_ = 0;
 
@@ -125,58 +104,13 @@ private:
   std::unique_ptr<pplx::task<void>> monitor_task_;
   std::string hostname_;
 
-  struct SendBufferStatus {
-    std::chrono::system_clock::time_point time;
-    uint64_t size;
-
-    uint64_t cached_acked;
-    uint64_t acked;
-    uint64_t sent;
-    uint64_t written;
-
-    int64_t used() const {
-      assert(sent <= written);
-      return written - sent;
-    }
-    int64_t sending() const {
-      assert(acked <= sent);
-      return sent - acked;
-    }
-    int64_t freeing() const {
-      assert(cached_acked <= acked);
-      return acked - cached_acked;
-    }
-    int64_t unused() const {
-      assert(written <= cached_acked + size);
-      return cached_acked + size - written;
-    }
-
-    float percentage(int64_t value) const {
-      return static_cast<float>(value) / static_cast<float>(size);
-    }
-
-    static std::string caption() {
-      return std::string("used/sending/freeing/free");
-    }
-
-    std::string percentage_str(int64_t value) const {
-      boost::format percent_fmt("%4.1f%%");
-      percent_fmt % (percentage(value) * 100);
-      std::string s = percent_fmt.str();
-      s.resize(4);
-      return s;
-    }
-
-    std::string percentages() const {
-      return percentage_str(used()) + " " + percentage_str(sending()) + " " +
-             percentage_str(freeing()) + " " + percentage_str(unused());
-    }
-
-    std::vector<int64_t> vector() const {
-      return std::vector<int64_t>{used(), sending(), freeing(), unused()};
-    }
-  };
-
   SendBufferStatus previous_send_buffer_status_desc_ = SendBufferStatus();
   SendBufferStatus previous_send_buffer_status_data_ = SendBufferStatus();
+
+  /// Exported fill levels of the input buffers.
+  BufferMetrics desc_metrics_;
+  BufferMetrics data_metrics_;
+
+  /// Sampled latencies of the timeslice sending stages.
+  LatencyTracer latency_tracer_;
 };
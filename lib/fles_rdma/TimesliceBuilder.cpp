@@ -4,8 +4,6 @@
 #include "InputNodeInfo.hpp"
 #include "RequestIdentifier.hpp"
 #include "System.hpp"
-#include "TimesliceCompletion.hpp"
-#include "TimesliceWorkItem.hpp"
 #include "log.hpp"
 #include <algorithm>
 #include <limits>
@@ -21,8 +19,9 @@ TimesliceBuilder::TimesliceBuilder(uint64_t compute_index,
     : compute_index_(compute_index), timeslice_buffer_(timeslice_buffer),
       service_(service), num_input_nodes_(num_input_nodes),
       timeslice_size_(timeslice_size),
-      ack_(timeslice_buffer_.get_desc_size_exp()),
-      signal_status_(signal_status), drop_(drop) {
+      signal_status_(signal_status),
+      latency_tracer_(LatencyTracer::Role::compute, "rdma", compute_index),
+      timeslices_(timeslice_buffer, timeslice_size, latency_tracer_, drop) {
   assert(timeslice_buffer_.get_num_input_nodes() == num_input_nodes);
 
   if (!monitor_uri.empty()) {
@@ -38,6 +37,15 @@ TimesliceBuilder::TimesliceBuilder(uint64_t compute_index,
 
   previous_recv_buffer_status_data_.resize(num_input_nodes);
   previous_recv_buffer_status_desc_.resize(num_input_nodes);
+
+  for (uint32_t i = 0; i < num_input_nodes; ++i) {
+    std::string labels = metrics_labels("rdma", "compute", compute_index) +
+                         ",input=\"" + std::to_string(i) + "\"";
+    desc_metrics_.push_back(
+        std::make_unique<BufferMetrics>("timeslice_desc", labels));
+    data_metrics_.push_back(
+        std::make_unique<BufferMetrics>("timeslice_data", labels));
+  }
 }
 
 TimesliceBuilder::~TimesliceBuilder() = default;
@@ -47,8 +55,8 @@ void TimesliceBuilder::report_status() {
 
   std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
 
-  L_(debug) << "[c" << compute_index_ << "] " << completely_written_
-            << " completely written, " << acked_ << " acked";
+  L_(debug) << "[c" << compute_index_ << "] " << timeslices_.dispatched()
+            << " completely written, " << timeslices_.acked() << " acked";
 
   std::string measurement;
 
@@ -128,6 +136,13 @@ void TimesliceBuilder::report_status() {
                      "i,desc_rate=" + std::to_string(rate_desc) + "\n";
     }
 
+    desc_metrics_.at(c->index())
+        ->update(status_desc.used(), 0, status_desc.freeing(),
+                 status_desc.size, status_desc.acked);
+    data_metrics_.at(c->index())
+        ->update(status_data.used(), 0, status_data.freeing(),
+                 status_data.size, status_data.acked);
+
     previous_recv_buffer_status_data_.at(c->index()) = status_data;
     previous_recv_buffer_status_desc_.at(c->index()) = status_desc;
   }
@@ -309,7 +324,15 @@ void TimesliceBuilder::on_completion(const struct ibv_wc& wc) {
   } break;
 
   case ID_RECEIVE_STATUS: {
+    uint64_t old_desc = conn_[in]->cn_wp().desc;
     conn_[in]->on_complete_recv();
+    uint64_t new_desc = conn_[in]->cn_wp().desc;
+    if (new_desc > old_desc) {
+      latency_tracer_.mark_range(old_desc, new_desc,
+                                 LatencyTracer::first_contribution);
+      latency_tracer_.mark_latest_range(old_desc, new_desc,
+                                        LatencyTracer::last_contribution);
+    }
     if (connected_ == conn_.size() && in == red_lantern_) {
       auto new_red_lantern = std::min_element(
           std::begin(conn_), std::end(conn_),
@@ -321,24 +344,10 @@ void TimesliceBuilder::on_completion(const struct ibv_wc& wc) {
       uint64_t new_completely_written = (*new_red_lantern)->cn_wp().desc;
       red_lantern_ = std::distance(std::begin(conn_), new_red_lantern);
 
-      for (uint64_t tpos = completely_written_; tpos < new_completely_written;
-           ++tpos) {
-        if (!drop_) {
-          uint64_t ts_index = UINT64_MAX;
-          if (!conn_.empty()) {
-            ts_index = timeslice_buffer_.get_desc(0, tpos).ts_num;
-          }
-          timeslice_buffer_.send_work_item(
-              {{ts_index, tpos, timeslice_size_,
-                static_cast<uint32_t>(conn_.size())},
-               timeslice_buffer_.get_data_size_exp(),
-               timeslice_buffer_.get_desc_size_exp()});
-        } else {
-          timeslice_buffer_.send_completion({tpos});
-        }
+      while (timeslices_.dispatched() < new_completely_written) {
+        timeslices_.dispatch(
+            timeslice_buffer_.get_desc(0, timeslices_.dispatched()).ts_num);
       }
-
-      completely_written_ = new_completely_written;
     }
   } break;
 
@@ -348,18 +357,10 @@ void TimesliceBuilder::on_completion(const struct ibv_wc& wc) {
 }
 
 void TimesliceBuilder::poll_ts_completion() {
-  fles::TimesliceCompletion c;
-  if (!timeslice_buffer_.try_receive_completion(c)) {
-    return;
-  }
-  if (c.ts_pos == acked_) {
-    do {
-      ++acked_;
-    } while (ack_.at(acked_) > c.ts_pos);
+  uint64_t acked = timeslices_.acked();
+  if (timeslices_.poll_completion() && timeslices_.acked() != acked) {
     for (auto& connection : conn_) {
-      connection->inc_ack_pointers(acked_);
+      connection->inc_ack_pointers(timeslices_.acked());
     }
-  } else {
-    ack_.at(c.ts_pos) = c.ts_pos;
   }
 }
@@ -3,8 +3,11 @@
 
 #include "ComputeNodeConnection.hpp"
 #include "IBConnectionGroup.hpp"
-#include "RingBuffer.hpp"
+#include "LatencyTracer.hpp"
+#include "Metrics.hpp"
+#include "ReceiveBufferStatus.hpp"
 #include "TimesliceBuffer.hpp"
+#include "TimesliceBufferTracker.hpp"
 #define _TURN_OFF_PLATFORM_STRING
 #include <cpprest/http_client.h>
 #include <csignal>
@@ -57,19 +60,21 @@ private:
   uint32_t timeslice_size_;
 
   size_t red_lantern_ = 0;
-  uint64_t completely_written_ = 0;
-  uint64_t acked_ = 0;
-
-  /// Buffer to store acknowledged status of timeslices.
-  RingBuffer<uint64_t, true> ack_;
 
   volatile sig_atomic_t* signal_status_;
-  bool drop_;
 
-  std::vector<ComputeNodeConnection::BufferStatus>
-      previous_recv_buffer_status_desc_;
-  std::vector<ComputeNodeConnection::BufferStatus>
-      previous_recv_buffer_status_data_;
+  std::vector<ReceiveBufferStatus> previous_recv_buffer_status_desc_;
+  std::vector<ReceiveBufferStatus> previous_recv_buffer_status_data_;
+
+  /// Exported fill levels of the per-connection receive buffers.
+  std::vector<std::unique_ptr<BufferMetrics>> desc_metrics_;
+  std::vector<std::unique_ptr<BufferMetrics>> data_metrics_;
+
+  /// Sampled latencies of the timeslice building stages.
+  LatencyTracer latency_tracer_;
+
+  /// Dispatched and acknowledged timeslices in the timeslice buffer.
+  TimesliceBufferTracker timeslices_;
 
   std::unique_ptr<web::http::client::http_client> monitor_client_;
   std::unique_ptr<pplx::task<void>> monitor_task_;
@@ -0,0 +1,183 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "ComputeNodeConnection.hpp"
+#include "RequestIdentifier.hpp"
+#include "System.hpp"
+#include "UringException.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <sys/socket.h>
+
+namespace tl_uring {
+
+namespace {
+/// Maximum length of a single receive request (the entry length is 32 bit).
+constexpr uint64_t max_recv_length = UINT64_C(1) << 30;
+} // namespace
+
+ComputeNodeConnection::ComputeNodeConnection(
+    uint_fast16_t connection_index,
+    uint_fast16_t remote_connection_index,
+    int fd,
+    uint8_t* data_ptr,
+    uint32_t data_buffer_size_exp,
+    fles::TimesliceComponentDescriptor* desc_ptr,
+    uint32_t desc_buffer_size_exp)
+    : UringConnection(connection_index, remote_connection_index, fd),
+      data_ptr_(data_ptr), data_buffer_size_exp_(data_buffer_size_exp),
+      desc_ptr_(desc_ptr), desc_buffer_size_exp_(desc_buffer_size_exp) {
+  assert(data_ptr_ && desc_ptr_ && data_buffer_size_exp_ &&
+         desc_buffer_size_exp_);
+}
+
+void ComputeNodeConnection::setup(IoUring& ring) { post_recv_header(ring); }
+
+void ComputeNodeConnection::post_recv_header(IoUring& ring) {
+  io_uring_sqe* sqe = ring.get_sqe();
+  sqe->opcode = IORING_OP_RECV;
+  sqe->fd = fd_;
+  sqe->addr = reinterpret_cast<uint64_t>(
+      reinterpret_cast<uint8_t*>(&recv_header_) + header_received_);
+  sqe->len = static_cast<uint32_t>(sizeof(recv_header_) - header_received_);
+  sqe->msg_flags = MSG_WAITALL;
+  sqe->user_data = make_user_data(ID_RECEIVE_HEADER, index_);
+  ++total_recv_requests_;
+}
+
+void ComputeNodeConnection::post_recv_data(IoUring& ring) {
+  uint64_t data_mask = (UINT64_C(1) << data_buffer_size_exp_) - 1;
+  uint8_t* target =
+      data_ptr_ + (recv_header_.tscdesc.offset & data_mask) + data_received_;
+  uint64_t length =
+      std::min(recv_header_.tscdesc.size - data_received_, max_recv_length);
+
+  io_uring_sqe* sqe = ring.get_sqe();
+  sqe->opcode = IORING_OP_RECV;
+  sqe->fd = fd_;
+  sqe->addr = reinterpret_cast<uint64_t>(target);
+  sqe->len = static_cast<uint32_t>(length);
+  sqe->msg_flags = MSG_WAITALL;
+  sqe->user_data = make_user_data(ID_RECEIVE_DATA, index_);
+  ++total_recv_requests_;
+}
+
+bool ComputeNodeConnection::on_complete_recv(IoUring& ring,
+                                             const io_uring_cqe& cqe) {
+  bool is_header = request_id(cqe.user_data) == ID_RECEIVE_HEADER;
+
+  if (cqe.res < 0) {
+    if (cqe.res != -EINTR && cqe.res != -EAGAIN) {
+      L_(fatal) << "[" << index_ << "] receive failed: "
+                << fles::system::stringerror(-cqe.res);
+      throw UringException("receive of timeslice component failed");
+    }
+  } else if (cqe.res == 0) {
+    throw UringException("connection closed by input node");
+  } else if (is_header) {
+    header_received_ += static_cast<std::size_t>(cqe.res);
+  } else {
+    data_received_ += static_cast<uint64_t>(cqe.res);
+  }
+
+  if (is_header) {
+    if (header_received_ < sizeof(recv_header_)) {
+      post_recv_header(ring);
+      return false;
+    }
+    header_received_ = 0;
+    if (recv_header_.final) {
+      L_(debug) << "[c" << remote_index_ << "] "
+                << "[" << index_ << "] "
+                << "received FINAL message";
+      final_received_ = true;
+      post_send_status_message(ring);
+      return false;
+    }
+    assert((recv_header_.tscdesc.offset &
+            ((UINT64_C(1) << data_buffer_size_exp_) - 1)) +
+               recv_header_.tscdesc.size <=
+           (UINT64_C(1) << data_buffer_size_exp_));
+    data_received_ = 0;
+    post_recv_data(ring);
+    return false;
+  }
+
+  if (data_received_ < recv_header_.tscdesc.size) {
+    post_recv_data(ring);
+    return false;
+  }
+
+  // payload complete, publish the component descriptor
+  desc_ptr_[cn_wp_.desc & ((UINT64_C(1) << desc_buffer_size_exp_) - 1)] =
+      recv_header_.tscdesc;
+  cn_wp_.data = recv_header_.tscdesc.offset + recv_header_.tscdesc.size;
+  ++cn_wp_.desc;
+  post_recv_header(ring);
+  return true;
+}
+
+void ComputeNodeConnection::inc_ack_pointers(uint64_t ack_pos) {
+  cn_ack_.desc = ack_pos;
+
+  const fles::TimesliceComponentDescriptor& acked_ts =
+      desc_ptr_[(ack_pos - 1) & ((UINT64_C(1) << desc_buffer_size_exp_) - 1)];
+
+  cn_ack_.data = acked_ts.offset + acked_ts.size;
+}
+
+void ComputeNodeConnection::post_send_status_message(IoUring& ring) {
+  if (send_pending_ || done_) {
+    return;
+  }
+  if (!final_received_ && cn_ack_ == send_status_message_.ack &&
+      request_abort_ == send_status_message_.request_abort) {
+    return;
+  }
+  send_status_message_.ack = cn_ack_;
+  send_status_message_.request_abort = request_abort_;
+  send_status_message_.final = final_received_;
+  status_sent_ = 0;
+  send_pending_ = true;
+  post_send_remainder(ring);
+}
+
+void ComputeNodeConnection::post_send_remainder(IoUring& ring) {
+  io_uring_sqe* sqe = ring.get_sqe();
+  sqe->opcode = IORING_OP_SEND;
+  sqe->fd = fd_;
+  sqe->addr = reinterpret_cast<uint64_t>(
+      reinterpret_cast<uint8_t*>(&send_status_message_) + status_sent_);
+  sqe->len = static_cast<uint32_t>(sizeof(send_status_message_) -
+                                   status_sent_);
+  sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+  sqe->user_data = make_user_data(ID_SEND_STATUS, index_);
+  ++total_send_requests_;
+}
+
+void ComputeNodeConnection::on_complete_send(IoUring& ring,
+                                             const io_uring_cqe& cqe) {
+  if (cqe.res < 0 && cqe.res != -EINTR && cqe.res != -EAGAIN) {
+    L_(fatal) << "[" << index_ << "] status send failed: "
+              << fles::system::stringerror(-cqe.res);
+    throw UringException("send of status message failed");
+  }
+  if (cqe.res > 0) {
+    status_sent_ += static_cast<std::size_t>(cqe.res);
+    total_bytes_sent_ += static_cast<uint64_t>(cqe.res);
+  }
+  if (status_sent_ < sizeof(send_status_message_)) {
+    post_send_remainder(ring);
+    return;
+  }
+  send_pending_ = false;
+  if (send_status_message_.final) {
+    done_ = true;
+    return;
+  }
+  // the acknowledged position may have advanced in the meantime
+  post_send_status_message(ring);
+}
+
+} // namespace tl_uring
@@ -0,0 +1,104 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "ComputeNodeStatusMessage.hpp"
+#include "InputChannelMessage.hpp"
+#include "IoUring.hpp"
+#include "ReceiveBufferStatus.hpp"
+#include "UringConnection.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace tl_uring {
+
+/// Compute node connection class.
+/** A ComputeNodeConnection object represents the endpoint of a single
+    timeslice building connection from a compute node to an input
+    node. The payload of each timeslice component is received directly to
+    its final position in the timeslice buffer; its descriptor is stored
+    once the payload is complete. */
+
+class ComputeNodeConnection : public UringConnection {
+public:
+  ComputeNodeConnection(uint_fast16_t connection_index,
+                        uint_fast16_t remote_connection_index,
+                        int fd,
+                        uint8_t* data_ptr,
+                        uint32_t data_buffer_size_exp,
+                        fles::TimesliceComponentDescriptor* desc_ptr,
+                        uint32_t desc_buffer_size_exp);
+
+  ComputeNodeConnection(const ComputeNodeConnection&) = delete;
+  void operator=(const ComputeNodeConnection&) = delete;
+
+  /// Start receiving timeslice components.
+  void setup(IoUring& ring);
+
+  /// Handle a receive completion. Returns true if a timeslice component
+  /// has been completely received.
+  bool on_complete_recv(IoUring& ring, const io_uring_cqe& cqe);
+
+  /// Handle a status send completion.
+  void on_complete_send(IoUring& ring, const io_uring_cqe& cqe);
+
+  /// Send a status message if the acknowledged position has changed.
+  void post_send_status_message(IoUring& ring);
+
+  void request_abort() { request_abort_ = true; }
+
+  bool abort_flag() const { return recv_header_.abort; }
+
+  void inc_ack_pointers(uint64_t ack_pos);
+
+  const ComputeNodeBufferPosition& cn_wp() const { return cn_wp_; }
+
+  ReceiveBufferStatus buffer_status_data() const {
+    return ReceiveBufferStatus{std::chrono::system_clock::now(),
+                               (UINT64_C(1) << data_buffer_size_exp_),
+                               send_status_message_.ack.data, cn_ack_.data,
+                               cn_wp_.data};
+  }
+
+  ReceiveBufferStatus buffer_status_desc() const {
+    return ReceiveBufferStatus{std::chrono::system_clock::now(),
+                               (UINT64_C(1) << desc_buffer_size_exp_),
+                               send_status_message_.ack.desc, cn_ack_.desc,
+                               cn_wp_.desc};
+  }
+
+private:
+  void post_recv_header(IoUring& ring);
+
+  void post_recv_data(IoUring& ring);
+
+  /// Post a send of the unsent rest of the status message in flight.
+  void post_send_remainder(IoUring& ring);
+
+  /// Status message in flight (or last sent).
+  ComputeNodeStatusMessage send_status_message_ = ComputeNodeStatusMessage();
+  ComputeNodeBufferPosition cn_ack_ = ComputeNodeBufferPosition();
+
+  /// Header of the timeslice component being received.
+  InputChannelMessage recv_header_ = InputChannelMessage();
+  ComputeNodeBufferPosition cn_wp_ = ComputeNodeBufferPosition();
+
+  /// Bytes received of the current header and payload.
+  std::size_t header_received_ = 0;
+  uint64_t data_received_ = 0;
+
+  /// Bytes sent of the status message in flight.
+  std::size_t status_sent_ = 0;
+  bool send_pending_ = false;
+
+  bool request_abort_ = false;
+  bool final_received_ = false;
+
+  uint8_t* data_ptr_ = nullptr;
+  std::size_t data_buffer_size_exp_ = 0;
+
+  fles::TimesliceComponentDescriptor* desc_ptr_ = nullptr;
+  std::size_t desc_buffer_size_exp_ = 0;
+};
+
+} // namespace tl_uring
@@ -0,0 +1,20 @@
+// Copyright 2012-2013 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <cstdint>
+
+namespace tl_uring {
+
+#pragma pack(1)
+
+/// Structure representing the compute node information sent in reply to a
+/// connecting input node.
+struct ComputeNodeInfo {
+  uint32_t index;
+  uint32_t data_buffer_size_exp;
+  uint32_t desc_buffer_size_exp;
+};
+
+#pragma pack()
+
+} // namespace tl_uring
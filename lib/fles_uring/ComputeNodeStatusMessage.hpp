@@ -0,0 +1,20 @@
+// Copyright 2014 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "ComputeNodeBufferPosition.hpp"
+
+namespace tl_uring {
+
+#pragma pack(1)
+
+/// Structure representing a status update message sent from compute buffer to
+/// input channel.
+struct ComputeNodeStatusMessage {
+  ComputeNodeBufferPosition ack;
+  bool request_abort;
+  bool final;
+};
+
+#pragma pack()
+
+} // namespace tl_uring
@@ -0,0 +1,284 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "InputChannelConnection.hpp"
+#include "MicrosliceDescriptor.hpp"
+#include "RequestIdentifier.hpp"
+#include "System.hpp"
+#include "UringException.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+
+namespace tl_uring {
+
+namespace {
+/// Maximum length of a single send request (the entry length is 32 bit).
+constexpr uint64_t max_send_length = UINT64_C(1) << 30;
+} // namespace
+
+InputChannelConnection::InputChannelConnection(
+    uint_fast16_t connection_index,
+    uint_fast16_t remote_connection_index,
+    int fd,
+    ComputeNodeInfo remote_info,
+    unsigned int max_pending_write_requests,
+    bool zero_copy,
+    bool multishot)
+    : UringConnection(connection_index, remote_connection_index, fd),
+      remote_info_(remote_info),
+      max_pending_write_requests_(max_pending_write_requests),
+      zero_copy_(zero_copy), multishot_(multishot),
+      status_buffers_(num_status_buffers_ * status_buffer_size_) {
+  assert(max_pending_write_requests_ > 0);
+}
+
+bool InputChannelConnection::check_for_buffer_space(uint64_t data_size,
+                                                    uint64_t desc_size) const {
+  return cn_ack_.data - cn_wp_.data +
+                 (UINT64_C(1) << remote_info_.data_buffer_size_exp) >=
+             data_size &&
+         cn_ack_.desc - cn_wp_.desc +
+                 (UINT64_C(1) << remote_info_.desc_buffer_size_exp) >=
+             desc_size;
+}
+
+bool InputChannelConnection::write_request_available() const {
+  return jobs_.size() < max_pending_write_requests_;
+}
+
+void InputChannelConnection::inc_write_pointers(uint64_t data_size,
+                                                uint64_t desc_size) {
+  cn_wp_.data += data_size;
+  cn_wp_.desc += desc_size;
+}
+
+uint64_t InputChannelConnection::skip_required(uint64_t data_size) const {
+  uint64_t databuf_size = UINT64_C(1) << remote_info_.data_buffer_size_exp;
+  uint64_t databuf_wp = cn_wp_.data & (databuf_size - 1);
+  if (databuf_wp + data_size <= databuf_size) {
+    return 0;
+  }
+  return databuf_size - databuf_wp;
+}
+
+void InputChannelConnection::send_data(IoUring& ring,
+                                       const Chunk* chunks,
+                                       unsigned int num_chunks,
+                                       uint64_t timeslice,
+                                       uint64_t desc_length,
+                                       uint64_t data_length,
+                                       uint64_t skip) {
+  jobs_.emplace_back();
+  SendJob& job = jobs_.back();
+  std::memset(&job, 0, sizeof(job));
+  job.timeslice = timeslice;
+  job.header.tscdesc.ts_num = timeslice;
+  job.header.tscdesc.offset = cn_wp_.data + skip;
+  job.header.tscdesc.size =
+      data_length + desc_length * sizeof(fles::MicrosliceDescriptor);
+  job.header.tscdesc.num_microslices = desc_length;
+  job.parts[0] = {&job.header, sizeof(job.header), -1};
+  job.num_parts = 1;
+
+  for (unsigned int i = 0; i < num_chunks; ++i) {
+    const auto* ptr = static_cast<const uint8_t*>(chunks[i].ptr);
+    uint64_t remaining = chunks[i].length;
+    while (remaining > 0) {
+      if (job.num_parts == max_parts) {
+        throw UringException("timeslice component too large");
+      }
+      uint64_t length = std::min(remaining, max_send_length);
+      job.parts[job.num_parts++] = {ptr, length, chunks[i].buf_index};
+      ptr += length;
+      remaining -= length;
+    }
+  }
+
+  post_send_job(ring);
+}
+
+void InputChannelConnection::post_send_job(IoUring& ring) {
+  if (sending_ || send_seq_ == first_job_seq_ + jobs_.size()) {
+    return;
+  }
+  SendJob& job = jobs_[send_seq_ - first_job_seq_];
+
+  unsigned int first = 0;
+  while (job.sent[first] == job.parts[first].length) {
+    ++first;
+  }
+  // a chain split across two submissions would lose its ordering
+  ring.reserve_sqes(job.num_parts - first);
+  for (unsigned int p = first; p < job.num_parts; ++p) {
+    io_uring_sqe* sqe = ring.get_sqe();
+    const Chunk& chunk = job.parts[p];
+    if (zero_copy_ && p > 0) {
+      sqe->opcode = IORING_OP_SEND_ZC;
+      if (chunk.buf_index >= 0) {
+        sqe->ioprio = IORING_RECVSEND_FIXED_BUF;
+        sqe->buf_index = static_cast<uint16_t>(chunk.buf_index);
+      }
+    } else {
+      sqe->opcode = IORING_OP_SEND;
+    }
+    sqe->fd = fd_;
+    sqe->addr = reinterpret_cast<uint64_t>(
+        static_cast<const uint8_t*>(chunk.ptr) + job.sent[p]);
+    sqe->len = static_cast<uint32_t>(chunk.length - job.sent[p]);
+    sqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+    sqe->user_data = make_user_data(ID_SEND_COMPONENT, index_, p, send_seq_);
+    if (p + 1 < job.num_parts) {
+      // keep the parts of the component in stream order
+      sqe->flags = IOSQE_IO_LINK;
+    }
+    ++job.pending_sends;
+    ++total_send_requests_;
+  }
+  sending_ = true;
+}
+
+bool InputChannelConnection::on_complete_send(IoUring& ring,
+                                              const io_uring_cqe& cqe,
+                                              uint64_t& timeslice) {
+  uint64_t seq = request_seq(cqe.user_data);
+  assert(seq >= first_job_seq_ && seq < first_job_seq_ + jobs_.size());
+  SendJob& job = jobs_[seq - first_job_seq_];
+
+  if ((cqe.flags & IORING_CQE_F_NOTIF) != 0) {
+    // the kernel no longer references the buffer of a zero-copy send
+    --job.pending_notifs;
+  } else {
+    --job.pending_sends;
+    if ((cqe.flags & IORING_CQE_F_MORE) != 0) {
+      ++job.pending_notifs;
+    }
+    if (cqe.res > 0) {
+      job.sent[request_part(cqe.user_data)] += static_cast<uint64_t>(cqe.res);
+      total_bytes_sent_ += static_cast<uint64_t>(cqe.res);
+    } else if (cqe.res < 0 && cqe.res != -ECANCELED && cqe.res != -EINTR &&
+               cqe.res != -EAGAIN) {
+      L_(fatal) << "[" << index_ << "] send failed: "
+                << fles::system::stringerror(-cqe.res);
+      throw UringException("send of timeslice component failed");
+    }
+    if (job.pending_sends == 0) {
+      // a short send breaks the link chain, continue where it stopped
+      sending_ = false;
+      if (job.sent[job.num_parts - 1] == job.parts[job.num_parts - 1].length) {
+        job.sent_complete = true;
+        ++send_seq_;
+      }
+      post_send_job(ring);
+    }
+  }
+
+  bool completed = job.sent_complete && job.pending_notifs == 0;
+  bool is_component = !job.header.final;
+  timeslice = job.timeslice;
+
+  while (!jobs_.empty() && jobs_.front().sent_complete &&
+         jobs_.front().pending_notifs == 0) {
+    jobs_.pop_front();
+    ++first_job_seq_;
+  }
+
+  return completed && is_component;
+}
+
+void InputChannelConnection::setup(IoUring& ring) {
+  ring.prep_provide_buffers(status_buffers_.data(), status_buffer_size_,
+                            num_status_buffers_, index_, 0,
+                            make_user_data(ID_PROVIDE_BUFFERS, index_));
+  post_recv_status_message(ring);
+}
+
+void InputChannelConnection::post_recv_status_message(IoUring& ring) {
+  io_uring_sqe* sqe = ring.get_sqe();
+  sqe->opcode = IORING_OP_RECV;
+  sqe->fd = fd_;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = index_;
+  if (multishot_) {
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+  }
+  sqe->user_data = make_user_data(ID_RECEIVE_STATUS, index_);
+  ++total_recv_requests_;
+}
+
+void InputChannelConnection::on_complete_recv(IoUring& ring,
+                                              const io_uring_cqe& cqe) {
+  if (cqe.res > 0) {
+    assert((cqe.flags & IORING_CQE_F_BUFFER) != 0);
+    uint16_t bid = cqe.flags >> IORING_CQE_BUFFER_SHIFT;
+    uint8_t* buf = &status_buffers_[bid * status_buffer_size_];
+    const uint8_t* p = buf;
+    auto remaining = static_cast<std::size_t>(cqe.res);
+    while (remaining > 0) {
+      std::size_t n =
+          std::min(remaining, sizeof(partial_status_message_) -
+                                  partial_status_bytes_);
+      std::memcpy(reinterpret_cast<uint8_t*>(&partial_status_message_) +
+                      partial_status_bytes_,
+                  p, n);
+      p += n;
+      remaining -= n;
+      partial_status_bytes_ += n;
+      if (partial_status_bytes_ == sizeof(partial_status_message_)) {
+        partial_status_bytes_ = 0;
+        recv_status_message_ = partial_status_message_;
+        on_status_message(ring);
+      }
+    }
+    ring.prep_provide_buffers(buf, status_buffer_size_, 1, index_, bid,
+                              make_user_data(ID_PROVIDE_BUFFERS, index_));
+  } else if (cqe.res == 0) {
+    if (!done_) {
+      throw UringException("connection closed by compute node");
+    }
+    return;
+  } else if (cqe.res != -ENOBUFS && cqe.res != -EINTR &&
+             cqe.res != -EAGAIN) {
+    L_(fatal) << "[" << index_ << "] status receive failed: "
+              << fles::system::stringerror(-cqe.res);
+    throw UringException("receive of status message failed");
+  }
+
+  if ((cqe.flags & IORING_CQE_F_MORE) == 0 && !done_) {
+    post_recv_status_message(ring);
+  }
+}
+
+void InputChannelConnection::on_status_message(IoUring& ring) {
+  if (recv_status_message_.final) {
+    done_ = true;
+    return;
+  }
+  cn_ack_ = recv_status_message_.ack;
+  try_send_final(ring);
+}
+
+void InputChannelConnection::finalize(IoUring& ring, bool abort) {
+  finalize_ = true;
+  abort_ = abort;
+  try_send_final(ring);
+}
+
+void InputChannelConnection::try_send_final(IoUring& ring) {
+  if (!finalize_ || final_queued_ || (cn_wp_ != cn_ack_ && !abort_)) {
+    return;
+  }
+  final_queued_ = true;
+  jobs_.emplace_back();
+  SendJob& job = jobs_.back();
+  std::memset(&job, 0, sizeof(job));
+  job.header.final = true;
+  job.header.abort = abort_;
+  job.parts[0] = {&job.header, sizeof(job.header), -1};
+  job.num_parts = 1;
+  post_send_job(ring);
+}
+
+} // namespace tl_uring
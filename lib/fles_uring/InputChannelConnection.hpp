@@ -0,0 +1,157 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "ComputeNodeInfo.hpp"
+#include "ComputeNodeStatusMessage.hpp"
+#include "InputChannelMessage.hpp"
+#include "IoUring.hpp"
+#include "UringConnection.hpp"
+#include <deque>
+#include <vector>
+
+namespace tl_uring {
+
+/// Input channel connection class.
+/** An InputChannelConnection object represents the endpoint of a single
+    timeslice building connection from an input channel to a compute
+    node. Each timeslice component is sent as a header followed by its
+    descriptor and data chunks, as one linked chain of send requests. The
+    chunks are sent in place from the (registered) input buffers, using
+    zero-copy sends if the kernel supports them. */
+
+class InputChannelConnection : public UringConnection {
+public:
+  /// Contiguous piece of a timeslice component in the input buffers.
+  struct Chunk {
+    const void* ptr;
+    uint64_t length;
+    /// Index of the registered buffer holding the chunk (or -1).
+    int buf_index;
+  };
+
+  /// Maximum number of chunks (including the header) of a component.
+  static constexpr unsigned int max_parts = 16;
+
+  /// The InputChannelConnection constructor.
+  InputChannelConnection(uint_fast16_t connection_index,
+                         uint_fast16_t remote_connection_index,
+                         int fd,
+                         ComputeNodeInfo remote_info,
+                         unsigned int max_pending_write_requests,
+                         bool zero_copy,
+                         bool multishot);
+
+  InputChannelConnection(const InputChannelConnection&) = delete;
+  void operator=(const InputChannelConnection&) = delete;
+
+  /// Wait until enough space is available at target compute node.
+  bool check_for_buffer_space(uint64_t data_size, uint64_t desc_size) const;
+
+  /// Check if a new send request can be queued.
+  bool write_request_available() const;
+
+  /// Increment target write pointers after data has been sent.
+  void inc_write_pointers(uint64_t data_size, uint64_t desc_size);
+
+  /// Return number of bytes to skip to avoid a wrap of the target buffer.
+  uint64_t skip_required(uint64_t data_size) const;
+
+  /// Queue a timeslice component for sending.
+  void send_data(IoUring& ring,
+                 const Chunk* chunks,
+                 unsigned int num_chunks,
+                 uint64_t timeslice,
+                 uint64_t desc_length,
+                 uint64_t data_length,
+                 uint64_t skip);
+
+  /// Handle a send completion. Returns true (and sets timeslice) if the
+  /// component of a timeslice has been sent and its input buffer ranges
+  /// are no longer referenced by the kernel.
+  bool on_complete_send(IoUring& ring,
+                        const io_uring_cqe& cqe,
+                        uint64_t& timeslice);
+
+  /// Provide the status receive buffers and start receiving.
+  void setup(IoUring& ring);
+
+  /// Handle a status receive completion.
+  void on_complete_recv(IoUring& ring, const io_uring_cqe& cqe);
+
+  /// Send the final message once everything has been acknowledged.
+  void finalize(IoUring& ring, bool abort);
+
+  bool request_abort_flag() const {
+    return recv_status_message_.request_abort;
+  }
+
+private:
+  /// Timeslice component (or final message) queued for sending.
+  struct SendJob {
+    uint64_t timeslice;
+    InputChannelMessage header;
+    /// Header (part 0) followed by the payload chunks.
+    Chunk parts[max_parts];
+    /// Bytes of each part handed to the socket so far.
+    uint64_t sent[max_parts];
+    unsigned int num_parts;
+    /// Send completions outstanding for the chain in flight.
+    unsigned int pending_sends;
+    /// Zero-copy notifications outstanding.
+    unsigned int pending_notifs;
+    bool sent_complete;
+  };
+
+  /// Post the send chain of the next job (or the rest of the current one).
+  void post_send_job(IoUring& ring);
+
+  void post_recv_status_message(IoUring& ring);
+
+  void on_status_message(IoUring& ring);
+
+  /// Queue the final message if the connection may be finalized.
+  void try_send_final(IoUring& ring);
+
+  /// Information on remote end.
+  ComputeNodeInfo remote_info_;
+
+  /// Limit of queued send jobs.
+  unsigned int max_pending_write_requests_;
+
+  /// Flag whether to send payload chunks with zero-copy requests.
+  bool zero_copy_;
+
+  /// Flag whether status messages are received with a multishot request.
+  bool multishot_;
+
+  ComputeNodeBufferPosition cn_ack_ = ComputeNodeBufferPosition();
+  ComputeNodeBufferPosition cn_wp_ = ComputeNodeBufferPosition();
+
+  /// Queued send jobs, the front job has sequence number first_job_seq_.
+  std::deque<SendJob> jobs_;
+  uint64_t first_job_seq_ = 0;
+
+  /// Sequence number of the job being sent (or to be sent next).
+  uint64_t send_seq_ = 0;
+
+  /// Flag whether a send chain is in flight.
+  bool sending_ = false;
+
+  /// Provided buffers for the status receive requests.
+  static constexpr unsigned int num_status_buffers_ = 8;
+  static constexpr unsigned int status_buffer_size_ = 512;
+  std::vector<uint8_t> status_buffers_;
+
+  /// Last received status message and the number of bytes received of the
+  /// next one (a message may be split across receive completions).
+  ComputeNodeStatusMessage recv_status_message_ = ComputeNodeStatusMessage();
+  ComputeNodeStatusMessage partial_status_message_ =
+      ComputeNodeStatusMessage();
+  std::size_t partial_status_bytes_ = 0;
+
+  bool finalize_ = false;
+  bool abort_ = false;
+  bool final_queued_ = false;
+};
+
+} // namespace tl_uring
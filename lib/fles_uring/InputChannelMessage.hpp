@@ -0,0 +1,24 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "TimesliceComponentDescriptor.hpp"
+
+namespace tl_uring {
+
+#pragma pack(1)
+
+/// Structure representing the header sent from input channel to compute
+/// buffer ahead of each timeslice component.
+/** The component payload (descriptors and data, tscdesc.size bytes) follows
+    the header on the stream. The descriptor offset already includes any
+    bytes skipped to avoid a buffer wrap. A final header carries no
+    payload and ends the stream. */
+struct InputChannelMessage {
+  fles::TimesliceComponentDescriptor tscdesc;
+  bool abort;
+  bool final;
+};
+
+#pragma pack()
+
+} // namespace tl_uring
@@ -0,0 +1,404 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "InputChannelSender.hpp"
+#include "InputNodeInfo.hpp"
+#include "MicrosliceDescriptor.hpp"
+#include "RequestIdentifier.hpp"
+#include "Socket.hpp"
+#include "Utility.hpp"
+#include "log.hpp"
+#include <cassert>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include <unistd.h>
+
+namespace tl_uring {
+
+namespace {
+/// Time to wait for completions in a run loop cycle without progress.
+constexpr std::chrono::microseconds idle_timeout{100};
+} // namespace
+
+InputChannelSender::InputChannelSender(
+    uint64_t input_index,
+    InputBufferReadInterface& data_source,
+    const std::vector<std::string>& compute_hostnames,
+    const std::vector<std::string>& compute_services,
+    uint32_t timeslice_size,
+    uint32_t overlap_size,
+    uint32_t max_timeslice_number)
+    : input_index_(input_index), data_source_(data_source),
+      compute_hostnames_(compute_hostnames),
+      compute_services_(compute_services), timeslice_size_(timeslice_size),
+      overlap_size_(overlap_size), max_timeslice_number_(max_timeslice_number),
+      send_buffer_(data_source, timeslice_size),
+      desc_metrics_("input_desc",
+                    metrics_labels("iouring", "input", input_index)),
+      data_metrics_("input_data",
+                    metrics_labels("iouring", "input", input_index)),
+      latency_tracer_(LatencyTracer::Role::input, "iouring", input_index) {
+  zero_copy_ = ring_->probe(IORING_OP_SEND_ZC);
+  if (!zero_copy_) {
+    L_(warning) << "[i" << input_index_ << "] "
+                << "kernel lacks io_uring zero-copy send, copying data";
+  }
+  register_buffers();
+}
+
+InputChannelSender::~InputChannelSender() = default;
+
+void InputChannelSender::register_buffers() {
+  std::vector<iovec> buffers;
+  auto add_slices = [&buffers](const void* ptr, uint64_t bytes) {
+    auto* p = const_cast<uint8_t*>(static_cast<const uint8_t*>(ptr));
+    for (uint64_t pos = 0; pos < bytes; pos += buffer_slice_size_) {
+      buffers.push_back({p + pos, std::min(bytes - pos, buffer_slice_size_)});
+    }
+  };
+  add_slices(data_source_.data_buffer().ptr(),
+             data_source_.data_buffer().bytes());
+  desc_buf_index_ = static_cast<int>(buffers.size());
+  add_slices(data_source_.desc_buffer().ptr(),
+             data_source_.desc_buffer().bytes());
+
+  registered_ = zero_copy_ && ring_->register_buffers(buffers);
+  if (zero_copy_ && !registered_) {
+    L_(warning) << "[i" << input_index_ << "] "
+                << "registration of input buffers failed (locked memory "
+                   "limit?), sending from unregistered buffers";
+  }
+}
+
+void InputChannelSender::report_status() {
+  constexpr auto interval = std::chrono::seconds(1);
+
+  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+  SendBufferStatus status_desc = send_buffer_.status_desc(now);
+  SendBufferStatus status_data = send_buffer_.status_data(now);
+
+  double delta_t =
+      std::chrono::duration<double, std::chrono::seconds::period>(
+          status_desc.time - previous_send_buffer_status_desc_.time)
+          .count();
+  double rate_desc =
+      static_cast<double>(status_desc.acked -
+                          previous_send_buffer_status_desc_.acked) /
+      delta_t;
+  double rate_data =
+      static_cast<double>(status_data.acked -
+                          previous_send_buffer_status_data_.acked) /
+      delta_t;
+
+  // retrieve SubsystemIdentifier and EquipmentIdentifier
+  // from most current MicrosliceDescriptor
+  fles::SubsystemIdentifier sys_id = static_cast<fles::SubsystemIdentifier>(0);
+  std::string eq_id("Undefined");
+  if (status_desc.written > 0) {
+    sys_id = static_cast<fles::SubsystemIdentifier>(
+        data_source_.desc_buffer().at(status_desc.written - 1).sys_id);
+    std::stringstream eq_id_ss;
+    eq_id_ss << std::hex << std::uppercase << std::setfill('0') << std::setw(4)
+             << data_source_.desc_buffer().at(status_desc.written - 1).eq_id;
+    eq_id = eq_id_ss.str();
+  }
+
+  L_(debug) << "[i" << input_index_ << "] desc " << status_desc.percentages()
+            << " (used..free) | "
+            << human_readable_count(status_desc.acked, true, "") << " ("
+            << human_readable_count(rate_desc, true, "Hz") << ")";
+
+  L_(debug) << "[i" << input_index_ << "] data " << status_data.percentages()
+            << " (used..free) | "
+            << human_readable_count(status_data.acked, true) << " ("
+            << human_readable_count(rate_data, true, "B/s") << ")";
+
+  L_(status) << "[i" << input_index_ << "]   |"
+             << bar_graph(status_data.vector(), "#x._", 20) << "|"
+             << bar_graph(status_desc.vector(), "#x._", 10) << "| "
+             << human_readable_count(rate_data, true, "B/s") << " ("
+             << human_readable_count(rate_desc, true, "Hz") << ") "
+             << fles::to_string(sys_id) << " " << eq_id;
+
+  desc_metrics_.update(status_desc.used(), status_desc.sending(),
+                       status_desc.freeing(), status_desc.size,
+                       status_desc.acked - send_buffer_.start_index().desc);
+  data_metrics_.update(status_data.used(), status_data.sending(),
+                       status_data.freeing(), status_data.size,
+                       status_data.acked - send_buffer_.start_index().data);
+
+  previous_send_buffer_status_desc_ = status_desc;
+  previous_send_buffer_status_data_ = status_data;
+
+  scheduler_.add(std::bind(&InputChannelSender::report_status, this),
+                 now + interval);
+}
+
+void InputChannelSender::sync_data_source(bool schedule) {
+  send_buffer_.sync_data_source();
+
+  if (schedule) {
+    auto now = std::chrono::system_clock::now();
+    scheduler_.add(std::bind(&InputChannelSender::sync_data_source, this, true),
+                   now + std::chrono::milliseconds(100));
+  }
+}
+
+/// The thread main function.
+void InputChannelSender::operator()() {
+  try {
+
+    connect();
+    for (auto& c : conn_) {
+      c->setup(*ring_);
+    }
+    L_(info) << "[i" << input_index_ << "] "
+             << "connection to compute nodes established";
+
+    data_source_.proceed();
+    time_begin_ = std::chrono::high_resolution_clock::now();
+
+    uint64_t timeslice = 0;
+    sync_data_source(true);
+    report_status();
+    while (timeslice < max_timeslice_number_ && !abort_) {
+      bool sent = try_send_timeslice(timeslice);
+      if (sent) {
+        timeslice++;
+        if (timeslice == 1) {
+          L_(info) << "[i" << input_index_ << "] "
+                   << "first timeslice processed";
+        }
+      }
+      int ne = poll_completion();
+      data_source_.proceed();
+      scheduler_.timer();
+      if (!sent && ne == 0) {
+        wait_completion(idle_timeout);
+      }
+    }
+
+    // wait for pending send completions
+    while (send_buffer_.acked_timeslices() < timeslice) {
+      if (poll_completion() == 0) {
+        wait_completion(idle_timeout);
+      }
+      scheduler_.timer();
+    }
+    sync_data_source(false);
+
+    for (auto& c : conn_) {
+      c->finalize(*ring_, abort_);
+    }
+
+    L_(debug) << "[i" << input_index_ << "] "
+              << "SENDER loop done";
+
+    while (!all_done_) {
+      if (poll_completion() == 0) {
+        wait_completion(idle_timeout);
+      }
+      scheduler_.timer();
+    }
+
+    time_end_ = std::chrono::high_resolution_clock::now();
+
+    summary();
+  } catch (std::exception& e) {
+    L_(error) << "exception in InputChannelSender: " << e.what();
+  }
+}
+
+bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
+  // wait until a complete timeslice is available in the input buffer
+  uint64_t desc_offset =
+      timeslice * timeslice_size_ + send_buffer_.start_index().desc;
+  uint64_t desc_length = timeslice_size_ + overlap_size_;
+
+  if (write_index_desc_ < desc_offset + desc_length) {
+    write_index_desc_ = data_source_.get_write_index().desc;
+  }
+  // check if microslice no. (desc_offset + desc_length - 1) is avail
+  if (write_index_desc_ >= desc_offset + desc_length) {
+    latency_tracer_.mark(timeslice, LatencyTracer::available);
+
+    uint64_t data_offset = data_source_.desc_buffer().at(desc_offset).offset;
+    uint64_t data_end =
+        data_source_.desc_buffer().at(desc_offset + desc_length - 1).offset +
+        data_source_.desc_buffer().at(desc_offset + desc_length - 1).size;
+    assert(data_end >= data_offset);
+
+    uint64_t data_length = data_end - data_offset;
+    uint64_t total_length =
+        data_length + desc_length * sizeof(fles::MicrosliceDescriptor);
+
+    int cn = target_cn_index(timeslice);
+
+    if (!conn_[cn]->write_request_available()) {
+      return false;
+    }
+
+    // number of bytes to skip in advance (to avoid buffer wrap)
+    uint64_t skip = conn_[cn]->skip_required(total_length);
+    total_length += skip;
+
+    if (conn_[cn]->check_for_buffer_space(total_length, 1)) {
+
+      post_send_data(timeslice, cn, desc_offset, desc_length, data_offset,
+                     data_length, skip);
+      latency_tracer_.mark(timeslice, LatencyTracer::posted);
+
+      conn_[cn]->inc_write_pointers(total_length, 1);
+
+      send_buffer_.mark_sent({desc_offset + desc_length, data_end});
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void InputChannelSender::connect() {
+  // limit queued send jobs per connection, each one pins a part of the
+  // input buffer until the kernel has released it
+  constexpr unsigned int max_pending_write_requests = 64;
+
+  for (unsigned int i = 0; i < compute_hostnames_.size(); ++i) {
+    int fd;
+    while ((fd = connect_socket(compute_hostnames_[i],
+                                compute_services_[i])) < 0) {
+      // compute node not listening yet, retry
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    ComputeNodeInfo remote_info{};
+    try {
+      InputNodeInfo info{static_cast<uint32_t>(input_index_)};
+      write_all(fd, &info, sizeof(info));
+      read_all(fd, &remote_info, sizeof(remote_info));
+    } catch (...) {
+      ::close(fd);
+      throw;
+    }
+    L_(debug) << "[i" << input_index_ << "] "
+              << "connected to compute node " << remote_info.index;
+
+    conn_.push_back(std::make_unique<InputChannelConnection>(
+        i, input_index_, fd, remote_info, max_pending_write_requests,
+        zero_copy_, zero_copy_));
+    ++connected_;
+  }
+}
+
+int InputChannelSender::target_cn_index(uint64_t timeslice) {
+  return timeslice % conn_.size();
+}
+
+void InputChannelSender::add_chunks(InputChannelConnection::Chunk* chunks,
+                                    unsigned int& num_chunks,
+                                    const uint8_t* buffer,
+                                    int first_buf_index,
+                                    const uint8_t* ptr,
+                                    uint64_t length) {
+  while (length > 0) {
+    auto pos = static_cast<uint64_t>(ptr - buffer);
+    uint64_t slice = pos / buffer_slice_size_;
+    uint64_t chunk_length =
+        std::min(length, (slice + 1) * buffer_slice_size_ - pos);
+    int buf_index =
+        registered_ ? first_buf_index + static_cast<int>(slice) : -1;
+    chunks[num_chunks++] = {ptr, chunk_length, buf_index};
+    ptr += chunk_length;
+    length -= chunk_length;
+  }
+}
+
+void InputChannelSender::post_send_data(uint64_t timeslice,
+                                        int cn,
+                                        uint64_t desc_offset,
+                                        uint64_t desc_length,
+                                        uint64_t data_offset,
+                                        uint64_t data_length,
+                                        uint64_t skip) {
+  unsigned int num_chunks = 0;
+  InputChannelConnection::Chunk chunks[InputChannelConnection::max_parts - 1];
+
+  auto& desc_buffer = data_source_.desc_buffer();
+  auto& data_buffer = data_source_.data_buffer();
+  const auto* desc_base = reinterpret_cast<const uint8_t*>(desc_buffer.ptr());
+  const uint8_t* data_base = data_buffer.ptr();
+
+  // descriptors
+  uint64_t desc_first = desc_offset & desc_buffer.size_mask();
+  uint64_t desc_first_length =
+      std::min(desc_length, desc_buffer.size() - desc_first);
+  add_chunks(chunks, num_chunks, desc_base, desc_buf_index_,
+             desc_base + desc_first * sizeof(fles::MicrosliceDescriptor),
+             desc_first_length * sizeof(fles::MicrosliceDescriptor));
+  add_chunks(chunks, num_chunks, desc_base, desc_buf_index_, desc_base,
+             (desc_length - desc_first_length) *
+                 sizeof(fles::MicrosliceDescriptor));
+
+  // data
+  uint64_t data_first = data_offset & data_buffer.size_mask();
+  uint64_t data_first_length =
+      std::min(data_length, data_buffer.size() - data_first);
+  add_chunks(chunks, num_chunks, data_base, 0, data_base + data_first,
+             data_first_length);
+  add_chunks(chunks, num_chunks, data_base, 0, data_base,
+             data_length - data_first_length);
+
+  conn_[cn]->send_data(*ring_, chunks, num_chunks, timeslice, desc_length,
+                       data_length, skip);
+}
+
+void InputChannelSender::on_completion(const io_uring_cqe& cqe) {
+  uint_fast16_t cn = request_connection(cqe.user_data);
+  assert(cn < conn_.size());
+
+  switch (request_id(cqe.user_data)) {
+  case ID_SEND_COMPONENT: {
+    uint64_t ts;
+    if (!conn_[cn]->on_complete_send(*ring_, cqe, ts)) {
+      break;
+    }
+    latency_tracer_.mark(ts, LatencyTracer::written);
+
+    uint64_t acked_ts = send_buffer_.acked_timeslices();
+    if (send_buffer_.acknowledge(ts)) {
+      latency_tracer_.mark_range(acked_ts, send_buffer_.acked_timeslices(),
+                                 LatencyTracer::released);
+    }
+  } break;
+
+  case ID_RECEIVE_STATUS: {
+    bool was_done = conn_[cn]->done();
+    conn_[cn]->on_complete_recv(*ring_, cqe);
+    if (conn_[cn]->request_abort_flag()) {
+      abort_ = true;
+    }
+    if (!was_done && conn_[cn]->done()) {
+      ++connections_done_;
+      all_done_ = (connections_done_ == conn_.size());
+      L_(debug) << "[i" << input_index_ << "] "
+                << "ID_RECEIVE_STATUS final for id " << cn
+                << " all_done=" << all_done_;
+    }
+  } break;
+
+  case ID_PROVIDE_BUFFERS:
+    if (cqe.res < 0) {
+      throw UringException("providing receive buffers failed");
+    }
+    break;
+
+  default:
+    L_(error) << "[i" << input_index_ << "] "
+              << "completion for unknown request id "
+              << request_id(cqe.user_data);
+    throw UringException("completion for unknown request id");
+  }
+}
+
+} // namespace tl_uring
@@ -0,0 +1,121 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "DualRingBuffer.hpp"
+#include "InputChannelConnection.hpp"
+#include "LatencyTracer.hpp"
+#include "Metrics.hpp"
+#include "SendBufferTracker.hpp"
+#include "UringConnectionGroup.hpp"
+#include <string>
+#include <vector>
+
+namespace tl_uring {
+
+/// Input buffer and compute node connection container class.
+/** An InputChannelSender object represents an input buffer (filled by a
+    FLIB) and a group of TCP timeslice building connections to compute
+    nodes, driven by an io_uring. The input buffers are registered with
+    the ring and sent in place. */
+
+class InputChannelSender : public UringConnectionGroup<InputChannelConnection> {
+public:
+  /// The InputChannelSender default constructor.
+  InputChannelSender(uint64_t input_index,
+                     InputBufferReadInterface& data_source,
+                     const std::vector<std::string>& compute_hostnames,
+                     const std::vector<std::string>& compute_services,
+                     uint32_t timeslice_size,
+                     uint32_t overlap_size,
+                     uint32_t max_timeslice_number);
+
+  InputChannelSender(const InputChannelSender&) = delete;
+  void operator=(const InputChannelSender&) = delete;
+
+  /// The InputChannelSender default destructor.
+  ~InputChannelSender() override;
+
+  void report_status();
+
+  void sync_data_source(bool schedule);
+
+  void operator()() override;
+
+  /// The central function for distributing timeslice data.
+  bool try_send_timeslice(uint64_t timeslice);
+
+  /// Connect to list of target hostnames.
+  void connect();
+
+private:
+  /// Return target computation node for given timeslice.
+  int target_cn_index(uint64_t timeslice);
+
+  /// Register the input buffers with the ring.
+  void register_buffers();
+
+  /// Append the chunks of a contiguous input buffer range, split at the
+  /// boundaries of the registered buffer slices.
+  void add_chunks(InputChannelConnection::Chunk* chunks,
+                  unsigned int& num_chunks,
+                  const uint8_t* buffer,
+                  int first_buf_index,
+                  const uint8_t* ptr,
+                  uint64_t length);
+
+  /// Create chunk list for transmission of timeslice
+  void post_send_data(uint64_t timeslice,
+                      int cn,
+                      uint64_t desc_offset,
+                      uint64_t desc_length,
+                      uint64_t data_offset,
+                      uint64_t data_length,
+                      uint64_t skip);
+
+  /// Completion notification event dispatcher. Called by the event loop.
+  void on_completion(const io_uring_cqe& cqe) override;
+
+  uint64_t input_index_;
+
+  /// Data source (e.g., FLIB).
+  InputBufferReadInterface& data_source_;
+
+  const std::vector<std::string> compute_hostnames_;
+  const std::vector<std::string> compute_services_;
+
+  const uint32_t timeslice_size_;
+  const uint32_t overlap_size_;
+  const uint32_t max_timeslice_number_;
+
+  /// Sent, acknowledged and released positions in the input buffer.
+  SendBufferTracker send_buffer_;
+
+  uint64_t write_index_desc_ = 0;
+
+  bool abort_ = false;
+
+  /// Flag whether the kernel supports zero-copy sends (and multishot
+  /// receives, which arrived with the same kernel release).
+  bool zero_copy_ = false;
+
+  /// Flag whether the input buffers are registered with the ring.
+  bool registered_ = false;
+
+  /// Size of the registered buffer slices (the kernel limit per buffer).
+  static constexpr uint64_t buffer_slice_size_ = UINT64_C(1) << 30;
+
+  /// Index of the first registered slice of the descriptor buffer.
+  int desc_buf_index_ = 0;
+
+  SendBufferStatus previous_send_buffer_status_desc_ = SendBufferStatus();
+  SendBufferStatus previous_send_buffer_status_data_ = SendBufferStatus();
+
+  /// Exported fill levels of the input buffers.
+  BufferMetrics desc_metrics_;
+  BufferMetrics data_metrics_;
+
+  /// Sampled latencies of the timeslice sending stages.
+  LatencyTracer latency_tracer_;
+};
+
+} // namespace tl_uring
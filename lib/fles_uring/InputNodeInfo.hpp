@@ -0,0 +1,18 @@
+// Copyright 2012-2013 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <cstdint>
+
+namespace tl_uring {
+
+#pragma pack(1)
+
+/// Structure representing the input node information sent when
+/// connecting to a compute node.
+struct InputNodeInfo {
+  uint32_t index;
+};
+
+#pragma pack()
+
+} // namespace tl_uring
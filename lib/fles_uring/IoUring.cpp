@@ -0,0 +1,239 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "IoUring.hpp"
+#include "System.hpp"
+#include "UringException.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace tl_uring {
+
+namespace {
+UringException uring_error(const std::string& what, int err) {
+  return UringException("io_uring: " + what + ": " +
+                        fles::system::stringerror(err));
+}
+
+template <typename T> T* ring_ptr(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<uint8_t*>(ring) + offset);
+}
+
+unsigned int load_acquire(const unsigned int* p) {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+void store_release(unsigned int* p, unsigned int v) {
+  __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+} // namespace
+
+IoUring::IoUring(unsigned int entries) {
+  fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params_));
+  if (fd_ < 0) {
+    throw uring_error("setup failed", errno);
+  }
+
+  sq_ring_size_ =
+      params_.sq_off.array + params_.sq_entries * sizeof(unsigned int);
+  cq_ring_size_ =
+      params_.cq_off.cqes + params_.cq_entries * sizeof(io_uring_cqe);
+  bool single_mmap = (params_.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+
+  sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    int err = errno;
+    ::close(fd_);
+    throw uring_error("mmap of submission queue failed", err);
+  }
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_ = ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      int err = errno;
+      ::munmap(sq_ring_, sq_ring_size_);
+      ::close(fd_);
+      throw uring_error("mmap of completion queue failed", err);
+    }
+  }
+  void* sqes = ::mmap(nullptr, params_.sq_entries * sizeof(io_uring_sqe),
+                      PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+                      IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    int err = errno;
+    if (cq_ring_ != sq_ring_) {
+      ::munmap(cq_ring_, cq_ring_size_);
+    }
+    ::munmap(sq_ring_, sq_ring_size_);
+    ::close(fd_);
+    throw uring_error("mmap of submission entries failed", err);
+  }
+  sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+  sq_head_ = ring_ptr<unsigned int>(sq_ring_, params_.sq_off.head);
+  sq_tail_ = ring_ptr<unsigned int>(sq_ring_, params_.sq_off.tail);
+  sq_mask_ = *ring_ptr<unsigned int>(sq_ring_, params_.sq_off.ring_mask);
+  cq_head_ = ring_ptr<unsigned int>(cq_ring_, params_.cq_off.head);
+  cq_tail_ = ring_ptr<unsigned int>(cq_ring_, params_.cq_off.tail);
+  cq_mask_ = *ring_ptr<unsigned int>(cq_ring_, params_.cq_off.ring_mask);
+  cqes_ = ring_ptr<io_uring_cqe>(cq_ring_, params_.cq_off.cqes);
+
+  // entries are always handed to the kernel in ring order
+  unsigned int* array = ring_ptr<unsigned int>(sq_ring_, params_.sq_off.array);
+  for (unsigned int i = 0; i < params_.sq_entries; ++i) {
+    array[i] = i;
+  }
+  sqe_tail_ = *sq_tail_;
+}
+
+IoUring::~IoUring() {
+  ::munmap(sqes_, params_.sq_entries * sizeof(io_uring_sqe));
+  if (cq_ring_ != sq_ring_) {
+    ::munmap(cq_ring_, cq_ring_size_);
+  }
+  ::munmap(sq_ring_, sq_ring_size_);
+  ::close(fd_);
+}
+
+io_uring_sqe* IoUring::get_sqe() {
+  reserve_sqes(1);
+  io_uring_sqe* sqe = &sqes_[sqe_tail_ & sq_mask_];
+  std::memset(sqe, 0, sizeof(*sqe));
+  ++sqe_tail_;
+  return sqe;
+}
+
+void IoUring::reserve_sqes(unsigned int count) {
+  if (count > params_.sq_entries) {
+    throw UringException("io_uring: cannot reserve " + std::to_string(count) +
+                         " of " + std::to_string(params_.sq_entries) +
+                         " entries");
+  }
+  while (params_.sq_entries - pending() < count) {
+    submit();
+  }
+}
+
+unsigned int IoUring::pending() const {
+  return sqe_tail_ - load_acquire(sq_head_);
+}
+
+void IoUring::reap_cqes() {
+  unsigned int head = *cq_head_;
+  unsigned int tail = load_acquire(cq_tail_);
+  for (; head != tail; ++head) {
+    cqe_backlog_.push_back(cqes_[head & cq_mask_]);
+  }
+  store_release(cq_head_, head);
+}
+
+void IoUring::enter(unsigned int to_submit,
+                    unsigned int min_complete,
+                    unsigned int flags,
+                    void* arg,
+                    std::size_t arg_size) {
+  store_release(sq_tail_, sqe_tail_);
+  long rc = ::syscall(__NR_io_uring_enter, fd_, to_submit, min_complete,
+                      flags, arg, arg_size);
+  if (rc < 0) {
+    // the kernel refuses new entries while completions are waiting for
+    // room in the completion queue; keep them aside and let the caller
+    // try again
+    if (errno == EBUSY) {
+      reap_cqes();
+      return;
+    }
+    // a timeout or a signal are no errors
+    if (errno == ETIME || errno == EINTR || errno == EAGAIN) {
+      return;
+    }
+    throw uring_error("enter failed", errno);
+  }
+}
+
+void IoUring::submit() {
+  unsigned int to_submit = pending();
+  if (to_submit != 0) {
+    enter(to_submit, 0, 0, nullptr, 0);
+  }
+}
+
+void IoUring::submit_and_wait(std::chrono::microseconds timeout) {
+  if ((params_.features & IORING_FEAT_EXT_ARG) == 0 ||
+      !cqe_backlog_.empty() || load_acquire(cq_tail_) != *cq_head_) {
+    submit();
+    return;
+  }
+  __kernel_timespec ts{};
+  ts.tv_sec = timeout.count() / 1000000;
+  ts.tv_nsec = (timeout.count() % 1000000) * 1000;
+  io_uring_getevents_arg arg{};
+  arg.ts = reinterpret_cast<uint64_t>(&ts);
+  enter(pending(), 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg,
+        sizeof(arg));
+}
+
+io_uring_cqe* IoUring::peek_cqe() {
+  if (!cqe_backlog_.empty()) {
+    return &cqe_backlog_.front();
+  }
+  unsigned int head = *cq_head_;
+  if (head == load_acquire(cq_tail_)) {
+    return nullptr;
+  }
+  return &cqes_[head & cq_mask_];
+}
+
+void IoUring::cqe_seen() {
+  if (!cqe_backlog_.empty()) {
+    cqe_backlog_.pop_front();
+    return;
+  }
+  store_release(cq_head_, *cq_head_ + 1);
+}
+
+bool IoUring::probe(uint8_t opcode) {
+  constexpr unsigned int max_ops = 256;
+  std::vector<uint8_t> buf(sizeof(io_uring_probe) +
+                           max_ops * sizeof(io_uring_probe_op));
+  auto* p = reinterpret_cast<io_uring_probe*>(buf.data());
+  if (::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PROBE, p,
+                max_ops) < 0) {
+    return false;
+  }
+  return opcode <= p->last_op &&
+         (p->ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0;
+}
+
+bool IoUring::register_buffers(const std::vector<iovec>& buffers) {
+  return ::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS,
+                   buffers.data(), buffers.size()) == 0;
+}
+
+void IoUring::prep_provide_buffers(void* addr,
+                                   unsigned int len,
+                                   unsigned int nbufs,
+                                   uint16_t group,
+                                   uint16_t first_id,
+                                   uint64_t user_data) {
+  io_uring_sqe* sqe = get_sqe();
+  sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+  sqe->fd = static_cast<int32_t>(nbufs);
+  sqe->addr = reinterpret_cast<uint64_t>(addr);
+  sqe->len = len;
+  sqe->off = first_id;
+  sqe->buf_group = group;
+  sqe->user_data = user_data;
+}
+
+} // namespace tl_uring
@@ -0,0 +1,109 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+#include <vector>
+
+namespace tl_uring {
+
+/// Minimal io_uring instance.
+/** An IoUring object sets up a submission and completion queue pair
+    directly on top of the kernel interface (no liburing dependency). It
+    provides just what the transport needs: preparing and submitting
+    entries, reaping completions, registered buffers, provided buffer
+    groups and an opcode probe. The object is used by a single thread. */
+
+class IoUring {
+public:
+  /// The IoUring constructor, creates a ring with the given number of
+  /// submission queue entries.
+  explicit IoUring(unsigned int entries);
+
+  IoUring(const IoUring&) = delete;
+  void operator=(const IoUring&) = delete;
+
+  /// The IoUring destructor.
+  ~IoUring();
+
+  /// Return a cleared submission queue entry. Pending entries are
+  /// submitted first if the submission queue is full.
+  io_uring_sqe* get_sqe();
+
+  /// Make room for the given number of entries, e.g., for a chain of
+  /// linked entries that must be submitted together. Pending entries are
+  /// submitted first if there is not enough room.
+  void reserve_sqes(unsigned int count);
+
+  /// Submit all prepared entries without waiting.
+  void submit();
+
+  /// Submit all prepared entries and wait up to the given time for at
+  /// least one completion.
+  void submit_and_wait(std::chrono::microseconds timeout);
+
+  /// Return the next completion, or nullptr if there is none. The entry
+  /// stays valid until cqe_seen() or get_sqe() is called.
+  io_uring_cqe* peek_cqe();
+
+  /// Release the completion returned by peek_cqe().
+  void cqe_seen();
+
+  /// Retrieve the number of submission queue entries of the ring.
+  unsigned int sq_entries() const { return params_.sq_entries; }
+
+  /// Check whether the kernel supports the given opcode.
+  bool probe(uint8_t opcode);
+
+  /// Register a list of fixed buffers, return false if the kernel refuses
+  /// (e.g., because the locked memory limit is too low).
+  bool register_buffers(const std::vector<iovec>& buffers);
+
+  /// Prepare an entry handing a contiguous set of buffers to a provided
+  /// buffer group.
+  void prep_provide_buffers(void* addr,
+                            unsigned int len,
+                            unsigned int nbufs,
+                            uint16_t group,
+                            uint16_t first_id,
+                            uint64_t user_data);
+
+private:
+  void enter(unsigned int to_submit, unsigned int min_complete,
+             unsigned int flags, void* arg, std::size_t arg_size);
+
+  /// Number of prepared entries not yet consumed by the kernel.
+  unsigned int pending() const;
+
+  /// Move all completions from the completion queue to the backlog.
+  void reap_cqes();
+
+  int fd_ = -1;
+  io_uring_params params_{};
+
+  void* sq_ring_ = nullptr;
+  std::size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  std::size_t cq_ring_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+
+  unsigned int* sq_head_ = nullptr;
+  unsigned int* sq_tail_ = nullptr;
+  unsigned int sq_mask_ = 0;
+  unsigned int* cq_head_ = nullptr;
+  unsigned int* cq_tail_ = nullptr;
+  unsigned int cq_mask_ = 0;
+  io_uring_cqe* cqes_ = nullptr;
+
+  /// Local submission queue tail (prepared entries).
+  unsigned int sqe_tail_ = 0;
+
+  /// Completions reaped to make room in a full completion queue, handed
+  /// out before the ones still in the queue.
+  std::deque<io_uring_cqe> cqe_backlog_;
+};
+
+} // namespace tl_uring
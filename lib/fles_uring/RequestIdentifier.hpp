@@ -0,0 +1,65 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+
+namespace tl_uring {
+
+/// io_uring request IDs.
+/** The user data of a request holds the ID in bits 0..7, the connection
+    index in bits 8..23, the part of a linked send chain in bits 24..27 and
+    a sequence number in bits 28..63. */
+enum RequestIdentifier {
+  ID_SEND_COMPONENT = 1,
+  ID_RECEIVE_STATUS,
+  ID_PROVIDE_BUFFERS,
+  ID_RECEIVE_HEADER,
+  ID_RECEIVE_DATA,
+  ID_SEND_STATUS
+};
+
+/// Compose the user data of a request.
+inline uint64_t make_user_data(RequestIdentifier id,
+                               uint64_t connection,
+                               uint64_t part = 0,
+                               uint64_t seq = 0) {
+  return static_cast<uint64_t>(id) | (connection << 8) | (part << 24) |
+         (seq << 28);
+}
+
+inline RequestIdentifier request_id(uint64_t user_data) {
+  return static_cast<RequestIdentifier>(user_data & 0xFF);
+}
+
+inline uint_fast16_t request_connection(uint64_t user_data) {
+  return (user_data >> 8) & 0xFFFF;
+}
+
+inline unsigned int request_part(uint64_t user_data) {
+  return (user_data >> 24) & 0xF;
+}
+
+inline uint64_t request_seq(uint64_t user_data) { return user_data >> 28; }
+
+/// Overloaded output operator for RequestIdentifier values.
+inline std::ostream& operator<<(std::ostream& s, RequestIdentifier v) {
+  switch (v) {
+  case ID_SEND_COMPONENT:
+    return s << "ID_SEND_COMPONENT";
+  case ID_RECEIVE_STATUS:
+    return s << "ID_RECEIVE_STATUS";
+  case ID_PROVIDE_BUFFERS:
+    return s << "ID_PROVIDE_BUFFERS";
+  case ID_RECEIVE_HEADER:
+    return s << "ID_RECEIVE_HEADER";
+  case ID_RECEIVE_DATA:
+    return s << "ID_RECEIVE_DATA";
+  case ID_SEND_STATUS:
+    return s << "ID_SEND_STATUS";
+  default:
+    return s << static_cast<int>(v);
+  }
+}
+
+} // namespace tl_uring
@@ -0,0 +1,143 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "Socket.hpp"
+#include "System.hpp"
+#include "UringException.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace tl_uring {
+
+namespace {
+UringException socket_error(const std::string& what) {
+  return UringException("socket: " + what + ": " +
+                        fles::system::stringerror(errno));
+}
+
+void set_nodelay(int fd) {
+  // headers and status messages must not wait for more data
+  int on = 1;
+  ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+} // namespace
+
+int connect_socket(const std::string& host, const std::string& service) {
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* result = nullptr;
+  int rc = ::getaddrinfo(host.c_str(), service.c_str(), &hints, &result);
+  if (rc != 0) {
+    throw UringException("socket: cannot resolve " + host + ": " +
+                         gai_strerror(rc));
+  }
+
+  int fd = -1;
+  int err = 0;
+  for (addrinfo* ai = result; ai != nullptr; ai = ai->ai_next) {
+    fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC,
+                  ai->ai_protocol);
+    if (fd < 0) {
+      err = errno;
+      continue;
+    }
+    if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+      break;
+    }
+    err = errno;
+    ::close(fd);
+    fd = -1;
+  }
+  ::freeaddrinfo(result);
+  if (fd < 0) {
+    if (err == ECONNREFUSED || err == ETIMEDOUT || err == EHOSTUNREACH) {
+      return -1;
+    }
+    errno = err;
+    throw socket_error("cannot connect to " + host + ":" + service);
+  }
+  set_nodelay(fd);
+  return fd;
+}
+
+int listen_socket(unsigned short port, int backlog) {
+  int fd = ::socket(AF_INET6, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    throw socket_error("socket() failed");
+  }
+  int off = 0;
+  ::setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+  int on = 1;
+  ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+  sockaddr_in6 addr{};
+  addr.sin6_family = AF_INET6;
+  addr.sin6_addr = in6addr_any;
+  addr.sin6_port = htons(port);
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+      ::listen(fd, backlog) != 0) {
+    UringException error =
+        socket_error("cannot listen on port " + std::to_string(port));
+    ::close(fd);
+    throw error;
+  }
+  return fd;
+}
+
+int accept_socket(int listen_fd, std::chrono::milliseconds timeout) {
+  pollfd pfd{listen_fd, POLLIN, 0};
+  int rc = ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+  if (rc < 0 && errno != EINTR) {
+    throw socket_error("poll failed");
+  }
+  if (rc <= 0) {
+    return -1;
+  }
+  int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+  if (fd < 0) {
+    throw socket_error("accept failed");
+  }
+  set_nodelay(fd);
+  return fd;
+}
+
+void write_all(int fd, const void* buf, std::size_t size) {
+  const auto* p = static_cast<const uint8_t*>(buf);
+  while (size > 0) {
+    ssize_t n = ::send(fd, p, size, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw socket_error("send failed");
+    }
+    p += n;
+    size -= static_cast<std::size_t>(n);
+  }
+}
+
+void read_all(int fd, void* buf, std::size_t size) {
+  auto* p = static_cast<uint8_t*>(buf);
+  while (size > 0) {
+    ssize_t n = ::recv(fd, p, size, 0);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw socket_error("receive failed");
+    }
+    if (n == 0) {
+      throw UringException("socket: connection closed by peer");
+    }
+    p += n;
+    size -= static_cast<std::size_t>(n);
+  }
+}
+
+} // namespace tl_uring
@@ -0,0 +1,27 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace tl_uring {
+
+/// Connect a TCP socket to the given host and service. Returns -1 if the
+/// peer is not (yet) listening, throws UringException on other errors.
+int connect_socket(const std::string& host, const std::string& service);
+
+/// Create a TCP socket listening on the given port (all interfaces).
+int listen_socket(unsigned short port, int backlog);
+
+/// Accept a connection on a listening socket. Returns -1 if none arrives
+/// within the timeout.
+int accept_socket(int listen_fd, std::chrono::milliseconds timeout);
+
+/// Blocking write of a complete buffer (used during connection setup).
+void write_all(int fd, const void* buf, std::size_t size);
+
+/// Blocking read of a complete buffer (used during connection setup).
+void read_all(int fd, void* buf, std::size_t size);
+
+} // namespace tl_uring
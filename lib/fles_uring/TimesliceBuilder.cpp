@@ -0,0 +1,320 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "TimesliceBuilder.hpp"
+#include "ComputeNodeInfo.hpp"
+#include "InputNodeInfo.hpp"
+#include "RequestIdentifier.hpp"
+#include "Socket.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <limits>
+#include <unistd.h>
+
+namespace tl_uring {
+
+namespace {
+/// Time to wait for completions in a run loop cycle without progress.
+constexpr std::chrono::microseconds idle_timeout{100};
+} // namespace
+
+TimesliceBuilder::TimesliceBuilder(uint64_t compute_index,
+                                   TimesliceBuffer& timeslice_buffer,
+                                   unsigned short service,
+                                   uint32_t num_input_nodes,
+                                   uint32_t timeslice_size,
+                                   volatile sig_atomic_t* signal_status,
+                                   bool drop)
+    : compute_index_(compute_index), timeslice_buffer_(timeslice_buffer),
+      service_(service), num_input_nodes_(num_input_nodes),
+      timeslice_size_(timeslice_size),
+      signal_status_(signal_status),
+      latency_tracer_(LatencyTracer::Role::compute, "iouring", compute_index),
+      timeslices_(timeslice_buffer, timeslice_size, latency_tracer_, drop) {
+  assert(timeslice_buffer_.get_num_input_nodes() == num_input_nodes);
+
+  previous_recv_buffer_status_data_.resize(num_input_nodes);
+  previous_recv_buffer_status_desc_.resize(num_input_nodes);
+
+  for (uint32_t i = 0; i < num_input_nodes; ++i) {
+    std::string labels = metrics_labels("iouring", "compute", compute_index) +
+                         ",input=\"" + std::to_string(i) + "\"";
+    desc_metrics_.push_back(
+        std::make_unique<BufferMetrics>("timeslice_desc", labels));
+    data_metrics_.push_back(
+        std::make_unique<BufferMetrics>("timeslice_data", labels));
+  }
+}
+
+TimesliceBuilder::~TimesliceBuilder() = default;
+
+void TimesliceBuilder::report_status() {
+  constexpr auto interval = std::chrono::seconds(1);
+
+  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+
+  L_(debug) << "[c" << compute_index_ << "] " << timeslices_.dispatched()
+            << " completely written, " << timeslices_.acked() << " acked";
+
+  double total_rate_desc = 0.;
+  double total_rate_data = 0.;
+
+  float min_used_desc = std::numeric_limits<float>::max();
+  float min_used_data = std::numeric_limits<float>::max();
+  float min_free_desc = std::numeric_limits<float>::max();
+  float min_free_data = std::numeric_limits<float>::max();
+  float min_freeing_plus_free_desc = std::numeric_limits<float>::max();
+  float min_freeing_plus_free_data = std::numeric_limits<float>::max();
+
+  for (auto& c : conn_) {
+    auto status_desc = c->buffer_status_desc();
+    auto status_data = c->buffer_status_data();
+
+    min_used_desc =
+        std::min(min_used_desc, status_desc.percentage(status_desc.used()));
+    min_used_data =
+        std::min(min_used_data, status_data.percentage(status_data.used()));
+    min_free_desc =
+        std::min(min_free_desc, status_desc.percentage(status_desc.unused()));
+    min_free_data =
+        std::min(min_free_data, status_data.percentage(status_data.unused()));
+    min_freeing_plus_free_desc =
+        std::min(min_freeing_plus_free_desc,
+                 status_desc.percentage(status_desc.freeing()) +
+                     status_desc.percentage(status_desc.unused()));
+    min_freeing_plus_free_data =
+        std::min(min_freeing_plus_free_data,
+                 status_data.percentage(status_data.freeing()) +
+                     status_data.percentage(status_data.unused()));
+
+    double delta_t =
+        std::chrono::duration<double, std::chrono::seconds::period>(
+            status_desc.time -
+            previous_recv_buffer_status_desc_.at(c->index()).time)
+            .count();
+    double rate_desc =
+        static_cast<double>(
+            status_desc.received -
+            previous_recv_buffer_status_desc_.at(c->index()).received) /
+        delta_t;
+    double rate_data =
+        static_cast<double>(
+            status_data.received -
+            previous_recv_buffer_status_data_.at(c->index()).received) /
+        delta_t;
+    total_rate_desc += rate_desc;
+    total_rate_data += rate_data;
+
+    L_(debug) << "[c" << compute_index_ << "] desc "
+              << status_desc.percentages() << " (used..free) | "
+              << human_readable_count(status_desc.acked, true, "")
+              << " timeslices";
+    L_(debug) << "[c" << compute_index_ << "] data "
+              << status_data.percentages() << " (used..free) | "
+              << human_readable_count(status_data.acked, true);
+    L_(debug) << "[c" << compute_index_ << "_" << c->index() << "] |"
+              << bar_graph(status_data.vector(), "#._", 20) << "|"
+              << bar_graph(status_desc.vector(), "#._", 10) << "| "
+              << human_readable_count(rate_data, true, "B/s") << " ("
+              << human_readable_count(rate_desc, true, "Hz") << ")";
+
+    desc_metrics_.at(c->index())
+        ->update(status_desc.used(), 0, status_desc.freeing(),
+                 status_desc.size, status_desc.acked);
+    data_metrics_.at(c->index())
+        ->update(status_data.used(), 0, status_data.freeing(),
+                 status_data.size, status_data.acked);
+
+    previous_recv_buffer_status_data_.at(c->index()) = status_data;
+    previous_recv_buffer_status_desc_.at(c->index()) = status_desc;
+  }
+
+  float min_freeing_desc =
+      std::max(min_freeing_plus_free_desc - min_free_desc, 0.f);
+  float min_freeing_data =
+      std::max(min_freeing_plus_free_data - min_free_data, 0.f);
+  float mixed_desc =
+      std::max(1.f - min_used_desc - min_free_desc - min_freeing_desc, 0.f);
+  float mixed_data =
+      std::max(1.f - min_used_data - min_free_data - min_freeing_data, 0.f);
+
+  auto total_status_data = std::vector<float>{min_used_data, mixed_data,
+                                              min_freeing_data, min_free_data};
+  auto total_status_desc = std::vector<float>{min_used_desc, mixed_desc,
+                                              min_freeing_desc, min_free_desc};
+
+  L_(status) << "[c" << compute_index_ << "]   |"
+             << bar_graph(total_status_data, "#=._", 20) << "|"
+             << bar_graph(total_status_desc, "#=._", 10) << "| "
+             << human_readable_count(total_rate_data, true, "B/s") << " ("
+             << human_readable_count(total_rate_desc, true, "Hz") << ")";
+
+  scheduler_.add(std::bind(&TimesliceBuilder::report_status, this),
+                 now + interval);
+}
+
+void TimesliceBuilder::request_abort() {
+  L_(info) << "[c" << compute_index_ << "] "
+           << "request abort";
+
+  for (auto& connection : conn_) {
+    connection->request_abort();
+    connection->post_send_status_message(*ring_);
+  }
+}
+
+/// The thread main function.
+void TimesliceBuilder::operator()() {
+  try {
+    accept();
+    for (auto& c : conn_) {
+      c->setup(*ring_);
+    }
+    L_(info) << "[c" << compute_index_ << "] "
+             << "connection to input nodes established";
+
+    time_begin_ = std::chrono::high_resolution_clock::now();
+
+    report_status();
+    while (!all_done_) {
+      int ne = poll_completion();
+      bool completions = poll_ts_completion();
+      scheduler_.timer();
+      if (*signal_status_ != 0) {
+        *signal_status_ = 0;
+        request_abort();
+      }
+      if (ne == 0 && !completions) {
+        wait_completion(idle_timeout);
+      }
+    }
+
+    time_end_ = std::chrono::high_resolution_clock::now();
+
+    timeslice_buffer_.send_end_work_item();
+    timeslice_buffer_.send_end_completion();
+
+    summary();
+  } catch (std::exception& e) {
+    L_(error) << "exception in TimesliceBuilder: " << e.what();
+  }
+}
+
+void TimesliceBuilder::accept() {
+  conn_.resize(num_input_nodes_);
+
+  int listen_fd = listen_socket(service_, static_cast<int>(num_input_nodes_));
+  L_(debug) << "waiting for " << num_input_nodes_ << " connections";
+
+  try {
+    while (connected_ != num_input_nodes_) {
+      int fd = accept_socket(listen_fd, std::chrono::milliseconds(100));
+      if (fd < 0) {
+        continue;
+      }
+
+      InputNodeInfo remote_info{};
+      try {
+        read_all(fd, &remote_info, sizeof(remote_info));
+        uint_fast16_t index = remote_info.index;
+        if (index >= conn_.size() || conn_.at(index) != nullptr) {
+          throw UringException("unexpected input node index " +
+                               std::to_string(index));
+        }
+        ComputeNodeInfo info{
+            static_cast<uint32_t>(compute_index_),
+            static_cast<uint32_t>(timeslice_buffer_.get_data_size_exp()),
+            static_cast<uint32_t>(timeslice_buffer_.get_desc_size_exp())};
+        write_all(fd, &info, sizeof(info));
+      } catch (...) {
+        ::close(fd);
+        throw;
+      }
+
+      uint_fast16_t index = remote_info.index;
+      conn_.at(index) = std::make_unique<ComputeNodeConnection>(
+          index, compute_index_, fd, timeslice_buffer_.get_data_ptr(index),
+          timeslice_buffer_.get_data_size_exp(),
+          timeslice_buffer_.get_desc_ptr(index),
+          timeslice_buffer_.get_desc_size_exp());
+      ++connected_;
+      L_(debug) << "[c" << compute_index_ << "] "
+                << "connection from input node " << index;
+    }
+  } catch (...) {
+    ::close(listen_fd);
+    throw;
+  }
+  ::close(listen_fd);
+}
+
+/// Completion notification event dispatcher. Called by the event loop.
+void TimesliceBuilder::on_completion(const io_uring_cqe& cqe) {
+  size_t in = request_connection(cqe.user_data);
+  assert(in < conn_.size());
+  switch (request_id(cqe.user_data)) {
+
+  case ID_SEND_STATUS: {
+    bool was_done = conn_[in]->done();
+    conn_[in]->on_complete_send(*ring_, cqe);
+    if (!was_done && conn_[in]->done()) {
+      if (!conn_[in]->abort_flag()) {
+        assert(timeslice_buffer_.get_num_work_items() == 0);
+        assert(timeslice_buffer_.get_num_completions() == 0);
+      }
+      ++connections_done_;
+      all_done_ = (connections_done_ == conn_.size());
+      L_(debug) << "[c" << compute_index_ << "] "
+                << "SEND FINALIZE complete for id " << in
+                << " all_done=" << all_done_;
+    }
+  } break;
+
+  case ID_RECEIVE_HEADER:
+  case ID_RECEIVE_DATA: {
+    uint64_t old_desc = conn_[in]->cn_wp().desc;
+    if (!conn_[in]->on_complete_recv(*ring_, cqe)) {
+      break;
+    }
+    uint64_t new_desc = conn_[in]->cn_wp().desc;
+    latency_tracer_.mark_range(old_desc, new_desc,
+                               LatencyTracer::first_contribution);
+    latency_tracer_.mark_latest_range(old_desc, new_desc,
+                                      LatencyTracer::last_contribution);
+    if (in == red_lantern_) {
+      auto new_red_lantern = std::min_element(
+          std::begin(conn_), std::end(conn_),
+          [](const std::unique_ptr<ComputeNodeConnection>& v1,
+             const std::unique_ptr<ComputeNodeConnection>& v2) {
+            return v1->cn_wp().desc < v2->cn_wp().desc;
+          });
+
+      uint64_t new_completely_written = (*new_red_lantern)->cn_wp().desc;
+      red_lantern_ = std::distance(std::begin(conn_), new_red_lantern);
+
+      while (timeslices_.dispatched() < new_completely_written) {
+        timeslices_.dispatch(
+            timeslice_buffer_.get_desc(0, timeslices_.dispatched()).ts_num);
+      }
+    }
+  } break;
+
+  default:
+    throw UringException("completion for unknown request id");
+  }
+}
+
+bool TimesliceBuilder::poll_ts_completion() {
+  uint64_t acked = timeslices_.acked();
+  if (!timeslices_.poll_completion()) {
+    return false;
+  }
+  if (timeslices_.acked() != acked) {
+    for (auto& connection : conn_) {
+      connection->inc_ack_pointers(timeslices_.acked());
+      connection->post_send_status_message(*ring_);
+    }
+  }
+  return true;
+}
+
+} // namespace tl_uring
@@ -0,0 +1,81 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "ComputeNodeConnection.hpp"
+#include "LatencyTracer.hpp"
+#include "Metrics.hpp"
+#include "ReceiveBufferStatus.hpp"
+#include "TimesliceBuffer.hpp"
+#include "TimesliceBufferTracker.hpp"
+#include "UringConnectionGroup.hpp"
+#include <csignal>
+#include <memory>
+#include <vector>
+
+namespace tl_uring {
+
+/// Timeslice receiver and input node connection container class.
+/** A TimesliceBuilder object represents a group of TCP timeslice building
+ connections to input nodes, driven by an io_uring, and receives timeslices
+ to a timeslice buffer. */
+
+class TimesliceBuilder : public UringConnectionGroup<ComputeNodeConnection> {
+public:
+  /// The TimesliceBuilder constructor.
+  TimesliceBuilder(uint64_t compute_index,
+                   TimesliceBuffer& timeslice_buffer,
+                   unsigned short service,
+                   uint32_t num_input_nodes,
+                   uint32_t timeslice_size,
+                   volatile sig_atomic_t* signal_status,
+                   bool drop);
+
+  TimesliceBuilder(const TimesliceBuilder&) = delete;
+  void operator=(const TimesliceBuilder&) = delete;
+
+  /// The TimesliceBuilder destructor.
+  ~TimesliceBuilder() override;
+
+  void report_status();
+
+  void request_abort();
+
+  void operator()() override;
+
+  /// Accept the connections of all input nodes.
+  void accept();
+
+  /// Completion notification event dispatcher. Called by the event loop.
+  void on_completion(const io_uring_cqe& cqe) override;
+
+  /// Handle timeslice completions, return false if there were none.
+  bool poll_ts_completion();
+
+private:
+  uint64_t compute_index_;
+  TimesliceBuffer& timeslice_buffer_;
+
+  unsigned short service_;
+  uint32_t num_input_nodes_;
+
+  uint32_t timeslice_size_;
+
+  size_t red_lantern_ = 0;
+
+  volatile sig_atomic_t* signal_status_;
+
+  std::vector<ReceiveBufferStatus> previous_recv_buffer_status_desc_;
+  std::vector<ReceiveBufferStatus> previous_recv_buffer_status_data_;
+
+  /// Exported fill levels of the per-connection receive buffers.
+  std::vector<std::unique_ptr<BufferMetrics>> desc_metrics_;
+  std::vector<std::unique_ptr<BufferMetrics>> data_metrics_;
+
+  /// Sampled latencies of the timeslice building stages.
+  LatencyTracer latency_tracer_;
+
+  /// Dispatched and acknowledged timeslices in the timeslice buffer.
+  TimesliceBufferTracker timeslices_;
+};
+
+} // namespace tl_uring
@@ -0,0 +1,21 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "UringConnection.hpp"
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace tl_uring {
+
+UringConnection::UringConnection(uint_fast16_t connection_index,
+                                 uint_fast16_t remote_connection_index,
+                                 int fd)
+    : index_(connection_index), remote_index_(remote_connection_index),
+      fd_(fd) {}
+
+UringConnection::~UringConnection() {
+  // complete receive requests still pending on the socket
+  ::shutdown(fd_, SHUT_RDWR);
+  ::close(fd_);
+}
+
+} // namespace tl_uring
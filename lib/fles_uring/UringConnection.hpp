@@ -0,0 +1,67 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <cstdint>
+
+namespace tl_uring {
+
+/// io_uring connection base class.
+/** A UringConnection object represents the endpoint of a single TCP
+    timeslice building connection driven by an io_uring. */
+
+class UringConnection {
+public:
+  /// The UringConnection constructor, takes ownership of a connected
+  /// socket.
+  UringConnection(uint_fast16_t connection_index,
+                  uint_fast16_t remote_connection_index,
+                  int fd);
+
+  UringConnection(const UringConnection&) = delete;
+  UringConnection& operator=(const UringConnection&) = delete;
+
+  /// The UringConnection destructor.
+  virtual ~UringConnection();
+
+  /// Retrieve index of this connection in the local connection group.
+  uint_fast16_t index() const { return index_; }
+
+  /// Retrieve the connected socket.
+  int fd() const { return fd_; }
+
+  /// Check if the connection has been finalized.
+  bool done() const { return done_; }
+
+  /// Retrieve the total number of bytes transmitted.
+  uint64_t total_bytes_sent() const { return total_bytes_sent_; }
+
+  /// Retrieve the total number of SEND requests.
+  uint64_t total_send_requests() const { return total_send_requests_; }
+
+  /// Retrieve the total number of RECV requests.
+  uint64_t total_recv_requests() const { return total_recv_requests_; }
+
+protected:
+  /// Index of this connection in the local group of connections.
+  uint_fast16_t index_;
+
+  /// Index of this connection in the remote group of connections.
+  uint_fast16_t remote_index_;
+
+  /// The connected TCP socket.
+  int fd_;
+
+  /// Flag indicating connection finished state.
+  bool done_ = false;
+
+  /// Total number of bytes transmitted.
+  uint64_t total_bytes_sent_ = 0;
+
+  /// Total number of SEND requests.
+  uint64_t total_send_requests_ = 0;
+
+  /// Total number of RECV requests.
+  uint64_t total_recv_requests_ = 0;
+};
+
+} // namespace tl_uring
@@ -0,0 +1,145 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include "ConnectionGroupWorker.hpp"
+#include "IoUring.hpp"
+#include "Metrics.hpp"
+#include "UringException.hpp"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace tl_uring {
+
+/// io_uring connection group base class.
+/** A UringConnectionGroup object represents a group of TCP connections
+    that are driven by the same io_uring instance. */
+
+template <typename CONNECTION>
+class UringConnectionGroup : public ConnectionGroupWorker {
+public:
+  /// The UringConnectionGroup default constructor.
+  UringConnectionGroup() : ring_(new IoUring(ring_entries_)) {}
+
+  UringConnectionGroup(const UringConnectionGroup&) = delete;
+  UringConnectionGroup& operator=(const UringConnectionGroup&) = delete;
+
+  /// The UringConnectionGroup default destructor.
+  ~UringConnectionGroup() override {
+    // tear down the ring first, pending requests refer to connection
+    // buffers
+    ring_ = nullptr;
+  }
+
+  /// The completion queue handler. Submits prepared requests and handles
+  /// all completions available.
+  int poll_completion() {
+    ring_->submit();
+
+    int ne_total = 0;
+    io_uring_cqe* cqe;
+    while (ne_total < 1000 && (cqe = ring_->peek_cqe()) != nullptr) {
+      io_uring_cqe c = *cqe;
+      ring_->cqe_seen();
+      ++ne_total;
+      on_completion(c);
+    }
+
+    cq_polls_metric_.add();
+    if (ne_total > 0) {
+      cq_completions_metric_.add(static_cast<uint64_t>(ne_total));
+      cq_batch_metric_.record(static_cast<uint64_t>(ne_total));
+    }
+
+    return ne_total;
+  }
+
+  /// Block until a completion is available or the timeout expires. Used
+  /// when a run loop cycle found nothing to do.
+  void wait_completion(std::chrono::microseconds timeout) {
+    ring_->submit_and_wait(timeout);
+  }
+
+  size_t size() const { return conn_.size(); }
+
+  /// Retrieve the total number of bytes transmitted.
+  uint64_t aggregate_bytes_sent() const {
+    uint64_t sum = 0;
+    for (auto& c : conn_) {
+      sum += c->total_bytes_sent();
+    }
+    return sum;
+  }
+
+  /// Retrieve the total number of SEND requests.
+  uint64_t aggregate_send_requests() const {
+    uint64_t sum = 0;
+    for (auto& c : conn_) {
+      sum += c->total_send_requests();
+    }
+    return sum;
+  }
+
+  /// Retrieve the total number of RECV requests.
+  uint64_t aggregate_recv_requests() const {
+    uint64_t sum = 0;
+    for (auto& c : conn_) {
+      sum += c->total_recv_requests();
+    }
+    return sum;
+  }
+
+  void summary() const {
+    double runtime = std::chrono::duration_cast<std::chrono::microseconds>(
+                         time_end_ - time_begin_)
+                         .count();
+    uint64_t bytes_sent = aggregate_bytes_sent();
+    L_(info) << "summary: " << aggregate_send_requests() << " SEND, "
+             << aggregate_recv_requests() << " RECV requests";
+    double rate = static_cast<double>(bytes_sent) / runtime;
+    L_(info) << "summary: " << human_readable_count(bytes_sent) << " sent in "
+             << runtime / 1000000. << " s (" << rate << " MB/s)";
+  }
+
+protected:
+  /// Completion notification event dispatcher. Called by the event loop.
+  virtual void on_completion(const io_uring_cqe& cqe) = 0;
+
+  /// Number of submission queue entries of the ring.
+  static constexpr unsigned int ring_entries_ = 4096;
+
+  /// Vector of associated connection objects.
+  std::vector<std::unique_ptr<CONNECTION>> conn_;
+
+  /// The io_uring instance shared by all connections.
+  std::unique_ptr<IoUring> ring_;
+
+  /// Number of established connections
+  unsigned int connected_ = 0;
+
+  /// Number of connections in the done state.
+  unsigned int connections_done_ = 0;
+
+  /// Flag causing termination of completion handler.
+  bool all_done_ = false;
+
+  std::chrono::high_resolution_clock::time_point time_begin_;
+
+  std::chrono::high_resolution_clock::time_point time_end_;
+
+  Scheduler scheduler_;
+
+private:
+  /// Exported completion queue statistics
+  MetricsCounter& cq_polls_metric_ = MetricsRegistry::instance().counter(
+      "flesnet_cq_polls_total", "Completion queue polls",
+      "transport=\"iouring\"");
+  MetricsCounter& cq_completions_metric_ = MetricsRegistry::instance().counter(
+      "flesnet_cq_completions_total", "Completions read from the queues",
+      "transport=\"iouring\"");
+  MetricsHistogram& cq_batch_metric_ = MetricsRegistry::instance().histogram(
+      "flesnet_cq_batch_size", "Completions handled per non-empty poll",
+      "transport=\"iouring\"");
+};
+
+} // namespace tl_uring
@@ -0,0 +1,19 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <stdexcept>
+
+namespace tl_uring {
+
+/// io_uring transport exception class.
+/** A UringException object signals an error that occured in the io_uring
+    transport functions (ring setup, sockets, failed transfers). */
+
+class UringException : public std::runtime_error {
+public:
+  /// The UringException default constructor.
+  explicit UringException(const std::string& what_arg = "")
+      : std::runtime_error(what_arg) {}
+};
+
+} // namespace tl_uring
@@ -0,0 +1,24 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <cstdint>
+
+/// Envelope of a timeslice component sent from an input to a compute node.
+/** The header part is followed by desc_parts message parts holding the
+    microslice descriptors and data_parts parts holding the microslice
+    data. A range that wraps around the input ring buffer is sent as two
+    parts, so each range has one or two parts. If both part counts are
+    zero, the desc_size + data_size bytes of the component follow on the
+    data channel of the compute node instead. If that channel fails, the
+    input acknowledges the component as dropped and the compute node
+    delivers it empty. */
+struct ComponentReplyHeader {
+  /// Maximum number of message parts of a single range.
+  static constexpr uint32_t max_range_parts = 2;
+
+  uint64_t ts;
+  uint32_t desc_parts;
+  uint32_t data_parts;
+  uint64_t desc_size;
+  uint64_t data_size;
+};
@@ -5,6 +5,7 @@
 #include "Utility.hpp"
 #include "log.hpp"
 #include <algorithm>
+#include <stdexcept>
 
 ComponentSenderZeromq::ComponentSenderZeromq(
     uint64_t input_index,
@@ -19,25 +20,39 @@ ComponentSenderZeromq::ComponentSenderZeromq(
       timeslice_size_(timeslice_size), overlap_size_(overlap_size),
       max_timeslice_number_(max_timeslice_number),
       signal_status_(signal_status),
-      min_acked_({data_source.desc_buffer().size() / 4,
-                  data_source.data_buffer().size() / 4}) {
-  start_index_ = sent_ = acked_ = cached_acked_ = data_source.get_read_index();
-
-  size_t min_ack_buffer_size =
-      (data_source_.desc_buffer().size() / timeslice_size_ + 1) * 2;
-  ack_.alloc_with_size(min_ack_buffer_size);
-
-  socket_ = zmq_socket(zmq_context, ZMQ_REP);
+      send_buffer_(data_source, timeslice_size, 2),
+      desc_metrics_("input_desc",
+                    metrics_labels("zeromq", "input", input_index)),
+      data_metrics_("input_data",
+                    metrics_labels("zeromq", "input", input_index)),
+      latency_tracer_(LatencyTracer::Role::input, "zeromq", input_index) {
+  ack_pool_.alloc_with_size(
+      (data_source_.desc_buffer().size() / timeslice_size_ + 1) * 2);
+
+  socket_ = zmq_socket(zmq_context, ZMQ_ROUTER);
   assert(socket_);
   int timeout_ms = 500;
   [[maybe_unused]] int rc =
-      zmq_setsockopt(socket_, ZMQ_RCVTIMEO, &timeout_ms, sizeof timeout_ms);
+      zmq_setsockopt(socket_, ZMQ_SNDTIMEO, &timeout_ms, sizeof timeout_ms);
   assert(rc == 0);
-  rc = zmq_setsockopt(socket_, ZMQ_SNDTIMEO, &timeout_ms, sizeof timeout_ms);
+  // report full or vanished peers instead of silently dropping replies
+  int mandatory = 1;
+  rc = zmq_setsockopt(socket_, ZMQ_ROUTER_MANDATORY, &mandatory,
+                      sizeof mandatory);
   assert(rc == 0);
 
   rc = zmq_bind(socket_, listen_address.c_str());
   assert(rc == 0);
+
+  // remote compute nodes receive the timeslice data on a plain TCP stream
+  if (listen_address.compare(0, 6, "tcp://") == 0) {
+    try {
+      listener_ = std::make_unique<DataChannelListener>();
+    } catch (std::runtime_error& e) {
+      L_(warning) << "[i" << input_index_ << "] " << e.what()
+                  << ", sending data as messages";
+    }
+  }
 }
 
 ComponentSenderZeromq::~ComponentSenderZeromq() {
@@ -49,7 +64,8 @@ ComponentSenderZeromq::~ComponentSenderZeromq() {
 
 void ComponentSenderZeromq::operator()() {
   run_begin();
-  while (acked_ts2_ / 2 < max_timeslice_number_ && *signal_status_ == 0) {
+  while (send_buffer_.acked_timeslices() < max_timeslice_number_ &&
+         *signal_status_ == 0) {
     run_cycle();
     scheduler_.timer();
   }
@@ -63,79 +79,226 @@ void ComponentSenderZeromq::run_begin() {
 }
 
 bool ComponentSenderZeromq::run_cycle() {
-  zmq_msg_t request;
-  [[maybe_unused]] int rc = zmq_msg_init(&request);
-  assert(rc == 0);
-
-  int len = zmq_msg_recv(&request, socket_, 0);
-  if (len == -1 && errno == EAGAIN) {
-    // timeout reached
-    return true;
+  poll_items_.clear();
+  poll_items_.push_back({socket_, 0, ZMQ_POLLIN, 0});
+  if (listener_) {
+    poll_items_.push_back({nullptr, listener_->fd(), ZMQ_POLLIN, 0});
+  }
+  for (auto& pc : channels_) {
+    if (!pc.second.transfers.empty()) {
+      poll_items_.push_back(
+          {nullptr, pc.second.channel->fd(), ZMQ_POLLOUT, 0});
+    }
   }
-  assert(len != -1);
 
-  assert(len == sizeof(uint64_t));
-  uint64_t timeslice = *static_cast<uint64_t*>(zmq_msg_data(&request));
-  zmq_msg_close(&request);
+  // while requests are pending, wake up frequently to check for new data
+  long timeout_ms = pending_requests_.empty() ? 500 : 1;
+  int rc = zmq_poll(poll_items_.data(), static_cast<int>(poll_items_.size()),
+                    timeout_ms);
+  if (rc > 0) {
+    if ((poll_items_[0].revents & ZMQ_POLLIN) != 0) {
+      receive_requests();
+    }
+    if (listener_ && (poll_items_[1].revents & ZMQ_POLLIN) != 0) {
+      accept_data_channel();
+    }
+  }
 
-  try_send_timeslice(timeslice);
   data_source_.proceed();
+  answer_pending_requests();
+  flush_data_channels();
+
+  return true;
+}
+
+void ComponentSenderZeromq::receive_requests() {
+  while (true) {
+    // part 1: peer routing id
+    zmq_msg_t peer;
+    [[maybe_unused]] int rc = zmq_msg_init(&peer);
+    assert(rc == 0);
+    if (zmq_msg_recv(&peer, socket_, ZMQ_DONTWAIT) == -1) {
+      assert(errno == EAGAIN);
+      zmq_msg_close(&peer);
+      return;
+    }
+    assert(zmq_msg_more(&peer));
+    std::string peer_id(static_cast<char*>(zmq_msg_data(&peer)),
+                        zmq_msg_size(&peer));
+    zmq_msg_close(&peer);
+
+    // part 2: requested timeslice, or empty for a data channel request
+    uint64_t timeslice;
+    int len = zmq_recv(socket_, &timeslice, sizeof(timeslice), 0);
+    if (len == 0) {
+      offer_data_channel(peer_id);
+      continue;
+    }
+    assert(len == sizeof(uint64_t));
+    assert(timeslice >= send_buffer_.acked_timeslices());
+    pending_requests_.emplace(timeslice, std::move(peer_id));
+  }
+}
+
+void ComponentSenderZeromq::offer_data_channel(const std::string& peer) {
+  DataChannelOffer offer{0, 0};
+  if (listener_) {
+    offer = {next_token_++, listener_->port()};
+    offered_channels_[offer.token] = peer;
+  }
+
+  zmq_msg_t peer_msg;
+  zmq_msg_init_size(&peer_msg, peer.size());
+  std::copy_n(peer.data(), peer.size(),
+              static_cast<char*>(zmq_msg_data(&peer_msg)));
+  bool routed = true;
+  send_part(&peer_msg, ZMQ_SNDMORE, routed);
+  zmq_msg_t offer_msg;
+  zmq_msg_init_size(&offer_msg, sizeof(offer));
+  *static_cast<DataChannelOffer*>(zmq_msg_data(&offer_msg)) = offer;
+  send_part(&offer_msg, 0, routed);
+}
+
+void ComponentSenderZeromq::accept_data_channel() {
+  uint64_t token = 0;
+  std::unique_ptr<DataChannel> channel;
+  try {
+    channel = listener_->accept(token);
+  } catch (std::runtime_error& e) {
+    L_(warning) << "[i" << input_index_ << "] " << e.what();
+    return;
+  }
+
+  auto offered = offered_channels_.find(token);
+  if (offered == offered_channels_.end()) {
+    L_(warning) << "[i" << input_index_
+                << "] data channel with unknown token rejected";
+    return;
+  }
+  if (channels_.count(offered->second) != 0) {
+    L_(warning) << "[i" << input_index_
+                << "] duplicate data channel rejected";
+  } else {
+    L_(debug) << "[i" << input_index_ << "] data channel " << token
+              << " connected";
+    channels_[offered->second].channel = std::move(channel);
+  }
+  offered_channels_.erase(offered);
+}
+
+void ComponentSenderZeromq::flush_data_channels() {
+  for (auto it = channels_.begin(); it != channels_.end();) {
+    if (flush_data_channel(it->second)) {
+      ++it;
+      continue;
+    }
+    L_(warning) << "[i" << input_index_ << "] "
+                << it->second.transfers.size()
+                << " timeslices dropped, data channel failed";
+    for (auto& transfer : it->second.transfers) {
+      ack_timeslice(transfer.ts, false);
+      ack_timeslice(transfer.ts, true);
+    }
+    it = channels_.erase(it);
+  }
+}
 
+bool ComponentSenderZeromq::flush_data_channel(PeerChannel& pc) {
+  try {
+    while (!pc.transfers.empty()) {
+      Transfer& transfer = pc.transfers.front();
+      int first = 0;
+      while (first < transfer.iovcnt && transfer.iov[first].iov_len == 0) {
+        ++first;
+      }
+      if (first < transfer.iovcnt) {
+        size_t n = pc.channel->send(&transfer.iov[first],
+                                    transfer.iovcnt - first);
+        for (int i = first; i < transfer.iovcnt && n > 0; ++i) {
+          size_t chunk = std::min(n, transfer.iov[i].iov_len);
+          transfer.iov[i].iov_base =
+              static_cast<uint8_t*>(transfer.iov[i].iov_base) + chunk;
+          transfer.iov[i].iov_len -= chunk;
+          n -= chunk;
+        }
+        if (transfer.iov[transfer.iovcnt - 1].iov_len != 0) {
+          // socket buffer full
+          return true;
+        }
+      }
+      // the data has been copied to the socket buffer
+      ack_timeslice(transfer.ts, false);
+      ack_timeslice(transfer.ts, true);
+      pc.transfers.pop_front();
+    }
+  } catch (std::runtime_error& e) {
+    L_(warning) << "[i" << input_index_ << "] " << e.what();
+    return false;
+  }
   return true;
 }
 
+void ComponentSenderZeromq::answer_pending_requests() {
+  // timeslices become available in order, so stop at the first missing one
+  while (!pending_requests_.empty() &&
+         timeslice_available(pending_requests_.begin()->first)) {
+    auto request = pending_requests_.begin();
+    send_timeslice(request->second, request->first);
+    pending_requests_.erase(request);
+  }
+}
+
 void ComponentSenderZeromq::run_end() {
   sync_data_source();
   time_end_ = std::chrono::high_resolution_clock::now();
 }
 
-struct Acknowledgment {
-  ComponentSenderZeromq* server;
-  uint64_t timeslice;
-  bool is_data;
-};
-
 void free_ts(void* /* data */, void* hint) {
   assert(hint);
-  auto* ack = static_cast<Acknowledgment*>(hint);
-  ack->server->ack_timeslice(ack->timeslice, ack->is_data);
-  delete ack;
+  auto* ack = static_cast<ComponentSenderZeromq::Acknowledgment*>(hint);
+  // a wrapped range is acknowledged when both of its parts are released
+  if (ack->parts.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    ack->server->ack_timeslice(ack->timeslice, ack->is_data);
+  }
 }
 
-bool ComponentSenderZeromq::try_send_timeslice(uint64_t ts) {
-  assert(ts >= acked_ts2_ / 2);
-
-  uint64_t desc_offset = ts * timeslice_size_ + start_index_.desc;
-  uint64_t desc_length = timeslice_size_ + overlap_size_;
-
-  // check if complete timeslice is available in the input buffer
-  if (write_index_desc_ < desc_offset + desc_length) {
-    data_source_.proceed();
+bool ComponentSenderZeromq::timeslice_available(uint64_t ts) {
+  uint64_t desc_end = (ts + 1) * timeslice_size_ +
+                      send_buffer_.start_index().desc +
+                      overlap_size_;
+  if (write_index_desc_ < desc_end) {
     write_index_desc_ = data_source_.get_write_index().desc;
-    if (write_index_desc_ < desc_offset + desc_length) {
-      // send empty message
-      zmq_msg_t msg;
-      zmq_msg_init_size(&msg, 0);
-      int rc;
-      do {
-        rc = zmq_msg_send(&msg, socket_, 0);
-      } while (rc == -1 && errno == EAGAIN && *signal_status_ == 0);
-      return false;
-    }
   }
+  return write_index_desc_ >= desc_end;
+}
 
-  // part 1: descriptors
-  if (desc_offset + desc_length > sent_.desc) {
-    sent_.desc = desc_offset + desc_length;
+void ComponentSenderZeromq::send_part(zmq_msg_t* msg,
+                                      int flags,
+                                      bool& routed) {
+  int rc = -1;
+  if (routed) {
+    do {
+      rc = zmq_msg_send(msg, socket_, flags);
+    } while (rc == -1 && errno == EAGAIN && *signal_status_ == 0);
   }
-  auto desc_msg = create_message(data_source_.desc_buffer(), desc_offset,
-                                 desc_length, ts, false);
-  int rc;
-  do {
-    rc = zmq_msg_send(&desc_msg, socket_, ZMQ_SNDMORE);
-  } while (rc == -1 && errno == EAGAIN && *signal_status_ == 0);
-
-  // part 2: data
+  if (rc == -1) {
+    // the message is still ours, release it to acknowledge its data
+    zmq_msg_close(msg);
+    routed = false;
+  }
+}
+
+void ComponentSenderZeromq::send_timeslice(const std::string& peer,
+                                           uint64_t ts) {
+  assert(ts >= send_buffer_.acked_timeslices());
+
+  uint64_t desc_offset =
+      ts * timeslice_size_ + send_buffer_.start_index().desc;
+  uint64_t desc_length = timeslice_size_ + overlap_size_;
+
+  latency_tracer_.mark(ts, LatencyTracer::available);
+  latency_tracer_.mark(ts, LatencyTracer::posted);
+
   uint64_t data_offset = data_source_.desc_buffer().at(desc_offset).offset;
   uint64_t data_end =
       data_source_.desc_buffer().at(desc_offset + desc_length - 1).offset +
@@ -143,81 +306,132 @@ bool ComponentSenderZeromq::try_send_timeslice(uint64_t ts) {
   assert(data_end >= data_offset);
   uint64_t data_length = data_end - data_offset;
 
-  if (data_offset + data_length > sent_.data) {
-    sent_.data = data_offset + data_length;
+  // requests may be answered out of order
+  DualIndex sent = send_buffer_.sent();
+  sent.desc = std::max(sent.desc, desc_offset + desc_length);
+  sent.data = std::max(sent.data, data_end);
+  send_buffer_.mark_sent(sent);
+
+  // the data follows either on the data channel or as message parts
+  auto pc = channels_.find(peer);
+  bool direct = pc != channels_.end();
+  ComponentReplyHeader header{
+      ts, 0, 0, desc_length * sizeof(fles::MicrosliceDescriptor),
+      data_length};
+  zmq_msg_t desc_msgs[ComponentReplyHeader::max_range_parts];
+  zmq_msg_t data_msgs[ComponentReplyHeader::max_range_parts];
+  if (!direct) {
+    header.desc_parts =
+        create_messages(data_source_.desc_buffer(), desc_offset, desc_length,
+                        ts, false, desc_msgs);
+    header.data_parts =
+        create_messages(data_source_.data_buffer(), data_offset, data_length,
+                        ts, true, data_msgs);
   }
-  auto data_msg = create_message(data_source_.data_buffer(), data_offset,
-                                 data_length, ts, true);
-  do {
-    rc = zmq_msg_send(&data_msg, socket_, 0);
-  } while (rc == -1 && errno == EAGAIN && *signal_status_ == 0);
 
-  return true;
+  // envelope: peer routing id and reply header
+  zmq_msg_t peer_msg;
+  zmq_msg_init_size(&peer_msg, peer.size());
+  std::copy_n(peer.data(), peer.size(),
+              static_cast<char*>(zmq_msg_data(&peer_msg)));
+  bool routed = true;
+  send_part(&peer_msg, ZMQ_SNDMORE, routed);
+  zmq_msg_t header_msg;
+  zmq_msg_init_size(&header_msg, sizeof(ComponentReplyHeader));
+  *static_cast<ComponentReplyHeader*>(zmq_msg_data(&header_msg)) = header;
+  send_part(&header_msg, direct ? 0 : ZMQ_SNDMORE, routed);
+
+  // part 1: descriptors, part 2: data
+  for (uint32_t i = 0; i < header.desc_parts; ++i) {
+    send_part(&desc_msgs[i], ZMQ_SNDMORE, routed);
+  }
+  for (uint32_t i = 0; i < header.data_parts; ++i) {
+    send_part(&data_msgs[i], i + 1 < header.data_parts ? ZMQ_SNDMORE : 0,
+              routed);
+  }
+
+  if (direct && routed) {
+    Transfer transfer{ts, {}, 0};
+    add_chunks(transfer, data_source_.desc_buffer(), desc_offset,
+               desc_length);
+    add_chunks(transfer, data_source_.data_buffer(), data_offset,
+               data_length);
+    pc->second.transfers.push_back(transfer);
+  } else if (direct) {
+    ack_timeslice(ts, false);
+    ack_timeslice(ts, true);
+  }
+  if (!routed) {
+    L_(warning) << "[i" << input_index_ << "] timeslice " << ts
+                << " dropped, compute node unreachable";
+  }
+  latency_tracer_.mark(ts, LatencyTracer::written);
 }
 
 template <typename T_>
-zmq_msg_t ComponentSenderZeromq::create_message(RingBufferView<T_>& buf,
+uint32_t ComponentSenderZeromq::create_messages(RingBufferView<T_>& buf,
                                                 uint64_t offset,
                                                 uint64_t length,
                                                 uint64_t ts,
-                                                bool is_data) {
-  zmq_msg_t msg;
-
+                                                bool is_data,
+                                                zmq_msg_t* msgs) {
   if (length == 0) {
     // zero chunks
-    zmq_msg_init_size(&msg, 0);
+    zmq_msg_init_size(&msgs[0], 0);
     ack_timeslice(ts, is_data);
-  } else if ((offset & buf.size_mask()) <=
-             ((offset + length - 1) & buf.size_mask())) {
+    return 1;
+  }
+
+  Acknowledgment& ack = ack_pool_.at(ts * 2 + (is_data ? 1 : 0));
+  ack.server = this;
+  ack.timeslice = ts;
+  ack.is_data = is_data;
+
+  if ((offset & buf.size_mask()) <= ((offset + length - 1) & buf.size_mask())) {
     // one chunk
-    auto* data = &buf.at(offset);
-    size_t bytes = sizeof(T_) * length;
-    auto* hint = new Acknowledgment{this, ts, is_data};
-    zmq_msg_init_data(&msg, data, bytes, free_ts, hint);
-  } else {
-    // two chunks
-    auto* data1 = &buf.at(offset);
-    size_t size1 = buf.size() - (offset & buf.size_mask());
-    auto* data2 = buf.ptr();
-    size_t size2 = length - buf.size() + (offset & buf.size_mask());
-    zmq_msg_init_size(&msg, (size1 + size2) * sizeof(T_));
-    auto msg_buf = static_cast<T_*>(zmq_msg_data(&msg));
-    std::copy_n(data1, size1, msg_buf);
-    std::copy_n(data2, size2, msg_buf + size1);
-    ack_timeslice(ts, is_data);
+    ack.parts.store(1, std::memory_order_relaxed);
+    zmq_msg_init_data(&msgs[0], &buf.at(offset), sizeof(T_) * length, free_ts,
+                      &ack);
+    return 1;
   }
 
-  return msg;
+  // two chunks, sent as two parts to avoid copying
+  size_t size1 = buf.size() - (offset & buf.size_mask());
+  size_t size2 = length - size1;
+  ack.parts.store(2, std::memory_order_relaxed);
+  zmq_msg_init_data(&msgs[0], &buf.at(offset), sizeof(T_) * size1, free_ts,
+                    &ack);
+  zmq_msg_init_data(&msgs[1], buf.ptr(), sizeof(T_) * size2, free_ts, &ack);
+  return 2;
+}
+
+template <typename T_>
+void ComponentSenderZeromq::add_chunks(Transfer& transfer,
+                                       RingBufferView<T_>& buf,
+                                       uint64_t offset,
+                                       uint64_t length) {
+  if (length == 0) {
+    return;
+  }
+  uint64_t size1 =
+      std::min(length, buf.size() - (offset & buf.size_mask()));
+  transfer.iov[transfer.iovcnt++] = {&buf.at(offset), sizeof(T_) * size1};
+  if (size1 < length) {
+    transfer.iov[transfer.iovcnt++] = {buf.ptr(),
+                                       sizeof(T_) * (length - size1)};
+  }
 }
 
 void ComponentSenderZeromq::ack_timeslice(uint64_t ts, bool is_data) {
-  // use ts2 and acked_ts2_ to handle desc and data sequentially
-  uint64_t ts2 = ts * 2 + (is_data ? 1 : 0);
-  assert(ts2 >= acked_ts2_);
-  if (ts2 != acked_ts2_) {
-    // transmission has been reordered, store completion information
-    ack_.at(ts2) = ts2;
-  } else {
-    // completion is for earliest pending timeslice, update indices
-    do {
-      ++acked_ts2_;
-    } while (ack_.at(acked_ts2_) > ts2);
-    acked_.desc = acked_ts2_ / 2 * timeslice_size_ + start_index_.desc;
-    acked_.data = data_source_.desc_buffer().at(acked_.desc - 1).offset +
-                  data_source_.desc_buffer().at(acked_.desc - 1).size;
-    if (acked_.data >= cached_acked_.data + min_acked_.data ||
-        acked_.desc >= cached_acked_.desc + min_acked_.desc) {
-      cached_acked_ = acked_;
-      data_source_.set_read_index(cached_acked_);
-    }
+  if (is_data) {
+    latency_tracer_.mark(ts, LatencyTracer::released);
   }
+  // desc and data are acknowledged as two parts of the timeslice
+  send_buffer_.acknowledge(ts, is_data ? 1 : 0);
 }
 
 void ComponentSenderZeromq::sync_data_source() {
-  if (acked_.data > cached_acked_.data || acked_.desc > cached_acked_.desc) {
-    cached_acked_ = acked_;
-    data_source_.set_read_index(cached_acked_);
-  }
+  send_buffer_.sync_data_source();
 }
 
 void ComponentSenderZeromq::report_status() {
@@ -225,20 +439,8 @@ void ComponentSenderZeromq::report_status() {
 
   std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
 
-  DualIndex written = data_source_.get_write_index();
-
-  SendBufferStatus status_desc{now,
-                               data_source_.desc_buffer().size(),
-                               cached_acked_.desc,
-                               acked_.desc,
-                               sent_.desc,
-                               written.desc};
-  SendBufferStatus status_data{now,
-                               data_source_.data_buffer().size(),
-                               cached_acked_.data,
-                               acked_.data,
-                               sent_.data,
-                               written.data};
+  SendBufferStatus status_desc = send_buffer_.status_desc(now);
+  SendBufferStatus status_data = send_buffer_.status_data(now);
 
   double delta_t =
       std::chrono::duration<double, std::chrono::seconds::period>(
@@ -269,6 +471,13 @@ void ComponentSenderZeromq::report_status() {
            << human_readable_count(rate_data, true, "B/s") << " ("
            << human_readable_count(rate_desc, true, "Hz") << ")";
 
+  desc_metrics_.update(status_desc.used(), status_desc.sending(),
+                       status_desc.freeing(), status_desc.size,
+                       status_desc.acked - send_buffer_.start_index().desc);
+  data_metrics_.update(status_data.used(), status_data.sending(),
+                       status_data.freeing(), status_data.size,
+                       status_data.acked - send_buffer_.start_index().data);
+
   previous_send_buffer_status_desc_ = status_desc;
   previous_send_buffer_status_data_ = status_data;
 
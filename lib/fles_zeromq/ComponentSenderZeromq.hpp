@@ -1,12 +1,22 @@
 // Copyright 2012-2013, 2016 Jan de Cuveland <cmail@cuveland.de>
 #pragma once
 
+#include "ComponentReplyHeader.hpp"
+#include "DataChannel.hpp"
 #include "DualRingBuffer.hpp"
+#include "LatencyTracer.hpp"
+#include "Metrics.hpp"
 #include "RingBuffer.hpp"
 #include "Scheduler.hpp"
-#include <boost/format.hpp>
+#include "SendBufferTracker.hpp"
+#include <atomic>
 #include <cassert>
 #include <csignal>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 #include <zmq.h>
 
 /// Input buffer and compute node connection container class.
@@ -56,26 +66,59 @@ private:
   /// Pointer to global signal status variable.
   volatile sig_atomic_t* signal_status_;
 
-  /// ZeroMQ socket.
+  /// ZeroMQ socket (ROUTER, one peer per compute node).
   void* socket_;
 
-  /// Buffer to store acknowledged status of timeslices.
-  RingBuffer<uint64_t, true> ack_;
+  /// Timeslice requests that cannot be answered yet <timeslice, peer id>.
+  /** A compute node keeps several requests outstanding; each one is
+      answered as soon as its timeslice is complete in the input buffer. */
+  std::multimap<uint64_t, std::string> pending_requests_;
 
-  /// Number of acknowledged timeslices (times two - desc and data).
-  uint64_t acked_ts2_ = 0;
+  /// Listener for the data channels of the compute nodes (TCP only).
+  std::unique_ptr<DataChannelListener> listener_;
 
-  /// Indexes of acknowledged microslices (i.e., read indexes).
-  DualIndex acked_;
+  /// Tokens of offered but not yet connected data channels <token, peer>.
+  std::map<uint64_t, std::string> offered_channels_;
 
-  /// Hysteresis for writing read indexes to data source.
-  const DualIndex min_acked_;
+  /// Token handed out with the next data channel offer.
+  uint64_t next_token_ = 1;
 
-  /// Read indexes last written to data source.
-  DualIndex cached_acked_;
+  /// Timeslice component being written to a data channel.
+  struct Transfer {
+    uint64_t ts;
+    /// Remaining descriptor and data chunks (at most two each).
+    iovec iov[2 * ComponentReplyHeader::max_range_parts];
+    int iovcnt;
+  };
+
+  /// Data channel to a compute node with its queue of transfers.
+  struct PeerChannel {
+    std::unique_ptr<DataChannel> channel;
+    std::deque<Transfer> transfers;
+  };
 
-  /// Read indexes at start of operation.
-  DualIndex start_index_;
+  /// Connected data channels <peer id, channel>.
+  std::map<std::string, PeerChannel> channels_;
+
+  /// Poll items of the socket, the listener and the data channels.
+  std::vector<zmq_pollitem_t> poll_items_;
+
+  /// Sent, acknowledged and released positions in the input buffer.
+  SendBufferTracker send_buffer_;
+
+  /// Release notification of a zero-copy message range.
+  struct Acknowledgment {
+    ComponentSenderZeromq* server;
+    uint64_t timeslice;
+    bool is_data;
+    /// Message parts of the range not yet released by ZeroMQ.
+    std::atomic<uint32_t> parts{0};
+  };
+
+  /// Preallocated acknowledgments, indexed by timeslice and part. An entry
+  /// is reused only after its timeslice has been acknowledged, because the
+  /// acknowledgment buffer covers the whole input buffer.
+  RingBuffer<Acknowledgment> ack_pool_;
 
   /// Write index received from data source.
   uint64_t write_index_desc_ = 0;
@@ -86,64 +129,16 @@ private:
   /// End of operation (for performance statistics).
   std::chrono::high_resolution_clock::time_point time_end_;
 
-  /// Amount of data sent (for performance statistics).
-  DualIndex sent_;
-
-  struct SendBufferStatus {
-    std::chrono::system_clock::time_point time;
-    uint64_t size;
-
-    uint64_t cached_acked;
-    uint64_t acked;
-    uint64_t sent;
-    uint64_t written;
-
-    int64_t used() const {
-      assert(sent <= written);
-      return written - sent;
-    }
-    int64_t sending() const {
-      assert(acked <= sent);
-      return sent - acked;
-    }
-    int64_t freeing() const {
-      assert(cached_acked <= acked);
-      return acked - cached_acked;
-    }
-    int64_t unused() const {
-      assert(written <= cached_acked + size);
-      return cached_acked + size - written;
-    }
-
-    float percentage(int64_t value) const {
-      return static_cast<float>(value) / static_cast<float>(size);
-    }
-
-    static std::string caption() {
-      return std::string("used/sending/freeing/free");
-    }
-
-    std::string percentage_str(int64_t value) const {
-      boost::format percent_fmt("%4.1f%%");
-      percent_fmt % (percentage(value) * 100);
-      std::string s = percent_fmt.str();
-      s.resize(4);
-      return s;
-    }
-
-    std::string percentages() const {
-      return percentage_str(used()) + " " + percentage_str(sending()) + " " +
-             percentage_str(freeing()) + " " + percentage_str(unused());
-    }
-
-    std::vector<int64_t> vector() const {
-      return std::vector<int64_t>{used(), sending(), freeing(), unused()};
-    }
-  };
-
   SendBufferStatus previous_send_buffer_status_desc_ = SendBufferStatus();
   SendBufferStatus previous_send_buffer_status_data_ = SendBufferStatus();
 
+  /// Exported fill levels of the input buffers.
+  BufferMetrics desc_metrics_;
+  BufferMetrics data_metrics_;
+
+  /// Sampled latencies of the timeslice sending stages.
+  LatencyTracer latency_tracer_;
+
   /// Scheduler for periodic events.
   Scheduler scheduler_;
 
@@ -156,16 +151,54 @@ private:
   /// Cleanup at end of run.
   void run_end();
 
+  /// Queue all timeslice requests waiting in the socket.
+  void receive_requests();
+
+  /// Answer a data channel request of a compute node.
+  void offer_data_channel(const std::string& peer);
+
+  /// Accept a data channel connection of a compute node.
+  void accept_data_channel();
+
+  /// Write the queued transfers of all data channels as far as possible.
+  /** A failed data channel is removed and its transfers are acknowledged,
+      the affected timeslices are lost. */
+  void flush_data_channels();
+
+  /// Write queued transfers to a data channel as far as possible, return
+  /// false if the channel failed.
+  bool flush_data_channel(PeerChannel& pc);
+
+  /// Answer the pending requests of the timeslices that became available.
+  void answer_pending_requests();
+
+  /// Check whether a timeslice is complete in the input buffer.
+  bool timeslice_available(uint64_t ts);
+
   /// The central function for distributing timeslice data.
-  bool try_send_timeslice(uint64_t ts);
+  void send_timeslice(const std::string& peer, uint64_t ts);
+
+  /// Send a message part, retrying while the socket is busy. Once a part
+  /// fails (e.g., the compute node is gone), the remaining parts of the
+  /// message are released instead.
+  void send_part(zmq_msg_t* msg, int flags, bool& routed);
 
-  /// Create zeromq message part with requested data.
+  /// Create zero-copy zeromq message parts with requested data, two parts
+  /// if the range wraps around the buffer. Returns the number of parts.
   template <typename T_>
-  zmq_msg_t create_message(RingBufferView<T_>& buf,
+  uint32_t create_messages(RingBufferView<T_>& buf,
                            uint64_t offset,
                            uint64_t length,
                            uint64_t ts,
-                           bool is_data);
+                           bool is_data,
+                           zmq_msg_t* msgs);
+
+  /// Append the chunks of a ring buffer range to a transfer.
+  template <typename T_>
+  void add_chunks(Transfer& transfer,
+                  RingBufferView<T_>& buf,
+                  uint64_t offset,
+                  uint64_t length);
 
   /// Update read indexes after timeslice has been sent.
   void ack_timeslice(uint64_t ts, bool is_data);
@@ -0,0 +1,144 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#include "DataChannel.hpp"
+#include "System.hpp"
+#include <cerrno>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+std::runtime_error channel_error(const std::string& what) {
+  return std::runtime_error("data channel: " + what + ": " +
+                            fles::system::stringerror(errno));
+}
+
+void set_nodelay(int fd) {
+  // the tail of a component must not wait for more data
+  int on = 1;
+  ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+} // namespace
+
+DataChannel::~DataChannel() { ::close(fd_); }
+
+std::unique_ptr<DataChannel>
+DataChannel::connect(const std::string& host, uint16_t port, uint64_t token) {
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* result = nullptr;
+  int rc = ::getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints,
+                         &result);
+  if (rc != 0) {
+    throw std::runtime_error("data channel: cannot resolve " + host + ": " +
+                             gai_strerror(rc));
+  }
+
+  int fd = -1;
+  for (addrinfo* ai = result; ai != nullptr; ai = ai->ai_next) {
+    fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC,
+                  ai->ai_protocol);
+    if (fd < 0) {
+      continue;
+    }
+    if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+      break;
+    }
+    ::close(fd);
+    fd = -1;
+  }
+  ::freeaddrinfo(result);
+  if (fd < 0) {
+    throw channel_error("cannot connect to " + host + ":" +
+                        std::to_string(port));
+  }
+
+  std::unique_ptr<DataChannel> channel(new DataChannel(fd));
+  set_nodelay(fd);
+  if (::send(fd, &token, sizeof(token), MSG_NOSIGNAL) != sizeof(token)) {
+    throw channel_error("cannot send token");
+  }
+  return channel;
+}
+
+std::size_t DataChannel::send(const iovec* iov, int iovcnt) {
+  msghdr msg{};
+  msg.msg_iov = const_cast<iovec*>(iov);
+  msg.msg_iovlen = static_cast<std::size_t>(iovcnt);
+  ssize_t n;
+  do {
+    n = ::sendmsg(fd_, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+  } while (n < 0 && errno == EINTR);
+  if (n < 0) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      return 0;
+    }
+    throw channel_error("send failed");
+  }
+  return static_cast<std::size_t>(n);
+}
+
+std::size_t DataChannel::receive(void* buf, std::size_t size) {
+  ssize_t n;
+  do {
+    n = ::recv(fd_, buf, size, MSG_DONTWAIT);
+  } while (n < 0 && errno == EINTR);
+  if (n < 0) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      return 0;
+    }
+    throw channel_error("receive failed");
+  }
+  if (n == 0 && size > 0) {
+    throw std::runtime_error("data channel: closed by peer");
+  }
+  return static_cast<std::size_t>(n);
+}
+
+DataChannelListener::DataChannelListener() {
+  fd_ = ::socket(AF_INET6, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd_ < 0) {
+    throw channel_error("socket() failed");
+  }
+  int off = 0;
+  ::setsockopt(fd_, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+
+  sockaddr_in6 addr{};
+  addr.sin6_family = AF_INET6;
+  addr.sin6_addr = in6addr_any;
+  addr.sin6_port = 0;
+  socklen_t addr_len = sizeof(addr);
+  if (::bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+      ::listen(fd_, 16) != 0 ||
+      ::getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &addr_len) !=
+          0) {
+    std::runtime_error error = channel_error("cannot listen");
+    ::close(fd_);
+    throw error;
+  }
+  port_ = ntohs(addr.sin6_port);
+}
+
+DataChannelListener::~DataChannelListener() { ::close(fd_); }
+
+std::unique_ptr<DataChannel> DataChannelListener::accept(uint64_t& token) {
+  int fd = ::accept4(fd_, nullptr, nullptr, SOCK_CLOEXEC);
+  if (fd < 0) {
+    throw channel_error("accept failed");
+  }
+  std::unique_ptr<DataChannel> channel(new DataChannel(fd));
+  set_nodelay(fd);
+  // the compute node sends its token right after connecting
+  ssize_t n;
+  do {
+    n = ::recv(fd, &token, sizeof(token), MSG_WAITALL);
+  } while (n < 0 && errno == EINTR);
+  if (n != sizeof(token)) {
+    throw channel_error("cannot receive token");
+  }
+  return channel;
+}
@@ -0,0 +1,79 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <sys/uio.h>
+
+/// Reply to a data channel request of a compute node.
+/** A port of zero means that the input node offers no data channel. The
+    compute node identifies its connection to the port with the token. */
+struct DataChannelOffer {
+  uint64_t token;
+  uint16_t port;
+};
+
+/// Plain TCP stream carrying the timeslice data to one compute node.
+/** The ZeroMQ sockets carry the timeslice requests and reply headers, the
+    payload bytes of the components follow on this stream in the same
+    order. Bypassing the ZeroMQ message buffers allows the compute node to
+    read the data directly into its timeslice buffer. Transfers never
+    block; errors and a peer closing the stream throw std::runtime_error. */
+class DataChannel {
+public:
+  /// The DataChannel constructor, takes ownership of a connected socket.
+  explicit DataChannel(int fd) : fd_(fd) {}
+
+  DataChannel(const DataChannel&) = delete;
+  void operator=(const DataChannel&) = delete;
+
+  /// The DataChannel destructor.
+  ~DataChannel();
+
+  /// Connect to the data channel port of an input node and identify with
+  /// the offered token.
+  static std::unique_ptr<DataChannel>
+  connect(const std::string& host, uint16_t port, uint64_t token);
+
+  /// Write as much of the given buffers as possible, return the number of
+  /// bytes written (zero if the socket buffer is full).
+  std::size_t send(const iovec* iov, int iovcnt);
+
+  /// Read up to size bytes, return the number of bytes read (zero if no
+  /// data is available).
+  std::size_t receive(void* buf, std::size_t size);
+
+  /// The underlying socket descriptor (for polling).
+  int fd() const { return fd_; }
+
+private:
+  int fd_;
+};
+
+/// Listening socket accepting the data channels of the compute nodes.
+class DataChannelListener {
+public:
+  /// The DataChannelListener constructor, listens on an ephemeral port.
+  DataChannelListener();
+
+  DataChannelListener(const DataChannelListener&) = delete;
+  void operator=(const DataChannelListener&) = delete;
+
+  /// The DataChannelListener destructor.
+  ~DataChannelListener();
+
+  /// Accept a pending connection and read the token it identifies with.
+  std::unique_ptr<DataChannel> accept(uint64_t& token);
+
+  /// The port number the listener is bound to.
+  uint16_t port() const { return port_; }
+
+  /// The underlying socket descriptor (for polling).
+  int fd() const { return fd_; }
+
+private:
+  int fd_ = -1;
+  uint16_t port_ = 0;
+};
@@ -2,11 +2,11 @@
 
 #include "TimesliceBuilderZeromq.hpp"
 #include "MicrosliceDescriptor.hpp"
-#include "TimesliceCompletion.hpp"
-#include "TimesliceWorkItem.hpp"
 #include "Utility.hpp"
 #include "log.hpp"
+#include <algorithm>
 #include <chrono>
+#include <stdexcept>
 #include <thread>
 
 TimesliceBuilderZeromq::TimesliceBuilderZeromq(
@@ -23,13 +23,16 @@ TimesliceBuilderZeromq::TimesliceBuilderZeromq(
       num_compute_nodes_(num_compute_nodes), timeslice_size_(timeslice_size),
       max_timeslice_number_(max_timeslice_number),
       signal_status_(signal_status), ts_index_(compute_index_),
-      ack_(timeslice_buffer_.get_desc_size_exp()) {
+      desc_metrics_("timeslice_desc",
+                    metrics_labels("zeromq", "compute", compute_index)),
+      latency_tracer_(LatencyTracer::Role::compute, "zeromq", compute_index),
+      timeslices_(timeslice_buffer, timeslice_size, latency_tracer_) {
   for (size_t i = 0; i < input_server_addresses_.size(); ++i) {
     auto input_server_address = input_server_addresses_.at(i);
 
     std::unique_ptr<Connection> c(new Connection{timeslice_buffer_, i});
 
-    c->socket = zmq_socket(zmq_context, ZMQ_REQ);
+    c->socket = zmq_socket(zmq_context, ZMQ_DEALER);
     assert(c->socket);
     int timeout_ms = 500;
     [[maybe_unused]] int rc =
@@ -42,12 +45,23 @@ TimesliceBuilderZeromq::TimesliceBuilderZeromq(
     rc = zmq_connect(c->socket, input_server_address.c_str());
     assert(rc == 0);
 
+    if (input_server_address.compare(0, 6, "tcp://") == 0) {
+      c->host = input_server_address.substr(
+          6, input_server_address.rfind(':') - 6);
+    }
+
+    poll_items_.push_back({c->socket, 0, ZMQ_POLLIN, 0});
     connections_.push_back(std::move(c));
   }
 }
 
 TimesliceBuilderZeromq::~TimesliceBuilderZeromq() {
   for (auto& c : connections_) {
+    if (c->held) {
+      for (uint32_t i = 0; i < c->part_count; ++i) {
+        zmq_msg_close(&c->parts[i]);
+      }
+    }
     if (c->socket != nullptr) {
       [[maybe_unused]] int rc = zmq_close(c->socket);
       assert(rc == 0);
@@ -66,106 +80,244 @@ void TimesliceBuilderZeromq::operator()() {
 
 void TimesliceBuilderZeromq::run_begin() {
   assert(!connections_.empty());
+  for (auto& c : connections_) {
+    if (!c->host.empty()) {
+      open_data_channel(*c);
+    }
+  }
   time_begin_ = std::chrono::high_resolution_clock::now();
   report_status();
 }
 
 bool TimesliceBuilderZeromq::run_cycle() {
-  auto& c = connections_.at(conn_);
+  // keep requests outstanding at all inputs and receive the components in
+  // the order they arrive
+  bool waiting_for_space = false;
+  for (size_t i = 0; i < connections_.size(); ++i) {
+    Connection& c = *connections_[i];
+    if (c.held && !store_component(c)) {
+      waiting_for_space = true;
+    }
+    send_requests(c);
+    zmq_pollitem_t& item = poll_items_[i];
+    if (c.payload_remaining > 0) {
+      // wait for the payload before reading the next header
+      item.socket = nullptr;
+      item.fd = c.channel->fd();
+      item.events = ZMQ_POLLIN;
+    } else {
+      // do not receive more from a connection that cannot store its data
+      item.socket = c.socket;
+      item.events = c.held ? 0 : ZMQ_POLLIN;
+    }
+  }
 
-  std::size_t msg_size;
+  int rc = zmq_poll(poll_items_.data(), static_cast<int>(poll_items_.size()),
+                    waiting_for_space ? 1 : 100);
+  if (rc > 0) {
+    for (size_t i = 0; i < connections_.size(); ++i) {
+      if ((poll_items_[i].revents & ZMQ_POLLIN) == 0) {
+        continue;
+      }
+      if (connections_[i]->payload_remaining > 0) {
+        receive_payload(*connections_[i]);
+      } else {
+        receive_component(*connections_[i]);
+      }
+    }
+  }
+
+  dispatch_timeslices();
+  if (waiting_for_space) {
+    handle_timeslice_completions();
+  }
 
-  // send request for timeslice data
+  return true;
+}
+
+void TimesliceBuilderZeromq::open_data_channel(Connection& c) {
+  // an empty request, answered before any timeslice is requested
   int rc;
   do {
-    rc = zmq_send(c->socket, &ts_index_, sizeof(ts_index_), 0);
+    rc = zmq_send(c.socket, nullptr, 0, 0);
   } while (rc == -1 && errno == EAGAIN && *signal_status_ == 0);
-  if (*signal_status_ != 0) {
-    return true;
+  if (rc == -1) {
+    return;
   }
 
-  // receive desc answer (part 1), do not release
-  rc = zmq_msg_init(&c->desc_msg);
-  assert(rc == 0);
+  DataChannelOffer offer{0, 0};
   do {
-    rc = zmq_msg_recv(&c->desc_msg, c->socket, 0);
+    rc = zmq_recv(c.socket, &offer, sizeof(offer), 0);
   } while (rc == -1 && errno == EAGAIN && *signal_status_ == 0);
-  if (*signal_status_ != 0) {
-    return true;
+  if (rc != sizeof(offer) || offer.port == 0) {
+    return;
   }
-  assert(rc != -1);
-  msg_size = zmq_msg_size(&c->desc_msg);
-  if (msg_size == 0) {
-    zmq_msg_close(&c->desc_msg);
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  try {
+    c.channel = DataChannel::connect(c.host, offer.port, offer.token);
+  } catch (std::runtime_error& e) {
+    L_(warning) << "[c" << compute_index_ << "] " << e.what()
+                << ", receiving data as messages";
   }
+}
 
-  if (msg_size == 0 || *signal_status_ != 0) {
-    return true;
+void TimesliceBuilderZeromq::send_requests(Connection& c) {
+  while (c.requested < timeslices_.dispatched() + request_window_) {
+    uint64_t ts = compute_index_ + c.requested * num_compute_nodes_;
+    if (ts >= max_timeslice_number_) {
+      return;
+    }
+    int rc = zmq_send(c.socket, &ts, sizeof(ts), ZMQ_DONTWAIT);
+    if (rc == -1) {
+      assert(errno == EAGAIN);
+      return;
+    }
+    ++c.requested;
   }
+}
 
-  // receive data answer (part 2), do not release
-  assert(zmq_msg_more(&c->desc_msg));
-  rc = zmq_msg_init(&c->data_msg);
-  assert(rc == 0);
-  do {
-    rc = zmq_msg_recv(&c->data_msg, c->socket, 0);
-  } while (rc == -1 && errno == EAGAIN && *signal_status_ == 0);
-  if (*signal_status_ != 0) {
-    return true;
+void TimesliceBuilderZeromq::receive_component(Connection& c) {
+  assert(!c.held && c.received < c.requested);
+
+  // envelope: reply header
+  ComponentReplyHeader header;
+  int rc = zmq_recv(c.socket, &header, sizeof(header), ZMQ_DONTWAIT);
+  if (rc == -1) {
+    assert(errno == EAGAIN);
+    return;
   }
-  assert(rc != -1);
+  assert(rc == sizeof(header));
+  assert(header.ts == compute_index_ + c.received * num_compute_nodes_);
+  // no parts: the payload follows on the data channel
+  assert(header.desc_parts <= ComponentReplyHeader::max_range_parts);
+  assert(header.data_parts <= ComponentReplyHeader::max_range_parts);
+  assert((header.desc_parts == 0) == (header.data_parts == 0));
+
+  // the remaining parts of a multipart message arrive atomically
+  c.header = header;
+  c.part_count = header.desc_parts + header.data_parts;
+  for (uint32_t i = 0; i < c.part_count; ++i) {
+    rc = zmq_msg_init(&c.parts[i]);
+    assert(rc == 0);
+    rc = zmq_msg_recv(&c.parts[i], c.socket, 0);
+    assert(rc != -1);
+    assert((zmq_msg_more(&c.parts[i]) != 0) == (i + 1 < c.part_count));
+  }
+  c.held = true;
+
+  store_component(c);
+}
 
+bool TimesliceBuilderZeromq::store_component(Connection& c) {
+  assert(c.held);
+  // the payload announced for a failed data channel never arrives, the
+  // input has acknowledged it as dropped and the component stays empty
+  bool lost = c.part_count == 0 && !c.channel;
   uint64_t size_required =
-      zmq_msg_size(&c->desc_msg) + zmq_msg_size(&c->data_msg);
+      lost ? 0 : c.header.desc_size + c.header.data_size;
 
-  while (c->data.size_available_contiguous() < size_required ||
-         c->desc.size_available() < 1) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    handle_timeslice_completions();
+  if (c.data.size_available_contiguous() < size_required ||
+      c.desc.size_available() < 1) {
+    return false;
   }
 
   // skip remaining bytes in data buffer to avoid fractured entry
-  c->data.skip_buffer_wrap(size_required);
+  c.data.skip_buffer_wrap(size_required);
 
   // generate timeslice component descriptor
-  assert(tpos_ == c->desc.write_index());
-  c->desc.append(
-      {ts_index_, c->data.write_index(), size_required,
-       zmq_msg_size(&c->desc_msg) / sizeof(fles::MicrosliceDescriptor)});
-
-  // copy into shared memory and release messages
-  c->data.append(static_cast<uint8_t*>(zmq_msg_data(&c->desc_msg)),
-                 zmq_msg_size(&c->desc_msg));
-  c->data.append(static_cast<uint8_t*>(zmq_msg_data(&c->data_msg)),
-                 zmq_msg_size(&c->data_msg));
-  zmq_msg_close(&c->desc_msg);
-  zmq_msg_close(&c->data_msg);
-
-  ++conn_;
-  if (conn_ == connections_.size()) {
-    conn_ = 0;
+  uint64_t tpos = c.received;
+  assert(tpos == c.desc.write_index());
+  c.desc.append(
+      {compute_index_ + tpos * num_compute_nodes_, c.data.write_index(),
+       size_required,
+       lost ? 0 : c.header.desc_size / sizeof(fles::MicrosliceDescriptor)});
+  latency_tracer_.mark(tpos, LatencyTracer::first_contribution);
+  latency_tracer_.mark_latest(tpos, LatencyTracer::last_contribution);
+
+  if (lost) {
+    c.held = false;
+    ++c.received;
+    return true;
+  }
 
-    handle_timeslice_completions();
+  if (c.part_count == 0) {
+    // receive the payload in place, without an intermediate copy
+    c.payload_target = &c.data.at(c.data.write_index());
+    c.payload_remaining = size_required;
+    c.data.advance_write_index(size_required);
+    c.held = false;
+    receive_payload(c);
+    return true;
+  }
 
-    timeslice_buffer_.send_work_item(
-        {{ts_index_, tpos_, timeslice_size_,
-          static_cast<uint32_t>(connections_.size())},
-         timeslice_buffer_.get_data_size_exp(),
-         timeslice_buffer_.get_desc_size_exp()});
-    ++tpos_;
-    // next timeslice: round robin
-    ts_index_ += num_compute_nodes_;
+  // copy into shared memory in sending order, this joins the two parts of
+  // a range that wrapped around the input buffer, and release messages
+  for (uint32_t i = 0; i < c.part_count; ++i) {
+    c.data.append(static_cast<uint8_t*>(zmq_msg_data(&c.parts[i])),
+                  zmq_msg_size(&c.parts[i]));
+    zmq_msg_close(&c.parts[i]);
   }
+  c.part_count = 0;
+  c.held = false;
+  ++c.received;
 
   return true;
 }
 
+void TimesliceBuilderZeromq::receive_payload(Connection& c) {
+  try {
+    while (c.payload_remaining > 0) {
+      size_t n = c.channel->receive(c.payload_target, c.payload_remaining);
+      if (n == 0) {
+        return;
+      }
+      c.payload_target += n;
+      c.payload_remaining -= n;
+    }
+  } catch (std::runtime_error& e) {
+    L_(warning) << "[c" << compute_index_ << "] " << e.what()
+                << ", timeslice "
+                << compute_index_ + c.received * num_compute_nodes_
+                << " incomplete, receiving data as messages";
+    abandon_payload(c);
+  }
+  ++c.received;
+}
+
+void TimesliceBuilderZeromq::abandon_payload(Connection& c) {
+  // the input acknowledges the components queued for the failed channel
+  // as dropped and sends further data as messages; keep the position of
+  // the partial component, but deliver it empty
+  c.channel.reset();
+  c.payload_target = nullptr;
+  c.payload_remaining = 0;
+  fles::TimesliceComponentDescriptor& desc = c.desc.at(c.received);
+  desc.size = 0;
+  desc.num_microslices = 0;
+}
+
+void TimesliceBuilderZeromq::dispatch_timeslices() {
+  uint64_t complete = UINT64_MAX;
+  for (auto& c : connections_) {
+    complete = std::min(complete, c->received);
+  }
+  if (complete <= timeslices_.dispatched()) {
+    return;
+  }
+
+  handle_timeslice_completions();
+  while (timeslices_.dispatched() < complete) {
+    timeslices_.dispatch(ts_index_);
+    // next timeslice: round robin
+    ts_index_ += num_compute_nodes_;
+  }
+}
+
 void TimesliceBuilderZeromq::run_end() {
   time_end_ = std::chrono::high_resolution_clock::now();
 
   // wait until all pending timeslices have been acknowledged
-  while (acked_ < tpos_) {
+  while (timeslices_.acked() < timeslices_.dispatched()) {
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
     handle_timeslice_completions();
   }
@@ -176,20 +328,17 @@ void TimesliceBuilderZeromq::run_end() {
 }
 
 void TimesliceBuilderZeromq::handle_timeslice_completions() {
-  fles::TimesliceCompletion c;
-  while (timeslice_buffer_.try_receive_completion(c)) {
-    if (c.ts_pos == acked_) {
-      do {
-        ++acked_;
-      } while (ack_.at(acked_) > c.ts_pos);
-      for (auto& conn : connections_) {
-        conn->desc.set_read_index(acked_);
-        conn->data.set_read_index(conn->desc.at(acked_ - 1).offset +
-                                  conn->desc.at(acked_ - 1).size);
-      }
-    } else {
-      ack_.at(c.ts_pos) = c.ts_pos;
-    }
+  uint64_t acked = timeslices_.acked();
+  while (timeslices_.poll_completion()) {
+  }
+  if (timeslices_.acked() == acked) {
+    return;
+  }
+  acked = timeslices_.acked();
+  for (auto& conn : connections_) {
+    conn->desc.set_read_index(acked);
+    conn->data.set_read_index(conn->desc.at(acked - 1).offset +
+                              conn->desc.at(acked - 1).size);
   }
 }
 
@@ -200,8 +349,12 @@ void TimesliceBuilderZeromq::report_status() {
 
   // FIXME: dummy code here...
   auto& c = connections_.at(0);
-  BufferStatus status_desc{now, c->desc.size(), acked_, acked_, tpos_};
-  BufferStatus status_data{now, c->desc.size(), acked_, acked_, tpos_};
+  uint64_t acked = timeslices_.acked();
+  uint64_t dispatched = timeslices_.dispatched();
+  ReceiveBufferStatus status_desc{now, c->desc.size(), acked, acked,
+                                  dispatched};
+  ReceiveBufferStatus status_data{now, c->desc.size(), acked, acked,
+                                  dispatched};
 
   /*
   double delta_t =
@@ -229,6 +382,9 @@ void TimesliceBuilderZeromq::report_status() {
            << bar_graph(status_data.vector(), "#._", 20) << "|"
            << bar_graph(status_desc.vector(), "#._", 10) << "| ";
 
+  desc_metrics_.update(status_desc.used(), 0, status_desc.freeing(),
+                       status_desc.size, status_desc.acked);
+
   previous_buffer_status_desc_ = status_desc;
   previous_buffer_status_data_ = status_data;
 
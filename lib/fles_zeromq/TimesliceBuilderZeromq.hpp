@@ -1,13 +1,19 @@
 // Copyright 2013, 2016 Jan de Cuveland <cmail@cuveland.de>
 #pragma once
 
+#include "ComponentReplyHeader.hpp"
+#include "DataChannel.hpp"
+#include "LatencyTracer.hpp"
 #include "ManagedRingBuffer.hpp"
-#include "RingBuffer.hpp"
+#include "Metrics.hpp"
+#include "ReceiveBufferStatus.hpp"
 #include "Scheduler.hpp"
 #include "TimesliceBuffer.hpp"
-#include <boost/format.hpp>
+#include "TimesliceBufferTracker.hpp"
 #include <cassert>
 #include <csignal>
+#include <memory>
+#include <string>
 #include <vector>
 #include <zmq.h>
 
@@ -60,20 +66,11 @@ private:
   /// Pointer to global signal status variable.
   volatile sig_atomic_t* signal_status_;
 
-  /// Index of acknowledged timeslices (local index).
-  uint64_t acked_ = 0;
-
   /// The global index of the timeslice currently being received.
   uint64_t ts_index_;
 
-  /// The local buffer position of the timeslice currently being received.
-  uint64_t tpos_ = 0;
-
-  /// The index of the connection to receive from next.
-  uint64_t conn_ = 0;
-
-  /// Buffer to store acknowledged status of timeslices.
-  RingBuffer<uint64_t, true> ack_;
+  /// Number of timeslices requested ahead of the dispatched ones.
+  static constexpr uint64_t request_window_ = 8;
 
   /// Connection struct, handles data for one input server.
   struct Connection {
@@ -87,57 +84,64 @@ private:
     ManagedRingBuffer<uint8_t> data;
 
     void* socket;
-    zmq_msg_t desc_msg;
-    zmq_msg_t data_msg;
+
+    /// Host name of the input server (for the data channel).
+    std::string host;
+
+    /// Data channel of the input server, if established and not failed.
+    std::unique_ptr<DataChannel> channel;
+
+    /// Reply header of the received timeslice component.
+    ComponentReplyHeader header{};
+
+    /// Message parts of the received timeslice component, the descriptor
+    /// parts followed by the data parts.
+    zmq_msg_t parts[2 * ComponentReplyHeader::max_range_parts];
+
+    /// Total number of parts in parts.
+    uint32_t part_count = 0;
+
+    /// Position in the timeslice buffer of the data channel payload that
+    /// is being received.
+    uint8_t* payload_target = nullptr;
+
+    /// Bytes of the data channel payload still to be received.
+    uint64_t payload_remaining = 0;
+
+    /// Local position of the next timeslice to request.
+    uint64_t requested = 0;
+
+    /// Local position of the next timeslice to receive.
+    uint64_t received = 0;
+
+    /// Flag whether a received timeslice component (header and parts)
+    /// waits for space in the timeslice buffer.
+    bool held = false;
   };
 
   /// The vector of connections, one per input server.
   std::vector<std::unique_ptr<Connection>> connections_;
 
+  /// Poll items of the connection sockets.
+  std::vector<zmq_pollitem_t> poll_items_;
+
   /// Begin of operation (for performance statistics).
   std::chrono::high_resolution_clock::time_point time_begin_;
 
   /// End of operation (for performance statistics).
   std::chrono::high_resolution_clock::time_point time_end_;
 
-  struct BufferStatus {
-    std::chrono::system_clock::time_point time;
-    uint64_t size;
+  ReceiveBufferStatus previous_buffer_status_desc_ = ReceiveBufferStatus();
+  ReceiveBufferStatus previous_buffer_status_data_ = ReceiveBufferStatus();
 
-    uint64_t cached_acked;
-    uint64_t acked;
-    uint64_t received;
+  /// Exported fill level of the timeslice buffer.
+  BufferMetrics desc_metrics_;
 
-    int64_t used() const { return received - acked; }
-    int64_t freeing() const { return acked - cached_acked; }
-    int64_t unused() const { return cached_acked + size - received; }
+  /// Sampled latencies of the timeslice building stages.
+  LatencyTracer latency_tracer_;
 
-    float percentage(int64_t value) const {
-      return static_cast<float>(value) / static_cast<float>(size);
-    }
-
-    static std::string caption() { return std::string("used/freeing/free"); }
-
-    std::string percentage_str(int64_t value) const {
-      boost::format percent_fmt("%4.1f%%");
-      percent_fmt % (percentage(value) * 100);
-      std::string s = percent_fmt.str();
-      s.resize(4);
-      return s;
-    }
-
-    std::string percentages() const {
-      return percentage_str(used()) + " " + percentage_str(freeing()) + " " +
-             percentage_str(unused());
-    }
-
-    std::vector<int64_t> vector() const {
-      return std::vector<int64_t>{used(), freeing(), unused()};
-    }
-  };
-
-  BufferStatus previous_buffer_status_desc_ = BufferStatus();
-  BufferStatus previous_buffer_status_data_ = BufferStatus();
+  /// Dispatched and acknowledged timeslices in the timeslice buffer.
+  TimesliceBufferTracker timeslices_;
 
   /// Scheduler for periodic events.
   Scheduler scheduler_;
@@ -151,6 +155,30 @@ private:
   /// Cleanup at end of run.
   void run_end();
 
+  /// Request and connect the data channel of a TCP connection.
+  void open_data_channel(Connection& c);
+
+  /// Fill the request window of a connection.
+  void send_requests(Connection& c);
+
+  /// Receive the next timeslice component of a connection.
+  void receive_component(Connection& c);
+
+  /// Copy a held timeslice component to the timeslice buffer if there is
+  /// enough space, or start receiving it from the data channel.
+  bool store_component(Connection& c);
+
+  /// Receive the available payload bytes from the data channel directly
+  /// into the timeslice buffer. A failed data channel is closed.
+  void receive_payload(Connection& c);
+
+  /// Close the failed data channel of a connection and turn the component
+  /// being received into an empty one.
+  void abandon_payload(Connection& c);
+
+  /// Hand the timeslices received from all inputs to the processors.
+  void dispatch_timeslices();
+
   /// Handle pending timeslice completions and advance read indexes.
   void handle_timeslice_completions();
 
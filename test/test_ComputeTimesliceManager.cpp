@@ -0,0 +1,38 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_ComputeTimesliceManager
+#include <boost/test/unit_test.hpp>
+
+#include "dfs/controller/interval_manager/ComputeTimesliceManager.hpp"
+#include "dfs/model/interval_manager/ComputeIntervalDataManager.hpp"
+
+using namespace tl_libfabric;
+
+BOOST_AUTO_TEST_CASE(slow_timeslice_test) {
+  ComputeIntervalDataManager* data_manager =
+      ComputeIntervalDataManager::get_instance(0, 100, "", false);
+  // two input connections, a tracking window of four timeslices
+  ComputeTimesliceManager* manager =
+      ComputeTimesliceManager::get_instance(0, 2, 4, "", false);
+
+  // timeslice 0 only gets the contribution of connection 0
+  BOOST_CHECK(!manager->log_contribution_arrival(0, 0));
+  for (uint64_t ts = 1; ts < 4; ++ts) {
+    BOOST_CHECK(!manager->log_contribution_arrival(0, ts));
+    BOOST_CHECK(manager->log_contribution_arrival(1, ts));
+  }
+  BOOST_CHECK(manager->get_last_ordered_completed_timeslice() ==
+              ConstVariables::MINUS_ONE);
+  BOOST_CHECK(!data_manager->contain_timeslice_timed_out_duration(0));
+
+  // timeslice 4 no longer fits next to the slow timeslice 0, which is
+  // reported as timed out instead of being dropped silently
+  BOOST_CHECK(!manager->log_contribution_arrival(0, 4));
+  BOOST_CHECK(data_manager->contain_timeslice_timed_out_duration(0));
+  BOOST_CHECK(!data_manager->contain_timeslice_completion_duration(0));
+  BOOST_CHECK_EQUAL(manager->get_last_ordered_completed_timeslice(), 3u);
+
+  // the late contribution of the timed out timeslice is ignored
+  BOOST_CHECK(!manager->log_contribution_arrival(1, 0));
+  BOOST_CHECK(manager->log_contribution_arrival(1, 4));
+  BOOST_CHECK_EQUAL(manager->get_last_ordered_completed_timeslice(), 4u);
+}
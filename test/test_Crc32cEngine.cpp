@@ -0,0 +1,119 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_Crc32cEngine
+#include <boost/test/unit_test.hpp>
+
+#include "Crc32cEngine.hpp"
+#include "interface.h" // crcutil_interface
+#include <boost/crc.hpp>
+#include <random>
+#include <vector>
+
+namespace {
+
+using Implementation = Crc32cEngine::Implementation;
+
+const std::vector<Implementation> all_implementations{
+    Implementation::Table, Implementation::Serial, Implementation::Interleaved,
+    Implementation::Avx512};
+
+uint32_t reference_crc(const uint8_t* data, size_t size) {
+  boost::crc_optimal<32, 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF, true, true> crc;
+  crc.process_bytes(data, size);
+  return crc();
+}
+
+std::vector<uint8_t> make_random_data(size_t size) {
+  std::mt19937 engine(42);
+  std::uniform_int_distribution<unsigned int> distribution(0, 255);
+  std::vector<uint8_t> data(size);
+  for (auto& byte : data) {
+    byte = static_cast<uint8_t>(distribution(engine));
+  }
+  return data;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(check_value_test) {
+  const std::string check("123456789");
+  for (auto implementation : all_implementations) {
+    if (!Crc32cEngine::is_available(implementation)) {
+      BOOST_TEST_MESSAGE("skipping " +
+                         Crc32cEngine::to_string(implementation));
+      continue;
+    }
+    Crc32cEngine engine(implementation);
+    BOOST_CHECK_EQUAL(engine.compute(check.data(), check.size()),
+                      UINT32_C(0xe3069283));
+    BOOST_CHECK_EQUAL(engine.compute(nullptr, 0), UINT32_C(0));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(implementations_test) {
+  std::vector<uint8_t> data = make_random_data(70000);
+  const std::vector<size_t> sizes{1,   7,    8,    9,     255,   256,  511,
+                                  512, 767,  768,  1000,  4095,  12287,
+                                  12288, 13000, 24576, 40001, 69990};
+
+  for (auto implementation : all_implementations) {
+    if (!Crc32cEngine::is_available(implementation)) {
+      continue;
+    }
+    Crc32cEngine engine(implementation);
+    for (size_t offset = 0; offset < 8; offset += 3) {
+      for (size_t size : sizes) {
+        const uint8_t* p = data.data() + offset;
+        BOOST_CHECK_EQUAL(engine.compute(p, size), reference_crc(p, size));
+        // extending in two parts yields the same result
+        uint32_t crc = engine.compute(p, size / 3);
+        crc = engine.extend(crc, p + size / 3, size - size / 3);
+        BOOST_CHECK_EQUAL(crc, reference_crc(p, size));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(crcutil_compatibility_test) {
+  std::vector<uint8_t> data = make_random_data(5000);
+  crcutil_interface::CRC* crcutil = crcutil_interface::CRC::Create(
+      0x82f63b78, 0, 32, true, 0, 0, 0,
+      crcutil_interface::CRC::IsSSE42Available(), nullptr);
+  crcutil_interface::UINT64 crc64 = 0;
+  crcutil->Compute(data.data(), data.size(), &crc64);
+  crcutil->Delete();
+
+  Crc32cEngine engine;
+  BOOST_CHECK_EQUAL(engine.compute(data.data(), data.size()),
+                    static_cast<uint32_t>(crc64));
+}
+
+BOOST_AUTO_TEST_CASE(batch_test) {
+  std::vector<uint8_t> data = make_random_data(100000);
+  std::mt19937 engine(7);
+  std::uniform_int_distribution<size_t> small(0, 1000);
+
+  std::vector<const void*> ptrs;
+  std::vector<size_t> sizes;
+  size_t offset = 0;
+  for (size_t i = 0; i < 50; ++i) {
+    size_t size = (i % 10 == 9) ? 5000 : small(engine);
+    ptrs.push_back(data.data() + offset);
+    sizes.push_back(size);
+    offset += size + i % 5;
+  }
+
+  for (auto implementation : all_implementations) {
+    if (!Crc32cEngine::is_available(implementation)) {
+      continue;
+    }
+    Crc32cEngine crc_engine(implementation);
+    std::vector<uint32_t> crcs(ptrs.size());
+    crc_engine.compute_batch(ptrs.size(), ptrs.data(), sizes.data(),
+                             crcs.data());
+    for (size_t i = 0; i < ptrs.size(); ++i) {
+      BOOST_CHECK_EQUAL(crcs[i],
+                        reference_crc(static_cast<const uint8_t*>(ptrs[i]),
+                                      sizes[i]));
+    }
+  }
+}
@@ -0,0 +1,35 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_InputBufferCrcStage
+#include <boost/test/unit_test.hpp>
+
+#include "Crc32cEngine.hpp"
+#include "FlesnetPatternGenerator.hpp"
+#include "InputBufferCrcStage.hpp"
+#include "MicrosliceReceiver.hpp"
+#include <memory>
+
+BOOST_AUTO_TEST_CASE(crc_stage_test) {
+  // small buffers, so that microslices wrap around the buffer end
+  constexpr std::size_t data_buffer_size_exp = 16;
+  constexpr std::size_t desc_buffer_size_exp = 8;
+  constexpr uint32_t typical_content_size = 1000;
+  constexpr size_t count = 5000;
+
+  auto pattern_generator = std::make_unique<FlesnetPatternGenerator>(
+      data_buffer_size_exp, desc_buffer_size_exp, 0, typical_content_size,
+      true, true);
+  InputBufferCrcStage crc_stage(std::move(pattern_generator), 0, 0.0);
+  fles::MicrosliceReceiver receiver(crc_stage);
+  Crc32cEngine reference(Crc32cEngine::Implementation::Table);
+
+  for (size_t i = 0; i < count; ++i) {
+    auto microslice = receiver.get();
+    BOOST_REQUIRE(microslice);
+    BOOST_CHECK_EQUAL(microslice->desc().idx, i);
+    BOOST_CHECK((microslice->desc().flags &
+                 static_cast<uint16_t>(fles::MicrosliceFlags::CrcValid)) != 0);
+    BOOST_CHECK_EQUAL(
+        microslice->desc().crc,
+        reference.compute(microslice->content(), microslice->desc().size));
+  }
+}
@@ -0,0 +1,198 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#define BOOST_TEST_MODULE test_IoUring
+#include <boost/test/unit_test.hpp>
+
+#include "FlesnetPatternGenerator.hpp"
+#include "InputChannelSender.hpp"
+#include "IoUring.hpp"
+#include "TimesliceBuffer.hpp"
+#include "TimesliceBuilder.hpp"
+#include "TimesliceReceiver.hpp"
+#include <csignal>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+// io_uring may be disabled (e.g., by a container's seccomp profile)
+boost::test_tools::assertion_result io_uring_available(
+    boost::unit_test::test_unit_id /* id */) {
+  try {
+    tl_uring::IoUring ring(4);
+  } catch (tl_uring::UringException& e) {
+    boost::test_tools::assertion_result result(false);
+    result.message() << e.what();
+    return result;
+  }
+  return true;
+}
+
+void prep_nop(tl_uring::IoUring& ring, uint64_t user_data, uint8_t flags) {
+  io_uring_sqe* sqe = ring.get_sqe();
+  sqe->opcode = IORING_OP_NOP;
+  sqe->flags = flags;
+  sqe->user_data = user_data;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(completion_queue_overflow_test,
+                     *boost::unit_test::precondition(io_uring_available)) {
+  // many more requests than fit into the completion queue, none of them
+  // reaped before all have been submitted
+  tl_uring::IoUring ring(4);
+  constexpr uint64_t count = 256;
+  for (uint64_t i = 0; i < count; ++i) {
+    prep_nop(ring, i, 0);
+  }
+  ring.submit();
+
+  uint64_t seen = 0;
+  for (int idle = 0; seen < count && idle < 100;) {
+    io_uring_cqe* cqe = ring.peek_cqe();
+    if (cqe == nullptr) {
+      ring.submit_and_wait(std::chrono::milliseconds(10));
+      ++idle;
+      continue;
+    }
+    BOOST_CHECK_EQUAL(cqe->user_data, seen);
+    BOOST_CHECK_EQUAL(cqe->res, 0);
+    ring.cqe_seen();
+    ++seen;
+    idle = 0;
+  }
+  BOOST_CHECK_EQUAL(seen, count);
+}
+
+BOOST_AUTO_TEST_CASE(linked_chain_reservation_test,
+                     *boost::unit_test::precondition(io_uring_available)) {
+  tl_uring::IoUring ring(8);
+  BOOST_CHECK_THROW(ring.reserve_sqes(ring.sq_entries() + 1),
+                    tl_uring::UringException);
+
+  // chains that do not fit into the rest of the submission queue are
+  // submitted as a whole, never as a truncated chain
+  constexpr unsigned int chain = 3;
+  constexpr uint64_t count = 30 * chain;
+  uint64_t seen = 0;
+  for (uint64_t i = 0; i < count; i += chain) {
+    ring.reserve_sqes(chain);
+    for (unsigned int p = 0; p < chain; ++p) {
+      prep_nop(ring, i + p, p + 1 < chain ? IOSQE_IO_LINK : 0);
+    }
+    if (i % (4 * chain) == 0) {
+      // drain now and then, so the completion queue does not overflow
+      ring.submit();
+      while (io_uring_cqe* cqe = ring.peek_cqe()) {
+        BOOST_CHECK_EQUAL(cqe->res, 0);
+        ring.cqe_seen();
+        ++seen;
+      }
+    }
+  }
+  ring.submit();
+  for (int idle = 0; seen < count && idle < 100;) {
+    io_uring_cqe* cqe = ring.peek_cqe();
+    if (cqe == nullptr) {
+      ring.submit_and_wait(std::chrono::milliseconds(10));
+      ++idle;
+      continue;
+    }
+    BOOST_CHECK_EQUAL(cqe->res, 0);
+    ring.cqe_seen();
+    ++seen;
+  }
+  BOOST_CHECK_EQUAL(seen, count);
+}
+
+BOOST_AUTO_TEST_CASE(localhost_transport_test,
+                     *boost::unit_test::precondition(io_uring_available)) {
+  constexpr uint32_t num_inputs = 2;
+  constexpr uint32_t num_outputs = 2;
+  constexpr uint32_t timeslice_size = 10;
+  constexpr uint32_t overlap_size = 1;
+  constexpr uint32_t num_timeslices = 200;
+  const auto base_port =
+      static_cast<unsigned short>(29200 + (getpid() % 1000) * num_outputs);
+
+  volatile sig_atomic_t signal_status = 0;
+  std::vector<std::string> shm_ids;
+  std::vector<std::string> hosts;
+  std::vector<std::string> services;
+  std::vector<std::unique_ptr<TimesliceBuffer>> buffers;
+  std::vector<std::unique_ptr<tl_uring::TimesliceBuilder>> builders;
+  for (uint32_t c = 0; c < num_outputs; ++c) {
+    shm_ids.push_back("test_IoUring_" + std::to_string(getpid()) + "_" +
+                      std::to_string(c) + "_");
+    buffers.push_back(
+        std::make_unique<TimesliceBuffer>(shm_ids.back(), 18, 6, num_inputs));
+    auto port = static_cast<unsigned short>(base_port + c);
+    builders.push_back(std::make_unique<tl_uring::TimesliceBuilder>(
+        c, *buffers.back(), port, num_inputs, timeslice_size, &signal_status,
+        false));
+    hosts.emplace_back("127.0.0.1");
+    services.push_back(std::to_string(port));
+  }
+
+  std::vector<std::unique_ptr<FlesnetPatternGenerator>> sources;
+  std::vector<std::unique_ptr<tl_uring::InputChannelSender>> senders;
+  for (uint32_t i = 0; i < num_inputs; ++i) {
+    sources.push_back(
+        std::make_unique<FlesnetPatternGenerator>(18, 8, i, 256, true, true));
+    senders.push_back(std::make_unique<tl_uring::InputChannelSender>(
+        i, *sources.back(), hosts, services, timeslice_size, overlap_size,
+        num_timeslices));
+  }
+
+  // check the contents of all timeslices received by a compute node
+  std::vector<uint64_t> checked(num_outputs, 0);
+  std::vector<uint64_t> errors(num_outputs, 0);
+  auto consume = [&](uint32_t c) {
+    fles::TimesliceReceiver receiver(shm_ids[c]);
+    while (auto ts = receiver.get()) {
+      if (ts->index() % num_outputs != c ||
+          ts->num_components() != num_inputs) {
+        ++errors[c];
+      }
+      for (uint32_t i = 0; i < ts->num_components(); ++i) {
+        if (ts->num_microslices(i) != timeslice_size + overlap_size) {
+          ++errors[c];
+        }
+        for (uint64_t m = 0; m < ts->num_microslices(i); ++m) {
+          const auto& desc = ts->descriptor(i, m);
+          if (desc.idx != ts->index() * timeslice_size + m) {
+            ++errors[c];
+          }
+          const auto* content =
+              reinterpret_cast<const uint64_t*>(ts->content(i, m));
+          for (uint64_t w = 0; w < desc.size / sizeof(uint64_t); ++w) {
+            if (content[w] != ((UINT64_C(1) * i << 48) | (w * 8))) {
+              ++errors[c];
+            }
+          }
+        }
+      }
+      ++checked[c];
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (uint32_t c = 0; c < num_outputs; ++c) {
+    threads.emplace_back(consume, c);
+    threads.emplace_back(std::ref(*builders[c]));
+  }
+  for (auto& sender : senders) {
+    threads.emplace_back(std::ref(*sender));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (uint32_t c = 0; c < num_outputs; ++c) {
+    BOOST_CHECK_EQUAL(errors[c], 0u);
+    BOOST_CHECK_EQUAL(checked[c], num_timeslices / num_outputs);
+  }
+}
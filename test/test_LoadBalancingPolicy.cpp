@@ -0,0 +1,55 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_LoadBalancingPolicy
+#include <boost/test/unit_test.hpp>
+
+#include "TimesliceSchedule.hpp"
+#include "dfs/controller/load_balancer/LoadBalancingPolicy.hpp"
+#include <vector>
+
+using tl_libfabric::LoadBalancingPolicy;
+using tl_libfabric::TimesliceSchedule;
+
+BOOST_AUTO_TEST_CASE(initial_load_test) {
+  std::vector<double> load = LoadBalancingPolicy::initial_load({}, 4);
+  BOOST_CHECK_EQUAL(load.size(), 4u);
+  BOOST_CHECK_EQUAL(load[3], 1.0);
+
+  load = LoadBalancingPolicy::initial_load({2.0, 1.0, 1.0}, 3);
+  BOOST_CHECK_CLOSE(load[0], 1.5, 1e-9);
+  BOOST_CHECK_CLOSE(load[1], 0.75, 1e-9);
+
+  // standby compute nodes get no load, the others keep their proportions
+  load = LoadBalancingPolicy::initial_load({2.0, 1.0, 1.0, 3.0}, 4, 3);
+  BOOST_REQUIRE_EQUAL(load.size(), 4u);
+  BOOST_CHECK_EQUAL(load[3], 0.0);
+  BOOST_CHECK_CLOSE(load[0], 2 * load[1], 1e-9);
+  BOOST_CHECK_CLOSE(load[1], load[2], 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(standby_join_test) {
+  const std::vector<double> weights{1.0, 1.0, 1.0, 1.0};
+  TimesliceSchedule schedule;
+
+  // inputs start with all compute nodes connected, the last one on standby
+  schedule.add(0, 199, LoadBalancingPolicy::initial_load(weights, 4, 3));
+  for (uint32_t cn = 0; cn < 3; ++cn) {
+    BOOST_CHECK(schedule.count(cn, 0, 199) > 0);
+  }
+  BOOST_CHECK_EQUAL(schedule.count(3, 0, 199), 0u);
+  BOOST_CHECK_EQUAL(schedule.next(3, 0), TimesliceSchedule::NONE);
+
+  // the compute nodes propose loads of the running ones until the join
+  std::vector<double> last_load = {1.2, 1.0, 0.8};
+  schedule.add(200, 399, last_load);
+  BOOST_CHECK_EQUAL(schedule.count(3, 0, 399), 0u);
+
+  // after the join, the standby node receives its share of the timeslices
+  std::vector<double> load =
+      LoadBalancingPolicy::join_load(last_load, weights, 4);
+  BOOST_REQUIRE_EQUAL(load.size(), 4u);
+  BOOST_CHECK_CLOSE(load[3], 1.0, 1e-9);
+  schedule.add(400, 599, load);
+  BOOST_CHECK_EQUAL(schedule.next(3, 0), schedule.next(3, 400));
+  BOOST_CHECK_CLOSE(static_cast<double>(schedule.count(3, 400, 599)), 50.0,
+                    5.0);
+}
@@ -0,0 +1,79 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#define BOOST_TEST_MODULE test_Metrics
+#include <boost/test/unit_test.hpp>
+
+#include "HdrHistogram.hpp"
+#include "LatencyTracer.hpp"
+#include "Metrics.hpp"
+
+BOOST_AUTO_TEST_CASE(histogram_bucket_bounds_test) {
+  using H = HdrHistogram<>;
+  for (uint64_t value : {UINT64_C(0), UINT64_C(31), UINT64_C(32),
+                         UINT64_C(1000), UINT64_C(123456789), UINT64_MAX}) {
+    size_t index = H::bucket_index(value);
+    BOOST_CHECK_LT(index, H::BUCKET_COUNT);
+    BOOST_CHECK_LE(H::bucket_lower_bound(index), value);
+    BOOST_CHECK_GE(H::bucket_upper_bound(index), value);
+  }
+  BOOST_CHECK_EQUAL(H::bucket_index(UINT64_MAX), H::BUCKET_COUNT - 1);
+}
+
+BOOST_AUTO_TEST_CASE(histogram_quantile_test) {
+  HdrHistogram<> h;
+  BOOST_CHECK_EQUAL(h.median(), 0u);
+  for (uint64_t i = 1; i <= 10000; ++i) {
+    h.record(i);
+  }
+  BOOST_CHECK_EQUAL(h.count(), 10000u);
+  BOOST_CHECK_EQUAL(h.sum(), 50005000u);
+  BOOST_CHECK_CLOSE(static_cast<double>(h.median()), 5000.0, 3.5);
+  BOOST_CHECK_CLOSE(static_cast<double>(h.value_at_quantile(0.99)), 9900.0,
+                    3.5);
+  h.remove(10000);
+  BOOST_CHECK_EQUAL(h.count(), 9999u);
+}
+
+BOOST_AUTO_TEST_CASE(registry_render_test) {
+  MetricsRegistry& registry = MetricsRegistry::instance();
+  registry.counter("test_events_total", "Test events", "node=\"1\"").add(3);
+  BOOST_CHECK_EQUAL(
+      &registry.counter("test_events_total", "Test events", "node=\"1\""),
+      &registry.counter("test_events_total", "Test events", "node=\"1\""));
+  registry.gauge("test_level", "Test level").set(0.5);
+  MetricsHistogram& h = registry.histogram("test_latency", "Test latency");
+  h.record(10);
+  h.record(100);
+
+  std::string text = registry.render_prometheus();
+  BOOST_CHECK(text.find("# TYPE test_events_total counter\n") !=
+              std::string::npos);
+  BOOST_CHECK(text.find("test_events_total{node=\"1\"} 3\n") !=
+              std::string::npos);
+  BOOST_CHECK(text.find("test_level 0.5\n") != std::string::npos);
+  BOOST_CHECK(text.find("test_latency_bucket{le=\"31\"} 1\n") !=
+              std::string::npos);
+  BOOST_CHECK(text.find("test_latency_bucket{le=\"+Inf\"} 2\n") !=
+              std::string::npos);
+  BOOST_CHECK(text.find("test_latency_sum 110\n") != std::string::npos);
+
+  BOOST_CHECK_THROW(registry.gauge("test_events_total", "Test events"),
+                    std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(latency_tracer_test) {
+  LatencyTracer tracer(LatencyTracer::Role::compute, "test", 0, 4);
+  BOOST_CHECK(tracer.sampled(8));
+  BOOST_CHECK(!tracer.sampled(9));
+  tracer.mark_range(3, 10, LatencyTracer::first_contribution);
+  tracer.mark_latest_range(3, 10, LatencyTracer::last_contribution);
+  for (uint64_t ts = 3; ts < 10; ++ts) {
+    tracer.mark(ts, LatencyTracer::dispatched);
+    tracer.mark(ts, LatencyTracer::completed);
+  }
+
+  MetricsHistogram& total = MetricsRegistry::instance().histogram(
+      "flesnet_timeslice_latency_microseconds", "",
+      metrics_labels("test", "compute", 0));
+  BOOST_CHECK_EQUAL(total.count(), 2u);
+}
@@ -0,0 +1,102 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_MicrosliceIndexChecker
+#include <boost/test/unit_test.hpp>
+
+#include "MicrosliceIndexChecker.hpp"
+#include "StorableTimeslice.hpp"
+#include <vector>
+
+namespace {
+
+constexpr uint64_t period = 125000;
+constexpr uint32_t core = 4;
+
+/// Create a single-component timeslice with microslices of given indices.
+fles::StorableTimeslice make_timeslice(uint64_t index,
+                                       const std::vector<uint64_t>& indices) {
+  fles::StorableTimeslice ts(core, index);
+  ts.append_component(indices.size());
+  for (size_t m = 0; m < indices.size(); ++m) {
+    fles::MicrosliceDescriptor desc = fles::MicrosliceDescriptor();
+    desc.idx = indices[m];
+    ts.append_microslice(0, m, desc, nullptr);
+  }
+  return ts;
+}
+
+/// Indices of a regular timeslice with one overlap microslice.
+std::vector<uint64_t> regular_indices(uint64_t index) {
+  std::vector<uint64_t> indices;
+  for (uint64_t m = 0; m <= core; ++m) {
+    indices.push_back((index * core + m) * period);
+  }
+  return indices;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(regular_test) {
+  MicrosliceIndexChecker checker;
+  for (uint64_t i = 0; i < 10; ++i) {
+    BOOST_CHECK(checker.check(make_timeslice(i, regular_indices(i)), 0));
+  }
+  BOOST_CHECK_EQUAL(checker.period(), period);
+  BOOST_CHECK_EQUAL(checker.checked(), 10 * core);
+  BOOST_CHECK(!checker.has_errors());
+  BOOST_CHECK_EQUAL(checker.missing_rate(), 0.);
+}
+
+BOOST_AUTO_TEST_CASE(gap_test) {
+  MicrosliceIndexChecker checker;
+  BOOST_CHECK(checker.check(make_timeslice(0, regular_indices(0)), 0));
+
+  // two microslices missing in the core of timeslice 1
+  auto indices = regular_indices(1);
+  indices.erase(indices.begin() + 1, indices.begin() + 3);
+  indices.push_back(indices.back() + period);
+  indices.push_back(indices.back() + period);
+  BOOST_CHECK(!checker.check(make_timeslice(1, indices), 0));
+  BOOST_CHECK_EQUAL(checker.missing(), 2);
+  BOOST_CHECK_EQUAL(checker.gap_runs(), 1);
+  BOOST_REQUIRE_EQUAL(checker.recent_gaps().size(), 1);
+  BOOST_CHECK_EQUAL(checker.recent_gaps()[0].first, 5 * period);
+  BOOST_CHECK_EQUAL(checker.recent_gaps()[0].count, 2);
+  BOOST_CHECK(!checker.error().empty());
+
+  // gap across timeslices (last core microslice was 9) and overlap mismatch
+  BOOST_CHECK(!checker.check(make_timeslice(2, regular_indices(3)), 0));
+  BOOST_CHECK_EQUAL(checker.missing(), 2 + 2);
+  BOOST_CHECK_EQUAL(checker.gap_runs(), 2);
+  BOOST_CHECK_EQUAL(checker.overlap_mismatches(), 1);
+  BOOST_CHECK_EQUAL(checker.duplicates(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(duplicate_test) {
+  MicrosliceIndexChecker checker;
+  BOOST_CHECK(checker.check(make_timeslice(0, regular_indices(0)), 0));
+
+  // timeslice 1 repeats the last two core microslices of timeslice 0
+  std::vector<uint64_t> indices;
+  for (uint64_t m = 2; m < 2 + core + 1; ++m) {
+    indices.push_back(m * period);
+  }
+  BOOST_CHECK(!checker.check(make_timeslice(1, indices), 0));
+  BOOST_CHECK_EQUAL(checker.duplicates(), 2);
+  BOOST_CHECK_EQUAL(checker.missing(), 0);
+
+  // a repeated microslice within a timeslice
+  indices = regular_indices(2);
+  indices[2] = indices[1];
+  BOOST_CHECK(!checker.check(make_timeslice(2, indices), 0));
+  BOOST_CHECK_EQUAL(checker.duplicates(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(non_consecutive_test) {
+  // timeslices of other streams (e.g., other tsclient instances) are not
+  // available, so only consecutive timeslices are compared
+  MicrosliceIndexChecker checker;
+  BOOST_CHECK(checker.check(make_timeslice(0, regular_indices(0)), 0));
+  BOOST_CHECK(checker.check(make_timeslice(5, regular_indices(5)), 0));
+  BOOST_CHECK(checker.check(make_timeslice(6, regular_indices(6)), 0));
+  BOOST_CHECK(!checker.has_errors());
+}
@@ -0,0 +1,44 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_PhiAccrualDetector
+#include <boost/test/unit_test.hpp>
+
+#include "dfs/controller/fault_tolerance/PhiAccrualDetector.hpp"
+#include <cmath>
+
+using tl_libfabric::PhiAccrualDetector;
+
+BOOST_AUTO_TEST_CASE(converge_test) {
+  PhiAccrualDetector detector(1000000, 100, 0);
+  for (int i = 0; i < 200; ++i) {
+    detector.add_interval(i % 2 == 0 ? 900 : 1100);
+  }
+  BOOST_CHECK_CLOSE(detector.mean(), 1000.0, 2.0);
+  BOOST_CHECK(detector.std_deviation() > 50 &&
+              detector.std_deviation() < 150);
+}
+
+BOOST_AUTO_TEST_CASE(suspicion_test) {
+  PhiAccrualDetector detector(1000, 100, 0);
+  for (int i = 0; i < 100; ++i) {
+    detector.add_interval(1000);
+  }
+  // the standard deviation is kept at its minimum for regular arrivals
+  BOOST_CHECK_SMALL(detector.phi(0), 0.01);
+  BOOST_CHECK_CLOSE(detector.phi(1000), -std::log10(0.5), 1.0);
+  BOOST_CHECK(detector.phi(1200) > 1.0);
+  BOOST_CHECK(detector.phi(1500) > 5.0);
+  BOOST_CHECK(detector.phi(1400) < detector.phi(1500));
+  BOOST_CHECK_EQUAL(detector.phi(100000), PhiAccrualDetector::MAX_PHI);
+}
+
+BOOST_AUTO_TEST_CASE(acceptable_pause_test) {
+  PhiAccrualDetector strict(1000, 100, 0);
+  PhiAccrualDetector tolerant(1000, 100, 5000);
+  for (int i = 0; i < 100; ++i) {
+    strict.add_interval(1000);
+    tolerant.add_interval(1000);
+  }
+  BOOST_CHECK(strict.phi(3000) > 8.0);
+  BOOST_CHECK(tolerant.phi(3000) < 1.0);
+  BOOST_CHECK_CLOSE(tolerant.phi(6000), strict.phi(1000), 1.0);
+}
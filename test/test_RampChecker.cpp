@@ -0,0 +1,90 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_RampChecker
+#include <boost/test/unit_test.hpp>
+
+#include "RampChecker.hpp"
+#include <vector>
+
+namespace {
+
+using Implementation = RampChecker::Implementation;
+
+const std::vector<Implementation> all_implementations{
+    Implementation::Scalar, Implementation::Sse41, Implementation::Avx2,
+    Implementation::Avx512};
+
+std::vector<uint64_t> make_ramp64(size_t count, uint64_t first, uint64_t step) {
+  std::vector<uint64_t> words(count);
+  for (size_t i = 0; i < count; ++i) {
+    words[i] = first + i * step;
+  }
+  return words;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(ramp64_test) {
+  const uint64_t first = UINT64_C(3) << 48;
+  const uint64_t step = 8;
+  for (auto implementation : all_implementations) {
+    if (!RampChecker::is_available(implementation)) {
+      continue;
+    }
+    RampChecker checker(implementation);
+    BOOST_TEST_CONTEXT(RampChecker::to_string(implementation)) {
+      for (size_t count : {0, 1, 7, 8, 31, 32, 33, 100, 1024}) {
+        auto words = make_ramp64(count, first, step);
+        uint64_t expected_sum = 0;
+        for (uint64_t word : words) {
+          expected_sum ^= word;
+        }
+        uint64_t xor_sum = 0;
+        BOOST_CHECK_EQUAL(
+            checker.find_mismatch(words.data(), count, first, step, &xor_sum),
+            count);
+        BOOST_CHECK_EQUAL(xor_sum, expected_sum);
+
+        for (size_t pos : {size_t{0}, count / 3, count - 1}) {
+          if (pos >= count) {
+            continue;
+          }
+          auto corrupted = words;
+          corrupted[pos] ^= UINT64_C(1) << 40;
+          BOOST_CHECK_EQUAL(
+              checker.find_mismatch(corrupted.data(), count, first, step),
+              pos);
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ramp16_test) {
+  const uint16_t first = 0xbc00;
+  for (auto implementation : all_implementations) {
+    if (!RampChecker::is_available(implementation)) {
+      continue;
+    }
+    RampChecker checker(implementation);
+    BOOST_TEST_CONTEXT(RampChecker::to_string(implementation)) {
+      for (size_t count : {0, 1, 2, 15, 16, 17, 31, 32, 33, 62, 200}) {
+        std::vector<uint16_t> words(count);
+        for (size_t i = 0; i < count; ++i) {
+          words[i] = static_cast<uint16_t>(first + i);
+        }
+        BOOST_CHECK_EQUAL(checker.find_mismatch(words.data(), count, first),
+                          count);
+
+        for (size_t pos : {size_t{0}, count / 2, count - 1}) {
+          if (pos >= count) {
+            continue;
+          }
+          auto corrupted = words;
+          corrupted[pos] = 0;
+          BOOST_CHECK_EQUAL(
+              checker.find_mismatch(corrupted.data(), count, first), pos);
+        }
+      }
+    }
+  }
+}
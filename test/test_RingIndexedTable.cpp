@@ -0,0 +1,79 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_RingIndexedTable
+#include <boost/test/unit_test.hpp>
+
+#include "RingIndexedTable.hpp"
+#include <vector>
+
+using tl_libfabric::RingIndexedTable;
+
+BOOST_AUTO_TEST_CASE(capacity_test) {
+  RingIndexedTable<uint64_t> table(5);
+  BOOST_CHECK_EQUAL(table.capacity(), 8u);
+  BOOST_CHECK(table.empty());
+}
+
+BOOST_AUTO_TEST_CASE(add_get_remove_test) {
+  RingIndexedTable<uint64_t> table(8);
+  for (uint64_t key = 100; key < 104; ++key) {
+    BOOST_CHECK(table.add(key, key * 2));
+  }
+  BOOST_CHECK(!table.add(101, 0));
+  BOOST_CHECK_EQUAL(table.size(), 4u);
+  BOOST_CHECK_EQUAL(table.get(102), 204u);
+  BOOST_CHECK_EQUAL(table.get_first_key(), 100u);
+  BOOST_CHECK_EQUAL(table.get_last_key(), 103u);
+
+  BOOST_CHECK(table.remove(100));
+  BOOST_CHECK(!table.remove(100));
+  BOOST_CHECK_EQUAL(table.get_first_key(), 101u);
+  BOOST_CHECK(table.remove(103));
+  BOOST_CHECK_EQUAL(table.get_last_key(), 102u);
+
+  // removing in the middle keeps the bounds
+  BOOST_CHECK(table.add(103, 0));
+  BOOST_CHECK(table.remove(102));
+  BOOST_CHECK_EQUAL(table.get_first_key(), 101u);
+  BOOST_CHECK_EQUAL(table.get_last_key(), 103u);
+  BOOST_CHECK(table.remove(101));
+  BOOST_CHECK_EQUAL(table.get_first_key(), 103u);
+}
+
+BOOST_AUTO_TEST_CASE(window_test) {
+  RingIndexedTable<uint64_t> table(4);
+  for (uint64_t key = 0; key < 4; ++key) {
+    BOOST_CHECK(table.add(key, key));
+  }
+  // advancing the window drops the oldest keys
+  BOOST_CHECK(!table.would_evict(3));
+  BOOST_CHECK(table.would_evict(5));
+  BOOST_CHECK(table.add(5, 5));
+  BOOST_CHECK(!table.contains(0));
+  BOOST_CHECK(!table.contains(1));
+  BOOST_CHECK(table.contains(2));
+  BOOST_CHECK_EQUAL(table.size(), 3u);
+  BOOST_CHECK_EQUAL(table.get_first_key(), 2u);
+
+  // keys older than the window are rejected, gaps can be filled
+  BOOST_CHECK(!table.add(1, 1));
+  BOOST_CHECK(table.add(4, 4));
+  BOOST_CHECK_EQUAL(table.size(), 4u);
+
+  table.remove(2);
+  table.remove(3);
+  table.remove(4);
+  table.remove(5);
+  BOOST_CHECK(table.empty());
+  BOOST_CHECK(table.add(1000, 1));
+  BOOST_CHECK_EQUAL(table.get_first_key(), 1000u);
+  BOOST_CHECK_EQUAL(table.get_last_key(), 1000u);
+}
+
+BOOST_AUTO_TEST_CASE(insert_in_place_test) {
+  RingIndexedTable<std::vector<uint64_t>> table(2);
+  std::vector<uint64_t>* value = table.insert(7);
+  BOOST_REQUIRE(value != nullptr);
+  value->assign(3, 1);
+  BOOST_CHECK(table.insert(7) == nullptr);
+  BOOST_CHECK_EQUAL(table.get(7).size(), 3u);
+}
@@ -0,0 +1,127 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+#define BOOST_TEST_MODULE test_TimesliceSchedule
+#include <boost/test/unit_test.hpp>
+
+#include "TimesliceSchedule.hpp"
+#include <vector>
+
+using tl_libfabric::TimesliceSchedule;
+
+BOOST_AUTO_TEST_CASE(weighted_owner_test) {
+  TimesliceSchedule schedule(4);
+  schedule.add(0, 799, {2.0, 1.0, 1.0});
+  BOOST_CHECK_EQUAL(schedule.end(), 800u);
+
+  std::vector<uint64_t> counts(3, 0);
+  for (uint64_t ts = 0; ts < 800; ++ts) {
+    ++counts[schedule.owner(ts)];
+  }
+  BOOST_CHECK_EQUAL(counts[0], 400u);
+  BOOST_CHECK_EQUAL(counts[1], 200u);
+  BOOST_CHECK_EQUAL(counts[2], 200u);
+  BOOST_CHECK_EQUAL(schedule.owner(800), TimesliceSchedule::NO_OWNER);
+
+  // the heavier node does not receive its share in a single burst
+  BOOST_CHECK(schedule.owner(0) != schedule.owner(1) ||
+              schedule.owner(1) != schedule.owner(2));
+}
+
+BOOST_AUTO_TEST_CASE(next_and_count_test) {
+  TimesliceSchedule schedule(8);
+  schedule.add(10, 109, {1.5, 0.25, 1.25});
+  schedule.add(110, 149, {0.0, 2.0, 1.0});
+
+  for (uint32_t cn = 0; cn < 3; ++cn) {
+    for (uint64_t from = 0; from < 160; ++from) {
+      uint64_t expected = TimesliceSchedule::NONE;
+      for (uint64_t ts = from; ts < 150; ++ts) {
+        if (schedule.owner(ts) == cn) {
+          expected = ts;
+          break;
+        }
+      }
+      BOOST_CHECK_EQUAL(schedule.next(cn, from), expected);
+    }
+
+    for (uint64_t first = 0; first < 160; first += 7) {
+      for (uint64_t last = first; last < 160; last += 11) {
+        uint64_t expected = 0;
+        for (uint64_t ts = first; ts <= last; ++ts) {
+          if (schedule.owner(ts) == cn) {
+            ++expected;
+          }
+        }
+        BOOST_CHECK_EQUAL(schedule.count(cn, first, last), expected);
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(schedule.count(0, 110, 149), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(truncate_release_test) {
+  TimesliceSchedule schedule;
+  schedule.add(0, 99, {1.0, 1.0});
+  schedule.add(100, 199, {1.0, 1.0});
+  uint32_t owner = schedule.owner(150);
+
+  schedule.truncate(149);
+  BOOST_CHECK_EQUAL(schedule.end(), 150u);
+  BOOST_CHECK_EQUAL(schedule.owner(150), TimesliceSchedule::NO_OWNER);
+  schedule.truncate(49);
+  BOOST_CHECK_EQUAL(schedule.end(), 50u);
+
+  schedule.add(50, 199, {1.0, 1.0});
+  BOOST_CHECK_EQUAL(schedule.owner(150), owner);
+  schedule.release(60);
+  BOOST_CHECK_EQUAL(schedule.owner(10), TimesliceSchedule::NO_OWNER);
+  BOOST_CHECK(schedule.owner(60) != TimesliceSchedule::NO_OWNER);
+  schedule.release(200);
+  BOOST_CHECK(schedule.empty());
+}
+
+BOOST_AUTO_TEST_CASE(many_intervals_test) {
+  // the intervals are found by binary search, check every timeslice of a
+  // long schedule against a schedule holding only its own interval
+  TimesliceSchedule schedule(4);
+  std::vector<TimesliceSchedule> single;
+  uint64_t start = 5;
+  for (uint32_t i = 0; i < 40; ++i) {
+    uint64_t last = start + 3 + (i * 7) % 23;
+    std::vector<double> load = {1.0 + i % 3, (i % 4 == 0) ? 0.0 : 0.5, 1.0};
+    schedule.add(start, last, load);
+    single.emplace_back(4);
+    single.back().add(start, last, load);
+    start = last + 1;
+  }
+  schedule.release(100);
+
+  for (uint64_t ts = 0; ts < start + 10; ++ts) {
+    uint32_t expected = TimesliceSchedule::NO_OWNER;
+    for (const auto& s : single) {
+      // release drops only the intervals that end before timeslice 100
+      if (s.end() > 100 && s.owner(ts) != TimesliceSchedule::NO_OWNER) {
+        expected = s.owner(ts);
+      }
+    }
+    BOOST_CHECK_EQUAL(schedule.owner(ts), expected);
+  }
+
+  for (uint64_t from = 90; from < start + 10; from += 3) {
+    uint64_t expected = TimesliceSchedule::NONE;
+    for (uint64_t ts = from; ts < start; ++ts) {
+      if (schedule.owner(ts) == 1) {
+        expected = ts;
+        break;
+      }
+    }
+    BOOST_CHECK_EQUAL(schedule.next(1, from), expected);
+
+    uint64_t count = 0;
+    for (uint64_t ts = from; ts <= from + 50; ++ts) {
+      if (schedule.owner(ts) == 1) {
+        ++count;
+      }
+    }
+    BOOST_CHECK_EQUAL(schedule.count(1, from, from + 50), count);
+  }
+}
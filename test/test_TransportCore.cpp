@@ -0,0 +1,160 @@
+// Copyright 2026 Jan de Cuveland <cmail@cuveland.de>
+
+#define BOOST_TEST_MODULE test_TransportCore
+#include <boost/test/unit_test.hpp>
+
+#include "AckRing.hpp"
+#include "FlesnetPatternGenerator.hpp"
+#include "InputChannelSender.hpp"
+#include "LoopbackNetwork.hpp"
+#include "SendBufferTracker.hpp"
+#include "TimesliceBuffer.hpp"
+#include "TimesliceBuilder.hpp"
+#include "TimesliceReceiver.hpp"
+#include <csignal>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(ack_ring_reorder_test) {
+  AckRing ack(3);
+  BOOST_CHECK_EQUAL(ack.size(), 8u);
+
+  BOOST_CHECK(!ack.acknowledge(2));
+  BOOST_CHECK(!ack.acknowledge(1));
+  BOOST_CHECK_EQUAL(ack.acked(), 0u);
+  BOOST_CHECK(ack.acknowledge(0));
+  BOOST_CHECK_EQUAL(ack.acked(), 3u);
+
+  // wrap around several times with reversed pairs, stale entries of
+  // earlier rounds must not be taken as acknowledged
+  for (uint64_t pos = 3; pos < 100; pos += 2) {
+    BOOST_CHECK(!ack.acknowledge(pos + 1));
+    BOOST_CHECK(ack.acknowledge(pos));
+    BOOST_CHECK_EQUAL(ack.acked(), pos + 2);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(send_buffer_tracker_parts_test) {
+  FlesnetPatternGenerator source(16, 10, 0, 64);
+  source.proceed();
+  SendBufferTracker tracker(source, 10, 2);
+
+  // data part before descriptor part, and timeslice 1 before timeslice 0
+  BOOST_CHECK(!tracker.acknowledge(0, 1));
+  BOOST_CHECK(!tracker.acknowledge(1, 0));
+  BOOST_CHECK(!tracker.acknowledge(1, 1));
+  BOOST_CHECK_EQUAL(tracker.acked_timeslices(), 0u);
+  BOOST_CHECK(tracker.acknowledge(0, 0));
+  BOOST_CHECK_EQUAL(tracker.acked_timeslices(), 2u);
+  BOOST_CHECK_EQUAL(tracker.acked().desc, 20u);
+  BOOST_CHECK_EQUAL(tracker.acked().data, 20u * 64);
+
+  // the read index is written to the source lazily
+  BOOST_CHECK_EQUAL(source.get_read_index().desc, 0u);
+  tracker.sync_data_source();
+  BOOST_CHECK_EQUAL(source.get_read_index().desc, 20u);
+  BOOST_CHECK_EQUAL(tracker.status_desc({}).freeing(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(loopback_transport_test) {
+  constexpr uint32_t num_inputs = 3;
+  constexpr uint32_t num_outputs = 2;
+  constexpr uint32_t timeslice_size = 10;
+  constexpr uint32_t overlap_size = 1;
+  constexpr uint32_t num_timeslices = 500;
+
+  std::vector<std::unique_ptr<FlesnetPatternGenerator>> sources;
+  for (uint32_t i = 0; i < num_inputs; ++i) {
+    sources.push_back(
+        std::make_unique<FlesnetPatternGenerator>(16, 8, i, 256, true, true));
+  }
+
+  // small timeslice buffers to exercise wrapping and full buffers
+  tl_loopback::LoopbackNetwork network(num_inputs, num_outputs);
+  volatile sig_atomic_t signal_status = 0;
+  std::vector<std::string> shm_ids;
+  std::vector<std::unique_ptr<TimesliceBuffer>> buffers;
+  std::vector<std::unique_ptr<tl_loopback::TimesliceBuilder>> builders;
+  for (uint32_t c = 0; c < num_outputs; ++c) {
+    shm_ids.push_back("test_TransportCore_" + std::to_string(getpid()) +
+                      "_" + std::to_string(c) + "_");
+    buffers.push_back(
+        std::make_unique<TimesliceBuffer>(shm_ids.back(), 14, 3, num_inputs));
+    builders.push_back(std::make_unique<tl_loopback::TimesliceBuilder>(
+        c, *buffers.back(), network, timeslice_size, &signal_status, false));
+  }
+  std::vector<std::unique_ptr<tl_loopback::InputChannelSender>> senders;
+  for (uint32_t i = 0; i < num_inputs; ++i) {
+    senders.push_back(std::make_unique<tl_loopback::InputChannelSender>(
+        i, *sources[i], network, timeslice_size, overlap_size,
+        num_timeslices));
+  }
+
+  // check the timeslices of each compute node, holding up to a few of
+  // them and releasing them out of order
+  std::vector<uint64_t> checked(num_outputs, 0);
+  std::vector<uint64_t> errors(num_outputs, 0);
+  auto consume = [&](uint32_t c) {
+    fles::TimesliceReceiver receiver(shm_ids[c]);
+    std::deque<std::unique_ptr<fles::TimesliceView>> held;
+    while (auto ts = receiver.get()) {
+      if (ts->index() % num_outputs != c ||
+          ts->num_components() != num_inputs) {
+        ++errors[c];
+      }
+      for (uint32_t i = 0; i < ts->num_components(); ++i) {
+        if (ts->num_microslices(i) != timeslice_size + overlap_size) {
+          ++errors[c];
+        }
+        for (uint64_t m = 0; m < ts->num_microslices(i); ++m) {
+          const auto& desc = ts->descriptor(i, m);
+          if (desc.idx != ts->index() * timeslice_size + m) {
+            ++errors[c];
+          }
+          const auto* content =
+              reinterpret_cast<const uint64_t*>(ts->content(i, m));
+          for (uint64_t w = 0; w < desc.size / sizeof(uint64_t); ++w) {
+            if (content[w] != ((UINT64_C(1) * i << 48) | (w * 8))) {
+              ++errors[c];
+            }
+          }
+        }
+      }
+      ++checked[c];
+      held.push_back(std::move(ts));
+      if (held.size() == 3) {
+        held.erase(held.begin() + 1);
+        held.pop_front();
+      }
+      if (checked[c] == num_timeslices / num_outputs) {
+        held.clear();
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (uint32_t c = 0; c < num_outputs; ++c) {
+    threads.emplace_back(consume, c);
+    threads.emplace_back(std::ref(*builders[c]));
+  }
+  for (auto& sender : senders) {
+    threads.emplace_back(std::ref(*sender));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (uint32_t c = 0; c < num_outputs; ++c) {
+    BOOST_CHECK_EQUAL(errors[c], 0u);
+    BOOST_CHECK_EQUAL(checked[c], num_timeslices / num_outputs);
+  }
+  for (auto& source : sources) {
+    BOOST_CHECK_EQUAL(source->get_read_index().desc,
+                      num_timeslices * timeslice_size);
+  }
+}
@@ -0,0 +1,37 @@
+#!/bin/bash
+
+# Failure injection: kill one of two compute nodes on localhost while
+# timeslices are in flight and check that the inputs recover and the
+# surviving node keeps processing.
+
+set -o pipefail
+
+cat > test_failover.cfg << EOF
+input = pgen://127.0.0.1/?mean=102400&overlap=1&pattern=0
+input = pgen://127.0.0.1/?mean=102400&overlap=1&pattern=0
+output = shm://127.0.0.1/flesnet_failover_0?datasize=27&descsize=19
+output = shm://127.0.0.1/flesnet_failover_1?datasize=27&descsize=19
+timeslice-size = 100
+max-timeslice-number = 2000
+processor-executable = ./tsclient -c%i -s%s -a
+processor-instances = 1
+transport = libfabric
+base-port = 20179
+scheduler-interval-length = 100
+scheduler-log-directory = .
+EOF
+
+./run_failover test_failover.cfg 0 3 | tee test_failover.out
+STATUS=$?
+
+PROCESSED=`grep "^compute 1:" test_failover.out \
+	| sed 's/compute 1: \([0-9]*\) timeslices.*/\1/'`
+echo "timeslices processed by the surviving node: ${PROCESSED:-0}"
+
+if [ $STATUS -ne 0 ] || [ "${PROCESSED:-0}" -eq 0 ]; then
+	echo "not ok"
+	exit 1
+else
+	echo "ok"
+	exit 0
+fi
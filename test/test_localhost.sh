@@ -0,0 +1,38 @@
+#!/bin/bash
+
+# Run two inputs and two compute nodes as separate processes on localhost
+# over libfabric and check which provider they use.
+#
+# usage: test_localhost.sh <expected provider log message>
+
+set -o errexit
+set -o pipefail
+
+EXPECTED="$1"
+
+cat > test_localhost.cfg << EOF
+input = pgen://127.0.0.1/?mean=10240&overlap=1&pattern=0
+input = pgen://127.0.0.1/?mean=10240&overlap=1&pattern=0
+output = shm://127.0.0.1/flesnet_localhost_0?datasize=27&descsize=19
+output = shm://127.0.0.1/flesnet_localhost_1?datasize=27&descsize=19
+timeslice-size = 100
+max-timeslice-number = 500
+processor-executable = ./tsclient -c%i -s%s -a
+processor-instances = 1
+transport = libfabric
+base-port = 20279
+scheduler-interval-length = 100
+scheduler-log-directory = .
+EOF
+
+./run_localhost test_localhost.cfg
+
+for LOG in flesnet_c0.log flesnet_c1.log flesnet_i0.log flesnet_i1.log; do
+	if ! grep -q "$EXPECTED" "$LOG"; then
+		echo "$LOG: expected \"$EXPECTED\""
+		echo "not ok"
+		exit 1
+	fi
+done
+echo "ok"
+exit 0
@@ -0,0 +1,95 @@
+#!/bin/bash
+
+# Late join: start a standby compute node on localhost while two inputs and
+# two compute nodes are running, and check that it joins at an interval
+# boundary and then processes timeslices.
+
+# seconds until the standby compute node is started
+JOIN_AFTER=3
+
+cat > test_standby.cfg << EOF
+input = pgen://127.0.0.1/?mean=102400&overlap=1&pattern=0
+input = pgen://127.0.0.1/?mean=102400&overlap=1&pattern=0
+output = shm://127.0.0.1/flesnet_standby_0?datasize=27&descsize=19
+output = shm://127.0.0.1/flesnet_standby_1?datasize=27&descsize=19
+output = shm://127.0.0.1/flesnet_standby_2?datasize=27&descsize=19&standby=1
+timeslice-size = 100
+max-timeslice-number = 4000
+processor-executable = ./tsclient -c%i -s%s -a
+processor-instances = 1
+transport = libfabric
+base-port = 20579
+scheduler-interval-length = 100
+scheduler-log-directory = .
+EOF
+
+rm -f /dev/shm/flesnet_standby_* flesnet_c*.log flesnet_c*.out \
+	flesnet_i*.log
+
+declare -a PIDS
+trap 'pkill -P $$ 2> /dev/null; kill "${PIDS[@]}" 2> /dev/null' INT TERM
+
+for i in 0 1; do
+	./flesnet -f test_standby.cfg -o $i -L "flesnet_c$i.log" \
+		> "flesnet_c$i.out" 2>&1 &
+	PIDS+=($!)
+done
+sleep 1
+for i in 0 1; do
+	./flesnet -f test_standby.cfg -i $i -L "flesnet_i$i.log" \
+		> /dev/null 2>&1 &
+	PIDS+=($!)
+done
+sleep "$JOIN_AFTER"
+./flesnet -f test_standby.cfg -o 2 -L flesnet_c2.log > flesnet_c2.out 2>&1 &
+PIDS+=($!)
+
+STATUS=0
+for PID in "${PIDS[@]}"; do
+	wait $PID || STATUS=1
+done
+
+for i in 0 1; do
+	JOINED=`grep -n "compute node 2 joined" "flesnet_i$i.log" \
+		| head -1 | cut -d: -f1`
+	if [ -z "$JOINED" ]; then
+		echo "input $i: compute node 2 did not join"
+		STATUS=1
+		continue
+	fi
+	# the first load distribution giving timeslices to the joined node has
+	# to follow the previous interval without a gap or an overlap
+	BOUNDARY=`grep -n "\[update_load_distribution\]" "flesnet_i$i.log" \
+		| awk -v joined="$JOINED" '{
+			for (f = 1; f <= NF; f++) {
+				if ($f == "start_ts:") start = $(f + 1)
+				if ($f == "last_ts:") last = $(f + 1)
+				if ($f == "dist:") load = $(f + 3)
+			}
+			if ($1 + 0 > joined && load > 0) { print start, prev; exit }
+			prev = last }'`
+	read START PREV_LAST <<< "$BOUNDARY"
+	if [ -z "$START" ]; then
+		echo "input $i: no load for compute node 2 after the join"
+		STATUS=1
+	elif [ -z "$PREV_LAST" ] || [ "$START" -ne $(( PREV_LAST + 1 )) ]; then
+		echo "input $i: compute node 2 joined at timeslice $START," \
+			"not at an interval boundary"
+		STATUS=1
+	else
+		echo "input $i: compute node 2 joined at timeslice $START"
+	fi
+done
+
+PROCESSED=`grep -h "total timeslices processed" flesnet_c2.out \
+	2> /dev/null | sed 's/.*processed: \([0-9]*\).*/\1/' \
+	| awk '{ n += $1 } END { print n + 0 }'`
+echo "timeslices processed by the standby node: $PROCESSED"
+
+if [ $STATUS -ne 0 ] || [ "$PROCESSED" -eq 0 ]; then
+	echo "not ok"
+	exit 1
+else
+	echo "ok"
+	exit 0
+fi